@@ -0,0 +1,172 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : acecacheheader.c                               */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Forms binary ACE cache file name and the part of the cache   */
+/*              header that identifies the source ACE file.                  */
+/*                                                                           */
+/* Comments: - The cache file name is formed from the table name and a hash  */
+/*             of the full path of the source file, so the same table read   */
+/*             from different libraries does not collide.                    */
+/*                                                                           */
+/*           - Source file is identified by size, modification time and an   */
+/*             FNV-1a checksum over the entire file. The checksum is         */
+/*             calculated only if chk is YES and "set acecache" check option */
+/*             is not 0. ReadACECache() requests it only after size and time */
+/*             match, so the entire file is read only for files that have a  */
+/*             candidate cache entry. The checksum of the previous file is   */
+/*             remembered, since consecutive tables are often read from the  */
+/*             same file.                                                    */
+/*                                                                           */
+/*           - File position is restored before return.                     */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "ACECacheHeader:"
+
+#define ACE_CACHE_READ_BUF 1048576
+
+/*****************************************************************************/
+
+long ACECacheHeader(long nuc, FILE *fp, char *fname, long *hdr, long chk)
+{
+  static char prev[MAX_STR] = "";
+  static unsigned long prevsum = 0;
+  static long prevsize = -1, prevtime = -1;
+  unsigned long sum, phash;
+  long ace, pos, n, i;
+  unsigned char *buf;
+  char src[MAX_STR], name[MAX_STR], *c;
+  struct stat st;
+
+  /* Check that cache is in use */
+
+  if ((long)RDB[DATA_ACE_CACHE_PTR_DIR] < VALID_PTR)
+    return NO;
+
+  /* Get pointer to ACE data */
+
+  ace = (long)RDB[nuc + NUCLIDE_PTR_ACE];
+  CheckPointer(FUNCTION_NAME, "ace", ACE_ARRAY, ace);
+
+  /* Get table and source file names (file name as given in the */
+  /* directory file) */
+
+  WDB[DATA_DUMMY] = ACE[ace + ACE_PTR_NAME];
+  strcpy(name, GetText(DATA_DUMMY));
+
+  WDB[DATA_DUMMY] = ACE[ace + ACE_PTR_FILE];
+  strcpy(src, GetText(DATA_DUMMY));
+
+  /* Get size and modification time */
+
+  if (fstat(fileno(fp), &st) != 0)
+    return NO;
+
+  /* Hash of source file path (FNV-1a) */
+
+  phash = 14695981039346656037UL;
+
+  for (c = src; *c != '\0'; c++)
+    {
+      phash ^= (unsigned long)((unsigned char)*c);
+      phash *= 1099511628211UL;
+    }
+
+  /* Cache file name */
+
+  if (snprintf(fname, MAX_STR, "%s/%s.%016lx.acb",
+               GetText(DATA_ACE_CACHE_PTR_DIR), name, phash) >= MAX_STR)
+    Error(0, "ACE cache file name too long in directory \"%s\"",
+          GetText(DATA_ACE_CACHE_PTR_DIR));
+
+  /* Reset header */
+
+  for (n = 0; n < ACE_CACHE_HDR_SIZE; n++)
+    hdr[n] = 0;
+
+  /* Put identifiers */
+
+  hdr[ACE_CACHE_HDR_MAGIC] = ACE_CACHE_MAGIC;
+  hdr[ACE_CACHE_HDR_VERSION] = ACE_CACHE_VERSION;
+  hdr[ACE_CACHE_HDR_SRC_SIZE] = (long)st.st_size;
+  hdr[ACE_CACHE_HDR_SRC_TIME] = (long)st.st_mtime;
+
+  /* Check if checksum is needed */
+
+  if ((chk == NO) || ((long)RDB[DATA_ACE_CACHE_CHECK] == NO))
+    return YES;
+
+  /* Compare to previous file */
+
+  if ((!strcmp(src, prev)) && ((long)st.st_size == prevsize) &&
+      ((long)st.st_mtime == prevtime))
+    {
+      /* Use stored value */
+
+      hdr[ACE_CACHE_HDR_SRC_SUM] = (long)prevsum;
+
+      /* Exit */
+
+      return YES;
+    }
+
+  /* Store position and rewind */
+
+  if ((pos = ftell(fp)) == -1)
+    Die(FUNCTION_NAME, "ftell error");
+
+  rewind(fp);
+
+  /* Allocate memory for read buffer */
+
+  buf = (unsigned char *)Mem(MEM_ALLOC, ACE_CACHE_READ_BUF,
+                             sizeof(unsigned char));
+
+  /* Calculate FNV-1a checksum over entire file */
+
+  sum = 14695981039346656037UL;
+
+  while ((n = (long)fread(buf, sizeof(unsigned char), ACE_CACHE_READ_BUF,
+                          fp)) > 0)
+    for (i = 0; i < n; i++)
+      {
+        sum ^= (unsigned long)buf[i];
+        sum *= 1099511628211UL;
+      }
+
+  /* Free buffer */
+
+  Mem(MEM_FREE, buf);
+
+  /* Restore position */
+
+  clearerr(fp);
+
+  if (fseek(fp, pos, SEEK_SET) != 0)
+    Die(FUNCTION_NAME, "fseek error");
+
+  /* Remember values */
+
+  strcpy(prev, src);
+  prevsum = sum;
+  prevsize = (long)st.st_size;
+  prevtime = (long)st.st_mtime;
+
+  /* Put checksum */
+
+  hdr[ACE_CACHE_HDR_SRC_SUM] = (long)sum;
+
+  /* Exit */
+
+  return YES;
+}
+
+/*****************************************************************************/
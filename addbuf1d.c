@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : addbuf1d.c                                     */
 /*                                                                           */
 /* Created:       2014/04/04 (JLe)                                           */
-/* Last modified: 2014/04/05 (JLe)                                           */
-/* Version:       2.1.20                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Simplified version of addbuf.c for 1d results                */
 /*                                                                           */
@@ -49,14 +49,26 @@ void AddBuf1D(double val, double wgt, long ptr, long id, long idx)
 
 #endif
 
-  /* Get pointer to buffer */
+  /* Check sparse storage */
 
-  loc0 = (long)RDB[ptr + SCORE_PTR_BUF];
-  CheckPointer(FUNCTION_NAME, "(loc0)", BUF_ARRAY, loc0);
+  if ((long)RDB[ptr + SCORE_SPARSE] == YES)
+    {
+      /* Get pointer to data (page is assigned when first scored) */
+
+      loc0 = SparseStatPtr(ptr, idx, BUF_ARRAY, YES);
+    }
+  else
+    {
+      /* Get pointer to buffer */
 
-  /* Get pointer to data */
+      loc0 = (long)RDB[ptr + SCORE_PTR_BUF];
+      CheckPointer(FUNCTION_NAME, "(loc0)", BUF_ARRAY, loc0);
+
+      /* Get pointer to data */
+
+      loc0 = loc0 + idx*BUF_BLOCK_SIZE;
+    }
 
-  loc0 = loc0 + idx*BUF_BLOCK_SIZE;
   CheckPointer(FUNCTION_NAME, "(loc0)", BUF_ARRAY, loc0);
 
   /* Check that buffer is not reduced */
@@ -66,7 +78,13 @@ void AddBuf1D(double val, double wgt, long ptr, long id, long idx)
 
   /* Check if shared or private */
 
-  if ((long)RDB[DATA_OPTI_SHARED_BUF] == YES)
+  if ((long)RDB[DATA_OPTI_HYBRID_BUF] == YES)
+    {
+      /* Hybrid buffer, add to thread-wise table */
+
+      AddHybridBuf(loc0, val, wgt, id);
+    }
+  else if ((long)RDB[DATA_OPTI_SHARED_BUF] == YES)
     {
       /* Shared buffer, put data */
 
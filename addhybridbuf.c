@@ -0,0 +1,125 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : addhybridbuf.c                                 */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Adds result to thread-wise hash table of hybrid scoring      */
+/*              buffer                                                       */
+/*                                                                           */
+/* Comments: - Used by AddBuf() and AddBuf1D() with "set hybuf". Repeated    */
+/*             scores to the same bin are summed in the table of the thread, */
+/*             and the table is flushed to the shared BUF array when half    */
+/*             of the slots are in use. Atomic operations are done once per  */
+/*             bin per flush instead of once per score.                      */
+/*                                                                           */
+/*           - The tables are in the PRIVA array, so the data of different   */
+/*             threads is in separate segments and never in the same cache   */
+/*             line.                                                         */
+/*                                                                           */
+/*           - Slot key is buffer index + 1 (zero is empty slot). Linear     */
+/*             probing is used for collisions.                               */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "AddHybridBuf:"
+
+/*****************************************************************************/
+
+void AddHybridBuf(long loc0, double val, double wgt, long id)
+{
+  long sz, ns, ptr, lst, cnt, i, n;
+  unsigned long h;
+  double key;
+
+  /* Get segment size and number of slots */
+
+  sz = (long)RDB[DATA_REAL_PRIVA_SIZE];
+  ns = (long)RDB[DATA_HYBRID_BUF_SIZE];
+
+  /* Get pointers to table, list of used slots and counter */
+
+  ptr = (long)RDB[DATA_PTR_HYBRID_BUF];
+  CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
+
+  lst = (long)RDB[DATA_PTR_HYBRID_BUF_LIST];
+  CheckPointer(FUNCTION_NAME, "(lst)", PRIVA_ARRAY, lst);
+
+  cnt = (long)RDB[DATA_PTR_HYBRID_BUF_COUNT];
+  CheckPointer(FUNCTION_NAME, "(cnt)", PRIVA_ARRAY, cnt);
+
+  /* Add thread offset */
+
+  ptr = ptr + id*sz;
+  lst = lst + id*sz;
+  cnt = cnt + id*sz;
+
+  /* Calculate hash (number of slots is a power of 2) */
+
+  h = (unsigned long)loc0*2654435761UL;
+  h = h ^ (h >> 16);
+  i = (long)(h & (unsigned long)(ns - 1));
+
+  /* Key */
+
+  key = (double)(loc0 + 1);
+
+  /* Loop over slots */
+
+  for (n = 0; n < ns; n++)
+    {
+      /* Check if bin is already in table */
+
+      if (PRIVA[ptr + i*HYBRID_BUF_BLOCK_SIZE + HYBRID_BUF_IDX] == key)
+        {
+          /* Add data */
+
+          PRIVA[ptr + i*HYBRID_BUF_BLOCK_SIZE + HYBRID_BUF_VAL] += wgt*val;
+          PRIVA[ptr + i*HYBRID_BUF_BLOCK_SIZE + HYBRID_BUF_WGT] += wgt;
+          PRIVA[ptr + i*HYBRID_BUF_BLOCK_SIZE + HYBRID_BUF_N] += 1.0;
+
+          /* Exit */
+
+          return;
+        }
+      else if (PRIVA[ptr + i*HYBRID_BUF_BLOCK_SIZE + HYBRID_BUF_IDX] == 0.0)
+        {
+          /* Empty slot, put data */
+
+          PRIVA[ptr + i*HYBRID_BUF_BLOCK_SIZE + HYBRID_BUF_IDX] = key;
+          PRIVA[ptr + i*HYBRID_BUF_BLOCK_SIZE + HYBRID_BUF_VAL] = wgt*val;
+          PRIVA[ptr + i*HYBRID_BUF_BLOCK_SIZE + HYBRID_BUF_WGT] = wgt;
+          PRIVA[ptr + i*HYBRID_BUF_BLOCK_SIZE + HYBRID_BUF_N] = 1.0;
+
+          /* Add to list of used slots */
+
+          n = (long)PRIVA[cnt];
+          PRIVA[lst + n] = (double)i;
+          PRIVA[cnt] = (double)(n + 1);
+
+          /* Flush if table is half full */
+
+          if (2*(n + 1) >= ns)
+            FlushHybridBuf(id);
+
+          /* Exit */
+
+          return;
+        }
+
+      /* Next slot */
+
+      i = (i + 1) & (ns - 1);
+    }
+
+  /* Table is full (should not happen) */
+
+  Die(FUNCTION_NAME, "Hash table is full");
+}
+
+/*****************************************************************************/
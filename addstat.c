@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : addstat.c                                      */
 /*                                                                           */
 /* Created:       2010/11/10 (JLe)                                           */
-/* Last modified: 2011/11/30 (JLe)                                           */
-/* Version:       2.1.0                                                      */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                      */
 /*                                                                           */
 /* Description: Adds score to statistics                                     */
 /*                                                                           */
@@ -97,6 +97,30 @@ void AddStat(double val, long ptr, ...)
 
 #endif
 
+  /* Check sparse storage */
+
+  if ((long)RDB[ptr + SCORE_SPARSE] == YES)
+    {
+      /* Zero values are not stored (number of scores is common to all */
+      /* bins and counted in CollectSparseDet()) */
+
+      if (val == 0.0)
+        return;
+
+      /* Get pointer to statistics (page is assigned when first scored) */
+
+      stp = SparseStatPtr(ptr, idx, RES1_ARRAY, YES);
+
+      /* Add value */
+
+      RES1[stp + STAT_X] = RES1[stp + STAT_X] + val;
+      RES1[stp + STAT_X2] = RES1[stp + STAT_X2] + val*val;
+
+      /* Exit */
+
+      return;
+    }
+
   /* Get pointer to statistics */
 
   stp = (long)RDB[ptr + SCORE_PTR_DATA] + idx*STAT_BLOCK_SIZE;
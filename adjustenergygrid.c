@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : adjustenergygrid.c                             */
 /*                                                                           */
 /* Created:       2010/12/09 (JLe)                                           */
-/* Last modified: 2011/11/11 (JLe)                                           */
-/* Version:       2.1.0                                                      */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Reconfigures energu grid structure                           */
 /*                                                                           */
@@ -81,6 +81,10 @@ void AdjustEnergyGrid(long erg, long ne, const double *E)
 
   WDB[erg + ENERGY_GRID_EMID] = -1.0;
   WDB[erg + ENERGY_GRID_NB] = -1.0;
+
+  /* Set up lethargy-bucket index */
+
+  MakeLethargyIndex(erg);
 }
 
 /*****************************************************************************/
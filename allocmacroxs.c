@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : allocmacroxs.c                                 */
 /*                                                                           */
 /* Created:       2011/06/21 (JLe)                                           */
-/* Last modified: 2018/03/27 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Allocates memory for reaction lists and material totals      */
 /*                                                                           */
@@ -23,6 +23,8 @@
 /*                                                                           */
 /*           - Light element production added 11.8.2017 / 2.1.30 / JLe       */
 /*                                                                           */
+/*           - Single-precision storage added 17.10.2026 / 2.1.32 / JLe      */
+/*                                                                           */
 /*           - TODO:  + Muistipaikan pointteri talteen MPI-jakoa varten      */
 /*                    + Muuttujien nimet "mode" ja "lst" on epäloogiset      */
 /*                                                                           */
@@ -37,7 +39,7 @@
 
 void AllocMacroXS()
 {
-  long mat, mat0, sz, mode, loc0, loc1, n, lst, rea, ptr, erg, ne, nr;
+  long mat, mat0, sz, mode, loc0, loc1, n, lst, rea, ptr, erg, ne, nr, np;
   double Emin, Emax, mem;
 
   /* Check decay only mode */
@@ -67,6 +69,13 @@ void AllocMacroXS()
 
       if ((long)RDB[DATA_OPTI_RECONSTRUCT_MACROXS] == YES)
         {
+          /* Array size (single-precision data is packed) */
+
+          if ((long)RDB[DATA_OPTI_XS_SP] == YES)
+            np = (ne + 1)/2;
+          else
+            np = ne;
+
           /* Loop over materials */
 
           mat = (long)RDB[DATA_PTR_M0];
@@ -96,9 +105,9 @@ void AllocMacroXS()
                   if ((long)RDB[mat + MATERIAL_TMS_MODE] == TMS_MODE_CE)
                     sz = sz + ne;
                   if ((long)RDB[mat + MATERIAL_OPTIONS] & OPT_FISSILE_MAT)
-                    sz = sz + 6*ne;
+                    sz = sz + 6*np;
                   else
-                    sz = sz + 4*ne;
+                    sz = sz + 4*np;
                 }
 
               /* Next material */
@@ -794,9 +803,18 @@ void AllocMacroXS()
           WDB[rea + REACTION_XS_I0] = 0.0;
           WDB[rea + REACTION_XS_NE] = (double)ne;
           
-          /* Allocate memory */
+          /* Allocate memory (single-precision values are packed two per */
+          /* word, TMS majorant is always stored in double precision) */
+
+          if (((long)RDB[DATA_OPTI_XS_SP] == YES) &&
+              (mode != MATERIAL_PTR_TMP_MAJORANTXS))
+            {
+              ptr = ReallocMem(DATA_ARRAY, (ne + 1)/2);
+              WDB[rea + REACTION_XS_SP] = (double)YES;
+            }
+          else
+            ptr = ReallocMem(DATA_ARRAY, ne);
 
-          ptr = ReallocMem(DATA_ARRAY, ne);
           WDB[rea + REACTION_PTR_XS] = (double)ptr;
         }
       
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : allocmicroxs.c                                 */
 /*                                                                           */
 /* Created:       2011/11/30 (JLe)                                           */
-/* Last modified: 2019/03/21 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Estimates total memory required by cross section data and    */
 /*              pre-allocates it                                             */
@@ -174,6 +174,11 @@ void AllocMicroXS()
   WorkArray(DATA_PTR_WORK_PRIVA_GRID1, PRIVA_ARRAY, ne, 0);
   WorkArray(DATA_PTR_WORK_PRIVA_GRID2, PRIVA_ARRAY, ne, 0);
   WorkArray(DATA_PTR_WORK_PRIVA_GRID3, PRIVA_ARRAY, ne, 0);
+
+  /* Temporary array for single-precision macroscopic cross sections */
+
+  if ((long)RDB[DATA_OPTI_XS_SP] == YES)
+    WorkArray(DATA_PTR_WORK_PRIVA_GRID4, PRIVA_ARRAY, ne, 0);
 }
 
 /*****************************************************************************/
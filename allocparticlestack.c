@@ -3,12 +3,14 @@
 /* serpent 2 (beta-version) : allocparticlestacs.c                           */
 /*                                                                           */
 /* Created:       2012/10/17 (JLe)                                           */
-/* Last modified: 2019/04/03 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Allocates memory for particle histories (stacks)             */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - Particles are stored in contiguous per-thread blocks of       */
+/*             aligned records and the stacks are LIFO free lists linked     */
+/*             through LIST_PTR_NEXT                                         */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -21,7 +23,7 @@
 
 void AllocParticleStack(long type, long np)
 {
-  long ptr, loc0, id, n, sz;
+  long ptr, loc0, loc1, loc2, id, n, nt, sz;
 
 #ifdef OLD_IFP
 
@@ -29,10 +31,6 @@ void AllocParticleStack(long type, long np)
 
 #endif
 
-  /* Calculate size for preallocation (per particle) */
-
-  sz = PARTICLE_BLOCK_SIZE;
-
   /* Avoid compiler warning */
 
   loc0 = -1;
@@ -56,19 +54,6 @@ void AllocParticleStack(long type, long np)
           ptr = AllocPrivateData(1, PRIVA_ARRAY);
           WDB[DATA_PART_PTR_MIN_NSTACK] = (double)ptr;
         }
-
-#ifdef OLD_IFP
-
-      /* Add IFP fission progeny size */
-
-      sz = sz + (long)RDB[DATA_IFP_CHAIN_LENGTH]*FISS_PROG_BLOCK_SIZE;
-
-      /* Add fission progeny list common size */
-
-      sz = sz + LIST_COMMON_DATA_SIZE;
-
-#endif
-
     }
   else if (type == PARTICLE_TYPE_GAMMA)
     {
@@ -109,39 +94,88 @@ void AllocParticleStack(long type, long np)
   else
     Die(FUNCTION_NAME, "Invalid particle type");
 
-  /* Preallocate memory (speeds things up by a lot) */
+  /* Record size rounded up to alignment */
+
+  sz = PARTICLE_POOL_ALIGN*((PARTICLE_BLOCK_SIZE + PARTICLE_POOL_ALIGN - 1)/
+                            PARTICLE_POOL_ALIGN);
+
+  /* Number of threads */
 
-  PreallocMem(sz*np, DATA_ARRAY);
+  nt = (long)RDB[DATA_OMP_MAX_THREADS];
 
-  /* Reset OpenMP index */
+  /* Preallocate memory */
 
-  id = 0;
+#ifdef OLD_IFP
 
-  /* Loop over particles */
+  if (type == PARTICLE_TYPE_NEUTRON)
+    PreallocMem((sz + (long)RDB[DATA_IFP_CHAIN_LENGTH]*FISS_PROG_BLOCK_SIZE +
+                 LIST_COMMON_DATA_SIZE)*np + (nt + 1)*PARTICLE_POOL_ALIGN,
+                DATA_ARRAY);
+  else
 
-  for (n = 0; n < np; n++)
+#endif
+
+    PreallocMem(sz*np + (nt + 1)*PARTICLE_POOL_ALIGN + LIST_COMMON_DATA_SIZE,
+                DATA_ARRAY);
+
+  /* Common list data for records that are not in any list (needed */
+  /* for the item size check in AddItem() in debug mode) */
+
+  loc1 = ReallocMem(DATA_ARRAY, LIST_COMMON_DATA_SIZE);
+  WDB[loc1 + LIST_COMMON_ITEM_SIZE] = (double)PARTICLE_BLOCK_SIZE;
+
+  /* Loop over threads */
+
+  for (id = 0; id < nt; id++)
     {
-      /* Allocate memory */
+      /* Number of records for this thread */
+
+      if ((n = np/nt + (id < np % nt)) == 0)
+        continue;
+
+      /* Allocate one contiguous aligned block */
+
+      ptr = ReallocMem(DATA_ARRAY, sz*n + PARTICLE_POOL_ALIGN);
+      ptr = ptr + PARTICLE_POOL_ALIGN - ptr % PARTICLE_POOL_ALIGN;
 
-      ptr = NewItem(OMPPtr(loc0, id), PARTICLE_BLOCK_SIZE);
+      /* Pointer to stack */
 
-      /* Put type */
+      loc2 = (long)RDB[OMPPtr(loc0, id)];
+      CheckPointer(FUNCTION_NAME, "(loc2)", DATA_ARRAY, loc2);
 
-      WDB[ptr + PARTICLE_TYPE] = (double)type;
+      /* Loop over records */
 
-      /* Allocate memory for fission progenies */
+      while (n-- > 0)
+        {
+          /* Put list data */
+
+          WDB[ptr + LIST_PTR_PREV] = NULLPTR;
+          WDB[ptr + LIST_PTR_COMMON] = (double)loc1;
+          WDB[ptr + LIST_PTR_DIRECT] = NULLPTR;
+
+          /* Put type */
+
+          WDB[ptr + PARTICLE_TYPE] = (double)type;
+
+          /* Allocate memory for fission progenies */
 
 #ifdef OLD_IFP
 
-      if (type == PARTICLE_TYPE_NEUTRON)
-        for (m = 0; m < (long)RDB[DATA_IFP_CHAIN_LENGTH]; m++)
-          NewItem(ptr + PARTICLE_PTR_FISS_PROG, FISS_PROG_BLOCK_SIZE);
+          if (type == PARTICLE_TYPE_NEUTRON)
+            for (m = 0; m < (long)RDB[DATA_IFP_CHAIN_LENGTH]; m++)
+              NewItem(ptr + PARTICLE_PTR_FISS_PROG, FISS_PROG_BLOCK_SIZE);
 #endif
 
-      /* Update OpenMP id */
+          /* Push to stack */
+
+          WDB[ptr + LIST_PTR_NEXT] = RDB[loc2 + PART_STACK_PTR_TOP];
+          WDB[loc2 + PART_STACK_PTR_TOP] = (double)ptr;
+          WDB[loc2 + PART_STACK_N] = RDB[loc2 + PART_STACK_N] + 1.0;
 
-      if (++id > (long)RDB[DATA_OMP_MAX_THREADS] - 1)
-        id = 0;
+          /* Next record */
+
+          ptr = ptr + sz;
+        }
     }
 
   /* Update memory size */
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : bufmean.c                                      */
 /*                                                                           */
 /* Created:       2010/11/10 (JLe)                                           */
-/* Last modified: 2014/02/25 (JLe)                                           */
-/* Version:       2.1.18                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Returns the mean of score buffer                             */
 /*                                                                           */
@@ -104,14 +104,27 @@ double BufMean(long ptr, ...)
 
   /***** Access data **********************************************************/
 
-  /* Get pointer to buffer */
+  /* Check sparse storage */
 
-  loc0 = (long)RDB[ptr + SCORE_PTR_BUF];
-  CheckPointer(FUNCTION_NAME, "(loc0)", BUF_ARRAY, loc0);
+  if ((long)RDB[ptr + SCORE_SPARSE] == YES)
+    {
+      /* Get pointer to data (zero if page is not scored) */
+
+      if ((loc0 = SparseStatPtr(ptr, idx, BUF_ARRAY, NO)) < 0)
+        return 0.0;
+    }
+  else
+    {
+      /* Get pointer to buffer */
+
+      loc0 = (long)RDB[ptr + SCORE_PTR_BUF];
+      CheckPointer(FUNCTION_NAME, "(loc0)", BUF_ARRAY, loc0);
 
-  /* Get pointer to data */
+      /* Get pointer to data */
+
+      loc0 = loc0 + idx*BUF_BLOCK_SIZE;
+    }
 
-  loc0 = loc0 + idx*BUF_BLOCK_SIZE;
   CheckPointer(FUNCTION_NAME, "(loc0)", BUF_ARRAY, loc0);
 
   /* Check that buffer is reduced */
@@ -0,0 +1,352 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : buildstlbvh.c                                  */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Builds bounding volume hierarchy for STL geometries          */
+/*                                                                           */
+/* Comments: - Items are given as bounding boxes (xmin, xmax, ymin, ymax,    */
+/*             zmin, zmax). Index vector is sorted so that each leaf owns a  */
+/*             continuous range of items.                                    */
+/*                                                                           */
+/*           - Split planes are selected using binned surface area           */
+/*             heuristic along the longest axis of centroid bounds.          */
+/*                                                                           */
+/*           - Nodes are first collected into a temporary array and then     */
+/*             copied to main data block.                                    */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "BuildSTLBVH:"
+
+/*****************************************************************************/
+
+long BuildSTLBVH(double *box, long *idx, long n, long *nn)
+{
+  long i, j, k, nd, ax, b, best, first, cnt, dep, ptr, tmp, sp;
+  long stk[2*STL_BVH_MAX_DEPTH + 4], dst[2*STL_BVH_MAX_DEPTH + 4];
+  long bc[STL_BVH_BINS], lc[STL_BVH_BINS];
+  double bb[6*STL_BVH_BINS], la[STL_BVH_BINS], lims[6], cmin[3], cmax[3];
+  double *nod, c, ext, cost, min, ra, dx, dy, dz;
+
+  /* Check number of items */
+
+  if (n < 1)
+    Die(FUNCTION_NAME, "No items");
+
+  /* Allocate memory for temporary node array (at most 2n - 1 nodes) */
+
+  nod = (double *)Mem(MEM_ALLOC, 2*n*STL_BVH_BLOCK_SIZE, sizeof(double));
+
+  /* Put root node */
+
+  nod[STL_BVH_CHILD] = -1.0;
+  nod[STL_BVH_FIRST] = 0.0;
+  nod[STL_BVH_N] = (double)n;
+
+  nd = 1;
+
+  /* Put root to stack */
+
+  stk[0] = 0;
+  dst[0] = 0;
+  sp = 1;
+
+  /* Loop until stack is empty */
+
+  while (sp > 0)
+    {
+      /* Pop node */
+
+      sp--;
+      ptr = stk[sp]*STL_BVH_BLOCK_SIZE;
+      dep = dst[sp];
+
+      first = (long)nod[ptr + STL_BVH_FIRST];
+      cnt = (long)nod[ptr + STL_BVH_N];
+
+      /* Calculate bounds of items and centroids */
+
+      for (k = 0; k < 3; k++)
+        {
+          lims[2*k] = INFTY;
+          lims[2*k + 1] = -INFTY;
+          cmin[k] = INFTY;
+          cmax[k] = -INFTY;
+        }
+
+      for (i = first; i < first + cnt; i++)
+        for (k = 0; k < 3; k++)
+          {
+            /* Bounding box */
+
+            if (box[6*idx[i] + 2*k] < lims[2*k])
+              lims[2*k] = box[6*idx[i] + 2*k];
+            if (box[6*idx[i] + 2*k + 1] > lims[2*k + 1])
+              lims[2*k + 1] = box[6*idx[i] + 2*k + 1];
+
+            /* Centroid */
+
+            c = 0.5*(box[6*idx[i] + 2*k] + box[6*idx[i] + 2*k + 1]);
+
+            if (c < cmin[k])
+              cmin[k] = c;
+            if (c > cmax[k])
+              cmax[k] = c;
+          }
+
+      /* Put bounds */
+
+      for (k = 0; k < 6; k++)
+        nod[ptr + STL_BVH_XMIN + k] = lims[k];
+
+      /* Find longest axis of centroid bounds */
+
+      ax = 0;
+      for (k = 1; k < 3; k++)
+        if (cmax[k] - cmin[k] > cmax[ax] - cmin[ax])
+          ax = k;
+
+      ext = cmax[ax] - cmin[ax];
+
+      /* Check leaf conditions */
+
+      if ((cnt <= STL_BVH_LEAF_SIZE) || (dep >= STL_BVH_MAX_DEPTH) ||
+          (ext <= 0.0))
+        continue;
+
+      /***********************************************************************/
+
+      /***** Binned SAH split ************************************************/
+
+      /* Reset bins */
+
+      for (b = 0; b < STL_BVH_BINS; b++)
+        {
+          bc[b] = 0;
+
+          for (k = 0; k < 3; k++)
+            {
+              bb[6*b + 2*k] = INFTY;
+              bb[6*b + 2*k + 1] = -INFTY;
+            }
+        }
+
+      /* Put items in bins */
+
+      for (i = first; i < first + cnt; i++)
+        {
+          /* Get bin index */
+
+          c = 0.5*(box[6*idx[i] + 2*ax] + box[6*idx[i] + 2*ax + 1]);
+          b = (long)((c - cmin[ax])/ext*STL_BVH_BINS);
+
+          if (b > STL_BVH_BINS - 1)
+            b = STL_BVH_BINS - 1;
+
+          /* Add to count and bounds */
+
+          bc[b]++;
+
+          for (k = 0; k < 6; k = k + 2)
+            {
+              if (box[6*idx[i] + k] < bb[6*b + k])
+                bb[6*b + k] = box[6*idx[i] + k];
+              if (box[6*idx[i] + k + 1] > bb[6*b + k + 1])
+                bb[6*b + k + 1] = box[6*idx[i] + k + 1];
+            }
+        }
+
+      /* Sweep from left (areas and counts on the left of split b) */
+
+      for (k = 0; k < 6; k = k + 2)
+        {
+          lims[k] = INFTY;
+          lims[k + 1] = -INFTY;
+        }
+
+      j = 0;
+
+      for (b = 1; b < STL_BVH_BINS; b++)
+        {
+          /* Add bin b - 1 */
+
+          j = j + bc[b - 1];
+
+          if (bc[b - 1] > 0)
+            for (k = 0; k < 6; k = k + 2)
+              {
+                if (bb[6*(b - 1) + k] < lims[k])
+                  lims[k] = bb[6*(b - 1) + k];
+                if (bb[6*(b - 1) + k + 1] > lims[k + 1])
+                  lims[k + 1] = bb[6*(b - 1) + k + 1];
+              }
+
+          /* Store count and half surface area */
+
+          lc[b] = j;
+
+          if (j > 0)
+            {
+              dx = lims[1] - lims[0];
+              dy = lims[3] - lims[2];
+              dz = lims[5] - lims[4];
+              la[b] = dx*dy + dy*dz + dz*dx;
+            }
+          else
+            la[b] = 0.0;
+        }
+
+      /* Sweep from right and find minimum cost */
+
+      for (k = 0; k < 6; k = k + 2)
+        {
+          lims[k] = INFTY;
+          lims[k + 1] = -INFTY;
+        }
+
+      min = INFTY;
+      best = -1;
+
+      for (b = STL_BVH_BINS - 1; b > 0; b--)
+        {
+          /* Add bin b */
+
+          if (bc[b] > 0)
+            for (k = 0; k < 6; k = k + 2)
+              {
+                if (bb[6*b + k] < lims[k])
+                  lims[k] = bb[6*b + k];
+                if (bb[6*b + k + 1] > lims[k + 1])
+                  lims[k + 1] = bb[6*b + k + 1];
+              }
+
+          /* Skip empty sides */
+
+          if ((lc[b] == 0) || (lc[b] == cnt))
+            continue;
+
+          /* Calculate cost */
+
+          dx = lims[1] - lims[0];
+          dy = lims[3] - lims[2];
+          dz = lims[5] - lims[4];
+          ra = dx*dy + dy*dz + dz*dx;
+
+          cost = (double)lc[b]*la[b] + (double)(cnt - lc[b])*ra;
+
+          /* Compare to minimum */
+
+          if (cost < min)
+            {
+              min = cost;
+              best = b;
+            }
+        }
+
+      /* Check (centroid extent is non-zero so both ends are occupied) */
+
+      if (best < 0)
+        Die(FUNCTION_NAME, "No split found");
+
+      /* Partition items */
+
+      i = first;
+      j = first + cnt - 1;
+
+      while (i <= j)
+        {
+          /* Get bin index */
+
+          c = 0.5*(box[6*idx[i] + 2*ax] + box[6*idx[i] + 2*ax + 1]);
+          b = (long)((c - cmin[ax])/ext*STL_BVH_BINS);
+
+          if (b > STL_BVH_BINS - 1)
+            b = STL_BVH_BINS - 1;
+
+          /* Swap to right side */
+
+          if (b < best)
+            i++;
+          else
+            {
+              tmp = idx[i];
+              idx[i] = idx[j];
+              idx[j] = tmp;
+              j--;
+            }
+        }
+
+      /* Check */
+
+      if (i - first != lc[best])
+        Die(FUNCTION_NAME, "Error in partition");
+
+      /***********************************************************************/
+
+      /***** Create children *************************************************/
+
+      /* Check size */
+
+      if (nd + 2 > 2*n)
+        Die(FUNCTION_NAME, "Node array overflow");
+
+      /* Put child index and reset leaf data */
+
+      nod[ptr + STL_BVH_CHILD] = (double)nd;
+      nod[ptr + STL_BVH_FIRST] = -1.0;
+      nod[ptr + STL_BVH_N] = 0.0;
+
+      /* Left child */
+
+      k = nd*STL_BVH_BLOCK_SIZE;
+      nod[k + STL_BVH_CHILD] = -1.0;
+      nod[k + STL_BVH_FIRST] = (double)first;
+      nod[k + STL_BVH_N] = (double)(i - first);
+
+      /* Right child */
+
+      k = k + STL_BVH_BLOCK_SIZE;
+      nod[k + STL_BVH_CHILD] = -1.0;
+      nod[k + STL_BVH_FIRST] = (double)i;
+      nod[k + STL_BVH_N] = (double)(first + cnt - i);
+
+      /* Put to stack */
+
+      stk[sp] = nd;
+      dst[sp++] = dep + 1;
+      stk[sp] = nd + 1;
+      dst[sp++] = dep + 1;
+
+      /* Update number of nodes */
+
+      nd = nd + 2;
+
+      /***********************************************************************/
+    }
+
+  /* Copy nodes to main data block */
+
+  ptr = ReallocMem(DATA_ARRAY, nd*STL_BVH_BLOCK_SIZE);
+  memcpy(&WDB[ptr], nod, nd*STL_BVH_BLOCK_SIZE*sizeof(double));
+
+  /* Free temporary array */
+
+  Mem(MEM_FREE, nod);
+
+  /* Put number of nodes */
+
+  *nn = nd;
+
+  /* Return pointer */
+
+  return ptr;
+}
+
+/*****************************************************************************/
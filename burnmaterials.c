@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : burnmaterials.c                                */
 /*                                                                           */
 /* Created:       2011/05/22 (JLe)                                           */
-/* Last modified: 2019/11/08 (ARi)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Performs burnup calculation for materials                    */
@@ -11,6 +11,10 @@
 /* Comments: - OpenMP parallelization revised 4.6.2012 (2.1.6)               */
 /*           - Added separate subroutine to be used with corrector iteration */
 /*             for convergence criterion calculation 4.11.2014 (2.1.22)      */
+/*           - Symbolic LU decomposition for CRAM is re-used for all         */
+/*             materials burned by the thread 17.10.2026 (2.1.32)            */
+/*           - Materials are processed in order of burnup matrix size,       */
+/*             largest first, for better OpenMP load balance                 */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -21,11 +25,11 @@
 
 /* Use local function to simplify OpenMP implementation */
 
-void BurnMaterials0(long, long, long, long, long);
+void BurnMaterials0(long, long, long, long, long, struct ccsMatrix **);
 
 void BurnMaterialsMSR(long, long, long, long, long);
 
-void BurnMaterialsCI(long, long, long, long, long);
+void BurnMaterialsCI(long, long, long, long, long, struct ccsMatrix **);
 
 void PrintDepMatrixMSR(long, struct ccsMatrix *, double, double *,
                        double *, long);
@@ -34,7 +38,9 @@ void PrintDepMatrixMSR(long, struct ccsMatrix *, double, double *,
 
 void BurnMaterials(long dep, long step)
 {
-  long mat, nss, type, mode;
+  long mat, nss, type, mode, nm, n;
+  double *lst;
+  struct ccsMatrix *LU;
 
   /***************************************************************************/
 
@@ -141,6 +147,12 @@ void BurnMaterials(long dep, long step)
 
   ReducePrivateRes();
 
+  /* Start depletion timers */
+
+  ResetTimer(TIMER_DEPLETION);
+  StartTimer(TIMER_DEPLETION);
+  StartTimer(TIMER_DEPLETION_TOTAL);
+
   /* If using corrector iteration, calculate initial extrapolations for      */
   /* nuclide field using non-averaged flux & xs                              */
 
@@ -179,43 +191,62 @@ void BurnMaterials(long dep, long step)
 
       PrintProgress(0, 0);
 
+      /* Get materials sorted by cost */
+
+      lst = BurnMatOrder(&nm);
+
       /* Start parallel timer */
 
       StartTimer(TIMER_OMP_PARA);
 
 #ifdef OPEN_MP
-#pragma omp parallel private (mat)
+#pragma omp parallel private (mat, LU, n)
 #endif
       {
+        /* Reset thread-wise symbolic LU decomposition */
+
+        LU = NULL;
+
         /* Loop over materials */
 
-        mat = (long)RDB[DATA_PTR_M0];
-        while (mat > VALID_PTR)
+#ifdef OPEN_MP
+#pragma omp for schedule(dynamic)
+#endif
+        for (n = 0; n < nm; n++)
           {
-            /* Check burn flag and test parallel id's */
+            /* Pointer to material */
 
-            if ((long)RDB[mat + MATERIAL_OPTIONS] & OPT_BURN_MAT)
-              if (MyParallelMat(mat, YES) == YES)
-                {
-                  /* Burn */
+            mat = (long)lst[n];
+            CheckPointer(FUNCTION_NAME, "(mat)", DATA_ARRAY, mat);
 
-                  BurnMaterialsCI(mat, step, nss, type, mode);
+            /* Test parallel id's */
 
-                  /* Print */
+            if (MyParallelMat(mat, YES) == YES)
+              {
+                /* Burn */
 
-                  PrintProgress(mat, 2);
-                }
+                BurnMaterialsCI(mat, step, nss, type, mode, &LU);
 
-            /* Next material */
+                /* Print */
 
-            mat = NextItem(mat);
+                PrintProgress(mat, 2);
+              }
           }
+
+        /* Free symbolic LU decomposition */
+
+        if (LU != NULL)
+          ccsMatrixFree(LU);
       }
 
       /* Stop parallel timer */
 
       StopTimer(TIMER_OMP_PARA);
 
+      /* Free array */
+
+      Mem(MEM_FREE, lst);
+
       /* Print */
 
       PrintProgress(0, 100);
@@ -252,24 +283,38 @@ void BurnMaterials(long dep, long step)
 
   PrintProgress(0, 0);
 
+  /* Get materials sorted by cost */
+
+  lst = BurnMatOrder(&nm);
+
   /* Start parallel timer */
 
   StartTimer(TIMER_OMP_PARA);
 
 #ifdef OPEN_MP
-#pragma omp parallel private (mat)
+#pragma omp parallel private (mat, LU, n)
 #endif
   {
-    /* Loop over materials */
+    /* Reset thread-wise symbolic LU decomposition */
+
+    LU = NULL;
 
-    mat = (long)RDB[DATA_PTR_M0];
-    while (mat > VALID_PTR)
+    /* Loop over materials (most expensive first) */
+
+#ifdef OPEN_MP
+#pragma omp for schedule(dynamic)
+#endif
+    for (n = 0; n < nm; n++)
       {
-        /* Check burn flag and inflow, and test parallel id's */
+        /* Pointer to material */
+
+        mat = (long)lst[n];
+        CheckPointer(FUNCTION_NAME, "(mat)", DATA_ARRAY, mat);
+
+        /* Check inflow, and test parallel id's */
         /* NOTE: No inflo in conventional burnup calculation. */
 
-        if (((long)RDB[mat + MATERIAL_OPTIONS] & OPT_BURN_MAT) &&
-            ((long)RDB[mat + MATERIAL_PTR_INFLOW] < VALID_PTR))
+        if ((long)RDB[mat + MATERIAL_PTR_INFLOW] < VALID_PTR)
           if (MyParallelMat(mat, YES) == YES)
             {
               /* Check flow index and burn */
@@ -278,7 +323,7 @@ void BurnMaterials(long dep, long step)
                 {
                   /* Not involved in continuous reprocessing */
 
-                  BurnMaterials0(mat, step, nss, type, mode);
+                  BurnMaterials0(mat, step, nss, type, mode, &LU);
 
                   /* Print */
 
@@ -295,21 +340,34 @@ void BurnMaterials(long dep, long step)
                   PrintProgress(mat, 2);
                 }
             }
+      }
 
-        /* Next material */
+    /* Free symbolic LU decomposition */
 
-        mat = NextItem(mat);
-      }
+    if (LU != NULL)
+      ccsMatrixFree(LU);
   }
 
   /* Stop parallel timer */
 
   StopTimer(TIMER_OMP_PARA);
 
+  /* Free array */
+
+  Mem(MEM_FREE, lst);
+
+  /* Stop depletion timers */
+
+  StopTimer(TIMER_DEPLETION);
+  StopTimer(TIMER_DEPLETION_TOTAL);
+
   /* Print */
 
   PrintProgress(0, 100);
 
+  fprintf(outp, "Depletion wall-clock time: %1.2f seconds\n\n",
+          TimerVal(TIMER_DEPLETION));
+
   /***************************************************************************/
 }
 
@@ -317,7 +375,8 @@ void BurnMaterials(long dep, long step)
 
 /*****************************************************************************/
 
-void BurnMaterials0(long mat, long step, long nss, long type, long mode)
+void BurnMaterials0(long mat, long step, long nss, long type, long mode,
+                    struct ccsMatrix **LU)
 {
   long iso, ptr, lst, i, sz, ss, id;
   double t, t1, t2, tot, *N, *N0;
@@ -455,6 +514,10 @@ void BurnMaterials0(long mat, long step, long nss, long type, long mode)
 
       A = MakeBurnMatrix(mat, id);
 
+      /* Store number of non-zeros for scheduling */
+
+      WDB[mat + MATERIAL_BURN_MATRIX_NNZ] = (double)A->nnz;
+
       /* Check size (sz == i tarkistettiin jo aikaisemmin) */
 
       if (sz != A->n)
@@ -492,7 +555,7 @@ void BurnMaterials0(long mat, long step, long nss, long type, long mode)
       if (mode == BUMODE_TTA)
         N = TTA(A, N0, t2 - t1);
       else if (mode == BUMODE_CRAM)
-        N = MatrixExponential(A, N0, t2 - t1);
+        N = MatrixExponential(A, N0, t2 - t1, LU);
       else
         Die(FUNCTION_NAME, "Invalid burnup mode");
 
@@ -576,7 +639,8 @@ void BurnMaterials0(long mat, long step, long nss, long type, long mode)
 
 /*****************************************************************************/
 
-void BurnMaterialsCI(long mat, long step, long nss, long type, long mode)
+void BurnMaterialsCI(long mat, long step, long nss, long type, long mode,
+                     struct ccsMatrix **LU)
 {
   long iso, ptr, lst, i, sz, ss, id;
   double t, t1, t2, *N, *N0, n;
@@ -681,6 +745,10 @@ void BurnMaterialsCI(long mat, long step, long nss, long type, long mode)
 
       A = MakeBurnMatrix(mat, id);
 
+      /* Store number of non-zeros for scheduling */
+
+      WDB[mat + MATERIAL_BURN_MATRIX_NNZ] = (double)A->nnz;
+
       /* Check size (sz == i tarkistettiin jo aikaisemmin) */
 
       if (sz != A->n)
@@ -710,7 +778,7 @@ void BurnMaterialsCI(long mat, long step, long nss, long type, long mode)
       if (mode == BUMODE_TTA)
         N = TTA(A, N0, t2 - t1);
       else if (mode == BUMODE_CRAM)
-        N = MatrixExponential(A, N0, t2 - t1);
+        N = MatrixExponential(A, N0, t2 - t1, LU);
       else
         Die(FUNCTION_NAME, "Invalid burnup mode");
 
@@ -943,6 +1011,10 @@ void BurnMaterialsMSR(long mat, long dep, long step, long type, long mode)
 
   A = MakeBurnMatrixMSR(mat, dep, R, id);
 
+  /* Store number of non-zeros for scheduling */
+
+  WDB[mat + MATERIAL_BURN_MATRIX_NNZ] = (double)A->nnz;
+
   /* Check size */
 
   if (sz + 1 != A->n)
@@ -972,7 +1044,7 @@ void BurnMaterialsMSR(long mat, long dep, long step, long type, long mode)
   if (mode == BUMODE_TTA)
     N = TTA(A, N0, t2 - t1);
   else if (mode == BUMODE_CRAM)
-    N = MatrixExponential(A, N0, t2 - t1);
+    N = MatrixExponential(A, N0, t2 - t1, NULL);
   else
     Die(FUNCTION_NAME, "Invalid burnup mode");
 
@@ -0,0 +1,174 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : burnmatorder.c                                 */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Returns array of burnable materials sorted by estimated cost */
+/*              of depletion solution in descending order                    */
+/*                                                                           */
+/* Comments: - Used for scheduling the OpenMP parallel loop in               */
+/*             BurnMaterials(). Processing the most expensive materials      */
+/*             first gives better load balance when material sizes differ.   */
+/*                                                                           */
+/*           - Cost is the number of non-zeros in the burnup matrix from     */
+/*             previous step, or the number of nuclides if the matrix has    */
+/*             not been formed yet.                                          */
+/*                                                                           */
+/*           - Heap sort is used because the number of materials may be      */
+/*             large.                                                        */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "BurnMatOrder:"
+
+/*****************************************************************************/
+
+double *BurnMatOrder(long *sz)
+{
+  long mat, n, nm, i, j, k;
+  double *lst, *cost, tmp;
+
+  /* Count burnable materials */
+
+  nm = 0;
+
+  mat = (long)RDB[DATA_PTR_M0];
+  while (mat > VALID_PTR)
+    {
+      /* Check burn flag */
+
+      if ((long)RDB[mat + MATERIAL_OPTIONS] & OPT_BURN_MAT)
+        nm++;
+
+      /* Next material */
+
+      mat = NextItem(mat);
+    }
+
+  /* Allocate memory for pointers and costs */
+
+  lst = (double *)Mem(MEM_ALLOC, nm + 1, sizeof(double));
+  cost = (double *)Mem(MEM_ALLOC, nm + 1, sizeof(double));
+
+  /* Read pointers and estimate costs */
+
+  n = 0;
+
+  mat = (long)RDB[DATA_PTR_M0];
+  while (mat > VALID_PTR)
+    {
+      /* Check burn flag */
+
+      if ((long)RDB[mat + MATERIAL_OPTIONS] & OPT_BURN_MAT)
+        {
+          /* Put pointer */
+
+          lst[n] = (double)mat;
+
+          /* Put cost */
+
+          if (RDB[mat + MATERIAL_BURN_MATRIX_NNZ] > 0.0)
+            cost[n] = RDB[mat + MATERIAL_BURN_MATRIX_NNZ];
+          else
+            cost[n] = (double)ListSize((long)RDB[mat + MATERIAL_PTR_COMP]);
+
+          /* Update index */
+
+          n++;
+        }
+
+      /* Next material */
+
+      mat = NextItem(mat);
+    }
+
+  /* Check count */
+
+  if (n != nm)
+    Die(FUNCTION_NAME, "Mismatch in number of materials");
+
+  /***************************************************************************/
+
+  /***** Heap sort (smallest cost at the root) *******************************/
+
+  /* Build heap */
+
+  for (i = nm/2 - 1; i > -1; i--)
+    {
+      /* Sift down */
+
+      j = i;
+      while ((k = 2*j + 1) < nm)
+        {
+          if ((k + 1 < nm) && (cost[k + 1] < cost[k]))
+            k++;
+
+          if (cost[j] <= cost[k])
+            break;
+
+          tmp = cost[j]; cost[j] = cost[k]; cost[k] = tmp;
+          tmp = lst[j]; lst[j] = lst[k]; lst[k] = tmp;
+
+          j = k;
+        }
+    }
+
+  /* Move root to end of array (gives descending order) */
+
+  for (n = nm - 1; n > 0; n--)
+    {
+      /* Swap */
+
+      tmp = cost[0]; cost[0] = cost[n]; cost[n] = tmp;
+      tmp = lst[0]; lst[0] = lst[n]; lst[n] = tmp;
+
+      /* Sift down */
+
+      j = 0;
+      while ((k = 2*j + 1) < n)
+        {
+          if ((k + 1 < n) && (cost[k + 1] < cost[k]))
+            k++;
+
+          if (cost[j] <= cost[k])
+            break;
+
+          tmp = cost[j]; cost[j] = cost[k]; cost[k] = tmp;
+          tmp = lst[j]; lst[j] = lst[k]; lst[k] = tmp;
+
+          j = k;
+        }
+    }
+
+  /***************************************************************************/
+
+#ifdef DEBUG
+
+  /* Check order */
+
+  for (n = 1; n < nm; n++)
+    if (cost[n - 1] < cost[n])
+      Die(FUNCTION_NAME, "Sorting failed");
+
+#endif
+
+  /* Free cost array */
+
+  Mem(MEM_FREE, cost);
+
+  /* Put size */
+
+  *sz = nm;
+
+  /* Return array */
+
+  return lst;
+}
+
+/*****************************************************************************/
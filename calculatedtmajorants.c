@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : calculatedtmajorants.c                         */
 /*                                                                           */
 /* Created:       2011/11/03 (JLe)                                           */
-/* Last modified: 2018/11/02 (RTu)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Calculates neutron and photon majorants for delta-tracking   */
 /*                                                                           */
@@ -25,14 +25,15 @@
 
 /* Use local function to simplify OpenMP implementation */
 
-void CalculateDTMajorants0(long, double *, long);
+void CalculateDTMajorants0(long, double *, double *, long);
 
 /*****************************************************************************/
 
 void CalculateDTMajorants()
 {
   long erg, ne, loc0, loc1, loc2, loc3, mat, rea, ptr, n, i, i0, sz, nt, rls, nuc;
-  double *tot, *xs, **maj, adens, Emin, Emax;
+  long nr;
+  double *tot, *xs, **maj, **reg, adens, Emin, Emax;
 
   /* Check DT flag */
 
@@ -194,6 +195,42 @@ void CalculateDTMajorants()
           maj[i] = (double *)Mem(MEM_ALLOC, ne, sizeof(double));
         }
 
+      /* Check regional majorants */
+
+      if ((long)RDB[DATA_DT_REG_PTR_MESH] > VALID_PTR)
+        {
+          /* Number of regional values */
+
+          ptr = (long)RDB[DATA_DT_REG_PTR_MESH];
+          nr = (long)(RDB[ptr + MESH_N0]*RDB[ptr + MESH_N1]*RDB[ptr + MESH_N2]
+                      *RDB[DATA_DT_REG_NG]);
+
+          /* Allocate memory for temporary data */
+
+          reg = (double **)Mem(MEM_ALLOC, nt, sizeof(double *));
+
+          for(i = 0; i < nt; i++)
+            reg[i] = (double *)Mem(MEM_ALLOC, nr, sizeof(double));
+
+          /* Pointer to energy array */
+
+          loc0 = (long)RDB[erg + ENERGY_GRID_PTR_DATA];
+          CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+          /* Put group structure (uniform lethargy) */
+
+          WDB[DATA_DT_REG_LOG_EMIN] = log(RDB[loc0]);
+          WDB[DATA_DT_REG_LOG_DE] = log(RDB[loc0 + ne - 1]/RDB[loc0])/
+            RDB[DATA_DT_REG_NG];
+        }
+      else
+        {
+          /* No regional majorants */
+
+          nr = 0;
+          reg = NULL;
+        }
+
       /* Start parallel timer */
 
       StartTimer(TIMER_OMP_PARA);
@@ -241,7 +278,11 @@ void CalculateDTMajorants()
               {
                 /* Process */
 
-                CalculateDTMajorants0(mat, maj[OMP_THREAD_NUM], erg);
+                if (reg != NULL)
+                  CalculateDTMajorants0(mat, maj[OMP_THREAD_NUM],
+                                        reg[OMP_THREAD_NUM], erg);
+                else
+                  CalculateDTMajorants0(mat, maj[OMP_THREAD_NUM], NULL, erg);
 
                 /* Print */
 
@@ -274,6 +315,19 @@ void CalculateDTMajorants()
             if (maj[i][n] > maj[0][n])
               maj[0][n] = maj[i][n];
         }
+
+      /* Regional majorants */
+
+#ifdef OPEN_MP
+#pragma omp for
+#endif
+
+      for (n = 0; n < nr; n++)
+        {
+          for (i = 1; i < nt; i++)
+            if (reg[i][n] > reg[0][n])
+              reg[0][n] = reg[i][n];
+        }
       }
 
       /* Stop parallel timer */
@@ -307,6 +361,27 @@ void CalculateDTMajorants()
       /*
       WDB[DATA_MIN_NMACROXS] = 1E-2;
       */
+      /* Put regional majorants */
+
+      if (reg != NULL)
+        {
+          /* Get pointer to data */
+
+          ptr = (long)RDB[DATA_DT_REG_PTR_MAJ];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+          /* Put data */
+
+          memcpy(&WDB[ptr], reg[0], nr*sizeof(double));
+
+          /* Free allocated memory */
+
+          for(i = 0; i < nt; i++)
+            Mem(MEM_FREE, reg[i]);
+
+          Mem(MEM_FREE, reg);
+        }
+
       /* Free allocated memory */
 
       for(i = 0; i < nt; i++)
@@ -528,10 +603,11 @@ void CalculateDTMajorants()
 
 /*****************************************************************************/
 
-void CalculateDTMajorants0(long mat, double *maj, long erg)
+void CalculateDTMajorants0(long mat, double *maj, double *reg, long erg)
 {
   long rea, ne, ptr, loc0, loc1, loc2, i0, sz, n, n0, id, rls, nuc, idx, m, arr;
-  double *tot, *xs, adens, Emin, Emax;
+  long ng, g0, g1, g, lst, r;
+  double *tot, *xs, adens, Emin, Emax, val;
 
   /* Check material pointer */
 
@@ -595,14 +671,9 @@ void CalculateDTMajorants0(long mat, double *maj, long erg)
 
       /***** Same energy grid, copy total ************************************/
 
-      /* Pointer to cross section array */
-
-      ptr = (long)RDB[rea + REACTION_PTR_XS];
-      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-
-      /* Copy data */
+      /* Copy data (may be stored in single precision) */
 
-      memcpy(tot, &RDB[ptr], ne*sizeof(double));
+      UnpackXS(rea, tot, ne);
 
       /***********************************************************************/
     }
@@ -887,6 +958,67 @@ void CalculateDTMajorants0(long mat, double *maj, long erg)
   for (n = 0; n < ne; n++)
     if (tot[n] > maj[n])
       maj[n] = tot[n];
+
+  /***************************************************************************/
+
+  /***** Regional majorants **************************************************/
+
+  /* Check array and get pointer to region list (divided materials */
+  /* use the list of parent) */
+
+  if (reg == NULL)
+    return;
+  else if ((ptr = (long)RDB[mat + MATERIAL_DIV_PTR_PARENT]) < VALID_PTR)
+    ptr = mat;
+
+  if ((lst = (long)RDB[ptr + MATERIAL_PTR_DT_REG_LIST]) < VALID_PTR)
+    return;
+
+  /* Number of groups */
+
+  ng = (long)RDB[DATA_DT_REG_NG];
+
+  /* Group of first point */
+
+  g0 = 0;
+
+  /* Loop over energy intervals (maximum of end points is included in */
+  /* all groups overlapping the interval, which covers both linear    */
+  /* and histogram interpolation) */
+
+  for (n = 0; n < ne - 1; n++)
+    {
+      /* Group of interval end point */
+
+      g1 = (long)((log(RDB[loc0 + n + 1]) - RDB[DATA_DT_REG_LOG_EMIN])/
+                  RDB[DATA_DT_REG_LOG_DE]);
+
+      if (g1 < 0)
+        g1 = 0;
+      else if (g1 > ng - 1)
+        g1 = ng - 1;
+
+      /* Get maximum */
+
+      if (tot[n] > tot[n + 1])
+        val = tot[n];
+      else
+        val = tot[n + 1];
+
+      /* Loop over regions and groups */
+
+      ptr = lst;
+      while ((r = (long)RDB[ptr++]) > -1)
+        for (g = g0; g < g1 + 1; g++)
+          if (val > reg[r*ng + g])
+            reg[r*ng + g] = val;
+
+      /* Update first group */
+
+      g0 = g1;
+    }
+
+  /***************************************************************************/
 }
 
 /*****************************************************************************/
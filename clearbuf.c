@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : clearbuf.c                                     */
 /*                                                                           */
 /* Created:       2010/11/10 (JLe)                                           */
-/* Last modified: 2018/09/13 (VVa)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Clears scoring buffer(s) in all bins                         */
 /*                                                                           */
@@ -33,6 +33,12 @@ void ClearBuf()
   sz = (long)RDB[DATA_REAL_BUF_SIZE];
   max = (long)RDB[DATA_ALLOC_BUF_SIZE];
 
+  /* Discard data in thread-wise tables of hybrid buffer */
+
+  if ((long)RDB[DATA_OPTI_HYBRID_BUF] == YES)
+    for (i = 0; i < (long)RDB[DATA_OMP_MAX_THREADS]; i++)
+      FlushHybridBuf(i);
+
   /* Number of segments */
 
   if ((long)RDB[DATA_OPTI_SHARED_BUF] == YES)
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : clearstat.c                                    */
 /*                                                                           */
 /* Created:       2010/11/10 (JLe)                                           */
-/* Last modified: 2013/01/07 (JLe)                                           */
-/* Version:       2.1.12                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Clears statistics in all bins                                */
 /*                                                                           */
@@ -21,7 +21,7 @@
 
 void ClearStat(long ptr)
 {
-  long nmax, n, stp;
+  long nmax, n, stp, tab;
 
   /* Check mode */
 
@@ -78,6 +78,35 @@ void ClearStat(long ptr)
 
       CheckPointer(FUNCTION_NAME, "", DATA_ARRAY, ptr);
       
+      /* Check sparse storage */
+
+      if ((long)RDB[ptr + SCORE_SPARSE] == YES)
+        {
+          /* Clear assigned pages */
+
+          nmax = (long)RDB[ptr + SCORE_RES_PAGES]*SPARSE_STAT_PAGE_SZ;
+
+          if (nmax > 0)
+            memset(&RES1[(long)RDB[ptr + SCORE_PTR_DATA]], 0.0,
+                   nmax*STAT_BLOCK_SIZE*sizeof(double));
+
+          /* Reset page table */
+
+          tab = (long)RDB[ptr + SCORE_PTR_RES_PAGE_TAB];
+
+          for (n = 0; n < (long)RDB[ptr + SCORE_N_PAGES]; n++)
+            WDB[tab + n] = -1.0;
+
+          /* Reset number of pages and scores */
+
+          WDB[ptr + SCORE_RES_PAGES] = 0.0;
+          WDB[ptr + SCORE_SPARSE_N] = 0.0;
+
+          /* Exit */
+
+          return;
+        }
+
       /* Get size */
 
       nmax = (long)RDB[ptr + SCORE_STAT_SIZE];
@@ -3,12 +3,13 @@
 /* serpent 2 (beta-version) : coldet.c                                       */
 /*                                                                           */
 /* Created:       2011/03/03 (JLe)                                           */
-/* Last modified: 2019/04/03 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Scores collision flux detectors                              */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - Only detectors in the candidate lists of the particle type,   */
+/*             material and cells of the collision point are looped.         */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -23,16 +24,22 @@ void ColDet(long part, long mat0, double flx0, double x0, double y0,
             double z0, double u0, double v0, double w0, double E0, double t0,
             double wgt0, double g0, long id)
 {
-  long det, loc0, idx, rbin, ptr, ptr1, type, mt, loc1;
+  long det, loc0, idx, rbin, ptr, ptr1, type, mt, loc1, n;
+  long lst[MAX_DET_CAND_LISTS];
   double f0, val0, u, v, w, f;
 
   /* Get particle type */
 
   type = (long)RDB[part + PARTICLE_TYPE];
 
-  /* Loop over detectors */
+  /* Get lists of detectors that can score in this point (reverse */
+  /* index is created in CompileDetIndex()) */
 
-  det = (long)RDB[DATA_PTR_DET0];
+  n = DetCandidates(type, mat0, lst, id);
+
+  /* Loop over candidate detectors */
+
+  det = NextDetCandidate(lst, n);
   while (det > VALID_PTR)
     {
       /*********************************************/
@@ -47,7 +54,7 @@ void ColDet(long part, long mat0, double flx0, double x0, double y0,
         {
           /* Next detector */
 
-          det = NextItem(det);
+          det = NextDetCandidate(lst, n);
 
           /* Cycle loop */
 
@@ -65,7 +72,7 @@ void ColDet(long part, long mat0, double flx0, double x0, double y0,
         {
           /* Next detector */
 
-          det = NextItem(det);
+          det = NextDetCandidate(lst, n);
 
           /* Cycle loop */
 
@@ -92,7 +99,7 @@ void ColDet(long part, long mat0, double flx0, double x0, double y0,
             {
               /* Next detector */
 
-              det = NextItem(det);
+              det = NextDetCandidate(lst, n);
 
               /* Cycle loop */
 
@@ -272,7 +279,7 @@ void ColDet(long part, long mat0, double flx0, double x0, double y0,
 
       /* Next detector */
 
-      det = NextItem(det);
+      det = NextDetCandidate(lst, n);
     }
 }
 
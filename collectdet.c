@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : collectdet.c                                   */
 /*                                                                           */
 /* Created:       2011/03/03 (JLe)                                           */
-/* Last modified: 2019/04/03 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Collects detector results                                    */
 /*                                                                           */
@@ -134,6 +134,8 @@ void CollectDet()
 
       if ((ptr = (long)RDB[det0 + DET_FET_PTR_PARAMS]) > VALID_PTR)
         CollectFET(&RDB[ptr], stp, 0);
+      else if ((long)RDB[stp + SCORE_SPARSE] == YES)
+        CollectSparseDet(det0, stp, norm);
       else
         {
           /* Loop over bins */
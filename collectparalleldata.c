@@ -3,12 +3,13 @@
 /* serpent 2 (beta-version) : collectparalleldata.c                          */
 /*                                                                           */
 /* Created:       2010/11/23 (JLe)                                           */
-/* Last modified: 2019/04/03 (VVa)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Collects results from parallel MPI tasks                     */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - Data is summed in place with MPIReduceSegments(), which skips */
+/*             segments that are zero in all tasks (2.1.32)                  */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -24,7 +25,6 @@ void CollectParallelData()
 
 #ifdef MPI
 
-  double *buff;
   long sz;
 
   /* Check if access to private arrays is allowed */
@@ -57,41 +57,9 @@ void CollectParallelData()
 
       sz = (long)RDB[DATA_ALLOC_RES1_SIZE];
 
-      /* Allocate memory for results */
+      /* Sum data over tasks (results are needed in all tasks) */
 
-      if (mpiid == 0)
-        buff = (double *)Mem(MEM_ALLOC, sz, sizeof(double));
-      else
-        buff = NULL;
-
-      /* Synchronise */
-
-      MPI_Barrier(my_comm);
-
-      /* Reduce data */
-
-      MPITransfer(RES1, buff, sz, 0, MPI_METH_RED);
-
-      /* Move data to original block */
-
-      if (mpiid == 0)
-        {
-          /* Copy data */
-
-          memcpy(RES1, buff, sz*sizeof(double));
-
-          /* Free buffer */
-
-          Mem(MEM_FREE, buff);
-        }
-
-      /* Synchronise */
-
-      MPI_Barrier(my_comm);
-
-      /* Broadcast data to other tasks */
-
-      MPITransfer(RES1, NULL, sz, 0, MPI_METH_BC);
+      MPIReduceSegments(RES1, sz, MPI_METH_ALL_RED);
     }
 
   /***************************************************************************/
@@ -106,41 +74,9 @@ void CollectParallelData()
 
   sz = (long)RDB[DATA_ALLOC_RES2_SIZE];
 
-  /* Allocate memory for results */
-
-  if (mpiid == 0)
-    buff = (double *)Mem(MEM_ALLOC, sz, sizeof(double));
-  else
-    buff = NULL;
-
-  /* Synchronise */
-
-  MPI_Barrier(my_comm);
-
-  /* Reduce data */
-
-  MPITransfer(RES2, buff, sz, 0, MPI_METH_RED);
-
-  /* Move data to original block */
-
-  if (mpiid == 0)
-    {
-      /* Copy data */
-
-      memcpy(RES2, buff, sz*sizeof(double));
-
-      /* Free buffer */
-
-      Mem(MEM_FREE, buff);
-    }
-
-  /* Synchronise */
-
-  MPI_Barrier(my_comm);
-
-  /* Broadcast data to other tasks */
+  /* Sum data over tasks */
 
-  MPITransfer(RES2, NULL, sz, 0, MPI_METH_BC);
+  MPIReduceSegments(RES2, sz, MPI_METH_ALL_RED);
 
   /* Synchronise */
 
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : collectresults.c                               */
 /*                                                                           */
 /* Created:       2011/03/10 (JLe)                                           */
-/* Last modified: 2019/08/24 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Collects results after cycle or batch                        */
@@ -228,6 +228,17 @@ void CollectResults()
       AddStat(val, ptr, n);
     }
 
+  /* Hit rate of neighbour cell cache in surface-tracking */
+
+  ptr = (long)RDB[RES_ST_NBR_EFF];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  if ((div = BufVal(ptr, 1)) > 0)
+    {
+      val = BufVal(ptr, 0);
+      AddStat(val/div, ptr, 0);
+    }
+
   /* TMS sampling efficiency */
 
   ptr = (long)RDB[RES_TMS_SAMPLING_EFF];
@@ -256,6 +267,64 @@ void CollectResults()
       AddStat(val/div, ptr, 3);
     }
 
+  /* Regional delta-tracking statistics */
+
+  if ((ptr = (long)RDB[DATA_DT_REG_PTR_MESH]) > VALID_PTR)
+    {
+      /* Number of regions */
+
+      m = (long)(RDB[ptr + MESH_N0]*RDB[ptr + MESH_N1]*RDB[ptr + MESH_N2]);
+
+      /* Pointer to statistics */
+
+      ptr = (long)RDB[RES_DT_REG_STAT];
+      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+      /* Get total number of collisions */
+
+      sum = 0.0;
+
+      for (n = 0; n < m; n++)
+        sum = sum + BufVal(ptr, n, 0) + BufVal(ptr, n, 1);
+
+      /* Pointer to majorant failure flags */
+
+      loc0 = (long)RDB[DATA_DT_REG_PTR_FAIL];
+      CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+      /* Loop over regions */
+
+      for (n = 0; n < m; n++)
+        {
+          /* Use global majorant in regions where failures were scored */
+          /* (set here instead of MoveDT() to keep results independent */
+          /* of thread timing) */
+
+          if (BufVal(ptr, n, 2) > 0.0)
+            WDB[loc0 + n] = (double)YES;
+
+          /* Ratio of virtual to real collisions */
+
+          if ((div = BufVal(ptr, n, 1)) > 0.0)
+            {
+              val = BufVal(ptr, n, 0);
+              AddStat(val/div, ptr, n, 0);
+            }
+
+          /* Fraction of all collisions */
+
+          if ((div = BufVal(ptr, n, 0) + BufVal(ptr, n, 1)) > 0.0)
+            {
+              AddStat(div/sum, ptr, n, 1);
+
+              /* Majorant failure fraction */
+
+              val = BufVal(ptr, n, 2);
+              AddStat(val/div, ptr, n, 2);
+            }
+        }
+    }
+
   /* STL ray test failures */
 
   if ((long)RDB[DATA_PTR_STL0] > VALID_PTR)
@@ -0,0 +1,189 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : collectsparsedet.c                             */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Collects detector results from sparse scoring buffer         */
+/*                                                                           */
+/* Comments: - Called from CollectDet() for detectors stored with            */
+/*             NewSparseStat(). Only the buffer pages scored in the current  */
+/*             batch are looped over.                                        */
+/*                                                                           */
+/*           - Bins not scored in the batch get zero value, which only       */
+/*             increases the number of scores. The number is common to all   */
+/*             bins and counted in SCORE_SPARSE_N, for which reason sparse   */
+/*             storage is not used with detector types and options in which  */
+/*             bins may be skipped (see processdetectors.c).                 */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "CollectSparseDet:"
+
+/*****************************************************************************/
+
+void CollectSparseDet(long det, long stp, double norm)
+{
+  long type, erg, tab, np, ns, n, pg, idx, i1, tot, ne, idx0, idx2, rb0, rb2;
+  long eb0, ptr;
+  double val, div, mul;
+
+  /* Check pointers */
+
+  CheckPointer(FUNCTION_NAME, "(det)", DATA_ARRAY, det);
+  CheckPointer(FUNCTION_NAME, "(stp)", DATA_ARRAY, stp);
+
+  /* Avoid compiler warning */
+
+  idx2 = -1;
+  rb2 = -1;
+
+  /* Update number of scores */
+
+  WDB[stp + SCORE_SPARSE_N] = RDB[stp + SCORE_SPARSE_N] + 1.0;
+
+  /* Get detector type, number of bins and number of energy bins */
+
+  type = (long)RDB[det + DET_TYPE];
+  tot = (long)RDB[det + DET_N_TOT_BINS];
+  ne = (long)RDB[det + DET_N_EBINS];
+
+  /* Pointer to energy distribution */
+
+  if ((erg = (long)RDB[det + DET_PTR_EGRID]) > VALID_PTR)
+    {
+      /* Get pointer to data */
+
+      erg = (long)RDB[erg + ENERGY_GRID_PTR_DATA];
+      CheckPointer(FUNCTION_NAME, "(erg)", DATA_ARRAY, erg);
+    }
+
+  /* Pointer to buffer page table, number of pages and used slots */
+
+  tab = (long)RDB[stp + SCORE_PTR_PAGE_TAB];
+  CheckPointer(FUNCTION_NAME, "(tab)", BUF_ARRAY, tab);
+
+  np = (long)RDB[stp + SCORE_N_PAGES];
+  ns = (long)BUF[tab + np];
+
+  /* Loop over used slots */
+
+  for (n = 1; n < ns + 1; n++)
+    {
+      /* Get page */
+
+      pg = (long)BUF[tab + np + n];
+      CheckValue(FUNCTION_NAME, "pg", "", pg, 0, np - 1);
+
+      /* Get index range */
+
+      idx = pg*SPARSE_STAT_PAGE_SZ;
+
+      if ((i1 = idx + SPARSE_STAT_PAGE_SZ) > (long)RDB[stp + SCORE_STAT_SIZE])
+        i1 = (long)RDB[stp + SCORE_STAT_SIZE];
+
+      /* Loop over bins */
+
+      for (; idx < i1; idx++)
+        {
+          /* Get bin and response index */
+
+          idx0 = idx%tot;
+          rb0 = idx/tot;
+
+          /* Get buffer value */
+
+          if (type == DETECTOR_TYPE_SUM_SCORES)
+            val = BufN(stp, idx0, rb0);
+          else
+            val = BufVal(stp, idx0, rb0);
+
+          /* Check zero */
+
+          if (val == 0.0)
+            continue;
+
+          /* Normalize */
+
+          val = val*norm;
+
+          /* Divide by volume */
+
+          div = RDB[det + DET_VOL];
+
+          /* Energy and lethargy divider */
+
+          if ((type == DETECTOR_TYPE_UNI_E) || (type == DETECTOR_TYPE_UNI_L))
+            {
+              /* Check pointer */
+
+              CheckPointer(FUNCTION_NAME, "(erg)", DATA_ARRAY, erg);
+
+              /* Energy bin index */
+
+              eb0 = idx0%ne;
+
+              /* Divide by energy or lethargy interval */
+
+              if (type == DETECTOR_TYPE_UNI_E)
+                div = div*(RDB[erg + eb0 + 1] - RDB[erg + eb0]);
+              else
+                div = div*(log(RDB[erg + eb0 + 1]) - log(RDB[erg + eb0]));
+            }
+
+          /* Reset multiplier */
+
+          mul = 1.0;
+
+          /* Detector multiplier */
+
+          if (type == DETECTOR_TYPE_MULTI)
+            {
+              /* Pointer to second detector */
+
+              ptr = (long)RDB[det + DET_PTR_MUL];
+              CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+              /* Check number of values */
+
+              if ((long)RDB[ptr + DET_N_TOT_BINS] == 1)
+                {
+                  /* Single-valued multiplier */
+
+                  idx2 = 0;
+                  rb2 = 0;
+                }
+              else if ((long)RDB[ptr + DET_N_TOT_BINS] == tot)
+                {
+                  /* Equal number of bins */
+
+                  idx2 = idx0;
+                  rb2 = rb0;
+                }
+              else
+                Die(FUNCTION_NAME, "Mismatch in number of bins");
+
+              /* Pointer to statistics */
+
+              ptr = (long)RDB[ptr + DET_PTR_STAT];
+              CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+              /* Get multiplier */
+
+              mul = norm*BufVal(ptr, idx2, rb2);
+            }
+
+          /* Add to statistics */
+
+          if (div != 0.0)
+            AddStat(mul*val/div, stp, idx0, rb0);
+        }
+    }
+}
+
+/*****************************************************************************/
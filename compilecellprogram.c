@@ -0,0 +1,471 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : compilecellprogram.c                           */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Compiles cell definition into a flat program of surface      */
+/*              tests evaluated by InCell()                                  */
+/*                                                                           */
+/* Comments: - Each instruction tests one surface and jumps to one of two    */
+/*             targets depending on the result. Targets are pointers to      */
+/*             other instructions or CELL_PROG_EXIT_IN / CELL_PROG_EXIT_OUT. */
+/*                                                                           */
+/*           - Simple surface types without transformations are inlined      */
+/*             with packed coefficients, everything else is passed to        */
+/*             TestSurface().                                                */
+/*                                                                           */
+/*           - Composition lists are converted from postfix notation into    */
+/*             short-circuit jumps. Instructions are written backwards from  */
+/*             the end of the block, so that the first test is always at     */
+/*             the beginning.                                                */
+/*                                                                           */
+/*           - Each instruction has slots for cell search list items of      */
+/*             neighbour cells found after exiting the cell through it. The  */
+/*             slots are filled in FindUniverseCell() and cleared when the   */
+/*             program is re-compiled.                                       */
+/*                                                                           */
+/*           - If prg is not a valid pointer, only the size of the program   */
+/*             is returned. The size doesn't depend on the order of the      */
+/*             intersection list, so the program can be re-compiled in place */
+/*             after sorting.                                                */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "CompileCellProgram:"
+
+static long SurfOp(long, long *);
+static void PutInstruction(long, long, long, long, long);
+static long Compile(long, long, long, long, long *);
+
+/*****************************************************************************/
+
+long CompileCellProgram(long cell, long prg)
+{
+  long ptr, loc0, surf, side, sz, np, n, i, next;
+
+  /* Check cell pointer */
+
+  CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
+
+  /* Reset size */
+
+  sz = 0;
+
+  /* Check type */
+
+  if ((ptr = (long)RDB[cell + CELL_PTR_SURF_INSC]) > VALID_PTR)
+    {
+      /***********************************************************************/
+
+      /***** Intersection list given *****************************************/
+
+      /* Calculate size */
+
+      n = 0;
+      while ((loc0 = ListPtr(ptr, n++)) > VALID_PTR)
+        {
+          surf = (long)RDB[loc0 + CELL_INSC_PTR_SURF];
+          CheckPointer(FUNCTION_NAME, "(surf)", DATA_ARRAY, surf);
+
+          SurfOp(surf, &np);
+          sz = sz + CELL_PROG_PARAMS + np;
+        }
+
+      /* Check mode */
+
+      if (prg < VALID_PTR)
+        return sz;
+
+      /* Loop over list backwards */
+
+      next = CELL_PROG_EXIT_IN;
+      loc0 = prg + sz;
+
+      for (i = ListSize(ptr) - 1; i > -1; i--)
+        {
+          /* Pointer to item */
+
+          n = ListPtr(ptr, i);
+          CheckPointer(FUNCTION_NAME, "(n)", DATA_ARRAY, n);
+
+          /* Pointer to surface */
+
+          surf = (long)RDB[n + CELL_INSC_PTR_SURF];
+          CheckPointer(FUNCTION_NAME, "(surf)", DATA_ARRAY, surf);
+
+          /* Surface side */
+
+          side = (long)RDB[n + CELL_INSC_SIDE];
+
+          /* Put instruction (point is out if on wrong side) */
+
+          SurfOp(surf, &np);
+          loc0 = loc0 - CELL_PROG_PARAMS - np;
+
+          if (side < 0)
+            PutInstruction(loc0, surf, next, CELL_PROG_EXIT_OUT,
+                           (long)RDB[n + CELL_INSC_PTR_OUT_COUNT]);
+          else
+            PutInstruction(loc0, surf, CELL_PROG_EXIT_OUT, next,
+                           (long)RDB[n + CELL_INSC_PTR_OUT_COUNT]);
+
+          /* Next instruction is this one */
+
+          next = loc0;
+        }
+
+      /* Check */
+
+      if (loc0 != prg)
+        Die(FUNCTION_NAME, "Error in program size");
+
+      /***********************************************************************/
+    }
+  else if ((ptr = (long)RDB[cell + CELL_PTR_SURF_COMP]) > VALID_PTR)
+    {
+      /***********************************************************************/
+
+      /***** Composition list given ******************************************/
+
+      /* Calculate size */
+
+      while ((long)RDB[ptr] != 0)
+        {
+          if (((long)RDB[ptr] != SURF_OP_OR) &&
+              ((long)RDB[ptr] != SURF_OP_AND) &&
+              ((long)RDB[ptr] != SURF_OP_NOT))
+            {
+              SurfOp((long)RDB[ptr], &np);
+              sz = sz + CELL_PROG_PARAMS + np;
+            }
+
+          ptr++;
+        }
+
+      /* Check mode */
+
+      if (prg < VALID_PTR)
+        return sz;
+
+      /* Check empty list */
+
+      if (ptr == (long)RDB[cell + CELL_PTR_SURF_COMP])
+        Die(FUNCTION_NAME, "Empty composition in cell %s",
+            GetText(cell + CELL_PTR_NAME));
+
+      /* Compile from last operation (value 1 means point is in) */
+
+      loc0 = prg + sz;
+
+      if (Compile((long)RDB[cell + CELL_PTR_SURF_COMP], ptr - 1,
+                  CELL_PROG_EXIT_IN, CELL_PROG_EXIT_OUT, &loc0) != prg)
+        Die(FUNCTION_NAME, "Error in program size");
+
+      /***********************************************************************/
+    }
+  else
+    Die(FUNCTION_NAME, "No lists");
+
+  /* Return size */
+
+  return sz;
+}
+
+/*****************************************************************************/
+
+/***** Compile postfix sub-expression ****************************************/
+
+static long Compile(long beg, long ptr, long t, long f, long *pos)
+{
+  long op, surf, np, n, ptr1;
+
+  /* Check pointer */
+
+  if (ptr < beg)
+    Die(FUNCTION_NAME, "Error in postfix notation");
+
+  /* Get operation */
+
+  op = (long)RDB[ptr];
+
+  /* Check */
+
+  if ((op == SURF_OP_OR) || (op == SURF_OP_AND))
+    {
+      /* Find beginning of right operand (count of missing values) */
+
+      ptr1 = ptr - 1;
+      n = 1;
+
+      while (1 == 1)
+        {
+          /* Check */
+
+          if (ptr1 < beg)
+            Die(FUNCTION_NAME, "Error in postfix notation");
+
+          /* Add operands and subtract value */
+
+          if (((long)RDB[ptr1] == SURF_OP_OR) ||
+              ((long)RDB[ptr1] == SURF_OP_AND))
+            n++;
+          else if ((long)RDB[ptr1] != SURF_OP_NOT)
+            n--;
+
+          /* Check */
+
+          if (n == 0)
+            break;
+
+          /* Previous */
+
+          ptr1--;
+        }
+
+      /* Right operand is evaluated last so it is written first. Left */
+      /* operand decides whether right one needs to be evaluated. */
+
+      n = Compile(beg, ptr - 1, t, f, pos);
+
+      if (op == SURF_OP_AND)
+        return Compile(beg, ptr1 - 1, n, f, pos);
+      else
+        return Compile(beg, ptr1 - 1, t, n, pos);
+    }
+  else if (op == SURF_OP_NOT)
+    {
+      /* Swap targets */
+
+      return Compile(beg, ptr - 1, f, t, pos);
+    }
+
+  /* Pointer to surface */
+
+  surf = op;
+  CheckPointer(FUNCTION_NAME, "(surf)", DATA_ARRAY, surf);
+
+  /* Value is 1 if point is outside surface */
+
+  SurfOp(surf, &np);
+  *pos = *pos - CELL_PROG_PARAMS - np;
+
+  PutInstruction(*pos, surf, f, t, -1);
+
+  /* Return pointer to instruction */
+
+  return *pos;
+}
+
+/*****************************************************************************/
+
+/***** Put instruction *******************************************************/
+
+static void PutInstruction(long loc0, long surf, long in, long out, long cnt)
+{
+  long ptr, op, np, n;
+
+  /* Get operation */
+
+  op = SurfOp(surf, &np);
+
+  /* Put data */
+
+  WDB[loc0 + CELL_PROG_OP] = (double)op;
+  WDB[loc0 + CELL_PROG_SIZE] = (double)(CELL_PROG_PARAMS + np);
+  WDB[loc0 + CELL_PROG_PTR_IN] = (double)in;
+  WDB[loc0 + CELL_PROG_PTR_OUT] = (double)out;
+  WDB[loc0 + CELL_PROG_PTR_OUT_COUNT] = (double)cnt;
+  WDB[loc0 + CELL_PROG_PTR_SURF] = (double)surf;
+
+  /* Reset neighbour cache */
+
+  for (n = 0; n < MAX_CELL_PROG_NBR; n++)
+    WDB[loc0 + CELL_PROG_PTR_NBR1 + n] = NULLPTR;
+
+  /* Pointer to parameters */
+
+  ptr = (long)RDB[surf + SURFACE_PTR_PARAMS];
+  loc0 = loc0 + CELL_PROG_PARAMS;
+
+  /* Copy parameters */
+
+  switch (op)
+    {
+    case CELL_PROG_OP_SPH:
+      {
+        /* Put squared radius */
+
+        WDB[loc0] = RDB[ptr];
+        WDB[loc0 + 1] = RDB[ptr + 1];
+        WDB[loc0 + 2] = RDB[ptr + 2];
+        WDB[loc0 + 3] = RDB[ptr + 3]*RDB[ptr + 3];
+
+        break;
+      }
+    case CELL_PROG_OP_CYLX:
+    case CELL_PROG_OP_CYLY:
+    case CELL_PROG_OP_CYLZ:
+      {
+        /* Put squared radius */
+
+        WDB[loc0] = RDB[ptr];
+        WDB[loc0 + 1] = RDB[ptr + 1];
+        WDB[loc0 + 2] = RDB[ptr + 2]*RDB[ptr + 2];
+
+        break;
+      }
+    case CELL_PROG_OP_PLANE:
+      {
+        /* Put optional parameters */
+
+        for (n = 0; n < 4; n++)
+          {
+            if (n < (long)RDB[surf + SURFACE_N_PARAMS])
+              WDB[loc0 + n] = RDB[ptr + n];
+            else
+              WDB[loc0 + n] = 0.0;
+          }
+
+        break;
+      }
+    default:
+      {
+        /* Copy parameters as is */
+
+        for (n = 0; n < np; n++)
+          WDB[loc0 + n] = RDB[ptr + n];
+      }
+    }
+}
+
+/*****************************************************************************/
+
+/***** Get operation and number of packed parameters *************************/
+
+static long SurfOp(long surf, long *np)
+{
+  long type, n;
+
+  /* Reset number of parameters */
+
+  *np = 0;
+
+  /* Surfaces with transformations are not inlined */
+
+  if ((long)RDB[surf + SURFACE_PTR_TRANS] > VALID_PTR)
+    return CELL_PROG_OP_CALL;
+
+  /* Get type and number of parameters */
+
+  type = (long)RDB[surf + SURFACE_TYPE];
+  n = (long)RDB[surf + SURFACE_N_PARAMS];
+
+  /* Check type */
+
+  switch (type)
+    {
+    case SURF_INF:
+      return CELL_PROG_OP_INF;
+
+    case SURF_PX:
+    case SURF_PY:
+    case SURF_PZ:
+      {
+        /* Check number of parameters */
+
+        if (n != 1)
+          return CELL_PROG_OP_CALL;
+
+        *np = 1;
+
+        if (type == SURF_PX)
+          return CELL_PROG_OP_PX;
+        else if (type == SURF_PY)
+          return CELL_PROG_OP_PY;
+        else
+          return CELL_PROG_OP_PZ;
+      }
+
+    case SURF_CYL:
+    case SURF_CYLZ:
+    case SURF_CYLX:
+    case SURF_CYLY:
+      {
+        /* Truncated cylinders are passed to TestSurface() */
+
+        if (n != 3)
+          return CELL_PROG_OP_CALL;
+
+        *np = 3;
+
+        if (type == SURF_CYLX)
+          return CELL_PROG_OP_CYLX;
+        else if (type == SURF_CYLY)
+          return CELL_PROG_OP_CYLY;
+        else
+          return CELL_PROG_OP_CYLZ;
+      }
+
+    case SURF_SPH:
+      {
+        if (n != 4)
+          return CELL_PROG_OP_CALL;
+
+        *np = 4;
+        return CELL_PROG_OP_SPH;
+      }
+
+    case SURF_CUBE:
+      {
+        if (n != 4)
+          return CELL_PROG_OP_CALL;
+
+        *np = 4;
+        return CELL_PROG_OP_CUBE;
+      }
+
+    case SURF_CUBOID:
+      {
+        if (n != 6)
+          return CELL_PROG_OP_CALL;
+
+        *np = 6;
+        return CELL_PROG_OP_CUBOID;
+      }
+
+    case SURF_SQC:
+      {
+        /* Rounded corners are passed to TestSurface() */
+
+        if (n != 3)
+          return CELL_PROG_OP_CALL;
+
+        *np = 3;
+        return CELL_PROG_OP_SQC;
+      }
+
+    case SURF_PLANE:
+    case SURF_MPLANE:
+      {
+        /* Only parametric form is inlined */
+
+        if ((n < 1) || (n > 4))
+          return CELL_PROG_OP_CALL;
+
+        *np = 4;
+        return CELL_PROG_OP_PLANE;
+      }
+    }
+
+  /* Call TestSurface() */
+
+  return CELL_PROG_OP_CALL;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,169 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : compilecells.c                                 */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Compiles cell definitions into contiguous per-universe       */
+/*              programs used by InCell() and packs the boundary surfaces    */
+/*              for NearestBoundary()                                        */
+/*                                                                           */
+/* Comments: - Must be called after surfaces are linked and transformations  */
+/*             are processed.                                                */
+/*                                                                           */
+/*           - Cells that are not in universe cell lists (tet mesh cells,    */
+/*             etc.) are evaluated from the original lists.                  */
+/*                                                                           */
+/*           - Programs are re-compiled in place after intersection lists    */
+/*             are sorted in SortAll().                                      */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "CompileCells:"
+
+/*****************************************************************************/
+
+void CompileCells()
+{
+  long uni, lst, cell, prg, sz, ncell, nins, ninl, npck, op, ptr;
+
+  fprintf(outp, "Compiling cell definitions...\n");
+
+  /* Reset counters */
+
+  ncell = 0;
+  nins = 0;
+  ninl = 0;
+  npck = 0;
+
+  /* Loop over universes */
+
+  uni = (long)RDB[DATA_PTR_U0];
+  while (uni > VALID_PTR)
+    {
+      /* Calculate size of programs and packed surfaces */
+
+      sz = 0;
+
+      lst = (long)RDB[uni + UNIVERSE_PTR_CELL_LIST];
+      while (lst > VALID_PTR)
+        {
+          /* Pointer to cell */
+
+          cell = (long)RDB[lst + CELL_LIST_PTR_CELL];
+          CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
+
+          /* Add to size */
+
+          sz = sz + CompileCellProgram(cell, -1) + PackCellSurfaces(cell, -1);
+
+          /* Next */
+
+          lst = NextItem(lst);
+        }
+
+      /* Check */
+
+      if (sz == 0)
+        {
+          /* Next universe */
+
+          uni = NextItem(uni);
+
+          /* Cycle loop */
+
+          continue;
+        }
+
+      /* Allocate memory */
+
+      prg = ReallocMem(DATA_ARRAY, sz);
+
+      /* Loop over cells and compile */
+
+      lst = (long)RDB[uni + UNIVERSE_PTR_CELL_LIST];
+      while (lst > VALID_PTR)
+        {
+          /* Pointer to cell */
+
+          cell = (long)RDB[lst + CELL_LIST_PTR_CELL];
+          CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
+
+          /* Skip cells already compiled */
+
+          if ((long)RDB[cell + CELL_PTR_PROG] > VALID_PTR)
+            {
+              /* Next */
+
+              lst = NextItem(lst);
+
+              /* Cycle loop */
+
+              continue;
+            }
+
+          /* Compile and put pointer */
+
+          WDB[cell + CELL_PTR_PROG] = (double)prg;
+          ptr = prg;
+
+          prg = prg + CompileCellProgram(cell, prg);
+
+          /* Count instructions */
+
+          while (ptr < prg)
+            {
+              op = (long)RDB[ptr + CELL_PROG_OP];
+
+              if (op != CELL_PROG_OP_CALL)
+                ninl++;
+
+              nins++;
+
+              ptr = ptr + (long)RDB[ptr + CELL_PROG_SIZE];
+            }
+
+          /* Pack surfaces */
+
+          WDB[cell + CELL_PTR_SURF_PACK] = (double)prg;
+          ptr = prg;
+
+          prg = prg + PackCellSurfaces(cell, prg);
+
+          /* Add counters */
+
+          ncell++;
+          npck = npck + (long)RDB[ptr + SURF_PACK_N_PLANE] +
+            (long)RDB[ptr + SURF_PACK_N_CYLX] +
+            (long)RDB[ptr + SURF_PACK_N_CYLY] +
+            (long)RDB[ptr + SURF_PACK_N_CYLZ] +
+            (long)RDB[ptr + SURF_PACK_N_SPH];
+
+          /* Next */
+
+          lst = NextItem(lst);
+        }
+
+      /* Next universe */
+
+      uni = NextItem(uni);
+    }
+
+  /* Print summary */
+
+  fprintf(outp, " - %ld cells compiled into %ld surface tests, ",
+          ncell, nins);
+  fprintf(outp, "%ld inlined\n", ninl);
+  fprintf(outp, " - %ld planes and quadratic surfaces packed for distance ",
+          npck);
+  fprintf(outp, "calculation\n");
+
+  fprintf(outp, "OK.\n\n");
+}
+
+/*****************************************************************************/
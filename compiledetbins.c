@@ -0,0 +1,385 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : compiledetbins.c                               */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Compiles detector flag masks, bin strides and cell and       */
+/*              material lookup tables used by DetBin()                      */
+/*                                                                           */
+/* Comments: - Called at the end of ProcessDetectors(), after bin sizes and  */
+/*             cell and material pointers are set.                           */
+/*                                                                           */
+/*           - Cells and materials get a running index in the order they     */
+/*             appear in detector bins, and each detector gets a table that  */
+/*             covers its own index range. Table entries store both the      */
+/*             pointer and the bin, so that cells and materials created      */
+/*             later (with no valid index) are never matched.                */
+/*                                                                           */
+/*           - If the index range is much larger than the number of bins     */
+/*             the table is not created, and DetBin() falls back to the bin  */
+/*             lists in the cell and material structures.                    */
+/*                                                                           */
+/*           - Flag masks and particle flags are stored as doubles, so flag  */
+/*             numbers above 53 cannot be represented exactly and are        */
+/*             rejected.                                                     */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "CompileDetBins:"
+
+#define MAX_TAB_RATIO 10
+
+/* Largest flag number that fits in the mantissa of a double */
+
+#define MAX_DET_FLAG 53
+
+/*****************************************************************************/
+
+void CompileDetBins()
+{
+  long det, ptr, cell, mat, tst, nc, nm, n, i0, i1, sz, tab, msh, stride;
+  long mset, munset, aset, aunset;
+
+  /***************************************************************************/
+
+  /***** Assign indexes to cells and materials *******************************/
+
+  /* Reset cell indexes */
+
+  cell = (long)RDB[DATA_PTR_C0];
+  while (cell > VALID_PTR)
+    {
+      WDB[cell + CELL_DET_IDX] = -1.0;
+      cell = NextItem(cell);
+    }
+
+  /* Reset material indexes */
+
+  mat = (long)RDB[DATA_PTR_M0];
+  while (mat > VALID_PTR)
+    {
+      WDB[mat + MATERIAL_DET_IDX] = -1.0;
+      mat = NextItem(mat);
+    }
+
+  /* Reset counters */
+
+  nc = 0;
+  nm = 0;
+
+  /* Loop over detectors */
+
+  det = (long)RDB[DATA_PTR_DET0];
+  while (det > VALID_PTR)
+    {
+      /* Physical cell bins (UMSH and super-imposed cells are tested */
+      /* separately) */
+
+      if (((ptr = (long)RDB[det + DET_PTR_CBINS]) > VALID_PTR) &&
+          ((long)RDB[ptr + DET_CBIN_UMSH_PTR_UMSH] < VALID_PTR) &&
+          ((long)RDB[ptr + DET_CBIN_SUPER_CELL] == NO))
+        while (ptr > VALID_PTR)
+          {
+            /* Pointer to cell */
+
+            cell = (long)RDB[ptr + DET_CBIN_PTR_CELL];
+            CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
+
+            /* Put index */
+
+            if ((long)RDB[cell + CELL_DET_IDX] < 0)
+              WDB[cell + CELL_DET_IDX] = (double)(nc++);
+
+            /* Next bin */
+
+            ptr = NextItem(ptr);
+          }
+
+      /* Material bins */
+
+      ptr = (long)RDB[det + DET_PTR_MBINS];
+      while (ptr > VALID_PTR)
+        {
+          /* Pointer to material */
+
+          mat = (long)RDB[ptr + DET_MBIN_PTR_MAT];
+          CheckPointer(FUNCTION_NAME, "(mat)", DATA_ARRAY, mat);
+
+          /* Put index */
+
+          if ((long)RDB[mat + MATERIAL_DET_IDX] < 0)
+            WDB[mat + MATERIAL_DET_IDX] = (double)(nm++);
+
+          /* Next bin */
+
+          ptr = NextItem(ptr);
+        }
+
+      /* Next detector */
+
+      det = NextItem(det);
+    }
+
+  /***************************************************************************/
+
+  /***** Compile detectors ***************************************************/
+
+  det = (long)RDB[DATA_PTR_DET0];
+  while (det > VALID_PTR)
+    {
+      /***********************************************************************/
+
+      /***** Flag masks ******************************************************/
+
+      /* Reset masks */
+
+      mset = 0;
+      munset = 0;
+      aset = 0;
+      aunset = 0;
+
+      /* Loop over flags */
+
+      ptr = (long)RDB[det + DET_PTR_FLAGGING];
+      while (ptr > VALID_PTR)
+        {
+          /* Get flag number */
+
+          tst = (long)RDB[ptr + DET_FBIN_FLAG_NUMBER];
+          CheckValue(FUNCTION_NAME, "tst", "", tst, 1, 64);
+
+          /* Check that flag can be stored exactly */
+
+          if (tst > MAX_DET_FLAG)
+            Error(det, "Flag number %ld exceeds maximum %d", tst,
+                  MAX_DET_FLAG);
+
+          /* Convert */
+
+          tst = (long)(pow(2.0, (double)tst - 1.0));
+          CheckValue(FUNCTION_NAME, "tst", "", tst, 1, LONG_MAX);
+
+          /* Add to masks */
+
+          if ((long)RDB[ptr + DET_FBIN_FLAG_OPTION] == DET_FLAG_OPT_TEST_SET)
+            {
+              mset = mset | tst;
+
+              if ((long)RDB[ptr + DET_FBIN_FLAG_AND_LOGIC] == YES)
+                aset = aset | tst;
+            }
+          else if ((long)RDB[ptr + DET_FBIN_FLAG_OPTION] ==
+                   DET_FLAG_OPT_TEST_UNSET)
+            {
+              munset = munset | tst;
+
+              if ((long)RDB[ptr + DET_FBIN_FLAG_AND_LOGIC] == YES)
+                aunset = aunset | tst;
+            }
+
+          /* Next flag */
+
+          ptr = NextItem(ptr);
+        }
+
+      /* Put masks */
+
+      WDB[det + DET_FLAG_MASK_SET] = (double)mset;
+      WDB[det + DET_FLAG_MASK_UNSET] = (double)munset;
+      WDB[det + DET_FLAG_MASK_AND_SET] = (double)aset;
+      WDB[det + DET_FLAG_MASK_AND_UNSET] = (double)aunset;
+
+      /***********************************************************************/
+
+      /***** Bin strides *****************************************************/
+
+      stride = 1;
+
+      WDB[det + DET_STRIDE_E] = (double)stride;
+      stride = stride*(long)RDB[det + DET_N_EBINS];
+
+      WDB[det + DET_STRIDE_U] = (double)stride;
+      stride = stride*(long)RDB[det + DET_N_UBINS];
+
+      WDB[det + DET_STRIDE_C] = (double)stride;
+      stride = stride*(long)RDB[det + DET_N_CBINS];
+
+      WDB[det + DET_STRIDE_M] = (double)stride;
+      stride = stride*(long)RDB[det + DET_N_MBINS];
+
+      WDB[det + DET_STRIDE_L] = (double)stride;
+      stride = stride*(long)RDB[det + DET_N_LBINS];
+
+      WDB[det + DET_STRIDE_I] = (double)stride;
+
+      if ((msh = (long)RDB[det + DET_PTR_MESH]) > VALID_PTR)
+        stride = stride*(long)(RDB[msh + MESH_N0]*RDB[msh + MESH_N1]*
+                               RDB[msh + MESH_N2]);
+
+      WDB[det + DET_STRIDE_T] = (double)stride;
+
+      /***********************************************************************/
+
+      /***** Cell bin table **************************************************/
+
+      /* Reset pointer */
+
+      WDB[det + DET_PTR_CBIN_TAB] = NULLPTR;
+
+      /* Check physical cell bins */
+
+      if (((ptr = (long)RDB[det + DET_PTR_CBINS]) > VALID_PTR) &&
+          ((long)RDB[ptr + DET_CBIN_UMSH_PTR_UMSH] < VALID_PTR) &&
+          ((long)RDB[ptr + DET_CBIN_SUPER_CELL] == NO))
+        {
+          /* Get index range */
+
+          i0 = nc;
+          i1 = -1;
+          n = 0;
+
+          while (ptr > VALID_PTR)
+            {
+              cell = (long)RDB[ptr + DET_CBIN_PTR_CELL];
+
+              if ((long)RDB[cell + CELL_DET_IDX] < i0)
+                i0 = (long)RDB[cell + CELL_DET_IDX];
+              if ((long)RDB[cell + CELL_DET_IDX] > i1)
+                i1 = (long)RDB[cell + CELL_DET_IDX];
+
+              n++;
+              ptr = NextItem(ptr);
+            }
+
+          /* Check size */
+
+          if ((sz = i1 - i0 + 1) <= MAX_TAB_RATIO*n)
+            {
+              /* Allocate memory and reset (pointer, bin) pairs */
+
+              tab = ReallocMem(DATA_ARRAY, 2*sz);
+
+              for (n = 0; n < sz; n++)
+                {
+                  WDB[tab + 2*n] = NULLPTR;
+                  WDB[tab + 2*n + 1] = -1.0;
+                }
+
+              /* Put bins (first occurrence of cell is used) */
+
+              n = 0;
+
+              ptr = (long)RDB[det + DET_PTR_CBINS];
+              while (ptr > VALID_PTR)
+                {
+                  cell = (long)RDB[ptr + DET_CBIN_PTR_CELL];
+                  i1 = (long)RDB[cell + CELL_DET_IDX] - i0;
+
+                  if ((long)RDB[tab + 2*i1] < VALID_PTR)
+                    {
+                      WDB[tab + 2*i1] = (double)cell;
+                      WDB[tab + 2*i1 + 1] = (double)n;
+                    }
+
+                  n++;
+                  ptr = NextItem(ptr);
+                }
+
+              /* Put pointer, first index and size */
+
+              WDB[det + DET_PTR_CBIN_TAB] = (double)tab;
+              WDB[det + DET_CBIN_TAB_IDX0] = (double)i0;
+              WDB[det + DET_CBIN_TAB_SZ] = (double)sz;
+            }
+        }
+
+      /***********************************************************************/
+
+      /***** Material bin table **********************************************/
+
+      /* Reset pointer */
+
+      WDB[det + DET_PTR_MBIN_TAB] = NULLPTR;
+
+      /* Check material bins */
+
+      if ((ptr = (long)RDB[det + DET_PTR_MBINS]) > VALID_PTR)
+        {
+          /* Get index range */
+
+          i0 = nm;
+          i1 = -1;
+          n = 0;
+
+          while (ptr > VALID_PTR)
+            {
+              mat = (long)RDB[ptr + DET_MBIN_PTR_MAT];
+
+              if ((long)RDB[mat + MATERIAL_DET_IDX] < i0)
+                i0 = (long)RDB[mat + MATERIAL_DET_IDX];
+              if ((long)RDB[mat + MATERIAL_DET_IDX] > i1)
+                i1 = (long)RDB[mat + MATERIAL_DET_IDX];
+
+              n++;
+              ptr = NextItem(ptr);
+            }
+
+          /* Check size */
+
+          if ((sz = i1 - i0 + 1) <= MAX_TAB_RATIO*n)
+            {
+              /* Allocate memory and reset (pointer, bin) pairs */
+
+              tab = ReallocMem(DATA_ARRAY, 2*sz);
+
+              for (n = 0; n < sz; n++)
+                {
+                  WDB[tab + 2*n] = NULLPTR;
+                  WDB[tab + 2*n + 1] = -1.0;
+                }
+
+              /* Put bins (first occurrence of material is used) */
+
+              n = 0;
+
+              ptr = (long)RDB[det + DET_PTR_MBINS];
+              while (ptr > VALID_PTR)
+                {
+                  mat = (long)RDB[ptr + DET_MBIN_PTR_MAT];
+                  i1 = (long)RDB[mat + MATERIAL_DET_IDX] - i0;
+
+                  if ((long)RDB[tab + 2*i1] < VALID_PTR)
+                    {
+                      WDB[tab + 2*i1] = (double)mat;
+                      WDB[tab + 2*i1 + 1] = (double)n;
+                    }
+
+                  n++;
+                  ptr = NextItem(ptr);
+                }
+
+              /* Put pointer, first index and size */
+
+              WDB[det + DET_PTR_MBIN_TAB] = (double)tab;
+              WDB[det + DET_MBIN_TAB_IDX0] = (double)i0;
+              WDB[det + DET_MBIN_TAB_SZ] = (double)sz;
+            }
+        }
+
+      /***********************************************************************/
+
+      /* Next detector */
+
+      det = NextItem(det);
+    }
+
+  /***************************************************************************/
+}
+
+/*****************************************************************************/
@@ -0,0 +1,323 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : compiledetindex.c                              */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Builds reverse index from particle type, material and cell   */
+/*              to detectors that can score there                            */
+/*                                                                           */
+/* Comments: - Called at the end of ProcessDetectors(). The candidate lists  */
+/*             are read in DetCandidates() and looped in ColDet().           */
+/*                                                                           */
+/*           - Detectors with material bins are listed under each material   */
+/*             they bin (and its divided sub-materials), detectors with      */
+/*             physical cell bins under each cell, and the rest under their  */
+/*             particle type. Surface detectors are not scored in ColDet()   */
+/*             and are not included.                                         */
+/*                                                                           */
+/*           - Lists contain detector indexes in the order of the detector   */
+/*             list, terminated by -1. The order is preserved in scoring,    */
+/*             because detector flags set by one detector are tested by the  */
+/*             following ones.                                               */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "CompileDetIndex:"
+
+/* Detector classes */
+
+#define DET_CLASS_NONE  0
+#define DET_CLASS_TYPE  1
+#define DET_CLASS_MAT   2
+#define DET_CLASS_CELL  3
+
+static long PutCandidates(long *, long);
+static int CompareIdx(const void *, const void *);
+
+/*****************************************************************************/
+
+void CompileDetIndex()
+{
+  long det, nd, tab, ptr, loc0, mat, cell, type, empty, stamp, i, n;
+  long *cls, *idx, *mark;
+
+  /* Count detectors */
+
+  nd = 0;
+
+  det = (long)RDB[DATA_PTR_DET0];
+  while (det > VALID_PTR)
+    {
+      nd++;
+      det = NextItem(det);
+    }
+
+  /* Check count */
+
+  if (nd == 0)
+    return;
+
+  /***************************************************************************/
+
+  /***** Index table and classes *********************************************/
+
+  /* Allocate memory for index table */
+
+  tab = ReallocMem(DATA_ARRAY, nd);
+  WDB[DATA_PTR_DET_TAB] = (double)tab;
+
+  /* Allocate memory for temporary arrays */
+
+  cls = (long *)Mem(MEM_ALLOC, nd, sizeof(long));
+  idx = (long *)Mem(MEM_ALLOC, nd, sizeof(long));
+  mark = (long *)Mem(MEM_ALLOC, nd, sizeof(long));
+
+  /* Loop over detectors */
+
+  i = 0;
+
+  det = (long)RDB[DATA_PTR_DET0];
+  while (det > VALID_PTR)
+    {
+      /* Put index and pointer */
+
+      WDB[det + DET_IDX] = (double)i;
+      WDB[tab + i] = (double)det;
+
+      /* Reset mark */
+
+      mark[i] = 0;
+
+      /* Get class */
+
+      ptr = (long)RDB[det + DET_PTR_CBINS];
+
+      if ((long)RDB[det + DET_PTR_SBINS] > VALID_PTR)
+        cls[i] = DET_CLASS_NONE;
+      else if ((long)RDB[det + DET_PTR_MBINS] > VALID_PTR)
+        cls[i] = DET_CLASS_MAT;
+      else if ((ptr > VALID_PTR) &&
+               ((long)RDB[ptr + DET_CBIN_UMSH_PTR_UMSH] < VALID_PTR) &&
+               ((long)RDB[ptr + DET_CBIN_SUPER_CELL] == NO))
+        cls[i] = DET_CLASS_CELL;
+      else
+        cls[i] = DET_CLASS_TYPE;
+
+      /* Update index */
+
+      i++;
+
+      /* Next detector */
+
+      det = NextItem(det);
+    }
+
+  /* Shared empty list */
+
+  empty = PutCandidates(idx, 0);
+
+  /***************************************************************************/
+
+  /***** Lists of all detectors and detectors by particle type ***************/
+
+  /* All detectors (used for cells and materials without index) */
+
+  n = 0;
+  for (i = 0; i < nd; i++)
+    if (cls[i] != DET_CLASS_NONE)
+      idx[n++] = i;
+
+  WDB[DATA_PTR_DET_CAND_ALL] = (double)PutCandidates(idx, n);
+
+  /* Allocate memory for particle types */
+
+  loc0 = ReallocMem(DATA_ARRAY, PARTICLE_TYPE_ALPHA + 1);
+  WDB[DATA_PTR_DET_CAND_TYPE] = (double)loc0;
+
+  /* Loop over particle types */
+
+  for (type = 0; type < PARTICLE_TYPE_ALPHA + 1; type++)
+    {
+      /* Collect detectors without material and cell bins */
+
+      n = 0;
+      for (i = 0; i < nd; i++)
+        {
+          det = (long)RDB[tab + i];
+
+          if ((cls[i] == DET_CLASS_TYPE) &&
+              ((long)RDB[det + DET_PARTICLE] == type))
+            idx[n++] = i;
+        }
+
+      /* Put list */
+
+      if (n > 0)
+        WDB[loc0 + type] = (double)PutCandidates(idx, n);
+      else
+        WDB[loc0 + type] = (double)empty;
+    }
+
+  /***************************************************************************/
+
+  /***** Materials ***********************************************************/
+
+  /* Reset stamp (used to mark detectors already in list) */
+
+  stamp = 0;
+
+  mat = (long)RDB[DATA_PTR_M0];
+  while (mat > VALID_PTR)
+    {
+      /* Reset count and update stamp */
+
+      n = 0;
+      stamp++;
+
+      /* Loop over material bins of material and parent */
+
+      ptr = (long)RDB[mat + MATERIAL_PTR_DETBIN];
+      while (ptr > VALID_PTR)
+        {
+          det = (long)RDB[ptr + DETBIN_PTR_DET];
+          i = (long)RDB[det + DET_IDX];
+
+          if ((cls[i] == DET_CLASS_MAT) && (mark[i] != stamp))
+            {
+              mark[i] = stamp;
+              idx[n++] = i;
+            }
+
+          ptr = NextItem(ptr);
+        }
+
+      if ((loc0 = (long)RDB[mat + MATERIAL_DIV_PTR_PARENT]) > VALID_PTR)
+        {
+          ptr = (long)RDB[loc0 + MATERIAL_PTR_DETBIN];
+          while (ptr > VALID_PTR)
+            {
+              det = (long)RDB[ptr + DETBIN_PTR_DET];
+              i = (long)RDB[det + DET_IDX];
+
+              if ((cls[i] == DET_CLASS_MAT) && (mark[i] != stamp))
+                {
+                  mark[i] = stamp;
+                  idx[n++] = i;
+                }
+
+              ptr = NextItem(ptr);
+            }
+        }
+
+      /* Put list */
+
+      if (n > 0)
+        WDB[mat + MATERIAL_PTR_DET_CAND] = (double)PutCandidates(idx, n);
+      else
+        WDB[mat + MATERIAL_PTR_DET_CAND] = (double)empty;
+
+      /* Next material */
+
+      mat = NextItem(mat);
+    }
+
+  /***************************************************************************/
+
+  /***** Cells ***************************************************************/
+
+  cell = (long)RDB[DATA_PTR_C0];
+  while (cell > VALID_PTR)
+    {
+      /* Reset count and update stamp */
+
+      n = 0;
+      stamp++;
+
+      /* Loop over cell bins */
+
+      ptr = (long)RDB[cell + CELL_PTR_DETBIN];
+      while (ptr > VALID_PTR)
+        {
+          det = (long)RDB[ptr + DETBIN_PTR_DET];
+          i = (long)RDB[det + DET_IDX];
+
+          if ((cls[i] == DET_CLASS_CELL) && (mark[i] != stamp))
+            {
+              mark[i] = stamp;
+              idx[n++] = i;
+            }
+
+          ptr = NextItem(ptr);
+        }
+
+      /* Put list */
+
+      if (n > 0)
+        WDB[cell + CELL_PTR_DET_CAND] = (double)PutCandidates(idx, n);
+      else
+        WDB[cell + CELL_PTR_DET_CAND] = (double)empty;
+
+      /* Next cell */
+
+      cell = NextItem(cell);
+    }
+
+  /***************************************************************************/
+
+  /* Free temporary arrays */
+
+  Mem(MEM_FREE, cls);
+  Mem(MEM_FREE, idx);
+  Mem(MEM_FREE, mark);
+}
+
+/*****************************************************************************/
+
+/***** Sort indexes and store list *******************************************/
+
+static long PutCandidates(long *idx, long n)
+{
+  long ptr, i;
+
+  /* Sort */
+
+  if (n > 1)
+    qsort(idx, n, sizeof(long), CompareIdx);
+
+  /* Allocate memory and put indexes */
+
+  ptr = ReallocMem(DATA_ARRAY, n + 1);
+
+  for (i = 0; i < n; i++)
+    WDB[ptr + i] = (double)idx[i];
+
+  /* Put terminator */
+
+  WDB[ptr + n] = -1.0;
+
+  /* Return pointer */
+
+  return ptr;
+}
+
+/*****************************************************************************/
+
+/***** Compare indexes *******************************************************/
+
+static int CompareIdx(const void *a, const void *b)
+{
+  if (*(const long *)a < *(const long *)b)
+    return -1;
+  else if (*(const long *)a > *(const long *)b)
+    return 1;
+  else
+    return 0;
+}
+
+/*****************************************************************************/
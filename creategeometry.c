@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : creategeometry.c                               */
 /*                                                                           */
 /* Created:       2011/03/02 (JLe)                                           */
-/* Last modified: 2018/09/05 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: - Creates physical and super-imposed universes               */
@@ -606,6 +606,11 @@ void CreateGeometry()
   ptr = AllocPrivateData(1, PRIVA_ARRAY);
   WDB[DATA_CELL_SEARCH_LIST] = (double)ptr;
 
+  /* Allocate memory for last exit instruction of compiled cell program */
+
+  ptr = AllocPrivateData(1, PRIVA_ARRAY);
+  WDB[DATA_CELL_PROG_EXIT] = (double)ptr;
+
   /* Exit OK */
 
   fprintf(outp, "OK.\n\n");
@@ -0,0 +1,215 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : csmcacheheader.c                               */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Forms adaptive cell search mesh cache file name and header   */
+/*              that identifies the geometry of the universe                 */
+/*                                                                           */
+/* Comments: - The geometry hash (FNV-1a) covers universe boundaries, mesh   */
+/*             parameters and the cells in the order of the universe cell    */
+/*             list: cell names and intersection or composition lists with   */
+/*             the type, parameters and transformations of each surface.     */
+/*             Materials and fills do not affect the mesh and are not        */
+/*             included.                                                     */
+/*                                                                           */
+/*           - Cache file name is formed from universe name and the hash.    */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "CSMCacheHeader:"
+
+static void HashBytes(unsigned long *, const void *, long);
+static void HashSurf(unsigned long *, long);
+
+/*****************************************************************************/
+
+long CSMCacheHeader(long uni, char *fname, long *hdr)
+{
+  long lst, loc0, cell, ptr, n, nc, val;
+  unsigned long hash;
+
+  /* Check that cache is in use */
+
+  if ((long)RDB[DATA_ADA_CSM_PTR_CACHE_DIR] < VALID_PTR)
+    return NO;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(uni)", DATA_ARRAY, uni);
+
+  /* Init hash */
+
+  hash = 14695981039346656037UL;
+
+  /* Mesh parameters */
+
+  val = ADA_CSM_DEPTH;
+  HashBytes(&hash, &val, sizeof(long));
+
+  val = ADA_CSM_SZ0;
+  HashBytes(&hash, &val, sizeof(long));
+
+  val = ADA_CSM_SZ;
+  HashBytes(&hash, &val, sizeof(long));
+
+  val = ADA_CSM_NP;
+  HashBytes(&hash, &val, sizeof(long));
+
+  val = MAX_CELL_SEARCH_MESH_SZ;
+  HashBytes(&hash, &val, sizeof(long));
+
+  /* Universe dimension and boundaries */
+
+  HashBytes(&hash, &RDB[uni + UNIVERSE_DIM], sizeof(double));
+  HashBytes(&hash, &RDB[uni + UNIVERSE_MINX], sizeof(double));
+  HashBytes(&hash, &RDB[uni + UNIVERSE_MAXX], sizeof(double));
+  HashBytes(&hash, &RDB[uni + UNIVERSE_MINY], sizeof(double));
+  HashBytes(&hash, &RDB[uni + UNIVERSE_MAXY], sizeof(double));
+  HashBytes(&hash, &RDB[uni + UNIVERSE_MINZ], sizeof(double));
+  HashBytes(&hash, &RDB[uni + UNIVERSE_MAXZ], sizeof(double));
+
+  /* Loop over cells */
+
+  lst = (long)RDB[uni + UNIVERSE_PTR_CELL_LIST];
+  CheckPointer(FUNCTION_NAME, "(lst)", DATA_ARRAY, lst);
+
+  nc = 0;
+  while ((loc0 = ListPtr(lst, nc++)) > VALID_PTR)
+    {
+      /* Pointer to cell */
+
+      cell = (long)RDB[loc0 + CELL_LIST_PTR_CELL];
+      CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
+
+      /* Name (including terminator to separate consecutive names) */
+
+      HashBytes(&hash, GetText(cell + CELL_PTR_NAME),
+                strlen(GetText(cell + CELL_PTR_NAME)) + 1);
+
+      /* Check list type */
+
+      if ((ptr = (long)RDB[cell + CELL_PTR_SURF_INSC]) > VALID_PTR)
+        {
+          /* Intersection list, loop over surfaces */
+
+          n = 0;
+          while ((loc0 = ListPtr(ptr, n++)) > VALID_PTR)
+            {
+              HashBytes(&hash, &RDB[loc0 + CELL_INSC_SIDE], sizeof(double));
+              HashSurf(&hash, (long)RDB[loc0 + CELL_INSC_PTR_SURF]);
+            }
+        }
+      else if ((ptr = (long)RDB[cell + CELL_PTR_SURF_COMP]) > VALID_PTR)
+        {
+          /* Composition list, loop over operators and surfaces */
+
+          while ((val = (long)RDB[ptr++]) != 0)
+            {
+              if ((val == SURF_OP_OR) || (val == SURF_OP_AND) ||
+                  (val == SURF_OP_NOT))
+                HashBytes(&hash, &val, sizeof(long));
+              else
+                HashSurf(&hash, val);
+            }
+        }
+    }
+
+  /* Number of cells (loop counter is one past the last) */
+
+  nc = nc - 1;
+
+  /* Cache file name */
+
+  if (snprintf(fname, MAX_STR, "%s/%s.%016lx.csm",
+               GetText(DATA_ADA_CSM_PTR_CACHE_DIR),
+               GetText(uni + UNIVERSE_PTR_NAME), hash) >= MAX_STR)
+    Error(0, "Cell search mesh cache file name too long in directory \"%s\"",
+          GetText(DATA_ADA_CSM_PTR_CACHE_DIR));
+
+  /* Reset header */
+
+  for (n = 0; n < CSM_CACHE_HDR_SIZE; n++)
+    hdr[n] = 0;
+
+  /* Put identifiers */
+
+  hdr[CSM_CACHE_HDR_MAGIC] = CSM_CACHE_MAGIC;
+  hdr[CSM_CACHE_HDR_VERSION] = CSM_CACHE_VERSION;
+  hdr[CSM_CACHE_HDR_HASH] = (long)hash;
+  hdr[CSM_CACHE_HDR_NC] = nc;
+
+  /* Exit */
+
+  return YES;
+}
+
+/*****************************************************************************/
+
+/***** Add bytes to hash *****************************************************/
+
+static void HashBytes(unsigned long *hash, const void *dat, long n)
+{
+  const unsigned char *c;
+  long i;
+
+  c = (const unsigned char *)dat;
+
+  for (i = 0; i < n; i++)
+    {
+      *hash ^= (unsigned long)c[i];
+      *hash *= 1099511628211UL;
+    }
+}
+
+/*****************************************************************************/
+
+/***** Add surface to hash ***************************************************/
+
+static void HashSurf(unsigned long *hash, long surf)
+{
+  long ptr, np, tra;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(surf)", DATA_ARRAY, surf);
+
+  /* Name, type and number of parameters */
+
+  HashBytes(hash, GetText(surf + SURFACE_PTR_NAME),
+            strlen(GetText(surf + SURFACE_PTR_NAME)) + 1);
+  HashBytes(hash, &RDB[surf + SURFACE_TYPE], sizeof(double));
+  HashBytes(hash, &RDB[surf + SURFACE_N_PARAMS], sizeof(double));
+
+  /* Parameters */
+
+  if ((np = (long)RDB[surf + SURFACE_N_PARAMS]) > 0)
+    {
+      ptr = (long)RDB[surf + SURFACE_PTR_PARAMS];
+      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+      HashBytes(hash, &RDB[ptr], np*sizeof(double));
+    }
+
+  /* Transformations */
+
+  tra = (long)RDB[surf + SURFACE_PTR_TRANS];
+  while (tra > VALID_PTR)
+    {
+      HashBytes(hash, &RDB[tra + TRANS_TYPE], sizeof(double));
+      HashBytes(hash, &RDB[tra + TRANS_ROT],
+                (TRANS_RZ9 - TRANS_ROT + 1)*sizeof(double));
+      HashBytes(hash, &RDB[tra + TRANS_T0],
+                (TRANS_ROT_AX_W - TRANS_T0 + 1)*sizeof(double));
+
+      tra = NextItem(tra);
+    }
+}
+
+/*****************************************************************************/
@@ -3,12 +3,18 @@
 /* serpent 2 (beta-version) : detbin.c                                       */
 /*                                                                           */
 /* Created:       2011/07/11 (JLe)                                           */
-/* Last modified: 2019/10/22 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Finds detector bin                                           */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - Flag masks, bin strides and cell and material lookup tables   */
+/*             are set in CompileDetBins(). Cell and material bin lists are  */
+/*             used only if the table was not created.                       */
+/*                                                                           */
+/*           - Universe bins are tested in list order, because the collision */
+/*             flags may be set by several calls to WhereAmI() during the    */
+/*             same collision and by super-imposed universes.                */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -22,10 +28,12 @@
 long DetBin(long det, long mat, long part, double x, double y, double z,
             double E, double t, long id)
 {
-  long ptr, uni, lat, cell, umsh, ifc, idx, ncol, lvl0, lvl, flg, tst, n, m;
-  long ebin, ubin, cbin, mbin, lbin, ibin, tbin, msh, prnt, tra;
-  long ne, nu, nc, nm, nl, ni, nt, nmax;
+  long ptr, uni, lat, cell, umsh, ifc, idx, ncol, lvl0, lvl, flg, tab, sz;
+  long ebin, ubin, cbin, mbin, lbin, ibin, tbin, msh, prnt, tra, i0, nt;
   double x1, y1, z1, u, v, w;
+#ifdef DEBUG
+  long ne, nu, nc, nm, nl;
+#endif
 
   /* Reset bins */
 
@@ -37,21 +45,18 @@ long DetBin(long det, long mat, long part, double x, double y, double z,
   ibin = 0;
   tbin = 0;
 
-  /* Get number of bins */
+#ifdef DEBUG
+
+  /* Get number of bins (needed only for checks, bin strides are */
+  /* calculated in CompileDetBins()) */
 
   ne = (long)RDB[det + DET_N_EBINS];
   nu = (long)RDB[det + DET_N_UBINS];
   nc = (long)RDB[det + DET_N_CBINS];
   nm = (long)RDB[det + DET_N_MBINS];
   nl = (long)RDB[det + DET_N_LBINS];
-  nt = (long)RDB[det + DET_N_TBINS];
-
-  /* Mesh bins */
 
-  if ((ptr = (long)RDB[det + DET_PTR_MESH]) > VALID_PTR)
-    ni = (long)(RDB[ptr + MESH_N0]*RDB[ptr + MESH_N1]*RDB[ptr + MESH_N2]);
-  else
-    ni = 1;
+#endif
 
   /* Get collision number */
 
@@ -74,90 +79,28 @@ long DetBin(long det, long mat, long part, double x, double y, double z,
 
   /***** Test flagging *******************************************************/
 
-  /* Check particle pointer */
+  /* Check particle pointer and flag tests (masks are set in */
+  /* CompileDetBins()) */
 
-  if (part > VALID_PTR)
+  if ((part > VALID_PTR) && (((long)RDB[det + DET_FLAG_MASK_SET] |
+                              (long)RDB[det + DET_FLAG_MASK_UNSET]) != 0))
     {
       /* Get flags */
 
       flg = (long)RDB[part + PARTICLE_DET_FLAGS];
 
-      /* Reset counters */
-
-      n = 0;
-      m = 0;
-
-      /* Loop over flags */
-
-      ptr = (long)RDB[det + DET_PTR_FLAGGING];
-      while (ptr > VALID_PTR)
-        {
-          /* Get flag number */
-
-          tst = (long)RDB[ptr + DET_FBIN_FLAG_NUMBER];
-          CheckValue(FUNCTION_NAME, "tst", "", tst, 1, 64);
-
-          /* Convert */
-
-          tst = (long)(pow(2.0, (double)tst - 1.0));
-          CheckValue(FUNCTION_NAME, "tst", "", tst, 1, LONG_MAX);
-
-          /* Check test option */
-
-          if ((long)RDB[ptr + DET_FBIN_FLAG_OPTION] ==
-              DET_FLAG_OPT_TEST_UNSET)
-            {
-              /* Add to test count */
-
-              m++;
-
-              /* Check if flag is not set */
-
-              if (!(flg & tst))
-                n++;
-              else if ((long)RDB[ptr + DET_FBIN_FLAG_AND_LOGIC] == YES)
-                {
-                  /* Reset count */
-
-                  n = -1;
+      /* Check flags with AND logic (all must pass) */
 
-                  /* Break loop */
-
-                  break;
-                }
-            }
-          else if ((long)RDB[ptr + DET_FBIN_FLAG_OPTION] ==
-                   DET_FLAG_OPT_TEST_SET)
-            {
-
-              /* Add to test count */
-
-              m++;
-
-              /* Check if flag is set */
-
-              if (flg & tst)
-                n++;
-              else if ((long)RDB[ptr + DET_FBIN_FLAG_AND_LOGIC] == YES)
-                {
-                  /* Reset count */
-
-                  n = -1;
-
-                  /* Break loop */
-
-                  break;
-                }
-            }
-
-          /* Next flag */
-
-          ptr = NextItem(ptr);
-        }
+      if ((flg & (long)RDB[det + DET_FLAG_MASK_AND_SET]) !=
+          (long)RDB[det + DET_FLAG_MASK_AND_SET])
+        return -1;
+      else if (flg & (long)RDB[det + DET_FLAG_MASK_AND_UNSET])
+        return -1;
 
-      /* Check if flags are tested but count is zero */
+      /* Check that at least one test passes */
 
-      if ((m > 0) && (n <= 0))
+      if (!(flg & (long)RDB[det + DET_FLAG_MASK_SET]) &&
+          !(~flg & (long)RDB[det + DET_FLAG_MASK_UNSET]))
         return -1;
     }
 
@@ -199,6 +142,10 @@ long DetBin(long det, long mat, long part, double x, double y, double z,
 
   if ((ptr = (long)RDB[det + DET_PTR_TME]) > VALID_PTR)
     {
+      /* Get number of bins */
+
+      nt = (long)RDB[det + DET_N_TBINS];
+
       /* Get bin */
 
       if ((tbin = SearchArray(&RDB[ptr], t, nt + 1)) < 0)
@@ -409,6 +356,19 @@ long DetBin(long det, long mat, long part, double x, double y, double z,
 
           cbin = -1;
 
+          /* Pointer to lookup table (set in CompileDetBins()) */
+
+          if ((tab = (long)RDB[det + DET_PTR_CBIN_TAB]) > VALID_PTR)
+            {
+              i0 = (long)RDB[det + DET_CBIN_TAB_IDX0];
+              sz = (long)RDB[det + DET_CBIN_TAB_SZ];
+            }
+          else
+            {
+              i0 = 0;
+              sz = 0;
+            }
+
           /* Loop over levels */
 
           lvl0 = (long)RDB[DATA_PTR_LVL0];
@@ -422,7 +382,21 @@ long DetBin(long det, long mat, long part, double x, double y, double z,
               /* Pointer to cell and detector bin */
 
               if ((cell = (long)GetPrivateData(lvl + LVL_PRIV_PTR_CELL, id))
-                  > VALID_PTR)
+                  < VALID_PTR)
+                {
+                  /* No cell at this level */
+                }
+              else if (tab > VALID_PTR)
+                {
+                  /* Get table index and compare cell pointer */
+
+                  idx = (long)RDB[cell + CELL_DET_IDX] - i0;
+
+                  if ((idx > -1) && (idx < sz) &&
+                      ((long)RDB[tab + 2*idx] == cell))
+                    cbin = (long)RDB[tab + 2*idx + 1];
+                }
+              else
                 {
                   /* Loop over detector bin list */
 
@@ -486,33 +460,34 @@ long DetBin(long det, long mat, long part, double x, double y, double z,
 
       mbin = -1;
 
-      /* Loop over detector bin list */
+      /* Check lookup table (set in CompileDetBins()) */
 
-      ptr = (long)RDB[mat + MATERIAL_PTR_DETBIN];
-      while (ptr > VALID_PTR)
+      if ((tab = (long)RDB[det + DET_PTR_MBIN_TAB]) > VALID_PTR)
         {
-          /* Check detector pointer */
+          /* Get first index and size */
 
-          if (det == (long)RDB[ptr + DETBIN_PTR_DET])
-            {
-              /* Set bin */
+          i0 = (long)RDB[det + DET_MBIN_TAB_IDX0];
+          sz = (long)RDB[det + DET_MBIN_TAB_SZ];
 
-              mbin = (long)RDB[ptr + DETBIN_BIN];
+          /* Get table index and compare material pointer */
 
-              /* Break loop */
+          idx = (long)RDB[mat + MATERIAL_DET_IDX] - i0;
 
-              break;
-            }
+          if ((idx > -1) && (idx < sz) && ((long)RDB[tab + 2*idx] == mat))
+            mbin = (long)RDB[tab + 2*idx + 1];
+          else if ((mat = (long)RDB[mat + MATERIAL_DIV_PTR_PARENT]) >
+                   VALID_PTR)
+            {
+              /* Repeat for parent */
 
-          /* Next bin list */
+              idx = (long)RDB[mat + MATERIAL_DET_IDX] - i0;
 
-          ptr = NextItem(ptr);
+              if ((idx > -1) && (idx < sz) &&
+                  ((long)RDB[tab + 2*idx] == mat))
+                mbin = (long)RDB[tab + 2*idx + 1];
+            }
         }
-
-      /* Repeat for parent */
-
-      if ((mbin < 0) &&
-          ((mat = (long)RDB[mat + MATERIAL_DIV_PTR_PARENT]) > VALID_PTR))
+      else
         {
           /* Loop over detector bin list */
 
@@ -536,6 +511,35 @@ long DetBin(long det, long mat, long part, double x, double y, double z,
 
               ptr = NextItem(ptr);
             }
+
+          /* Repeat for parent */
+
+          if ((mbin < 0) &&
+              ((mat = (long)RDB[mat + MATERIAL_DIV_PTR_PARENT]) > VALID_PTR))
+            {
+              /* Loop over detector bin list */
+
+              ptr = (long)RDB[mat + MATERIAL_PTR_DETBIN];
+              while (ptr > VALID_PTR)
+                {
+                  /* Check detector pointer */
+
+                  if (det == (long)RDB[ptr + DETBIN_PTR_DET])
+                    {
+                      /* Set bin */
+
+                      mbin = (long)RDB[ptr + DETBIN_BIN];
+
+                      /* Break loop */
+
+                      break;
+                    }
+
+                  /* Next bin list */
+
+                  ptr = NextItem(ptr);
+                }
+            }
         }
 
       /* Check bin */
@@ -699,31 +703,15 @@ long DetBin(long det, long mat, long part, double x, double y, double z,
       mbin = 0;
     }
 
-  /* Calculate index */
-
-  nmax = 1;
-  idx = 0;
-
-  idx = idx + ebin*nmax;
-  nmax = nmax*ne;
-
-  idx = idx + ubin*nmax;
-  nmax = nmax*nu;
-
-  idx = idx + cbin*nmax;
-  nmax = nmax*nc;
-
-  idx = idx + mbin*nmax;
-  nmax = nmax*nm;
-
-  idx = idx + lbin*nmax;
-  nmax = nmax*nl;
-
-  idx = idx + ibin*nmax;
-  nmax = nmax*ni;
+  /* Calculate index using bin strides (set in CompileDetBins()) */
 
-  idx = idx + tbin*nmax;
-  nmax = nmax*nt;
+  idx = ebin*(long)RDB[det + DET_STRIDE_E] +
+    ubin*(long)RDB[det + DET_STRIDE_U] +
+    cbin*(long)RDB[det + DET_STRIDE_C] +
+    mbin*(long)RDB[det + DET_STRIDE_M] +
+    lbin*(long)RDB[det + DET_STRIDE_L] +
+    ibin*(long)RDB[det + DET_STRIDE_I] +
+    tbin*(long)RDB[det + DET_STRIDE_T];
 
   /* Return index */
 
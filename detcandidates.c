@@ -0,0 +1,119 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : detcandidates.c                                */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Collects lists of detectors that can score in the current    */
+/*              collision point                                              */
+/*                                                                           */
+/* Comments: - Lists are created in CompileDetIndex(). Pointers to the first */
+/*             index of each list are put in lst, and the lists are merged   */
+/*             in NextDetCandidate(). Returns the number of lists.           */
+/*                                                                           */
+/*           - Cells are taken from the same level data as in DetBin(). If   */
+/*             the material or a cell is not indexed, or the number of lists */
+/*             exceeds the maximum, the list of all detectors is used.       */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "DetCandidates:"
+
+/*****************************************************************************/
+
+long DetCandidates(long type, long mat, long *lst, long id)
+{
+  long ptr, lvl0, lvl, cell, n;
+
+  /* Check index */
+
+  if ((long)RDB[DATA_PTR_DET_TAB] < VALID_PTR)
+    return 0;
+
+  /* Check particle type */
+
+  if ((type < 0) || (type > PARTICLE_TYPE_ALPHA))
+    Die(FUNCTION_NAME, "Invalid particle type %ld", type);
+
+  /* Reset count */
+
+  n = 0;
+
+  /* Detectors without material and cell bins */
+
+  ptr = (long)RDB[DATA_PTR_DET_CAND_TYPE];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  ptr = (long)RDB[ptr + type];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  if ((long)RDB[ptr] > -1)
+    lst[n++] = ptr;
+
+  /* Detectors with material bins */
+
+  if (mat > VALID_PTR)
+    {
+      /* Check if material is indexed */
+
+      if ((ptr = (long)RDB[mat + MATERIAL_PTR_DET_CAND]) < VALID_PTR)
+        {
+          /* Use all detectors */
+
+          lst[0] = (long)RDB[DATA_PTR_DET_CAND_ALL];
+          return 1;
+        }
+      else if ((long)RDB[ptr] > -1)
+        lst[n++] = ptr;
+    }
+
+  /* Detectors with cell bins, loop over levels */
+
+  lvl0 = (long)RDB[DATA_PTR_LVL0];
+  while (lvl0 > VALID_PTR)
+    {
+      /* Pointer to private data */
+
+      lvl = (long)RDB[lvl0 + LVL_PTR_PRIVATE_DATA];
+      CheckPointer(FUNCTION_NAME, "(lvl)", PRIVA_ARRAY, lvl);
+
+      /* Pointer to cell */
+
+      if ((cell = (long)GetPrivateData(lvl + LVL_PRIV_PTR_CELL, id))
+          > VALID_PTR)
+        {
+          /* Check if cell is indexed and number of lists */
+
+          if (((ptr = (long)RDB[cell + CELL_PTR_DET_CAND]) < VALID_PTR) ||
+              (n == MAX_DET_CAND_LISTS))
+            {
+              /* Use all detectors */
+
+              lst[0] = (long)RDB[DATA_PTR_DET_CAND_ALL];
+              return 1;
+            }
+          else if ((long)RDB[ptr] > -1)
+            lst[n++] = ptr;
+        }
+
+      /* Check if last */
+
+      if (GetPrivateData(lvl + LVL_PRIV_LAST, id) == YES)
+        break;
+
+      /* Next level */
+
+      lvl0 = NextItem(lvl0);
+    }
+
+  /* Return number of lists */
+
+  return n;
+}
+
+/*****************************************************************************/
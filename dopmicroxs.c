@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : dopmicroxs.c                                   */
 /*                                                                           */
 /* Created:       2011/09/06 (JLe)                                           */
-/* Last modified: 2019/12/18 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Returns temperature-corrected microscopic cross section      */
@@ -40,7 +40,7 @@ double DopMicroXS(long mat, long rea, double E, double *Er, double T, long id)
   long nuc, ptr, loc0, ncol;
   double awr, xs, kT, g;
   double ycn, r1, z, z2, rnd1, rnd2, s,c, ar,x2;
-  double T0, dT;
+  double T0, dT, nxs[NUC_XS_N];
 
   /* Check pointers */
 
@@ -119,6 +119,15 @@ double DopMicroXS(long mat, long rea, double E, double *Er, double T, long id)
         GetText(mat + MATERIAL_PTR_NAME), GetText(nuc + NUCLIDE_PTR_NAME),
         T, RDB[nuc + NUCLIDE_TMS_MAX_TEMP]);
 
+  /* Exact cross section from windowed multipole data (no sampling of */
+  /* target velocity) */
+
+  if ((xs = MultipoleMicroXS(rea, E, T, id)) > -1.0)
+    {
+      *Er = E;
+      return xs;
+    }
+
   /* Adjust lower boundary */
 
   kT = T - RDB[nuc + NUCLIDE_TMS_MIN_TEMP];
@@ -262,9 +271,22 @@ double DopMicroXS(long mat, long rea, double E, double *Er, double T, long id)
 
   }
 
-  /* Noudetaan suht. nopeutta vastaava mikroskooppinen vaikutusala */
+  /* Noudetaan suht. nopeutta vastaava mikroskooppinen vaikutusala   */
+  /* (elastic and fission cross sections are needed at the same      */
+  /* relative energy for scoring, interpolate all in a single pass)  */
 
-  xs = MicroXS(rea, *Er, id);
+  if (rea == (long)RDB[nuc + NUCLIDE_PTR_ELAXS])
+    {
+      NuclideMicroXS(nuc, *Er, nxs, id);
+      xs = nxs[NUC_XS_ELA];
+    }
+  else if (rea == (long)RDB[nuc + NUCLIDE_PTR_FISSXS])
+    {
+      NuclideMicroXS(nuc, *Er, nxs, id);
+      xs = nxs[NUC_XS_FISS];
+    }
+  else
+    xs = MicroXS(rea, *Er, id);
 
   /* Tehdään nyt PotCorr -korjaus jo tässä vaiheessa (TVi 2015-04-15)       */
   /* Monimutkaistaa asioita reaktiosämpläysvaiheessa, mutta yksinkertaistaa */
@@ -0,0 +1,89 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : dtregionmajorant.c                             */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Returns regional delta-tracking majorant at given position   */
+/*                                                                           */
+/* Comments: - Global majorant maj (from DTMajorant()) is returned if        */
+/*             regional majorants are not in use, the point is outside the   */
+/*             region mesh or majorant has failed in the region.             */
+/*                                                                           */
+/*           - Regional majorants are group-wise maxima of the base          */
+/*             majorant cross section. The difference between maj and the   */
+/*             base majorant (alpha and extra cross sections) is added to    */
+/*             the regional value, and the result is never above maj.        */
+/*                                                                           */
+/*           - Regions are described in preparedtregions.c.                  */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "DTRegionMajorant:"
+
+/*****************************************************************************/
+
+double DTRegionMajorant(long type, double maj, double E, double x, double y,
+                        double z, long id)
+{
+  long msh, idx, ng, g, ptr, rea;
+  double xs, f;
+
+  /* Check mesh and particle type */
+
+  if (((msh = (long)RDB[DATA_DT_REG_PTR_MESH]) < VALID_PTR) ||
+      (type != PARTICLE_TYPE_NEUTRON))
+    return maj;
+
+  /* Get region index */
+
+  if ((idx = MeshIndex(msh, x, y, z, -1.0)) < 0)
+    return maj;
+
+  /* Check failure flag */
+
+  ptr = (long)RDB[DATA_DT_REG_PTR_FAIL];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  if ((long)RDB[ptr + idx] == YES)
+    return maj;
+
+  /* Get group index */
+
+  ng = (long)RDB[DATA_DT_REG_NG];
+  g = (long)((log(E) - RDB[DATA_DT_REG_LOG_EMIN])/RDB[DATA_DT_REG_LOG_DE]);
+
+  if (g < 0)
+    g = 0;
+  else if (g > ng - 1)
+    g = ng - 1;
+
+  /* Get regional value */
+
+  ptr = (long)RDB[DATA_DT_REG_PTR_MAJ];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  xs = RDB[ptr + idx*ng + g];
+
+  /* Add difference between global and base majorant */
+
+  rea = (long)RDB[DATA_PTR_MAJORANT];
+  CheckPointer(FUNCTION_NAME, "(rea)", DATA_ARRAY, rea);
+
+  if ((f = maj - MajorantXS(rea, E, id)) > 0.0)
+    xs = xs + f;
+
+  /* Compare to global */
+
+  if (xs < maj)
+    return xs;
+  else
+    return maj;
+}
+
+/*****************************************************************************/
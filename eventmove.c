@@ -0,0 +1,303 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : eventmove.c                                    */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Move and interaction event for particle in event-based       */
+/*              transport bank                                               */
+/*                                                                           */
+/* Comments: - Same as the rest of the tracking loop in tracking.c. The      */
+/*             particle is moved using the tracking mode selected in EventXS */
+/*             and the collision, surface crossing, etc. at the end of the   */
+/*             track is handled. Collisions and boundary crossings are not   */
+/*             separated into events of their own because they use the       */
+/*             geometry data set in the move.                                */
+/*                                                                           */
+/*           - The move, collisions, surface crossings and end of history    */
+/*             are handled by TrackingMove(), TrackingCollision(),           */
+/*             TrackingSurf() and TrackingEnd(), which are also used in      */
+/*             Tracking().                                                   */
+/*                                                                           */
+/*           - If the particle is terminated, the next particle of the       */
+/*             source history is started from the que. Returns NO when the   */
+/*             source history is completed.                                  */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "EventMove:"
+
+/*****************************************************************************/
+
+long EventMove(EventSlot *s, long id)
+{
+  long part, type, cell, mat, trk, ptr, term;
+  double x, y, z, u, v, w, E, wgt, l, majorant, minxs, totxs, xs;
+  double spd, t, x0, y0, z0, xt, yt, zt, dxc, dyc, dzc;
+
+  /* Check status */
+
+  if (s->stat != EVENT_SLOT_MOVE)
+    Die(FUNCTION_NAME, "Invalid slot status %ld", s->stat);
+
+  /* Move secondaries to thread que */
+
+  EventQue(s->que, EVENT_QUE_GET, id);
+
+  /* Load private data */
+
+  EventState(s, EVENT_STATE_LOAD, id);
+
+  /* Put collision counter */
+
+  ptr = (long)RDB[DATA_PTR_COLLISION_COUNT];
+  PutPrivateData(ptr, (double)s->ncol, id);
+
+  /* Set cell search list option */
+
+  ptr = (long)RDB[DATA_CELL_SEARCH_LIST];
+  CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
+  PutPrivateData(ptr, (double)CELL_SEARCH_LIST_CELL, id);
+
+  /* Get particle variables */
+
+  part = s->part;
+  type = s->type;
+  mat = s->mat;
+
+  x = s->x;
+  y = s->y;
+  z = s->z;
+  u = s->u;
+  v = s->v;
+  w = s->w;
+  E = s->E;
+  wgt = s->wgt;
+  t = s->t;
+
+  x0 = s->x0;
+  y0 = s->y0;
+  z0 = s->z0;
+  xt = s->xt;
+  yt = s->yt;
+  zt = s->zt;
+  dxc = s->dxc;
+  dyc = s->dyc;
+  dzc = s->dzc;
+
+  spd = s->spd;
+  minxs = s->minxs;
+  totxs = s->totxs;
+  majorant = s->majorant;
+
+  /* Avoid compiler warning */
+
+  trk = -1;
+  cell = -1;
+  xs = -1.0;
+  l = 0.0;
+
+  /* Reset termination flag */
+
+  term = NO;
+
+  /* Single pass of the tracking loop (break ends the pass, termination */
+  /* flag tells if the particle history is completed) */
+
+  do
+    {
+      /* Move particle forward */
+
+      trk = TrackingMove(part, s->mode, type, majorant, totxs, minxs, spd, E,
+                         wgt, &cell, &xs, &x, &y, &z, &xt, &yt, &zt, &l, &u,
+                         &v, &w, &t, id);
+
+      /* This may happen in STL mode (DT is forced for next track). */
+
+      if ((s->mode == TRACK_MODE_ST) && (l == 0.0))
+        break;
+
+      /* Check domain decomposition */
+
+      if (trk == TRACK_END_DD)
+        Die(FUNCTION_NAME, "Domain decomposition in event-based mode");
+
+      /* Check if root universe is associated with symmetry */
+
+      ptr = (long)RDB[DATA_PTR_U0];
+      if ((ptr = (long)RDB[ptr + UNIVERSE_PTR_SYM]) > VALID_PTR)
+        if ((long)RDB[ptr + SYMMETRY_COORD_TRANS] == YES)
+          {
+            /* Apply symmetry */
+
+            UniSym(ptr, &x, &y, &z, &u, &v, &w);
+
+            /* Find cell */
+
+            cell = WhereAmI(x, y, z, u, v, w, id);
+            CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
+          }
+
+      /* Check cell pointer */
+
+      if (cell < VALID_PTR)
+        Die(FUNCTION_NAME, "Particle lost");
+
+      /* Get material pointer */
+
+      mat = (long)RDB[cell + CELL_PTR_MAT];
+      mat = MatPtr(mat, id);
+
+      /* Check track type */
+
+      if (trk == TRACK_END_VIRT)
+        {
+          /*******************************************************************/
+
+          /***** Virtual collision *******************************************/
+
+          trk = TrackingCollision(trk, part, mat, type, xs, majorant, spd, x,
+                                  y, z, &u, &v, &w, &E, &wgt, t, &x0, &y0,
+                                  &z0, xt, yt, zt, &dxc, &dyc, &dzc, id);
+
+          /*******************************************************************/
+        }
+      else if (trk == TRACK_END_COLL)
+        {
+          /*******************************************************************/
+
+          /***** Physical collision ******************************************/
+
+          trk = TrackingCollision(trk, part, mat, type, xs, majorant, spd, x,
+                                  y, z, &u, &v, &w, &E, &wgt, t, &x0, &y0,
+                                  &z0, xt, yt, zt, &dxc, &dyc, &dzc, id);
+
+          /* Check termination or reset infinite loop counter */
+
+          if ((trk == TRACK_END_CAPT) || (trk == TRACK_END_FISS) ||
+              (trk == TRACK_END_ECUT) || (trk == TRACK_END_WCUT))
+            {
+              term = YES;
+              break;
+            }
+          else if (trk == TRACK_END_SCAT)
+            s->loop = 0;
+
+          /*******************************************************************/
+        }
+      else
+        {
+          /*******************************************************************/
+
+          /***** Surface crossing and other track ends ***********************/
+
+          trk = TrackingSurf(trk, part, type, &cell, &mat, &x, &y, &z, &u, &v,
+                             &w, E, &wgt, t, &x0, &y0, &z0, &xt, &yt, &zt, id);
+
+          /* Check termination */
+
+          if ((trk == TRACK_END_LEAK) || (trk == TRACK_END_TCUT) ||
+              (trk == TRACK_END_WCUT))
+            {
+              term = YES;
+              break;
+            }
+
+          /*******************************************************************/
+        }
+
+      /* Check domain */
+
+      if (CheckDDDomain(mat) == NO)
+        Die(FUNCTION_NAME, "Domain decomposition in event-based mode");
+
+      /* Check track type */
+
+      if (trk == TRACK_END_VIRT)
+        {
+          /* Score total collision efficency */
+
+          ptr = (long)RDB[RES_TOT_COL_EFF];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+          AddBuf1D(1.0, 1.0, ptr, id, 4 - type);
+        }
+      else if ((trk != TRACK_END_SCAT) && (trk != TRACK_END_SURF) &&
+               (trk != TRACK_END_WWIN) && (trk != TRACK_END_FLAG))
+        Die(FUNCTION_NAME, "Loop not terminated by track type %ld", trk);
+    }
+  while (1 == 2);
+
+  /* Put particle variables */
+
+  s->cell = cell;
+  s->mat = mat;
+  s->trk = trk;
+
+  s->x = x;
+  s->y = y;
+  s->z = z;
+  s->u = u;
+  s->v = v;
+  s->w = w;
+  s->E = E;
+  s->wgt = wgt;
+  s->t = t;
+
+  s->x0 = x0;
+  s->y0 = y0;
+  s->z0 = z0;
+  s->xt = xt;
+  s->yt = yt;
+  s->zt = zt;
+  s->dxc = dxc;
+  s->dyc = dyc;
+  s->dzc = dzc;
+
+  /* Update loop counter and check infinite loop */
+
+  if (term == NO)
+    if (++s->loop < s->lmax)
+      {
+        /* Next event is cross section calculation */
+
+        s->stat = EVENT_SLOT_XS;
+
+        /* Save private data and secondaries */
+
+        EventState(s, EVENT_STATE_SAVE, id);
+        EventQue(s->que, EVENT_QUE_PUT, id);
+
+        /* Exit */
+
+        return YES;
+      }
+
+  /* Particle history terminated */
+
+  TrackingEnd(part, mat, type, trk, s->loop, s->lmax, x, y, z, u, v, w, E,
+              wgt, t, id);
+
+  /* Start next particle of source history */
+
+  if (EventStart(s, id) == NO)
+    s->stat = EVENT_SLOT_FREE;
+
+  /* Save private data and secondaries */
+
+  EventState(s, EVENT_STATE_SAVE, id);
+  EventQue(s->que, EVENT_QUE_PUT, id);
+
+  /* Exit */
+
+  if (s->stat == EVENT_SLOT_FREE)
+    return NO;
+  else
+    return YES;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,68 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : eventque.c                                     */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Moves particles between thread que and the que of a source  */
+/*              history in event-based transport mode                        */
+/*                                                                           */
+/* Comments: - Each source history in the bank has a separate que for its    */
+/*             secondaries. The particles are moved to the thread que        */
+/*             before the history is advanced, so that ToQue() and FromQue() */
+/*             work as in the history-based mode, and back when done.        */
+/*                                                                           */
+/*           - Order of particles is preserved.                              */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "EventQue:"
+
+/*****************************************************************************/
+
+void EventQue(long que, long mode, long id)
+{
+  long src, dst, ptr;
+
+  /* Avoid compiler warning */
+
+  src = -1;
+  dst = -1;
+
+  /* Check mode and get list roots */
+
+  if (mode == EVENT_QUE_GET)
+    {
+      src = que;
+      dst = OMPPtr(DATA_PART_PTR_QUE, id);
+    }
+  else if (mode == EVENT_QUE_PUT)
+    {
+      src = OMPPtr(DATA_PART_PTR_QUE, id);
+      dst = que;
+    }
+  else
+    Die(FUNCTION_NAME, "Invalid mode %ld", mode);
+
+  /* Pointer to dummy in the beginning of source list */
+
+  ptr = (long)RDB[src];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  /* Loop over particles */
+
+  while ((ptr = NextItem((long)RDB[src])) > VALID_PTR)
+    {
+      /* Move particle */
+
+      RemoveItem(ptr);
+      AddItem(dst, ptr);
+    }
+}
+
+/*****************************************************************************/
@@ -0,0 +1,280 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : eventstart.c                                   */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Starts next particle of source history in event-based        */
+/*              transport bank                                               */
+/*                                                                           */
+/* Comments: - Same as the start of history in tracking.c. Returns YES if a  */
+/*             particle was started and NO if the que is empty, in which     */
+/*             case the source history is completed and the prompt chain     */
+/*             length is scored.                                             */
+/*                                                                           */
+/*           - The que of the source history must be moved to the thread que */
+/*             and history-dependent private data loaded by the calling      */
+/*             routine.                                                      */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "EventStart:"
+
+/*****************************************************************************/
+
+long EventStart(EventSlot *s, long id)
+{
+  long part, type, ptr, cell, mat, n;
+
+  /* Loop until particle is found or que is empty */
+
+  while (1 != 2)
+    {
+      /* Get next particle from que */
+
+      part = FromQue(id);
+
+      /* Check if que is empty */
+
+      if (part < VALID_PTR)
+        break;
+
+      /* Reset OpenMP completed flag */
+
+      OMPResetComp(id);
+
+      /* Get particle type */
+
+      type = (long)RDB[part + PARTICLE_TYPE];
+
+      /* Check multiplicity */
+
+      if ((long)RDB[part + PARTICLE_MULTIPLICITY] > 0)
+        Die(FUNCTION_NAME, "Multiplicity");
+
+      /* Check that MPI index is match */
+
+      if ((long)RDB[part + PARTICLE_MPI_ID] != mpiid)
+        {
+          /* Check reproducibility */
+
+          if ((long)RDB[DATA_OPTI_MPI_REPRODUCIBILITY] == NO)
+            Die(FUNCTION_NAME, "Error in mpi mode");
+
+          /* Put particle back in stack */
+
+          ToStack(part, id);
+
+          /* Cycle loop */
+
+          continue;
+        }
+
+      /* Check generation cut-off */
+
+      if ((long)RDB[part + PARTICLE_GEN_IDX] >= (long)RDB[DATA_GEN_CUT])
+        {
+          /* Score cut-off */
+
+          ptr = (long)RDB[RES_TOT_NEUTRON_CUTRATE];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+          AddBuf1D(1.0, RDB[part + PARTICLE_WGT], ptr, id, 0);
+
+          /* Particle balance */
+
+          if (type == PARTICLE_TYPE_NEUTRON)
+            {
+              ptr = (long)RDB[RES_N_BALA_LOSS];
+              CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+              AddBuf(1.0, 1.0, ptr, id, -1, BALA_N_LOSS_CUT, 0);
+              AddBuf(RDB[part + PARTICLE_WGT], 1.0, ptr, id, -1,
+                     BALA_N_LOSS_CUT, 1);
+            }
+          else
+            Die(FUNCTION_NAME, "Invalid particle type");
+
+          /* Put particle back in stack */
+
+          ToStack(part, id);
+
+          /* Cycle loop */
+
+          continue;
+        }
+
+      /* Particle found, break loop */
+
+      break;
+    }
+
+  /***************************************************************************/
+
+  /***** Source history completed ********************************************/
+
+  if (part < VALID_PTR)
+    {
+      /* Add to mean prompt chain length */
+
+      if (s->gmax > 0)
+        {
+          ptr = (long)RDB[RES_PROMPT_CHAIN_LENGTH];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+          AddBuf1D((double)s->gmax, 1.0, ptr, id, 0);
+        }
+
+      /* Check maximum generation */
+
+      if (s->gmax > (long)RDB[DATA_MAX_PROMPT_CHAIN_LENGTH])
+        s->gmax = (long)RDB[DATA_MAX_PROMPT_CHAIN_LENGTH];
+
+      /* Add to prompt generation fractions and time */
+
+      if ((ptr = (long)RDB[RES_PROMPT_GEN_CUMU]) > VALID_PTR)
+        for (n = 0; n < s->gmax + 1; n++)
+          AddBuf1D(1.0, 1.0, ptr, id, n);
+
+      if ((ptr = (long)RDB[RES_PROMPT_GEN_TIMES]) > VALID_PTR)
+        AddBuf1D(s->t, 1.0, ptr, id, s->gmax);
+
+      /* Exit */
+
+      return NO;
+    }
+
+  /***************************************************************************/
+
+  /***** Start particle ******************************************************/
+
+  /* Check generation index */
+
+  if ((long)RDB[part + PARTICLE_GEN_IDX] > s->gmax)
+    s->gmax = (long)RDB[part + PARTICLE_GEN_IDX];
+
+  /* Add to population */
+
+  if ((ptr = (long)RDB[RES_PROMPT_GEN_POP]) > VALID_PTR)
+    AddBuf1D(1.0, 1.0, ptr, id, (long)RDB[part + PARTICLE_GEN_IDX]);
+
+  /* Put particle pointer and type */
+
+  s->part = part;
+  s->type = type;
+
+  /* Get spatial coordinates */
+
+  s->x = RDB[part + PARTICLE_X];
+  s->y = RDB[part + PARTICLE_Y];
+  s->z = RDB[part + PARTICLE_Z];
+
+  /* Set initial coordinates for surface based tallies */
+
+  s->x0 = s->x;
+  s->y0 = s->y;
+  s->z0 = s->z;
+
+  /* Set source and previous collision coordinates (used for CMM) */
+
+  s->xt = s->x;
+  s->yt = s->y;
+  s->zt = s->z;
+
+  s->dxc = 0.0;
+  s->dyc = 0.0;
+  s->dzc = 0.0;
+
+  /* Get direction cosines */
+
+  s->u = RDB[part + PARTICLE_U];
+  s->v = RDB[part + PARTICLE_V];
+  s->w = RDB[part + PARTICLE_W];
+
+  /* Get energy, weight and time */
+
+  s->E = RDB[part + PARTICLE_E];
+  s->wgt = RDB[part + PARTICLE_WGT];
+  s->t = RDB[part + PARTICLE_T];
+
+  /* Remember initial time */
+
+  s->t0 = s->t;
+
+  /* Store initial time to be used in coordtrans */
+
+  ptr = (long)RDB[DATA_PTR_PARTICLE_INITIAL_TIME];
+  PutPrivateData(ptr, s->t0, id);
+
+  /* Check with cut-off */
+
+  if ((s->t0 < RDB[DATA_TIME_CUT_TMIN]) ||
+      (s->t0 >= RDB[DATA_TIME_CUT_TMAX]))
+    Die(FUNCTION_NAME, "Error in time (%1.2E : %1.2E %1.2E)",
+        s->t0, RDB[DATA_TIME_CUT_TMIN], RDB[DATA_TIME_CUT_TMAX]);
+
+  /* Check if root universe is associated with symmetry */
+
+  ptr = (long)RDB[DATA_PTR_U0];
+  if ((ptr = (long)RDB[ptr + UNIVERSE_PTR_SYM]) > VALID_PTR)
+    if ((long)RDB[ptr + SYMMETRY_COORD_TRANS] == YES)
+      UniSym(ptr, &s->x, &s->y, &s->z, &s->u, &s->v, &s->w);
+
+  /* Set cell search list option */
+
+  ptr = (long)RDB[DATA_CELL_SEARCH_LIST];
+  CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
+  PutPrivateData(ptr, (double)CELL_SEARCH_LIST_UNI, id);
+
+  /* Find initial position */
+
+  cell = WhereAmI(s->x, s->y, s->z, s->u, s->v, s->w, id);
+  CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
+
+  /* Get material pointer */
+
+  mat = (long)RDB[cell + CELL_PTR_MAT];
+  mat = MatPtr(mat, id);
+
+  /* Put pointers */
+
+  s->cell = cell;
+  s->mat = mat;
+
+  /* Store starting point in history array */
+
+  StoreHistoryPoint(part, mat, -1, s->x, s->y, s->z, s->u, s->v, s->w, s->E,
+                    s->t, s->wgt, -1.0, TRACK_END_STRT, id);
+
+  /* Get maximum number of loops */
+
+  if (type == PARTICLE_TYPE_NEUTRON)
+    s->lmax = (long)RDB[DATA_NEUTRON_MAX_TRACK_LOOP];
+  else if (type == PARTICLE_TYPE_GAMMA)
+    s->lmax = (long)RDB[DATA_PHOTON_MAX_TRACK_LOOP];
+  else
+    Die(FUNCTION_NAME, "Invalid particle type");
+
+  /* Check value */
+
+  CheckValue(FUNCTION_NAME, "lmax", "", s->lmax, 1, 100000000000);
+
+  /* Reset loop counter and track type */
+
+  s->loop = 0;
+  s->trk = -1;
+
+  /* Next event is cross section calculation */
+
+  s->stat = EVENT_SLOT_XS;
+
+  /***************************************************************************/
+
+  /* Exit */
+
+  return YES;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,77 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : eventstate.c                                   */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Loads or saves history-dependent thread-private data for     */
+/*              particle in event-based transport bank                       */
+/*                                                                           */
+/* Comments: - Random number seed, initial time and the tracking mode flags  */
+/*             set in geometry routines are carried with the particle, so    */
+/*             that each history sees the same random number sequence as in  */
+/*             the history-based mode.                                       */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "EventState:"
+
+/*****************************************************************************/
+
+void EventState(EventSlot *s, long mode, long id)
+{
+  long ptr;
+
+  /* Check mode */
+
+  if (mode == EVENT_STATE_LOAD)
+    {
+      /* Random number seed */
+
+      SEED[id*RNG_SZ] = s->seed;
+
+      /* Initial time for coordtrans */
+
+      ptr = (long)RDB[DATA_PTR_PARTICLE_INITIAL_TIME];
+      PutPrivateData(ptr, s->t0, id);
+
+      /* Enforced delta-tracking flag */
+
+      ptr = (long)RDB[DATA_DT_ENFORCE_NEXT_TRACK];
+      CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
+      PutPrivateData(ptr, (double)s->dtf, id);
+
+      /* STL mode flag */
+
+      ptr = (long)RDB[DATA_ST_USE_STL_MODE];
+      CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
+      PutPrivateData(ptr, (double)s->stlf, id);
+    }
+  else if (mode == EVENT_STATE_SAVE)
+    {
+      /* Random number seed */
+
+      s->seed = SEED[id*RNG_SZ];
+
+      /* Enforced delta-tracking flag */
+
+      ptr = (long)RDB[DATA_DT_ENFORCE_NEXT_TRACK];
+      CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
+      s->dtf = (long)GetPrivateData(ptr, id);
+
+      /* STL mode flag */
+
+      ptr = (long)RDB[DATA_ST_USE_STL_MODE];
+      CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
+      s->stlf = (long)GetPrivateData(ptr, id);
+    }
+  else
+    Die(FUNCTION_NAME, "Invalid mode %ld", mode);
+}
+
+/*****************************************************************************/
@@ -0,0 +1,65 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : eventxs.c                                      */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Cross section event for particle in event-based transport    */
+/*              bank                                                         */
+/*                                                                           */
+/* Comments: - Cross sections and tracking mode are handled by TrackingXS(), */
+/*             which is also used in Tracking().                             */
+/*                                                                           */
+/*           - The collision counter is incremented from the thread-wise     */
+/*             value and stored in the slot, so that the counter values used */
+/*             as keys for private data are never shared between particles.  */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "EventXS:"
+
+/*****************************************************************************/
+
+void EventXS(EventSlot *s, long id)
+{
+  long ptr;
+
+  /* Check status */
+
+  if (s->stat != EVENT_SLOT_XS)
+    Die(FUNCTION_NAME, "Invalid slot status %ld", s->stat);
+
+  /* Load private data */
+
+  EventState(s, EVENT_STATE_LOAD, id);
+
+  /* Check that particle is in correct domain */
+
+  if (CheckDDDomain(s->mat) == NO)
+    Die(FUNCTION_NAME, "Mismatch in domain");
+
+  /* Get cross sections and tracking mode */
+
+  s->mode = TrackingXS(s->part, s->mat, s->type, s->E, s->x, s->y, s->z,
+                       &s->spd, &s->minxs, &s->totxs, &s->majorant, id);
+
+  /* Remember collision counter value */
+
+  ptr = (long)RDB[DATA_PTR_COLLISION_COUNT];
+  s->ncol = (long)GetPrivateData(ptr, id);
+
+  /* Save private data */
+
+  EventState(s, EVENT_STATE_SAVE, id);
+
+  /* Next event is move */
+
+  s->stat = EVENT_SLOT_MOVE;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,111 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : faddeeva.c                                     */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Faddeeva function for windowed multipole Doppler broadening  */
+/*                                                                           */
+/* Comments: - Weideman's rational approximation (SIAM J. Numer. Anal. 31    */
+/*             (1994) 1497) with N = 32 terms. The coefficients are computed */
+/*             with L = sqrt(N/sqrt(2)) and the relative error is below      */
+/*             1E-12 in the upper half-plane.                                */
+/*                                                                           */
+/*           - Lower half-plane is handled with -conj(w(conj(z))) instead of */
+/*             the analytic continuation, as required for the broadening of  */
+/*             poles with negative imaginary part (same convention as in     */
+/*             the multipole data of OpenMC).                                */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "Faddeeva:"
+
+#define FADDEEVA_N 32
+#define FADDEEVA_L 4.7568284600108841
+
+/* Expansion coefficients */
+
+static const double a[FADDEEVA_N] = {
+  2.5722534081245700E+00,  2.2635372999002690E+00,  1.8256696296324813E+00,
+  1.3455441692345449E+00,  9.0192548936479988E-01,  5.4601397206393432E-01,
+  2.9544451071508715E-01,  1.4060716226893771E-01,  5.7304403529837220E-02,
+  1.9006155784845536E-02,  4.5195411053493405E-03,  3.9259136070063941E-04,
+  -2.4532980270017642E-04, -1.3075449254618495E-04, -2.1409619201657810E-05,
+  6.8210319440203333E-06,  4.4015317314119944E-06,  4.2558331378453830E-07,
+  -4.1840763695623985E-07, -1.4813078903939285E-07,  2.2930439058641565E-08,
+  2.3797556918171519E-08,  8.1248914306772684E-10, -3.2080153655251966E-09,
+  -5.2310198915896738E-10,  4.1537454269237978E-10,  1.1658251291940913E-10,
+  -5.5442430194491454E-11, -2.1543485542226933E-11,  8.0305138655855736E-12,
+  3.7408217613093878E-12, -1.3034837519469384E-12};
+
+/*****************************************************************************/
+
+complex Faddeeva(complex z)
+{
+  long n, neg;
+  double d, re, im;
+  complex q, Z, p, w;
+
+  /* Check lower half-plane */
+
+  if (z.im < 0.0)
+    {
+      z.im = -z.im;
+      neg = YES;
+    }
+  else
+    neg = NO;
+
+  /* Calculate 1/(L - iz) */
+
+  re = FADDEEVA_L + z.im;
+  im = -z.re;
+  d = re*re + im*im;
+
+  q.re = re/d;
+  q.im = -im/d;
+
+  /* Mapped variable Z = (L + iz)/(L - iz) */
+
+  re = FADDEEVA_L - z.im;
+  im = z.re;
+
+  Z.re = re*q.re - im*q.im;
+  Z.im = re*q.im + im*q.re;
+
+  /* Evaluate polynomial (Horner) */
+
+  p.re = a[FADDEEVA_N - 1];
+  p.im = 0.0;
+
+  for (n = FADDEEVA_N - 2; n > -1; n--)
+    {
+      re = p.re*Z.re - p.im*Z.im + a[n];
+      p.im = p.re*Z.im + p.im*Z.re;
+      p.re = re;
+    }
+
+  /* w = 2p/(L - iz)^2 + 1/(sqrt(pi)(L - iz)) */
+
+  re = q.re*q.re - q.im*q.im;
+  im = 2.0*q.re*q.im;
+
+  w.re = 2.0*(p.re*re - p.im*im) + q.re/SQRTPI;
+  w.im = 2.0*(p.re*im + p.im*re) + q.im/SQRTPI;
+
+  /* Lower half-plane */
+
+  if (neg == YES)
+    w.re = -w.re;
+
+  /* Return value */
+
+  return w;
+}
+
+/*****************************************************************************/
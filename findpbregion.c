@@ -3,12 +3,12 @@
 /* serpent 2 (beta-version) : findpbregion.c                                 */
 /*                                                                           */
 /* Created:       2010/10/23 (JLe)                                           */
-/* Last modified: 2016/10/03 (JLe)                                           */
-/* Version:       2.1.28                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Finds neutron location in explicit stochastic geometry       */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - Search uses the packed grid created in PackPBGrid().          */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -22,8 +22,9 @@
 long FindPBRegion(long uni0, long pbd, double *x, double *y, double *z, 
                   long *pbl0, long *ridx, long id)
 {
-  long ptr, lst, pbl, uni, ncol, msh;
+  long ptr, pbl, uni, ncol, grd, nx, ny, nz, i, j, k, n, n0, n1, m;
   double rp, dx, dy, dz;
+  const double *X, *Y, *Z, *R2;
 
   /* Check pointers */
 
@@ -94,42 +95,75 @@ long FindPBRegion(long uni0, long pbd, double *x, double *y, double *z,
 
   *pbl0 = -1;
 
-  /* Pointer to search mesh */
+  /* Pointer to packed search grid */
 
-  msh = (long)RDB[pbd + PBED_PTR_SEARCH_MESH];
-  CheckPointer(FUNCTION_NAME, "(msh)", DATA_ARRAY, msh);
+  grd = (long)RDB[pbd + PBED_PTR_GRID];
+  CheckPointer(FUNCTION_NAME, "(grd)", DATA_ARRAY, grd);
 
-  /* Get pointer to search mesh */
-  
-  if ((lst = MeshPtr(msh, *x, *y, *z)) > VALID_PTR)
-    lst = (long)RDB[lst];
-  
-  /* Loop over content */
+  /* Get grid indexes */
+
+  i = (long)floor((*x - RDB[grd + PBGRID_MIN0])/RDB[grd + PBGRID_PITCH0]);
+  j = (long)floor((*y - RDB[grd + PBGRID_MIN1])/RDB[grd + PBGRID_PITCH1]);
+  k = (long)floor((*z - RDB[grd + PBGRID_MIN2])/RDB[grd + PBGRID_PITCH2]);
+
+  /* Get size */
+
+  nx = (long)RDB[grd + PBGRID_N0];
+  ny = (long)RDB[grd + PBGRID_N1];
+  nz = (long)RDB[grd + PBGRID_N2];
+
+  /* Check that point is in grid */
 
-  while (lst > VALID_PTR)
+  if ((i > -1) && (i < nx) && (j > -1) && (j < ny) && (k > -1) && (k < nz))
     {
-      /* Pointer to pebble */
-      
-      pbl = (long)RDB[lst + SEARCH_MESH_CELL_CONTENT];
-      CheckPointer(FUNCTION_NAME, "(pbl)", DATA_ARRAY, pbl);
+      /* Get index range */
 
-      /* Get parameters */
+      ptr = (long)RDB[grd + PBGRID_PTR_IDX] + i + nx*(j + ny*k);
+      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
 
-      dx = *x - RDB[pbl + PEBBLE_X0];
-      dy = *y - RDB[pbl + PEBBLE_Y0];
-      dz = *z - RDB[pbl + PEBBLE_Z0];
+      n0 = (long)RDB[ptr];
+      n1 = (long)RDB[ptr + 1];
 
-      rp = RDB[pbl + PEBBLE_RAD];
+      /* Pointers to data */
 
-      /* Check if particle is inside */
+      X = &RDB[(long)RDB[grd + PBGRID_PTR_X]];
+      Y = &RDB[(long)RDB[grd + PBGRID_PTR_Y]];
+      Z = &RDB[(long)RDB[grd + PBGRID_PTR_Z]];
+      R2 = &RDB[(long)RDB[grd + PBGRID_PTR_R2]];
 
-      if (dx*dx + dy*dy + dz*dz < rp*rp)
+      /* Loop over content (pebbles don't overlap, so the loop is done */
+      /* without exit to allow vectorization) */
+
+      m = -1;
+
+      for (n = n0; n < n1; n++)
         {
+          /* Get parameters */
+
+          dx = *x - X[n];
+          dy = *y - Y[n];
+          dz = *z - Z[n];
+
+          /* Check if particle is inside */
+
+          if (dx*dx + dy*dy + dz*dz < R2[n])
+            m = n;
+        }
+
+      /* Check if found */
+
+      if (m > -1)
+        {
+          /* Pointer to pebble */
+
+          pbl = (long)RDB[(long)RDB[grd + PBGRID_PTR_PBL] + m];
+          CheckPointer(FUNCTION_NAME, "(pbl)", DATA_ARRAY, pbl);
+
           /* Co-ordinate transformation */
 
-          *x = dx;
-          *y = dy;
-          *z = dz;
+          *x = *x - RDB[pbl + PEBBLE_X0];
+          *y = *y - RDB[pbl + PEBBLE_Y0];
+          *z = *z - RDB[pbl + PEBBLE_Z0];
 
           /* Get pointer to universe */
 
@@ -162,7 +196,7 @@ long FindPBRegion(long uni0, long pbd, double *x, double *y, double *z,
             {
               /* Pointer to counter */
               
-              ptr = (long)RDB[lst + SEARCH_MESH_PTR_CELL_COUNT];
+              ptr = (long)RDB[(long)RDB[grd + PBGRID_PTR_COUNT] + m];
               CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
               
               /* Add counter */
@@ -178,11 +212,7 @@ long FindPBRegion(long uni0, long pbd, double *x, double *y, double *z,
           /* Return universe pointer */
 
           return uni;
-             }
-      
-      /* Next */
-
-      lst = NextItem(lst);
+        }
     }
 
   /* Get pointer to background universe */
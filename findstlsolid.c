@@ -3,14 +3,17 @@
 /* serpent 2 (beta-version) : findstlsolid.c                                 */
 /*                                                                           */
 /* Created:       2014/03/05 (JLe)                                           */
-/* Last modified: 2018/11/15 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Finds STL solid located in position                          */
 /*                                                                           */
 /* Comments: - The direction vector defines the direction in which the       */
 /*             nearest boundary or known cell is searched.                   */
 /*                                                                           */
+/*           - Pre-assigned search mesh data is checked first, remaining     */
+/*             solids are found from the bounding volume hierarchy.          */
+/*                                                                           */
 /*****************************************************************************/
 
 #include "header.h"
@@ -26,7 +29,8 @@ void STLRayTestDir(long sld, long msh, double x, double y, double z,
 long FindSTLSolid(long stl, double x, double y, double z, 
                   double u, double v, double w, long pre, long id)
 {
-  long sld, msh, ptr, pts, lst, ok, i, mode;
+  long sld, msh, ptr, pts, lst, ok, i, mode, nod, loc0, n, sp;
+  long stk[2*STL_BVH_MAX_DEPTH + 4];
   
   /* Check pointer */
 
@@ -121,8 +125,7 @@ long FindSTLSolid(long stl, double x, double y, double z,
 
               /* Check solid */
               
-              if ((ok = STLRayTest(sld, msh, x, y, z, u, v, w, mode, id)) 
-                  == YES)
+              if ((ok = STLRayTest(sld, x, y, z, u, v, w, mode)) == YES)
                 return sld;
               else if (ok == NO)
                 break;
@@ -135,9 +138,9 @@ long FindSTLSolid(long stl, double x, double y, double z,
                   else
                     Die(FUNCTION_NAME, "Overlap in safe mode");
                 }
-              else if (ok <= STL_RAY_TEST_FAIL_PARA)
+              else if (ok == STL_RAY_TEST_FAIL_EDGE)
                 {
-                  /* Score failure */
+                  /* Score failure (ray hits facet edge) */
                   
                   AddBuf1D(1.0, 1.0, pts, id, -ok/1000);
 
@@ -180,126 +183,132 @@ long FindSTLSolid(long stl, double x, double y, double z,
   
   /***************************************************************************/
 
-  /***** Loop over all cells *************************************************/
+  /***** Loop over solids in bounding volume hierarchy ***********************/
 
-  /* Pointer to solid search mesh */
+  /* Pointers to nodes and solids */
 
-  ptr = (long)RDB[stl + STL_PTR_SOLID_MESH];
-  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, msh);
+  nod = (long)RDB[stl + STL_PTR_BVH];
+  CheckPointer(FUNCTION_NAME, "(nod)", DATA_ARRAY, nod);
 
-  /* Get pointer to search mesh cell */
+  loc0 = (long)RDB[stl + STL_PTR_BVH_SOLIDS];
+  CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
 
-  if ((lst = MeshPtr(ptr, x, y, z)) < VALID_PTR)
-    return NULLPTR;
+  /* Get mode */
+      
+  mode = (long)RDB[stl + STL_SEARCH_MODE];
+      
+  /* Pointer to fail statistics */
+      
+  pts = (long)RDB[RES_STL_RAY_TEST];
+  CheckPointer(FUNCTION_NAME, "(pts)", DATA_ARRAY, pts);
 
-  /* NOTE 13.11.2018: jos ei olla short-listillä, niin pitäisi olla */
-  /* ulkona. Testaa tämä ottamalla tuo testi käyttöön alempaa. */
+  /* Put root node to stack */
 
-  /*
-  if (pre == YES)
-    return NULLPTR;
-  */
+  stk[0] = 0;
+  sp = 1;
 
-  /* Loop over list */
+  /* Loop until stack is empty */
 
-  lst = (long)RDB[lst];
-  while (lst > VALID_PTR)
+  while (sp > 0)
     {
-      /* Pointer to solid */
-      
-      sld = (long)RDB[lst + SEARCH_MESH_CELL_CONTENT];
-      CheckPointer(FUNCTION_NAME, "(sld)", DATA_ARRAY, sld);
+      /* Pointer to node */
 
-      /* Get mode */
-      
-      mode = (long)RDB[stl + STL_SEARCH_MODE];
-      
-      /* Pointer to fail statistics */
-      
-      pts = (long)RDB[RES_STL_RAY_TEST];
-      CheckPointer(FUNCTION_NAME, "(pts)", DATA_ARRAY, pts);
+      ptr = nod + stk[--sp]*STL_BVH_BLOCK_SIZE;
 
-      /* Resampling loop */
-      
-      for (i = 0; i < 100; i++)
+      /* Check if point is inside */
+
+      if ((x < RDB[ptr + STL_BVH_XMIN]) || (x > RDB[ptr + STL_BVH_XMAX]) ||
+          (y < RDB[ptr + STL_BVH_YMIN]) || (y > RDB[ptr + STL_BVH_YMAX]) ||
+          (z < RDB[ptr + STL_BVH_ZMIN]) || (z > RDB[ptr + STL_BVH_ZMAX]))
+        continue;
+
+      /* Check inner node */
+
+      if ((n = (long)RDB[ptr + STL_BVH_CHILD]) > 0)
         {
-          /* Score total */
+          /* Check stack size */
 
-          AddBuf1D(1.0, 1.0, pts, id, 0);
+          if (sp > 2*STL_BVH_MAX_DEPTH + 1)
+            Die(FUNCTION_NAME, "Stack overflow");
 
-          /* Check solid */
-          
-          if ((ok = STLRayTest(sld, msh, x, y, z, u, v, w, mode, id)) == YES)
+          /* Put children to stack */
+
+          stk[sp++] = n + 1;
+          stk[sp++] = n;
+
+          /* Cycle loop */
+
+          continue;
+        }
+
+      /* Loop over solids in leaf */
+
+      for (n = (long)RDB[ptr + STL_BVH_FIRST];
+           n < (long)RDB[ptr + STL_BVH_FIRST] + (long)RDB[ptr + STL_BVH_N];
+           n++)
+        {
+          /* Pointer to solid */
+
+          sld = (long)RDB[loc0 + n];
+          CheckPointer(FUNCTION_NAME, "(sld)", DATA_ARRAY, sld);
+
+          /* Resampling loop */
+
+          for (i = 0; i < 100; i++)
             {
-              /* Check plotter mode */
+              /* Score total */
+
+              AddBuf1D(1.0, 1.0, pts, id, 0);
+
+              /* Check solid */
 
-              if ((long)RDB[DATA_PLOTTER_MODE] == NO)
+              if ((ok = STLRayTest(sld, x, y, z, u, v, w, mode)) == YES)
+                return sld;
+              else if (ok == NO)
+                break;
+              else if (ok == STL_FACET_OVERLAP)
                 {
-                  /* Pointer to counter */
-              
-                  ptr = (long)RDB[lst + SEARCH_MESH_PTR_CELL_COUNT];
-                  CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
-                  
-                  /* Add counter */
-                  
-                  AddPrivateData(ptr, 1, id);
+                  /* Print error */
+
+                  if (mode == STL_SEARCH_MODE_FAST)
+                    Error(stl, "Overlapping facets, try ray test mode 2");
+                  else
+                    Die(FUNCTION_NAME, "Overlap in safe mode");
                 }
-              /*
-              if (pre == YES)
-                Die(FUNCTION_NAME, "WTF?");
-              */
-              /* Return pointer */
+              else if (ok == STL_RAY_TEST_FAIL_EDGE)
+                {
+                  /* Score failure (ray hits facet edge) */
 
-              return sld;
-            }
-          else if (ok == NO)
-            break;
-          else if (ok == STL_FACET_OVERLAP)
-            {
-              /* Print error */
-              
-              if (mode == STL_SEARCH_MODE_FAST)
-                Error(stl, "Overlapping facets, try ray test mode 2");
+                  AddBuf1D(1.0, 1.0, pts, id, -ok/1000);
+
+                  /* Resample direction */
+
+                  IsotropicDirection(&u, &v, &w, id);
+                }
               else
-                Die(FUNCTION_NAME, "Overlap in safe mode");
+                Die(FUNCTION_NAME, "WTF?");
             }
-          else if (ok <= STL_RAY_TEST_FAIL_PARA)
+
+          /* Check for infinite loop */
+
+          if (i == 100)
             {
-              /* Score failure */
-              
-              AddBuf1D(1.0, 1.0, pts, id, -ok/1000);
+              /* Record error */
 
-              /* Resample direction */
-              
-              IsotropicDirection(&u, &v, &w, id);
-            }
-          else
-            Die(FUNCTION_NAME, "WTF?");
-        }
-      
-      /* Check for infinite loop */
-      
-      if (i == 100)
-        {
-          /* Record error */
-          
-          AddBuf1D(100.0, 1.0, pts, id, -STL_RAY_TEST_FAIL_STUCK/1000);
-          
-          /* Print warning */
-          
-          if ((long)RDB[DATA_STL_ENFORCE_DT] == NO)              
-            Note(stl, "Particle stuck on boundary, try enforcing DT");
-          else
-            Note(stl, "Particle stuck on boundary");
+              AddBuf1D(100.0, 1.0, pts, id, -STL_RAY_TEST_FAIL_STUCK/1000);
 
-          /* Put point outside */
-          
-          return NULLPTR;
-        }
-      
-      /* Next item in list */
+              /* Print warning */
+
+              if ((long)RDB[DATA_STL_ENFORCE_DT] == NO)
+                Note(stl, "Particle stuck on boundary, try enforcing DT");
+              else
+                Note(stl, "Particle stuck on boundary");
 
-      lst = NextItem(lst);
+              /* Put point outside */
+
+              return NULLPTR;
+            }
+        }
     }
 
   /***************************************************************************/
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : findtetcell.c                                  */
 /*                                                                           */
 /* Created:       2012/09/11 (JLe)                                           */
-/* Last modified: 2019/04/03 (VVa)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Finds tetrahedral mesh cell                                  */
 /*                                                                           */
@@ -13,6 +13,11 @@
 /*             moodissa tet-cellin pointteri, muulloin geometriacellin       */
 /*             pointteri.)                                                   */
 /*                                                                           */
+/*           - Fast mode walks through the mesh from the previous cell of    */
+/*             the same thread, or from the first cell in the search mesh    */
+/*             cell on a cold start, before testing all cells in the search  */
+/*             mesh cell.                                                    */
+/*                                                                           */
 /*****************************************************************************/
 
 #include "header.h"
@@ -27,22 +32,8 @@
 long FindTetCell(long ifc, double x, double y, double z, long id)
 {
 #ifdef FAST_MODE
-  long msh, lst, loc0, ptr, next, prev, i, pt0, pt1, pt2;
+  long msh, lst, loc0, loc1, ptr;
   double bb[6];
-  long *face[4];
-  long face1[3] = {0,2,1};
-  long face2[3] = {1,2,3};
-  long face3[3] = {0,3,2};
-  long face4[3] = {0,1,3};
-  long nc;
-  double dx, dy, dz, facex, facey, facez, r2, min;
-
-  /* Store point list for easy access (faceX are constant lists) */
-
-  face[0] = face1;
-  face[1] = face2;
-  face[2] = face3;
-  face[3] = face4;
 #else
   long tetlist, tet, ntet, i, prnt;
 #endif
@@ -55,139 +46,27 @@ long FindTetCell(long ifc, double x, double y, double z, long id)
 
   /***************************************************************************/
 
-  /***** Try previous cell ***************************************************/
+  /***** Walk from previous cell ********************************************/
 
-  /* Check previous cell */
+  /* Get previous cell */
 
   ptr = (long)RDB[ifc + IFC_PTR_PREV_CELL];
   CheckPointer(FUNCTION_NAME, "(ptr1)", PRIVA_ARRAY, ptr);
 
   if ((loc0 = (long)GetPrivateData(ptr, id)) > VALID_PTR)
     {
+      /* Walk from previous cell (returns previous if point is inside) */
 
-      /* Test cell */
-
-      if (InTetCell(loc0, x, y, z, YES) == YES)
+      if ((loc1 = WalkTetMesh(loc0, x, y, z)) > VALID_PTR)
         {
-          /* Return pointer */
-
-          return loc0;
-        }
-    }
-
-  /***************************************************************************/
-
-  /***** Try neighbour search ************************************************/
-
-  /* Check if previous cell was given (NOTE: Tää on nyt disabloitu kun  */
-  /* se ei toimi kovin hyvin) */
-
-  prev = -1;
-  next = -1;
-
-  if (loc0 > VALID_PTR)
-    {
-      /* Reset minimum distance */
-
-      min = INFTY;
-
-      /* Reset counter */
-
-      nc = 0;
-
-      /* Loop */
-
-      while (1 != 2)
-        {
-          /* Check pointer */
-
-          CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
-
-          /* Test cell */
-
-          if (InTetCell(loc0, x, y, z, YES) == YES)
-            {
-              /* Store pointer */
-
-              ptr = (long)RDB[ifc + IFC_PTR_PREV_CELL];
-              CheckPointer(FUNCTION_NAME, "(ptr2)", PRIVA_ARRAY, ptr);
-              PutPrivateData(ptr, loc0, id);
-
-              /* Return pointer */
-
-              return loc0;
-            }
-
-          /* Loop over faces and see which face has its barycenter closest to */
-          /* target coordinates */
-
-          for (i = 0; i < 4; i++)
-            {
-              /* Get pointers to points */
-
-              pt0 = (long)RDB[loc0 + TET_POINTS + face[i][0]];
-              pt1 = (long)RDB[loc0 + TET_POINTS + face[i][1]];
-              pt2 = (long)RDB[loc0 + TET_POINTS + face[i][2]];
-
-              /* Calculate barycenter of face */
-
-              facex = (RDB[pt0 + 0] + RDB[pt1 + 0] + RDB[pt2 + 0])/3.0;
-              facey = (RDB[pt0 + 1] + RDB[pt1 + 1] + RDB[pt2 + 1])/3.0;
-              facez = (RDB[pt0 + 2] + RDB[pt1 + 2] + RDB[pt2 + 2])/3.0;
-
-              /* Calculate distance components */
-
-              dx = (x - facex);
-              dy = (y - facey);
-              dz = (z - facez);
-
-              /* Compare square distance to minimum */
-
-              if ((r2 = dx*dx + dy*dy + dz*dz) == 0.0)
-                Die(FUNCTION_NAME, "Error in vector lenght");
-              else if (r2 < min)
-                {
-                  /* Get neighbour through current face */
-
-                  ptr = (long)RDB[loc0 + TET_NEIGHBOURS + i];
-
-                  /* Update pointer and minimum */
-
-                  next = ptr;
-                  min = r2;
-                }
-
-            }
-
-          /* Check if minimum was found */
-
-          if (next < VALID_PTR)
-            {
-              /* No neighbour cell (point may be outside), break loop */
-
-              break;
-            }
-          else if (next == prev)
-            {
-              /* Would return to previous cell leading to infinite oscillation */
-
-              break;
-            }
-          else
-            {
-              /* Store previous tet */
-
-              prev = loc0;
-
-              /* Go to next tet */
+          /* Store pointer */
 
-              loc0 = next;
-            }
+          if (loc1 != loc0)
+            PutPrivateData(ptr, loc1, id);
 
-          /* Check maximum number of iterations */
+          /* Return pointer */
 
-          if (nc++ > 10)
-            break;
+          return loc1;
         }
     }
 
@@ -212,7 +91,25 @@ long FindTetCell(long ifc, double x, double y, double z, long id)
   if (lst < VALID_PTR)
     return NULLPTR;
 
-  /* Loop over content */
+  /* Walk from first cell in search mesh cell */
+
+  loc0 = (long)RDB[lst + SEARCH_MESH_CELL_CONTENT];
+  CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+  if ((loc1 = WalkTetMesh(loc0, x, y, z)) > VALID_PTR)
+    {
+      /* Store pointer */
+
+      ptr = (long)RDB[ifc + IFC_PTR_PREV_CELL];
+      CheckPointer(FUNCTION_NAME, "(ptr3)", PRIVA_ARRAY, ptr);
+      PutPrivateData(ptr, loc1, id);
+
+      /* Return pointer */
+
+      return loc1;
+    }
+
+  /* Walk failed (non-convex mesh), loop over content */
 
   while (lst > VALID_PTR)
     {
@@ -3,12 +3,16 @@
 /* serpent 2 (beta-version) : finduniversecell.c                             */
 /*                                                                           */
 /* Created:       2010/10/13 (JLe)                                           */
-/* Last modified: 2018/06/26 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Find cell in universe                                        */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - After a surface crossing in ST mode, cells found on the other */
+/*             side are cached in the compiled program instruction through   */
+/*             which the particle exited the previous cell. The cache is     */
+/*             built lazily: on a miss the normal search is used and the     */
+/*             cell found is added to the cache.                             */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -22,7 +26,7 @@
 long FindUniverseCell(long uni, double x, double y, double z, long *ridx, 
                       long id)
 {
-  long cell, lst, ptr, msh, found, loc0, loc1, loc2, n, nc, opt, surf;
+  long cell, lst, ptr, msh, found, loc0, loc1, loc2, n, nc, opt, prg;
   
 
   /* Check universe pointer */
@@ -43,72 +47,121 @@ long FindUniverseCell(long uni, double x, double y, double z, long *ridx,
 
   /***** Check for surface crossing from ST **********************************/
 
+  /* Reset pointer to exit instruction */
+
+  prg = -1;
+
   if (opt == CELL_SEARCH_LIST_SURF)
     {
-      Die(FUNCTION_NAME, "This should not be used");
-
-      /* Get pointer to nearest surface */
+      /* Get pointer to previous region */
 
-      ptr = (long)RDB[uni + UNIVERSE_PTR_NEAREST_SURF];
-      CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);        
+      ptr = (long)RDB[uni + UNIVERSE_PTR_PREV_REG];
+      CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
 
-      /* Check surface pointer */
+      /* Check pointer */
 
-      if ((surf = (long)GetPrivateData(ptr, id)) > VALID_PTR)
+      if ((lst = (long)GetPrivateData(ptr, id)) > VALID_PTR)
         {
-          /* Get pointer to search list */
+          /* Get cell pointer */
 
-          ptr = (long)RDB[surf + SURFACE_PTR_CELL_LIST];
-          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-          
-          /* Loop over list */
-          
-          n = 0;
-          while ((loc0 = ListPtr(ptr, n++)) > VALID_PTR)
+          cell = (long)RDB[lst + CELL_LIST_PTR_CELL];
+          CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
+
+          /* Reset exit instruction */
+
+          loc2 = (long)RDB[DATA_CELL_PROG_EXIT];
+          CheckPointer(FUNCTION_NAME, "(loc2)", PRIVA_ARRAY, loc2);
+          PutPrivateData(loc2, -1, id);
+
+          /* Test cell (crossed surface may be at another level) */
+
+          if (InCell(cell, x, y, z, NO, id) == YES)
             {
-              /* Pointer to cell */
-              
-              loc1 = (long)RDB[loc0 + CELL_LIST_PTR_CELL];
-              CheckPointer(FUNCTION_NAME, "(loc1)", DATA_ARRAY, loc1);
-              
-              /* Check universe */
-              
-              if ((long)RDB[loc1 + CELL_PTR_UNI] != uni)
-                continue;
-              
-              /* Test cell */
-              
-              if (InCell(loc1, x, y, z, NO, id) == YES)
+              /* Put region index */
+
+              *ridx = (long)RDB[lst + CELL_LIST_REG_IDX];
+
+              /* Pointer to search list count */
+
+              loc2 = (long)RDB[lst + CELL_LIST_PTR_COUNT];
+              CheckPointer(FUNCTION_NAME, "(loc2)", DATA_ARRAY, loc2);
+
+              /* Add counter */
+
+              AddPrivateData(loc2, 1, id);
+
+              /* Return cell pointer */
+
+              return cell;
+            }
+
+          /* Get instruction through which the point exited the cell */
+          /* (defines the cell, crossed surface and side). */
+
+          if ((prg = (long)GetPrivateData(loc2, id)) > VALID_PTR)
+            {
+              /* Loop over cached neighbours */
+
+              for (n = 0; n < MAX_CELL_PROG_NBR; n++)
                 {
-                  /* Put region index */
-                  
-                  *ridx = (long)RDB[loc0 + CELL_LIST_REG_IDX];
-                  
-                  /* Pointer to search list count */
-                  
-                  loc2 = (long)RDB[loc0 + CELL_LIST_PTR_COUNT];
-                  CheckPointer(FUNCTION_NAME, "(loc2)", DATA_ARRAY, loc2);
-                  
-                  /* Add counter */
-                  
-                  AddPrivateData(loc2, 1, id);
-                  
-                  /* Put previous pointer */
-                  
-                  ptr = (long)RDB[uni + UNIVERSE_PTR_PREV_REG];
-                  PutPrivateData(ptr, loc0, id);
-                  
-                  /* Return cell pointer */
-                  
-                  return loc1;
+                  /* Pointer to search list item */
+
+                  if ((loc0 = (long)RDB[prg + CELL_PROG_PTR_NBR1 + n]) <
+                      VALID_PTR)
+                    break;
+
+                  /* Pointer to cell */
+
+                  loc1 = (long)RDB[loc0 + CELL_LIST_PTR_CELL];
+                  CheckPointer(FUNCTION_NAME, "(loc1)", DATA_ARRAY, loc1);
+
+                  /* Test cell */
+
+                  if (InCell(loc1, x, y, z, NO, id) == YES)
+                    {
+                      /* Put region index */
+
+                      *ridx = (long)RDB[loc0 + CELL_LIST_REG_IDX];
+
+                      /* Pointer to search list count */
+
+                      loc2 = (long)RDB[loc0 + CELL_LIST_PTR_COUNT];
+                      CheckPointer(FUNCTION_NAME, "(loc2)", DATA_ARRAY, loc2);
+
+                      /* Add counter */
+
+                      AddPrivateData(loc2, 1, id);
+
+                      /* Put previous pointer */
+
+                      PutPrivateData(ptr, loc0, id);
+
+                      /* Score hit */
+
+                      ptr = (long)RDB[RES_ST_NBR_EFF];
+                      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+                      AddBuf1D(1.0, 1.0, ptr, id, 0);
+                      AddBuf1D(1.0, 1.0, ptr, id, 1);
+
+                      /* Return cell pointer */
+
+                      return loc1;
+                    }
                 }
-            }
-          
-          /* Cell not found */
 
-          Warn(FUNCTION_NAME, "Cell not found in surface neighbours");
+              /* Score miss */
+
+              loc2 = (long)RDB[RES_ST_NBR_EFF];
+              CheckPointer(FUNCTION_NAME, "(loc2)", DATA_ARRAY, loc2);
+              AddBuf1D(1.0, 1.0, loc2, id, 1);
+
+              /* Universes with adaptive search mesh are not cached */
+
+              if ((long)RDB[uni + UNIVERSE_PTR_SEARCH_MESH] > VALID_PTR)
+                prg = -1;
+            }
         }
-      
+
       /* Override option */
 
       opt = CELL_SEARCH_LIST_CELL;
@@ -118,10 +171,12 @@ long FindUniverseCell(long uni, double x, double y, double z, long *ridx,
 
   /***** Check for previous point ********************************************/
 
-  /* Check plotter mode */
+  /* Check plotter mode (previous cell was already tested if crossing */
+  /* from ST) */
   
-  if (((long)RDB[DATA_PLOTTER_MODE] == NO) || 
-      ((long)RDB[DATA_QUICK_PLOT_MODE] == YES))
+  if ((cell < VALID_PTR) &&
+      (((long)RDB[DATA_PLOTTER_MODE] == NO) || 
+       ((long)RDB[DATA_QUICK_PLOT_MODE] == YES)))
     {
       /* Check if source point search mode */
 
@@ -185,14 +240,19 @@ long FindUniverseCell(long uni, double x, double y, double z, long *ridx,
           loc0 = (long)RDB[loc0];
           CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
 
-          /* Loop over candidates */
+          /* Loop over candidates (pointers to cell list items) */
 
           nc = (long)RDB[loc0 + CELL_SEARCH_MESH_N];
           for (n = 0; n < nc; n++)      
             {
+              /* Get pointer to search list item */
+
+              lst = (long)RDB[loc0 + CELL_SEARCH_MESH_PTR_C1 + n];
+              CheckPointer(FUNCTION_NAME, "(lst)", DATA_ARRAY, lst);
+
               /* Get pointer to cell */
               
-              cell = (long)RDB[loc0 + CELL_SEARCH_MESH_PTR_C1 + n];
+              cell = (long)RDB[lst + CELL_LIST_PTR_CELL];
               CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
               
               /* Test cell */
@@ -201,9 +261,30 @@ long FindUniverseCell(long uni, double x, double y, double z, long *ridx,
                 {
                   /* Put region index */
                  
-                  /* HUOM!!!!!! */                  
- 
-                  *ridx = 0;
+                  *ridx = (long)RDB[lst + CELL_LIST_REG_IDX];
+
+                  /* Check plotter mode */
+
+                  if ((long)RDB[DATA_PLOTTER_MODE] == NO)
+                    {
+                      /* Pointer to search list count */
+
+                      loc2 = (long)RDB[lst + CELL_LIST_PTR_COUNT];
+                      CheckPointer(FUNCTION_NAME, "(loc2)", DATA_ARRAY, loc2);
+
+                      /* Add counter */
+
+                      AddPrivateData(loc2, 1, id);
+
+                      /* Put previous pointer */
+
+                      if (opt == CELL_SEARCH_LIST_SRC)
+                        ptr = (long)RDB[uni + UNIVERSE_PTR_SRC_REG];
+                      else
+                        ptr = (long)RDB[uni + UNIVERSE_PTR_PREV_REG];
+
+                      PutPrivateData(ptr, lst, id);
+                    }
                   
                   /* Return cell pointer */
                 
@@ -298,6 +379,22 @@ long FindUniverseCell(long uni, double x, double y, double z, long *ridx,
 
               AddPrivateData(loc2, 1, id);
 
+              /* Add to neighbour cache (most recent first) */
+
+              if (prg > VALID_PTR)
+                {
+#ifdef OPEN_MP
+#pragma omp critical (nbr)
+#endif
+                  {
+                    for (n = MAX_CELL_PROG_NBR - 1; n > 0; n--)
+                      WDB[prg + CELL_PROG_PTR_NBR1 + n] =
+                        RDB[prg + CELL_PROG_PTR_NBR1 + n - 1];
+
+                    WDB[prg + CELL_PROG_PTR_NBR1] = (double)loc0;
+                  }
+                }
+
               /* Put previous pointer */
                   
               if (opt == CELL_SEARCH_LIST_SRC)
@@ -0,0 +1,106 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : flushhybridbuf.c                               */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Moves results from thread-wise hash table of hybrid scoring  */
+/*              buffer to shared BUF array                                   */
+/*                                                                           */
+/* Comments: - Called by AddHybridBuf() when the table fills up, and for     */
+/*             all threads by ReduceBuffer() and ClearBuf().                 */
+/*                                                                           */
+/*           - Only the slots in use are looped over.                        */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "FlushHybridBuf:"
+
+/*****************************************************************************/
+
+void FlushHybridBuf(long id)
+{
+  long sz, ptr, lst, cnt, loc0, loc1, n, i;
+
+  /* Check mode */
+
+  if ((long)RDB[DATA_OPTI_HYBRID_BUF] == NO)
+    return;
+
+  /* Check that tables are allocated */
+
+  if ((ptr = (long)RDB[DATA_PTR_HYBRID_BUF]) < VALID_PTR)
+    return;
+
+  /* Check id */
+
+  CheckValue(FUNCTION_NAME, "id", "", id, 0, MAX_OMP_THREADS);
+
+  /* Get segment size */
+
+  sz = (long)RDB[DATA_REAL_PRIVA_SIZE];
+
+  /* Get pointers to list of used slots and counter */
+
+  lst = (long)RDB[DATA_PTR_HYBRID_BUF_LIST];
+  CheckPointer(FUNCTION_NAME, "(lst)", PRIVA_ARRAY, lst);
+
+  cnt = (long)RDB[DATA_PTR_HYBRID_BUF_COUNT];
+  CheckPointer(FUNCTION_NAME, "(cnt)", PRIVA_ARRAY, cnt);
+
+  /* Add thread offset */
+
+  ptr = ptr + id*sz;
+  lst = lst + id*sz;
+  cnt = cnt + id*sz;
+
+  /* Loop over used slots */
+
+  for (n = 0; n < (long)PRIVA[cnt]; n++)
+    {
+      /* Pointer to slot */
+
+      i = (long)PRIVA[lst + n];
+      loc1 = ptr + i*HYBRID_BUF_BLOCK_SIZE;
+
+      /* Pointer to data in buffer */
+
+      loc0 = (long)PRIVA[loc1 + HYBRID_BUF_IDX] - 1;
+      CheckPointer(FUNCTION_NAME, "(loc0)", BUF_ARRAY, loc0);
+
+      /* Add to shared buffer */
+
+#ifdef OPEN_MP
+#pragma omp atomic
+#endif
+      BUF[loc0 + BUF_VAL] += PRIVA[loc1 + HYBRID_BUF_VAL];
+
+#ifdef OPEN_MP
+#pragma omp atomic
+#endif
+      BUF[loc0 + BUF_WGT] += PRIVA[loc1 + HYBRID_BUF_WGT];
+
+#ifdef OPEN_MP
+#pragma omp atomic
+#endif
+      BUF[loc0 + BUF_N] += PRIVA[loc1 + HYBRID_BUF_N];
+
+      /* Reset slot */
+
+      PRIVA[loc1 + HYBRID_BUF_IDX] = 0.0;
+      PRIVA[loc1 + HYBRID_BUF_VAL] = 0.0;
+      PRIVA[loc1 + HYBRID_BUF_WGT] = 0.0;
+      PRIVA[loc1 + HYBRID_BUF_N] = 0.0;
+    }
+
+  /* Reset counter */
+
+  PRIVA[cnt] = 0.0;
+}
+
+/*****************************************************************************/
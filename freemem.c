@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : freemem.c                                      */
 /*                                                                           */
 /* Created:       2010/09/15 (JLe)                                           */
-/* Last modified: 2018/03/14 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Frees memory allocated to data blocks                        */
 /*                                                                           */
@@ -21,6 +21,10 @@
 
 void FreeMem()
 {
+#ifdef OPEN_MP
+  long n;
+#endif
+
   /* Free FINIX data */
 
 #ifdef FINIX
@@ -61,6 +65,18 @@ void FreeMem()
   if (SEED0 != NULL)
     Mem(MEM_FREE, SEED0);
 
+#ifdef OPEN_MP
+
+  if (QUE_LOCK != NULL)
+    {
+      for (n = 0; n < MAX_OMP_THREADS; n++)
+        omp_destroy_lock(&QUE_LOCK[n]);
+
+      Mem(MEM_FREE, QUE_LOCK);
+    }
+
+#endif
+
   if (mpiid > 0)
     fclose(outp);
 }
@@ -3,12 +3,12 @@
 /* serpent 2 (beta-version) : fromstack.c                                    */
 /*                                                                           */
 /* Created:       2011/03/09 (JLe)                                           */
-/* Last modified: 2019/04/03 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Retrieves neutron / photon from stack                        */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - Stacks are LIFO free lists linked through LIST_PTR_NEXT       */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -21,7 +21,7 @@
 
 long FromStack(long type, long id)
 {
-  long ptr, loc0, sz, n;
+  long ptr, loc0, loc1, sz, n;
 
 #ifdef OLD_IFP
 
@@ -36,73 +36,68 @@ long FromStack(long type, long id)
 
   /* Avoid compiler warning */
 
-  ptr = -1;
+  loc0 = -1;
 
   /* Check type and get pointer to stack */
 
   if (type == PARTICLE_TYPE_NEUTRON)
-    ptr = (long)RDB[OMPPtr(DATA_PART_PTR_NSTACK, id)];
+    loc0 = (long)RDB[OMPPtr(DATA_PART_PTR_NSTACK, id)];
   else if (type == PARTICLE_TYPE_GAMMA)
-    ptr = (long)RDB[OMPPtr(DATA_PART_PTR_GSTACK, id)];
+    loc0 = (long)RDB[OMPPtr(DATA_PART_PTR_GSTACK, id)];
   else if (type == PARTICLE_TYPE_PRECURSOR)
-    ptr = (long)RDB[OMPPtr(DATA_PART_PTR_PSTACK, id)];
+    loc0 = (long)RDB[OMPPtr(DATA_PART_PTR_PSTACK, id)];
   else
     Die(FUNCTION_NAME, "Invalid particle type");
 
   /* Check pointer */
 
+  CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+  /* Get pointer to top of stack */
+
+  if ((ptr = (long)RDB[loc0 + PART_STACK_PTR_TOP]) < VALID_PTR)
+    {
+      if (type == PARTICLE_TYPE_NEUTRON)
+        Error(0, "Insufficient neutron buffer size, increase value of\nparameter \"nbuf\" (currently set to %1.1f)", RDB[DATA_PART_NBUF_FACTOR]);
+      else if (type == PARTICLE_TYPE_GAMMA)
+          Error(0, "Insufficient photon buffer size, increase value of\nparameter \"gbuf\" (currently set to %1.1f)", RDB[DATA_PART_GBUF_FACTOR]);
+      else
+          Error(0, "Insufficient precursor buffer size, increase value of\nparameter \"pbuf\" (currently set to %1.1f)", RDB[DATA_PART_PBUF_FACTOR]);
+    }
+
+  /* Check pointer */
+
   CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
 
-  /* Get size */
+  /* Pop from stack */
 
-  sz = ListSize(ptr) - 2;
+  WDB[loc0 + PART_STACK_PTR_TOP] = RDB[ptr + LIST_PTR_NEXT];
+  WDB[loc0 + PART_STACK_N] = RDB[loc0 + PART_STACK_N] - 1.0;
+  WDB[ptr + LIST_PTR_NEXT] = NULLPTR;
 
-  /* Avoid compiler warning */
+  /* Get size */
 
-  loc0 = -1;
+  sz = (long)RDB[loc0 + PART_STACK_N];
 
-  /* Compare to minimum */
+  /* Pointer to minimum size */
 
   if (type == PARTICLE_TYPE_NEUTRON)
-    loc0 = (long)RDB[DATA_PART_PTR_MIN_NSTACK];
+    loc1 = (long)RDB[DATA_PART_PTR_MIN_NSTACK];
   else if (type == PARTICLE_TYPE_GAMMA)
-    loc0 = (long)RDB[DATA_PART_PTR_MIN_GSTACK];
-  else if (type == PARTICLE_TYPE_PRECURSOR)
-    loc0 = (long)RDB[DATA_PART_PTR_MIN_PSTACK];
+    loc1 = (long)RDB[DATA_PART_PTR_MIN_GSTACK];
   else
-    Die(FUNCTION_NAME, "Invalid particle type");
+    loc1 = (long)RDB[DATA_PART_PTR_MIN_PSTACK];
 
   /* Check pointer */
 
-  CheckPointer(FUNCTION_NAME, "(loc0)", PRIVA_ARRAY, loc0);
+  CheckPointer(FUNCTION_NAME, "(loc1)", PRIVA_ARRAY, loc1);
 
   /* Compare to minimum */
 
-  if ((n = (long)GetPrivateData(loc0, id)) == 0)
-    PutPrivateData(loc0, sz, id);
+  if ((n = (long)GetPrivateData(loc1, id)) == 0)
+    PutPrivateData(loc1, sz, id);
   if (sz < n)
-    PutPrivateData(loc0, sz, id);
-
-  /* Get pointer to last item */
-
-  ptr = LastItem(ptr);
-  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-
-  /* Check type */
-
-  if ((long)RDB[ptr + PARTICLE_TYPE] == PARTICLE_TYPE_DUMMY)
-    {
-      if (type == PARTICLE_TYPE_NEUTRON)
-        Error(0, "Insufficient neutron buffer size, increase value of\nparameter \"nbuf\" (currently set to %1.1f)", RDB[DATA_PART_NBUF_FACTOR]);
-      else if (type == PARTICLE_TYPE_GAMMA)
-          Error(0, "Insufficient photon buffer size, increase value of\nparameter \"gbuf\" (currently set to %1.1f)", RDB[DATA_PART_GBUF_FACTOR]);
-      else
-          Error(0, "Insufficient precursor buffer size, increase value of\nparameter \"pbuf\" (currently set to %1.1f)", RDB[DATA_PART_PBUF_FACTOR]);
-    }
-
-  /* Remove particle from stack */
-
-  RemoveItem(ptr);
+    PutPrivateData(loc1, sz, id);
 
   /* Remember pointers to fission progeny and history data */
 
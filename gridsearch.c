@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : gridsearch.c                                   */
 /*                                                                           */
 /* Created:       2010/12/09 (JLe)                                           */
-/* Last modified: 2018/01/18 (JLe)                                           */
-/* Version:       2.1.30                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Finds energy interval from grid structure                    */
 /*                                                                           */
@@ -23,7 +23,7 @@
 long GridSearch(long erg, double E)
 {
   double Emin, Emax, Emid, logE;
-  long ptr, ne, idx, i0, nb, erg0, id;
+  long ptr, ne, idx, i0, i1, nb, erg0, id;
 
   /* Check pointer and value */
 
@@ -84,6 +84,81 @@ long GridSearch(long erg, double E)
 
   /***************************************************************************/
 
+  /***** Lethargy-bucket index ***********************************************/
+
+  if ((ptr = (long)RDB[erg + ENERGY_GRID_PTR_LIDX]) > VALID_PTR)
+    {
+      /* Get number of buckets */
+
+      nb = (long)RDB[erg + ENERGY_GRID_LIDX_NB];
+      CheckValue(FUNCTION_NAME, "nb", "", nb, 1, MAX_EGRID_NE);
+
+      /* Calculate bucket index */
+
+      idx = (long)((log(E) - RDB[erg + ENERGY_GRID_LOG_EMIN])*
+                   RDB[erg + ENERGY_GRID_LIDX_INV]);
+
+      /* Log-function may cause numerical problems */
+
+      if (idx < 0)
+        idx = 0;
+      else if (idx > nb - 1)
+        idx = nb - 1;
+
+      /* Get interval range */
+
+      i0 = (long)RDB[ptr + idx];
+      i1 = (long)RDB[ptr + idx + 1] + 1;
+
+      /* Get number of points and pointer to data */
+
+      ne = (long)RDB[erg + ENERGY_GRID_NE];
+      CheckValue(FUNCTION_NAME, "ne", "", ne, 2, MAX_EGRID_NE);
+
+      ptr = (long)RDB[erg + ENERGY_GRID_PTR_DATA];
+      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+      /* Upper boundary is excluded (same as in SearchArray()) */
+
+      if (E >= RDB[ptr + ne - 1])
+        return -1;
+
+      /* Adjust for round-off at bucket boundaries */
+
+      while ((i0 > 0) && (E < RDB[ptr + i0]))
+        i0--;
+
+      while ((i1 < ne - 1) && (E >= RDB[ptr + i1]))
+        i1++;
+
+      /* Split interval until only a few points remain */
+
+      while (i1 - i0 > EGRID_LIDX_SCAN)
+        {
+          idx = (i0 + i1)/2;
+
+          if (E < RDB[ptr + idx])
+            i1 = idx;
+          else
+            i0 = idx;
+        }
+
+      /* Loop to interval */
+
+      while (RDB[ptr + i0 + 1] <= E)
+        i0++;
+
+      /* Check */
+
+      CheckValue(FUNCTION_NAME, "E", "", E, RDB[ptr + i0], RDB[ptr + i0 + 1]);
+
+      /* Return index */
+
+      return i0;
+    }
+
+  /***************************************************************************/
+
   /***** Sub-intervals *******************************************************/
   
   /* Get number of bins */
@@ -23,6 +23,9 @@
 #include <unistd.h>
 #include <netdb.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 #ifndef NO_GFX_MODE
 #include <gd.h>
@@ -154,6 +157,9 @@
 #define MAX_GENERATIONS          1000000000
 #define MAX_RMX_BUFF             10000
 #define MAX_PLOT_COLORS          256
+#define MAX_DET_CAND_LISTS       32
+#define SPARSE_STAT_PAGE_SZ      4096
+#define MAX_WMP_COEF             16
 
 /* Tracking errors */
 
@@ -238,6 +244,10 @@
 #define PARTICLE_TYPE_POSITRON   5
 #define PARTICLE_TYPE_ALPHA      6
 
+/* Alignment of particle pool records (in doubles, 64 bytes) */
+
+#define PARTICLE_POOL_ALIGN      8
+
 /* K-eff iteration modes */
 
 #define ITER_MODE_NONE    0
@@ -351,6 +361,55 @@
 #define STL_RAY_TEST_FAIL_STUCK  -5000
 #define STL_FACET_OVERLAP        -6000
 
+/* STL bounding volume hierarchy */
+
+#define STL_BVH_LEAF_SIZE        4
+#define STL_BVH_MAX_DEPTH        64
+#define STL_BVH_BINS             16
+
+#define STL_BVH_MODE_NEAREST     1
+#define STL_BVH_MODE_STRICT      2
+#define STL_BVH_MODE_COUNT       3
+
+/* Binary ACE cache file header (entries are longs, followed by AWR and */
+/* the XSS array as doubles) */
+
+#define ACE_CACHE_MAGIC          0x5353534143454331
+#define ACE_CACHE_VERSION        2
+
+#define ACE_CACHE_HDR_MAGIC      0
+#define ACE_CACHE_HDR_VERSION    1
+#define ACE_CACHE_HDR_SRC_SIZE   2
+#define ACE_CACHE_HDR_SRC_TIME   3
+#define ACE_CACHE_HDR_SRC_SUM    4
+#define ACE_CACHE_HDR_POS        5
+#define ACE_CACHE_HDR_SZ         6
+#define ACE_CACHE_HDR_NXS        7
+#define ACE_CACHE_HDR_JXS       23
+#define ACE_CACHE_HDR_IZ        55
+#define ACE_CACHE_HDR_SIZE      71
+
+/* Adaptive cell search mesh parameters (depth, size of first level, */
+/* size of subsequent levels and number of sampled points per cell) */
+
+#define ADA_CSM_DEPTH           20
+#define ADA_CSM_SZ0              5
+#define ADA_CSM_SZ               2
+#define ADA_CSM_NP            1000
+
+/* Adaptive cell search mesh cache file header (entries are longs, */
+/* followed by mesh data) */
+
+#define CSM_CACHE_MAGIC          0x5353534353434D31
+#define CSM_CACHE_VERSION        1
+
+#define CSM_CACHE_HDR_MAGIC      0
+#define CSM_CACHE_HDR_VERSION    1
+#define CSM_CACHE_HDR_HASH       2
+#define CSM_CACHE_HDR_NC         3
+#define CSM_CACHE_HDR_SZ         4
+#define CSM_CACHE_HDR_SIZE       5
+
 /* XS data types */
 
 #define XS_TYPE_SAB         3
@@ -478,6 +537,14 @@
 
 #define MT_USER_DEFINED        -100
 
+/* Indexes for nuclide-wise cross sections interpolated in a single pass */
+
+#define NUC_XS_TOT  0
+#define NUC_XS_ABS  1
+#define NUC_XS_ELA  2
+#define NUC_XS_FISS 3
+#define NUC_XS_N    4
+
 /* Time-dependent source rates for different things */
 
 #define MT_PRIMARY_LIVE_SOURCE     -110
@@ -526,6 +593,12 @@
 #define GRID_TYPE_LIN  1
 #define GRID_TYPE_LOG  2
 
+/* Lethargy-bucket index for energy grid search (minimum grid size and */
+/* number of points searched linearly) */
+
+#define EGRID_LIDX_MIN_NE  1000
+#define EGRID_LIDX_SCAN    8
+
 /* User energy grid types */
 
 #define EG_TYPE_ARB     1
@@ -650,7 +723,7 @@
 
 /* Timers */
 
-#define TOT_TIMERS                22
+#define TOT_TIMERS                24
 
 #define TIMER_TRANSPORT            1
 #define TIMER_TRANSPORT_ACTIVE     2
@@ -674,6 +747,8 @@
 #define TIMER_RMX                 20
 #define TIMER_LEAKAGE_CORR        21
 #define TIMER_MISC                22
+#define TIMER_DEPLETION           23
+#define TIMER_DEPLETION_TOTAL     24
 
 /* Geometry errors */
 
@@ -881,6 +956,25 @@
 #define TRACK_MODE_DT 1
 #define TRACK_MODE_ST 2
 
+/* Event-based transport */
+
+#define EVENT_SLOT_FREE 0
+#define EVENT_SLOT_XS   1
+#define EVENT_SLOT_MOVE 2
+
+#define EVENT_STATE_LOAD 1
+#define EVENT_STATE_SAVE 2
+
+#define EVENT_QUE_GET 1
+#define EVENT_QUE_PUT 2
+
+/* OpenMP load balance statistics */
+
+#define OMP_BALANCE_START  1
+#define OMP_BALANCE_THREAD 2
+#define OMP_BALANCE_STOP   3
+#define OMP_BALANCE_END    4
+
 /* Critical spectrum calculation */
 
 #define CRIT_SPECTRUM_OLD  0
@@ -1258,6 +1352,39 @@ typedef struct {
   GSconfigElemData *elemData; /* Element-wise data */
 } GSconfigData;
 
+/* Particle state in event-based transport bank */
+
+typedef struct {
+  long stat;        /* Slot status (EVENT_SLOT_*) */
+  long que;         /* Root pointer to secondary que of source history */
+  long part;        /* Pointer to particle */
+  long type;        /* Particle type */
+  long cell;        /* Cell pointer */
+  long mat;         /* Material pointer */
+  long trk;         /* Track type */
+  long mode;        /* Tracking mode */
+  long loop;        /* Loop counter */
+  long lmax;        /* Maximum number of loops */
+  long gmax;        /* Maximum generation in source history */
+  long ncol;        /* Collision counter of current loop */
+  long dtf;         /* Private enforced delta-tracking flag */
+  long stlf;        /* Private STL mode flag */
+  unsigned long seed; /* Random number seed */
+  double x, y, z;   /* Coordinates */
+  double u, v, w;   /* Direction cosines */
+  double E;         /* Energy */
+  double wgt;       /* Weight */
+  double t;         /* Time */
+  double t0;        /* Initial time */
+  double x0, y0, z0; /* Previous coordinates for surface tallies */
+  double xt, yt, zt; /* Previous collision coordinates for CMM */
+  double dxc, dyc, dzc; /* Previous collision deltas for CMM */
+  double spd;       /* Speed */
+  double minxs;     /* Minimum cross section */
+  double totxs;     /* Total cross section */
+  double majorant;  /* Majorant */
+} EventSlot;
+
 /*****************************************************************************/
 
 /***** Function prototypes ***************************************************/
@@ -1268,6 +1395,8 @@ typedef struct {
 extern "C" {
 #endif
 
+long ACECacheHeader(long, FILE *, char *, long *, long);
+
 void AddBranching(long);
 
 void AddBuf(double, double, long, long, long, ...);
@@ -1278,6 +1407,8 @@ void AddChains(long, long, long);
 
 void AddDDRes(long, double);
 
+void AddHybridBuf(long, double, double, long);
+
 void AddItem(long, long);
 
 void AddFET(const double *const, long, long, double, double, double,
@@ -1379,10 +1510,14 @@ double BufVal(long, ...);
 
 double BufWgt(long, ...);
 
+long BuildSTLBVH(double *, long *, long, long *);
+
 void BurnMatCompositions(void);
 
 void BurnMaterials(long, long);
 
+double *BurnMatOrder(long *);
+
 long BurnMatrixSize(long);
 
 void BurnupCycle(void);
@@ -1495,6 +1630,14 @@ void CombineFissionYields(void);
 
 long CompareStr(long, long);
 
+long CompileCellProgram(long, long);
+
+void CompileCells(void);
+
+void CompileDetBins(void);
+
+void CompileDetIndex(void);
+
 void ComplexRea(long, long, double *, double, double, double, double *,
                 double *, double *, double, double *, double, double *, long);
 
@@ -1519,6 +1662,8 @@ void CollectResults(void);
 
 void CollectSensResults(void);
 
+void CollectSparseDet(long, long, double);
+
 void CollectUncResults(void);
 
 void CollectVRMeshData(void);
@@ -1555,6 +1700,8 @@ long CreateMesh(long, long, long, long, long, long, const double *, long);
 
 void CreateUMSHCells(long);
 
+long CSMCacheHeader(long, char *, long *);
+
 long CreateUniverse(long, char *, long);
 
 void CSplineConstruct(const double *, const double *, long, double, double,
@@ -1600,6 +1747,8 @@ void DepletionPolyFit(long, long);
 
 long DetBin(long, long, long, double, double, double, double, double, long);
 
+long DetCandidates(long, long, long *, long);
+
 void DetectorOutput(void);
 
 long DeterministicLeakage(long, long, long, const double *, const double *,
@@ -1653,6 +1802,8 @@ void DopplerBroad(void);
 
 double DTMajorant(long, double, long);
 
+double DTRegionMajorant(long, double, double, double, double, double, long);
+
 long DuplicateItem(long);
 
 long DuplicateParticle(long, long);
@@ -1704,10 +1855,20 @@ void EstimateRuntime(void);
 
 long EventFromBank(long, long);
 
+long EventMove(EventSlot *, long);
+
+void EventQue(long, long, long);
+
 void EventsToSensitivity(long, double, long, double, long);
 
+long EventStart(EventSlot *, long);
+
+void EventState(EventSlot *, long, long);
+
 void EventToBank(long, long);
 
+void EventXS(EventSlot *, long);
+
 double ExpandFE(const double *const, const double *const, double, double,
                 double, long);
 
@@ -1724,6 +1885,8 @@ void FETFinalize(const double *const, long, long, long, double *, double *);
 
 long FETIdx(const double *const, long, long, long);
 
+complex Faddeeva(complex);
+
 void FillSTLMesh(long, long, double, double, double);
 
 void FinalizeCCPrecDet(void);
@@ -1787,6 +1950,8 @@ void FixPolyhedMesh(long);
 
 void FlushBank(void);
 
+void FlushHybridBuf(long);
+
 void FlushPrecSource(void);
 
 void FormTransmuPaths(long, long, double, double, long, long);
@@ -1892,6 +2057,8 @@ void InitData(void);
 
 void InitHistories(void);
 
+void InitHybridBuf(void);
+
 void InitialCritSrc(void);
 
 void InitMPI(int, char **);
@@ -1978,6 +2145,8 @@ double MacroXS(long, double, long);
 
 double MajorantXS(long, double, long);
 
+long MakeAliasTable(long, long);
+
 double *MakeArray(double, double, long, long);
 
 struct ccsMatrix *MakeBurnMatrix(long, long);
@@ -1989,6 +2158,8 @@ void MakeDepletionZones(long, long, long, long, long, long *, double, double,
 
 long MakeEnergyGrid(long, long, long, long, const double *, long);
 
+long MakeLethargyIndex(long);
+
 void MakePalette(long *, long *, long *, long, long);
 
 void MakeRing(long);
@@ -2007,7 +2178,8 @@ long MatPtr(long, long);
 
 void MatPos(void);
 
-double *MatrixExponential(struct ccsMatrix *, double *, double);
+double *MatrixExponential(struct ccsMatrix *, double *, double,
+                          struct ccsMatrix **);
 
 void MaxSrcImp(long, double,  double,  double,  double, long);
 
@@ -2081,8 +2253,16 @@ long MoveST(long, double, double, long *, double *, double *, double *,
 
 void MoveStore(void);
 
+void MPIReduceSegments(double *, long, long);
+
 void MPITransfer(double *, double *, long, long, long);
 
+void MultipoleMajorant(long);
+
+double MultipoleMicroXS(long, double, double, long);
+
+void MultipoleXS(long, double, double, double *);
+
 long MyParallelMat(long, long);
 
 double NearestBoundary(long);
@@ -2107,8 +2287,12 @@ long NewLIFOItem(long, long);
 
 void NewReaList(long, long);
 
+long NewSparseStat(char *, long, long);
+
 long NewStat(char *, long, ...);
 
+long NextDetCandidate(long *, long);
+
 long NextReaction(long, long *, double *, double *, double *, long);
 
 long NextWord(char *, char *);
@@ -2133,6 +2317,8 @@ void Note(long, char *, ...);
 
 double Nubar(long, double, long);
 
+void NuclideMicroXS(long, double, double *, long);
+
 long NumericGauss(struct ccsMatrix *, complex *, complex, complex *);
 
 long NumericStr(char *);
@@ -2140,6 +2326,8 @@ long NumericStr(char *);
 void Nxn(long, long, double *, double, double, double, double *, double *,
          double *, double, double *, double, double *, long);
 
+void OMPBalance(long, long);
+
 void OMPResetComp(long);
 
 void OMPSetComp(long);
@@ -2158,6 +2346,17 @@ void OTFSabScattering(long, double *, double *, double *, double *, long);
 
 void OverrideIDs(void);
 
+long PackCellSurfaces(long, long);
+
+double PackedSurfDistance(long, double, double, double, double, double,
+                          double, long);
+
+void PackPBGrid(long);
+
+double PackXS(long, const double *, long);
+
+void PackTetFaces(long);
+
 void PairProduction(long, long, long, double, double, double, double, double,
                     double, double, double, double, long);
 
@@ -2224,6 +2423,8 @@ void PrepareCCIter(void);
 
 void PrepareCellSearchMesh(void);
 
+void PrepareDTRegions(void);
+
 void PrepareTransportCycle(void);
 
 void PreSort(void);
@@ -2374,6 +2575,8 @@ void ProcessNuclides(void);
 
 void ProcessOTFBurn(void);
 
+void ProcessOTFSab(void);
+
 void ProcessPairProduction(long, long);
 
 void ProcessPBGeometry(void);
@@ -2478,10 +2681,14 @@ char *ReactionMT(long, long);
 
 void ReadACEFile(long);
 
+long ReadACECache(long, FILE *, long *, long *, long *);
+
 void ReadBRAFile(void);
 
 void ReadCOVERXFile(long);
 
+long ReadCSMCache(long);
+
 void ReadDataInterfaces(void);
 
 void ReadDecayFile(void);
@@ -2518,6 +2725,8 @@ double ReadMesh(long, long, long, long);
 
 long ReadMeshPtr(long, long, long, long);
 
+void ReadMultipoleData(void);
+
 void ReadPendfData(long, FILE *, long, long);
 
 void ReadOFPatches(long);
@@ -2624,6 +2833,8 @@ void ResizeFissionSrc(void);
 
 double ResponseFunction(double, long);
 
+struct ccsMatrix *ReuseSymbolicLU(struct ccsMatrix *, struct ccsMatrix *);
+
 void RIACycle(void);
 
 void RROutput(void);
@@ -2842,8 +3053,12 @@ void SortArray(double *, long);
 
 void SortList(long, long, long);
 
+long SparseStatPtr(long, long, long, long);
+
 double Speed(long, double);
 
+void SplitCell(long, long, long);
+
 void SplitList(long, long, double, long);
 
 void SrcDet(long, long, double, double, double, double, double, double,
@@ -2860,6 +3075,8 @@ double StatSum(long, ...);
 
 void StatTests(void);
 
+long StealFromQue(long *, long);
+
 void StdComp(char *, char *);
 
 double StdDev(long, ...);
@@ -2869,8 +3086,10 @@ double STLFacetDistance(long, double, double, double, double, double, double,
 
 void STLMatFinder(void);
 
-long STLRayTest(long, long, double, double, double, double, double, double,
-                long, long);
+long STLBVHRayCast(long, double, double, double, double, double, double,
+                   long, double *, long *);
+
+long STLRayTest(long, double, double, double, double, double, double, long);
 
 void StopAtBoundary (long *, double *, double *, double *, double *, double,
                      double, double, long);
@@ -2961,6 +3180,9 @@ double TestValuePair(long, double, long);
 
 void TestXS(void);
 
+double TetFaceDistance(long, double, double, double, double, double, double,
+                       long *);
+
 void TetPutBoundingBox(long, long, long[4]);
 
 double TetraVol(long);
@@ -3004,8 +3226,32 @@ void TrackFile();
 
 void Tracking(long);
 
+void TrackingBank(long);
+
+long TrackingCollision(long, long, long, long, double, double, double, double,
+                       double, double, double *, double *, double *,
+                       double *, double *, double, double *, double *,
+                       double *, double, double, double, double *, double *,
+                       double *, long);
+
+void TrackingEnd(long, long, long, long, long, long, double, double, double,
+                 double, double, double, double, double, double, long);
+
 void TrackingError(long, double, long, long, long);
 
+long TrackingMove(long, long, long, double, double, double, double, double,
+                  double, long *, double *, double *, double *, double *,
+                  double *, double *, double *, double *, double *, double *,
+                  double *, double *, long);
+
+long TrackingSurf(long, long, long, long *, long *, double *, double *,
+                  double *, double *, double *, double *, double, double *,
+                  double, double *, double *, double *, double *, double *,
+                  double *, long);
+
+long TrackingXS(long, long, long, double, double, double, double, double *,
+                double *, double *, double *, long);
+
 long TrackMode(long, long, double, double, double, long, long);
 
 double TransportCorrection(long, double, long);
@@ -3044,6 +3290,8 @@ void UniSym(long, double *, double *, double *, double *, double *, double *);
 
 void UniverseBoundaries(void);
 
+void UnpackXS(long, double *, long);
+
 void UpdateCIStop(long, double *, long);
 
 void UpdateIFCDensMax(long);
@@ -3093,6 +3341,8 @@ void WalkerAliasInit(const double *, long, double *, double *, double *);
 long WalkerAliasSample(const double *, const double *, const double *, long,
                        long);
 
+long WalkTetMesh(long, double, double, double);
+
 void Warn(char *, char *, ...);
 
 long WeightWindow(long, long, long, double, double, double, double, double,
@@ -3102,8 +3352,13 @@ long WhereAmI(double, double, double, double, double, double, long);
 
 double *WorkArray(long, long, long, long);
 
+void WriteACECache(long, FILE *, const long *, const long *, const long *,
+                   double);
+
 void WriteCIMomFluxes(long);
 
+void WriteCSMCache(long);
+
 void WriteDynSrc(void);
 
 void WriteTetMeshtoGeo(void);
@@ -3439,6 +3694,14 @@ char *ASCII;
 unsigned long *SEED;
 unsigned long *SEED0;
 
+#ifdef OPEN_MP
+
+/* Locks for OpenMP particle ques (used with que stealing) */
+
+omp_lock_t *QUE_LOCK;
+
+#endif
+
 /*****************************************************************************/
 
 /* Output pointers */
@@ -3,12 +3,12 @@
 /* serpent 2 (beta-version) : incell.c                                       */
 /*                                                                           */
 /* Created:       2010/10/12 (JLe)                                           */
-/* Last modified: 2014/02/09 (JLe)                                           */
-/* Version:       2.1.17                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Checks if point is inside cell                               */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - Compiled program is used if available (see compilecells.c)    */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -21,7 +21,8 @@
 
 long InCell(long cell, double x, double y, double z, long on, long id)
 {
-  long n, ptr, loc0, surf, side, a, b, stack[10000];
+  long n, ptr, loc0, surf, side, a, b, in, stack[10000];
+  double u, v, w;
 
   /* Check cell pointer */
 
@@ -29,7 +30,206 @@ long InCell(long cell, double x, double y, double z, long on, long id)
 
   /* Check type */
 
-  if ((ptr = (long)RDB[cell + CELL_PTR_SURF_INSC]) > VALID_PTR)
+  if ((ptr = (long)RDB[cell + CELL_PTR_PROG]) > VALID_PTR)
+    {
+      /***********************************************************************/
+
+      /***** Compiled program ************************************************/
+
+      /* Loop until exit */
+
+      while (1 == 1)
+        {
+          /* Pointer to packed parameters */
+
+          loc0 = ptr + CELL_PROG_PARAMS;
+
+          /* Test surface */
+
+          switch ((long)RDB[ptr + CELL_PROG_OP])
+            {
+            case CELL_PROG_OP_INF:
+              {
+                in = YES;
+                break;
+              }
+            case CELL_PROG_OP_PX:
+              {
+                if (x - RDB[loc0] > 0)
+                  in = NO;
+                else
+                  in = YES;
+
+                break;
+              }
+            case CELL_PROG_OP_PY:
+              {
+                if (y - RDB[loc0] > 0)
+                  in = NO;
+                else
+                  in = YES;
+
+                break;
+              }
+            case CELL_PROG_OP_PZ:
+              {
+                if (z - RDB[loc0] > 0)
+                  in = NO;
+                else
+                  in = YES;
+
+                break;
+              }
+            case CELL_PROG_OP_CYLX:
+              {
+                v = y - RDB[loc0];
+                w = z - RDB[loc0 + 1];
+
+                if (v*v + w*w > RDB[loc0 + 2])
+                  in = NO;
+                else
+                  in = YES;
+
+                break;
+              }
+            case CELL_PROG_OP_CYLY:
+              {
+                u = x - RDB[loc0];
+                w = z - RDB[loc0 + 1];
+
+                if (u*u + w*w > RDB[loc0 + 2])
+                  in = NO;
+                else
+                  in = YES;
+
+                break;
+              }
+            case CELL_PROG_OP_CYLZ:
+              {
+                u = x - RDB[loc0];
+                v = y - RDB[loc0 + 1];
+
+                if (u*u + v*v > RDB[loc0 + 2])
+                  in = NO;
+                else
+                  in = YES;
+
+                break;
+              }
+            case CELL_PROG_OP_SPH:
+              {
+                u = x - RDB[loc0];
+                v = y - RDB[loc0 + 1];
+                w = z - RDB[loc0 + 2];
+
+                if (u*u + v*v + w*w > RDB[loc0 + 3])
+                  in = NO;
+                else
+                  in = YES;
+
+                break;
+              }
+            case CELL_PROG_OP_CUBE:
+              {
+                u = x - RDB[loc0];
+                v = y - RDB[loc0 + 1];
+                w = z - RDB[loc0 + 2];
+
+                if ((u > RDB[loc0 + 3]) || (u < -RDB[loc0 + 3]) ||
+                    (v > RDB[loc0 + 3]) || (v < -RDB[loc0 + 3]) ||
+                    (w > RDB[loc0 + 3]) || (w < -RDB[loc0 + 3]))
+                  in = NO;
+                else
+                  in = YES;
+
+                break;
+              }
+            case CELL_PROG_OP_CUBOID:
+              {
+                if ((x < RDB[loc0]) || (x > RDB[loc0 + 1]) ||
+                    (y < RDB[loc0 + 2]) || (y > RDB[loc0 + 3]) ||
+                    (z < RDB[loc0 + 4]) || (z > RDB[loc0 + 5]))
+                  in = NO;
+                else
+                  in = YES;
+
+                break;
+              }
+            case CELL_PROG_OP_SQC:
+              {
+                if (fabs(x - RDB[loc0]) > RDB[loc0 + 2])
+                  in = NO;
+                else if (fabs(y - RDB[loc0 + 1]) > RDB[loc0 + 2])
+                  in = NO;
+                else
+                  in = YES;
+
+                break;
+              }
+            case CELL_PROG_OP_PLANE:
+              {
+                if (RDB[loc0]*x + RDB[loc0 + 1]*y + RDB[loc0 + 2]*z
+                    < RDB[loc0 + 3])
+                  in = YES;
+                else
+                  in = NO;
+
+                break;
+              }
+            default:
+              {
+                /* Pointer to surface */
+
+                surf = (long)RDB[ptr + CELL_PROG_PTR_SURF];
+                CheckPointer(FUNCTION_NAME, "(surf)", DATA_ARRAY, surf);
+
+                /* Call surface test */
+
+                in = TestSurface(surf, x, y, z, on, id);
+              }
+            }
+
+          /* Get next instruction */
+
+          if (in == YES)
+            loc0 = (long)RDB[ptr + CELL_PROG_PTR_IN];
+          else
+            loc0 = (long)RDB[ptr + CELL_PROG_PTR_OUT];
+
+          /* Check exit */
+
+          if (loc0 == CELL_PROG_EXIT_OUT)
+            {
+              /* Store exit instruction for neighbour search */
+
+              loc0 = (long)RDB[DATA_CELL_PROG_EXIT];
+              CheckPointer(FUNCTION_NAME, "(loc0)", PRIVA_ARRAY, loc0);
+              PutPrivateData(loc0, ptr, id);
+
+              /* Add count */
+
+              if ((ptr = (long)RDB[ptr + CELL_PROG_PTR_OUT_COUNT]) > VALID_PTR)
+                AddPrivateData(ptr, 1.0, id);
+
+              /* Point is out */
+
+              return NO;
+            }
+          else if (loc0 == CELL_PROG_EXIT_IN)
+            {
+              /* Point is in */
+
+              return YES;
+            }
+
+          /* Next instruction */
+
+          ptr = loc0;
+        }
+
+      /***********************************************************************/
+    }
+  else if ((ptr = (long)RDB[cell + CELL_PTR_SURF_INSC]) > VALID_PTR)
     {
       /***********************************************************************/
 
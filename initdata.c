@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : initdata.c                                     */
 /*                                                                           */
 /* Created:       2010/11/21 (JLe)                                           */
-/* Last modified: 2020/05/11 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Inits values in main data block                              */
@@ -22,6 +22,9 @@
 void InitData()
 {
   long ptr;
+#ifdef OPEN_MP
+  long n;
+#endif
   double val;
   char *path, *strnomp, *seed, tmpstr[MAX_STR];
   struct timeb tb;
@@ -63,6 +66,10 @@ void InitData()
   SEED = NULL;
   SEED0 = NULL;
 
+#ifdef OPEN_MP
+  QUE_LOCK = NULL;
+#endif
+
   /* Allocate memory for random number seed vectors */
 
   SEED = (unsigned long *)Mem(MEM_ALLOC, MAX_OMP_THREADS*RNG_SZ,
@@ -70,6 +77,18 @@ void InitData()
   SEED0 = (unsigned long *)Mem(MEM_ALLOC, MAX_OMP_THREADS*RNG_SZ,
                               sizeof(unsigned long));
 
+#ifdef OPEN_MP
+
+  /* Allocate and init que locks */
+
+  QUE_LOCK = (omp_lock_t *)Mem(MEM_ALLOC, MAX_OMP_THREADS,
+                               sizeof(omp_lock_t));
+
+  for (n = 0; n < MAX_OMP_THREADS; n++)
+    omp_init_lock(&QUE_LOCK[n]);
+
+#endif
+
   /* Set pointer to standard output */
 
   if (mpiid == 0)
@@ -147,6 +166,11 @@ void InitData()
 
   WDB[DATA_ERG_TOL] = -1.0;
 
+  /* Lethargy-bucket index for energy grid search (off by default) */
+
+  WDB[DATA_ERG_LIDX] = (double)NO;
+  WDB[DATA_ERG_LIDX_PTS] = 4.0;
+
   WDB[DATA_NEUTRON_EMIN] = 1E-11;
   WDB[DATA_NEUTRON_EMAX] = 20.0;
 
@@ -320,6 +344,9 @@ void InitData()
   WDB[DATA_OPTI_UNIONIZE_GRID] = -1.0;
   WDB[DATA_OPTI_RECONSTRUCT_MICROXS] = -1.0;
   WDB[DATA_OPTI_RECONSTRUCT_MACROXS] = -1.0;
+  WDB[DATA_OPTI_XS_SP] = (double)NO;
+  WDB[DATA_OPTI_XS_SP_TOL] = 1E-6;
+  WDB[DATA_OPTI_ALIAS_TABLES] = (double)NO;
   WDB[DATA_OPTI_INCLUDE_SPECIALS] = (double)NO;
   WDB[DATA_OPTI_DIX] = -1.0;
 
@@ -335,6 +362,22 @@ void InitData()
   WDB[DATA_PRESORT_NP] = -1.0;
   WDB[DATA_PRESORT_NB] = 10.0;
 
+  /* Adaptive cell search mesh */
+
+  WDB[DATA_ADA_CSM_MODE] = (double)NO;
+  WDB[DATA_ADA_CSM_PTR_CACHE_DIR] = NULLPTR;
+
+  /* Regional delta-tracking majorants */
+
+  WDB[DATA_DT_REG_N0] = 0.0;
+  WDB[DATA_DT_REG_N1] = 0.0;
+  WDB[DATA_DT_REG_N2] = 0.0;
+  WDB[DATA_DT_REG_NP] = 1000.0;
+  WDB[DATA_DT_REG_NG] = 500.0;
+  WDB[DATA_DT_REG_PTR_MESH] = NULLPTR;
+  WDB[DATA_DT_REG_PTR_MAJ] = NULLPTR;
+  WDB[DATA_DT_REG_PTR_FAIL] = NULLPTR;
+
   /* Implicit Monte Carlo */
 
   WDB[DATA_OPT_IMPL_FISS] = -1.0;
@@ -493,6 +536,10 @@ void InitData()
   WDB[DATA_USE_DENSITY_FACTOR] = (double)NO;
   WDB[DATA_USE_DOPPLER_PREPROCESSOR] = (double)NO;
 
+  /* Windowed multipole data directory */
+
+  WDB[DATA_PTR_WMP_PATH] = NULLPTR;
+
   /* Ures energy boundaries */
 
   WDB[DATA_URES_EMIN] = INFTY;
@@ -523,6 +570,18 @@ void InitData()
 
   WDB[DATA_OPTI_SHARED_BUF] = (double)NO;
 
+  /* Hybrid scoring buffer (thread-wise hash tables flushed to shared */
+  /* buffer) and number of slots in table */
+
+  WDB[DATA_OPTI_HYBRID_BUF] = (double)NO;
+  WDB[DATA_HYBRID_BUF_SIZE] = 4096.0;
+
+  /* Sparse detector storage (minimum number of bins, zero = not in use) */
+  /* and number of pages */
+
+  WDB[DATA_SPARSE_BUF_MIN_BINS] = 0.0;
+  WDB[DATA_SPARSE_BUF_MAX_PAGES] = 1024.0;
+
   /* Shared RES2 array (NOTE: Tälle tehdään viritys initomp.c:ssä, */
   /* jotta arvoa voi muuttaa readinput.c:ssä). */
 
@@ -691,6 +750,11 @@ void InitData()
   WDB[DATA_GC_STAT_TESTS] = (double)NO;
   WDB[DATA_RUN_STAT_TESTS] = (double)NO;
 
+  /* Binary ACE cache */
+
+  WDB[DATA_ACE_CACHE_PTR_DIR] = NULLPTR;
+  WDB[DATA_ACE_CACHE_CHECK] = (double)YES;
+
   /* STL geometry stuff */
 
   WDB[DATA_STL_TEMP_ARRAY_SIZE] = 100.0;
@@ -985,6 +1049,15 @@ void InitData()
 
   WDB[DATA_COMMON_QUE_LIM] = 0.0;
 
+  /* Event-based transport mode and number of particles in bank */
+
+  WDB[DATA_EVENT_TRANSPORT] = (double)NO;
+  WDB[DATA_EVENT_BANK_SIZE] = 64.0;
+
+  /* Work stealing between OpenMP particle ques */
+
+  WDB[DATA_QUE_STEAL] = (double)NO;
+
   /* Default parameters for growing population simulation */
 
   WDB[DATA_GROW_POP_SIM] = (double)NO;
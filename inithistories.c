@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : inithistories.c                                */
 /*                                                                           */
 /* Created:       2011/04/01 (JLe)                                           */
-/* Last modified: 2019/10/16 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Initializes particle stacks, ques, source and bank for       */
@@ -30,40 +30,55 @@ void InitHistories()
 
   /***** Create lists ********************************************************/
 
-  /* Neutron stacks */
+  /* Neutron stacks (headers on separate cache lines) */
 
   loc0 = ReallocMem(DATA_ARRAY, (long)RDB[DATA_OMP_MAX_THREADS]);
   WDB[DATA_PART_PTR_NSTACK] = (double)loc0;
 
+  ptr = ReallocMem(DATA_ARRAY, ((long)RDB[DATA_OMP_MAX_THREADS] + 1)*
+                   PARTICLE_POOL_ALIGN);
+  ptr = ptr + PARTICLE_POOL_ALIGN - ptr % PARTICLE_POOL_ALIGN;
+
   for (id = 0; id < (long)RDB[DATA_OMP_MAX_THREADS]; id++)
     {
-      ptr = NewItem(loc0++, PARTICLE_BLOCK_SIZE);
-      WDB[ptr + PARTICLE_TYPE] = (double)PARTICLE_TYPE_DUMMY;
-      WDB[ptr + PARTICLE_RNG_IDX] = -1.0;
+      WDB[loc0++] = (double)ptr;
+      WDB[ptr + PART_STACK_PTR_TOP] = NULLPTR;
+      WDB[ptr + PART_STACK_TYPE] = (double)PARTICLE_TYPE_NEUTRON;
+      ptr = ptr + PARTICLE_POOL_ALIGN;
     }
 
-  /* Gamma stacks */
+  /* Gamma stacks (headers on separate cache lines) */
 
   loc0 = ReallocMem(DATA_ARRAY, (long)RDB[DATA_OMP_MAX_THREADS]);
   WDB[DATA_PART_PTR_GSTACK] = (double)loc0;
 
+  ptr = ReallocMem(DATA_ARRAY, ((long)RDB[DATA_OMP_MAX_THREADS] + 1)*
+                   PARTICLE_POOL_ALIGN);
+  ptr = ptr + PARTICLE_POOL_ALIGN - ptr % PARTICLE_POOL_ALIGN;
+
   for (id = 0; id < (long)RDB[DATA_OMP_MAX_THREADS]; id++)
     {
-      ptr = NewItem(loc0++, PARTICLE_BLOCK_SIZE);
-      WDB[ptr + PARTICLE_TYPE] = (double)PARTICLE_TYPE_DUMMY;
-      WDB[ptr + PARTICLE_RNG_IDX] = -1.0;
+      WDB[loc0++] = (double)ptr;
+      WDB[ptr + PART_STACK_PTR_TOP] = NULLPTR;
+      WDB[ptr + PART_STACK_TYPE] = (double)PARTICLE_TYPE_GAMMA;
+      ptr = ptr + PARTICLE_POOL_ALIGN;
     }
 
-  /* Precursor stacks */
+  /* Precursor stacks (headers on separate cache lines) */
 
   loc0 = ReallocMem(DATA_ARRAY, (long)RDB[DATA_OMP_MAX_THREADS]);
   WDB[DATA_PART_PTR_PSTACK] = (double)loc0;
 
+  ptr = ReallocMem(DATA_ARRAY, ((long)RDB[DATA_OMP_MAX_THREADS] + 1)*
+                   PARTICLE_POOL_ALIGN);
+  ptr = ptr + PARTICLE_POOL_ALIGN - ptr % PARTICLE_POOL_ALIGN;
+
   for (id = 0; id < (long)RDB[DATA_OMP_MAX_THREADS]; id++)
     {
-      ptr = NewItem(loc0++, PARTICLE_BLOCK_SIZE);
-      WDB[ptr + PARTICLE_TYPE] = (double)PARTICLE_TYPE_DUMMY;
-      WDB[ptr + PARTICLE_RNG_IDX] = -1.0;
+      WDB[loc0++] = (double)ptr;
+      WDB[ptr + PART_STACK_PTR_TOP] = NULLPTR;
+      WDB[ptr + PART_STACK_TYPE] = (double)PARTICLE_TYPE_PRECURSOR;
+      ptr = ptr + PARTICLE_POOL_ALIGN;
     }
 
   /* Particle ques */
@@ -136,6 +151,25 @@ void InitHistories()
 
   WDB[ptr + PARTICLE_U] = 2.0;
 
+  /* Que stealing is used only in dynamic modes (in criticality and */
+  /* external source modes the ques contain only the history being  */
+  /* tracked, and source points are already divided dynamically)    */
+
+  if (((long)RDB[DATA_QUE_STEAL] == YES) &&
+      (((long)RDB[DATA_SIMULATION_MODE] == SIMULATION_MODE_CRIT) ||
+       ((long)RDB[DATA_SIMULATION_MODE] == SIMULATION_MODE_SRC)))
+    {
+      Note(0, "Que stealing not used in criticality and source modes");
+      WDB[DATA_QUE_STEAL] = (double)NO;
+    }
+
+  /* Que stealing makes results depend on thread scheduling */
+
+  if (((long)RDB[DATA_QUE_STEAL] == YES) &&
+      ((long)RDB[DATA_OMP_MAX_THREADS] > 1) &&
+      ((long)RDB[DATA_OPTI_OMP_REPRODUCIBILITY] == YES))
+    Note(0, "OpenMP reproducibility not preserved with que stealing");
+
   /* Particle pool (no division to threads) */
 
   ptr = NewItem(DATA_PART_PTR_POOL, PARTICLE_BLOCK_SIZE);
@@ -148,6 +182,53 @@ void InitHistories()
   WDB[ptr + PARTICLE_TYPE] = (double)PARTICLE_TYPE_DUMMY;
   WDB[ptr + PARTICLE_RNG_IDX] = -1.0;
 
+  /* Ques for source histories in event-based transport mode (features */
+  /* that keep history-dependent data in thread-private caches are not */
+  /* supported, and scores are not added in the same order as in the   */
+  /* history-based mode, which breaks OpenMP reproducibility) */
+
+  if ((long)RDB[DATA_EVENT_TRANSPORT] == YES)
+    {
+      if ((long)RDB[DATA_SIMULATION_MODE] != SIMULATION_MODE_CRIT)
+        Note(0, "Event-based transport only in criticality source mode");
+      else if ((long)RDB[DATA_DD_DECOMPOSE] == YES)
+        Note(0, "Event-based transport not used with domain decomposition");
+      else if ((long)RDB[DATA_TMS_MODE] != TMS_MODE_NONE)
+        Note(0, "Event-based transport not used with TMS");
+      else if ((long)RDB[DATA_USE_URES] == YES)
+        Note(0, "Event-based transport not used with ures sampling");
+      else if ((long)RDB[DATA_SENS_MODE] != SENS_MODE_NONE)
+        Note(0, "Event-based transport not used with sensitivity mode");
+      else if ((long)RDB[DATA_COMMON_QUE_LIM] != 0)
+        Note(0, "Event-based transport not used with common que");
+      else if ((long)RDB[DATA_OPTI_OMP_REPRODUCIBILITY] == YES)
+        Note(0, "Event-based transport not used with OpenMP reproducibility");
+      else
+        {
+          /* Number of ques */
+
+          np = (long)RDB[DATA_OMP_MAX_THREADS]*
+            (long)RDB[DATA_EVENT_BANK_SIZE];
+
+          /* Allocate memory */
+
+          loc0 = ReallocMem(DATA_ARRAY, np);
+          WDB[DATA_PART_PTR_EVENT_QUE] = (double)loc0;
+
+          for (n = 0; n < np; n++)
+            {
+              ptr = NewItem(loc0++, PARTICLE_BLOCK_SIZE);
+              WDB[ptr + PARTICLE_TYPE] = (double)PARTICLE_TYPE_DUMMY;
+              WDB[ptr + PARTICLE_RNG_IDX] = -1.0;
+            }
+        }
+
+      /* Check if mode was switched off */
+
+      if ((long)RDB[DATA_PART_PTR_EVENT_QUE] < VALID_PTR)
+        WDB[DATA_EVENT_TRANSPORT] = (double)NO;
+    }
+
   /***************************************************************************/
 
   /***** Allocate memory for neutrons and photons ****************************/
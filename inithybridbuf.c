@@ -0,0 +1,87 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : inithybridbuf.c                                */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Allocates memory for thread-wise hash tables of hybrid       */
+/*              scoring buffer                                               */
+/*                                                                           */
+/* Comments: - The hybrid mode uses the shared BUF array, so the memory      */
+/*             size is close to the shared mode. Each thread has a table     */
+/*             with DATA_HYBRID_BUF_SIZE slots and a list of used slots.     */
+/*                                                                           */
+/*           - Not used with single thread, since the shared buffer has no   */
+/*             atomic overhead then.                                         */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "InitHybridBuf:"
+
+/*****************************************************************************/
+
+void InitHybridBuf()
+{
+  long ns, ptr;
+
+  /* Check mode */
+
+  if ((long)RDB[DATA_OPTI_HYBRID_BUF] == NO)
+    return;
+
+  /* Check number of threads */
+
+  if ((long)RDB[DATA_OMP_MAX_THREADS] == 1)
+    {
+      /* Not needed */
+
+      WDB[DATA_OPTI_HYBRID_BUF] = (double)NO;
+
+      /* Exit */
+
+      return;
+    }
+
+  /* Check that buffer is shared (option may be reset by "set shbuf") */
+
+  if ((long)RDB[DATA_OPTI_SHARED_BUF] == NO)
+    {
+      /* Print note */
+
+      Note(0, "Hybrid scoring buffer not used with private buffer");
+
+      /* Reset option */
+
+      WDB[DATA_OPTI_HYBRID_BUF] = (double)NO;
+
+      /* Exit */
+
+      return;
+    }
+
+  /* Round number of slots up to a power of 2 */
+
+  ns = 16;
+  while (ns < (long)RDB[DATA_HYBRID_BUF_SIZE])
+    ns = 2*ns;
+
+  WDB[DATA_HYBRID_BUF_SIZE] = (double)ns;
+
+  /* Allocate memory for table, list of used slots and counter */
+
+  ptr = AllocPrivateData(ns*HYBRID_BUF_BLOCK_SIZE, PRIVA_ARRAY);
+  WDB[DATA_PTR_HYBRID_BUF] = (double)ptr;
+
+  ptr = AllocPrivateData(ns, PRIVA_ARRAY);
+  WDB[DATA_PTR_HYBRID_BUF_LIST] = (double)ptr;
+
+  ptr = AllocPrivateData(1, PRIVA_ARRAY);
+  WDB[DATA_PTR_HYBRID_BUF_COUNT] = (double)ptr;
+}
+
+/*****************************************************************************/
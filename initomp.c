@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : initomp.c                                      */
 /*                                                                           */
 /* Created:       2011/11/11 (JLe)                                           */
-/* Last modified: 2019/04/03 (VVa)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Inits OpenMP related stuff                                   */
 /*                                                                           */
@@ -93,6 +93,21 @@ void InitOMP()
   ptr = ReallocMem(DATA_ARRAY, (long)RDB[DATA_OMP_MAX_THREADS]);
   WDB[DATA_PTR_OMP_COMPLETED] = (double)ptr;
 
+  /* Allocate memory for thread finish times and stolen particle counts */
+  /* (used for load balance statistics) */
+
+  ptr = ReallocMem(DATA_ARRAY, (long)RDB[DATA_OMP_MAX_THREADS]);
+  WDB[DATA_PTR_OMP_FINISH_TIME] = (double)ptr;
+
+  ptr = ReallocMem(DATA_ARRAY, (long)RDB[DATA_OMP_MAX_THREADS]);
+  WDB[DATA_PTR_OMP_STEAL_COUNT] = (double)ptr;
+
+  /* Allocate memory for next particle to be tracked from each que (used */
+  /* with que stealing) */
+
+  ptr = ReallocMem(DATA_ARRAY, (long)RDB[DATA_OMP_MAX_THREADS]);
+  WDB[DATA_PTR_OMP_QUE_NEXT] = (double)ptr;
+
   /***************************************************************************/
 }
 
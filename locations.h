@@ -132,6 +132,13 @@ enum block_DATA {
   DATA_PTR_XSTEST_FNAME,
   DATA_PTR_COVERXDATA_FNAME_LIST,
 
+/* Binary ACE cache */
+
+  DATA_ACE_CACHE_PTR_DIR,
+  DATA_ACE_CACHE_CHECK,
+  DATA_ACE_CACHE_N_READ,
+  DATA_ACE_CACHE_N_WRITE,
+
 /* Stuff for burnup calculation */
 
   DATA_PTR_COEF_BU_PT,
@@ -235,6 +242,8 @@ enum block_DATA {
   DATA_ERG_IMPORTANT_PTS,
   DATA_ERG_PTR_UNIONIZED_NGRID,
   DATA_ERG_PTR_UNIONIZED_PGRID,
+  DATA_ERG_LIDX,
+  DATA_ERG_LIDX_PTS,
 
 /* Minimum and maximum energy allowed in transport calculation */
 
@@ -426,6 +435,9 @@ enum block_DATA {
   DATA_OPTI_UNIONIZE_GRID,
   DATA_OPTI_RECONSTRUCT_MICROXS,
   DATA_OPTI_RECONSTRUCT_MACROXS,
+  DATA_OPTI_XS_SP,
+  DATA_OPTI_XS_SP_TOL,
+  DATA_OPTI_ALIAS_TABLES,
   DATA_OPTI_INCLUDE_SPECIALS,
   DATA_OPTI_MODE0_INCLUDE_TOTAL,
   DATA_OPTI_IMPLICIT_RR0,
@@ -434,6 +446,13 @@ enum block_DATA {
   DATA_OPTI_MG_MODE,
   DATA_OPTI_SHARED_BUF,
   DATA_OPTI_SHARED_RES2,
+  DATA_OPTI_HYBRID_BUF,
+  DATA_HYBRID_BUF_SIZE,
+  DATA_PTR_HYBRID_BUF,
+  DATA_PTR_HYBRID_BUF_LIST,
+  DATA_PTR_HYBRID_BUF_COUNT,
+  DATA_SPARSE_BUF_MIN_BINS,
+  DATA_SPARSE_BUF_MAX_PAGES,
   DATA_OPTI_OMP_REPRODUCIBILITY,
   DATA_OPTI_REPLAY,
   DATA_OPTI_ENTROPY_CALC,
@@ -442,6 +461,8 @@ enum block_DATA {
   DATA_OPTI_POISON_CALC,
   DATA_OPTI_POISON_CALC_XE135M,
   DATA_OPTI_MPI_BATCH_SIZE,
+  DATA_MPI_SEG_TOT,
+  DATA_MPI_SEG_REDUCED,
   DATA_OPTI_DIX,
   DATA_OPTI_EDDINGTON_CALC,
 
@@ -461,9 +482,22 @@ enum block_DATA {
   DATA_DT_ENFORCE_NEXT_TRACK,
   DATA_ST_USE_STL_MODE,
   DATA_CELL_SEARCH_LIST,
+  DATA_CELL_PROG_EXIT,
   DATA_MAX_CELL_SEARCH_LIST,
   DATA_PRESORT_NP,
   DATA_PRESORT_NB,
+  DATA_ADA_CSM_MODE,
+  DATA_ADA_CSM_PTR_CACHE_DIR,
+  DATA_DT_REG_N0,
+  DATA_DT_REG_N1,
+  DATA_DT_REG_N2,
+  DATA_DT_REG_NP,
+  DATA_DT_REG_NG,
+  DATA_DT_REG_LOG_EMIN,
+  DATA_DT_REG_LOG_DE,
+  DATA_DT_REG_PTR_MESH,
+  DATA_DT_REG_PTR_MAJ,
+  DATA_DT_REG_PTR_FAIL,
   DATA_GLOBAL_DF,
 
 /* Implicit Monte Carlo (TODO: ota toi OPT pois nimestä) */
@@ -547,6 +581,16 @@ enum block_DATA {
   DATA_PTR_OMP_HISTORY_COUNT,
   DATA_CONFIDENTIAL,
   DATA_COMMON_QUE_LIM,
+  DATA_EVENT_TRANSPORT,
+  DATA_EVENT_BANK_SIZE,
+  DATA_QUE_STEAL,
+  DATA_PTR_OMP_FINISH_TIME,
+  DATA_PTR_OMP_STEAL_COUNT,
+  DATA_PTR_OMP_QUE_NEXT,
+  DATA_OMP_PARA_T0,
+  DATA_OMP_PARA_SUM_MAX,
+  DATA_OMP_PARA_SUM_MEAN,
+  DATA_OMP_CYCLE_IMBALANCE,
 
 /* History index for debugging */
 
@@ -581,6 +625,7 @@ enum block_DATA {
   DATA_PART_PTR_LIMBO,
   DATA_PART_PTR_POOL,
   DATA_PART_PTR_COMMON_QUE,
+  DATA_PART_PTR_EVENT_QUE,
   DATA_PART_PTR_BANK,
   DATA_PART_PTR_TRK_BANK,
   DATA_PART_ALLOC_N,
@@ -912,6 +957,7 @@ enum block_DATA {
 
   DATA_USE_DOPPLER_PREPROCESSOR,
   DATA_TMS_MODE,
+  DATA_PTR_WMP_PATH,
   DATA_USE_DENSITY_FACTOR,
 
 /* Tracking collison counter */
@@ -975,6 +1021,7 @@ enum block_DATA {
   DATA_PTR_WORK_PRIVA_GRID1,
   DATA_PTR_WORK_PRIVA_GRID2,
   DATA_PTR_WORK_PRIVA_GRID3,
+  DATA_PTR_WORK_PRIVA_GRID4,
 
 /* Reaction sampling */
 
@@ -1005,6 +1052,9 @@ enum block_DATA {
   DATA_SORT_COUNT,
   DATA_NORM_PTR_RAD_SRC_MAT,
   DATA_MAX_DET_FLAGS,
+  DATA_PTR_DET_TAB,
+  DATA_PTR_DET_CAND_ALL,
+  DATA_PTR_DET_CAND_TYPE,
 
 /* Minimum xs for CFE */
 
@@ -1332,6 +1382,7 @@ enum block_RES {
   RES_ANA_CONV_RATIO,
   RES_CYCLE_RUNTIME,
   RES_CPU_USAGE,
+  RES_OMP_LOAD_IMBALANCE,
   RES_INI_SRC_WGT,
   RES_NEW_SRC_WGT,
   RES_SRC_WW_SPLIT,
@@ -1383,6 +1434,7 @@ enum block_RES {
   RES_ST_TRACK_FRAC,
   RES_DT_TRACK_FRAC,
   RES_DT_TRACK_EFF,
+  RES_ST_NBR_EFF,
   RES_IFC_COL_EFF,
   RES_TOT_COL_EFF,
   RES_REA_SAMPLING_EFF,
@@ -1417,6 +1469,7 @@ enum block_RES {
   RES_TMS_SAMPLING_EFF,
   RES_TMS_FAIL_STAT,
   RES_MIN_MACROXS,
+  RES_DT_REG_STAT,
 
   RES_STL_RAY_TEST,
 
@@ -1621,6 +1674,8 @@ enum block_MATERIAL {
   MATERIAL_PTR_TOTPHOTXS,
   MATERIAL_PTR_HEATPHOTXS,
   MATERIAL_PTR_TMP_MAJORANTXS,
+  MATERIAL_DT_REG_N,
+  MATERIAL_PTR_DT_REG_LIST,
   MATERIAL_MEM_SIZE,
   MATERIAL_TOT_DIV_MEM_SIZE,
   MATERIAL_PTR_SAB,
@@ -1651,6 +1706,7 @@ enum block_MATERIAL {
   MATERIAL_PTR_DATAIFC_ARR,
   MATERIAL_PROC_IDX,
   MATERIAL_BURN_IDX,
+  MATERIAL_BURN_MATRIX_NNZ,
   MATERIAL_PTR_GCU,
   MATERIAL_PTR_DIV,
   MATERIAL_DIV_TYPE,
@@ -1709,6 +1765,8 @@ enum block_MATERIAL {
   MATERIAL_CI_AVE_ABSXS2,
   MATERIAL_CI_IDE,
   MATERIAL_PTR_DETBIN,
+  MATERIAL_DET_IDX,
+  MATERIAL_PTR_DET_CAND,
   MATERIAL_PTR_INFLOW,
   MATERIAL_PTR_OUTFLOW,
   MATERIAL_FLOW_IDX,
@@ -1870,6 +1928,7 @@ enum block_NUCLIDE {
   NUCLIDE_PTR_ORIG_THERM,
   NUCLIDE_PTR_FISSE_DATA,
   NUCLIDE_PTR_NFXS,
+  NUCLIDE_PTR_WMP,
   NUCLIDE_BLOCK_SIZE
 };
 
@@ -1943,6 +2002,14 @@ enum block_BUF {
   BUF_BLOCK_SIZE
 };
 
+enum block_HYBRID_BUF {
+  HYBRID_BUF_IDX,
+  HYBRID_BUF_VAL,
+  HYBRID_BUF_WGT,
+  HYBRID_BUF_N,
+  HYBRID_BUF_BLOCK_SIZE
+};
+
 /* FET aliases */
 
 #define BUF_FET_VAL                   BUF_VAL
@@ -2007,6 +2074,9 @@ enum block_ENERGY_GRID {
   ENERGY_GRID_INTERP_MODE,
   ENERGY_GRID_ALLOC_NE,
   ENERGY_GRID_PTR_DIX_IDX,
+  ENERGY_GRID_PTR_LIDX,
+  ENERGY_GRID_LIDX_NB,
+  ENERGY_GRID_LIDX_INV,
   ENERGY_GRID_BLOCK_SIZE
 };
 
@@ -2034,6 +2104,7 @@ enum block_REACTION {
   REACTION_PTR_XS,
   REACTION_XS_I0,
   REACTION_XS_NE,
+  REACTION_XS_SP,
   REACTION_TGT_ZAI,
   REACTION_PTR_TGT,
   REACTION_PTR_BRANCH_PARENT,
@@ -2226,6 +2297,8 @@ enum block_ERG {
   ERG_LAW,
   ERG_INTERP,
   ERG_PTR_DATA,
+  ERG_PTR_ALIAS,
+  ERG_PTR_ANG_ALIAS,
   ERG_NR,
   ERG_PTR_INTERP,
   ERG_BLOCK_SIZE
@@ -2516,6 +2589,11 @@ enum block_SAB {
   SAB_FRAC,
   SAB_PTR_PREV_FRAC,
   SAB_PTR_PREV_SAB1,
+  SAB_PTR_REA_ELA,
+  SAB_PTR_REA_INL,
+  SAB_PTR_TIDX,
+  SAB_TIDX_N,
+  SAB_TIDX_DT,
   SAB_BLOCK_SIZE
 };
 
@@ -2539,6 +2617,28 @@ enum block_URES {
 
 /*****************************************************************************/
 
+/***** Windowed multipole resonance data *************************************/
+
+enum block_WMP {
+  WMP_EMIN,
+  WMP_EMAX,
+  WMP_SQRT_EMIN,
+  WMP_SPACING,
+  WMP_SQRT_AWR,
+  WMP_FISSILE,
+  WMP_N_POLES,
+  WMP_N_WINDOWS,
+  WMP_N_COEF,
+  WMP_PTR_POLES,
+  WMP_PTR_WINDOWS,
+  WMP_PTR_CURVEFIT,
+  WMP_PTR_OTHER_REA,
+  WMP_PTR_PREV_XS,
+  WMP_BLOCK_SIZE
+};
+
+/*****************************************************************************/
+
 /***** Angular distribution **************************************************/
 
 enum block_ANG {
@@ -2547,6 +2647,7 @@ enum block_ANG {
   ANG_PTR_D0,
   ANG_BINS,
   ANG_INTT,
+  ANG_PTR_ALIAS,
   ANG_BLOCK_SIZE
 };
 
@@ -2658,12 +2759,16 @@ enum block_CELL {
   CELL_UMSH_DET_BIN,
   CELL_PTR_BC_SURF,
   CELL_PTR_DETBIN,
+  CELL_DET_IDX,
+  CELL_PTR_DET_CAND,
   CELL_PTR_PREV_TET,
   CELL_PTR_TRANS,
   CELL_PTR_MC_VOLUME,
   CELL_PTR_MC_DENSITY,
   CELL_PTR_SEARCH_LIST,
   CELL_IMP,
+  CELL_PTR_PROG,
+  CELL_PTR_SURF_PACK,
   CELL_BLOCK_SIZE
 };
 
@@ -2686,6 +2791,55 @@ enum block_CELL_INSC {
   CELL_INSC_BLOCK_SIZE
 };
 
+/* Compiled cell program */
+
+#define CELL_PROG_EXIT_IN    -1
+#define CELL_PROG_EXIT_OUT   -2
+
+#define CELL_PROG_OP_CALL     0
+#define CELL_PROG_OP_INF      1
+#define CELL_PROG_OP_PX       2
+#define CELL_PROG_OP_PY       3
+#define CELL_PROG_OP_PZ       4
+#define CELL_PROG_OP_CYLX     5
+#define CELL_PROG_OP_CYLY     6
+#define CELL_PROG_OP_CYLZ     7
+#define CELL_PROG_OP_SPH      8
+#define CELL_PROG_OP_CUBE     9
+#define CELL_PROG_OP_CUBOID  10
+#define CELL_PROG_OP_SQC     11
+#define CELL_PROG_OP_PLANE   12
+
+enum block_CELL_PROG {
+  CELL_PROG_OP,
+  CELL_PROG_SIZE,
+  CELL_PROG_PTR_IN,
+  CELL_PROG_PTR_OUT,
+  CELL_PROG_PTR_OUT_COUNT,
+  CELL_PROG_PTR_SURF,
+  CELL_PROG_PTR_NBR1,
+  CELL_PROG_PTR_NBR2,
+  CELL_PROG_PTR_NBR3,
+  CELL_PROG_PTR_NBR4,
+  CELL_PROG_PARAMS
+};
+
+/* Number of cached neighbours per instruction */
+
+#define MAX_CELL_PROG_NBR 4
+
+/* Packed surface coefficients (group sizes followed by data) */
+
+enum block_SURF_PACK {
+  SURF_PACK_N_PLANE,
+  SURF_PACK_N_CYLX,
+  SURF_PACK_N_CYLY,
+  SURF_PACK_N_CYLZ,
+  SURF_PACK_N_SPH,
+  SURF_PACK_N_OTHER,
+  SURF_PACK_DATA
+};
+
 /*****************************************************************************/
 
 /***** Cell search mesh ******************************************************/        
@@ -2848,6 +3002,7 @@ enum block_PBED {
   PBED_PTR_UNI,
   PBED_PTR_PEBBLES,
   PBED_PTR_SEARCH_MESH,
+  PBED_PTR_GRID,
   PBED_PTR_BG_UNIV,
   PBED_CALC_RESULTS,
   PBED_PTR_COL_PEBBLE,
@@ -2866,6 +3021,29 @@ enum block_PEBBLE {
   PEBBLE_BLOCK_SIZE
 };
 
+/* Packed search grid (cell-wise pebble lists in contiguous arrays) */
+
+enum block_PBGRID {
+  PBGRID_N0,
+  PBGRID_N1,
+  PBGRID_N2,
+  PBGRID_MIN0,
+  PBGRID_MIN1,
+  PBGRID_MIN2,
+  PBGRID_PITCH0,
+  PBGRID_PITCH1,
+  PBGRID_PITCH2,
+  PBGRID_N_ENTRIES,
+  PBGRID_PTR_IDX,
+  PBGRID_PTR_X,
+  PBGRID_PTR_Y,
+  PBGRID_PTR_Z,
+  PBGRID_PTR_R2,
+  PBGRID_PTR_PBL,
+  PBGRID_PTR_COUNT,
+  PBGRID_BLOCK_SIZE
+};
+
 enum block_PEBTYPE {
   PEBTYPE_PTR_UNIV = LIST_DATA_SIZE,
   PEBTYPE_COUNT,
@@ -2914,6 +3092,9 @@ enum block_STL {
   STL_SEARCH_MESH_CELLS,
   STL_SEARCH_MODE,
   STL_SEARCH_MESH_V,
+  STL_PTR_BVH,
+  STL_PTR_BVH_SOLIDS,
+  STL_BVH_NODES,
   STL_BLOCK_SIZE
 };
 
@@ -2955,6 +3136,9 @@ enum block_STL_SOLID {
   STL_SOLID_ZMAX,
   STL_SOLID_PTR_BODY,
   STL_SOLID_REG_IDX,
+  STL_SOLID_PTR_BVH,
+  STL_SOLID_PTR_BVH_TRI,
+  STL_SOLID_BVH_NODES,
   STL_SOLID_BLOCK_SIZE
 };
 
@@ -2991,6 +3175,38 @@ enum block_STL_SEARCH_MESH_CONTENT {
   STL_SEARCH_MESH_CONTENT_BLOCK_SIZE
 };
 
+/* STL bounding volume hierarchy node (children are stored next to each */
+/* other, leaves have no children) */
+
+enum block_STL_BVH {
+  STL_BVH_XMIN,
+  STL_BVH_XMAX,
+  STL_BVH_YMIN,
+  STL_BVH_YMAX,
+  STL_BVH_ZMIN,
+  STL_BVH_ZMAX,
+  STL_BVH_CHILD,
+  STL_BVH_FIRST,
+  STL_BVH_N,
+  STL_BVH_BLOCK_SIZE
+};
+
+/* STL facet in BVH order */
+
+enum block_STL_BVH_TRI {
+  STL_BVH_TRI_X1,
+  STL_BVH_TRI_Y1,
+  STL_BVH_TRI_Z1,
+  STL_BVH_TRI_X2,
+  STL_BVH_TRI_Y2,
+  STL_BVH_TRI_Z2,
+  STL_BVH_TRI_X3,
+  STL_BVH_TRI_Y3,
+  STL_BVH_TRI_Z3,
+  STL_BVH_TRI_PTR_FACET,
+  STL_BVH_TRI_BLOCK_SIZE
+};
+
 /*****************************************************************************/
 
 /***** Search mesh ***********************************************************/
@@ -3158,12 +3374,19 @@ enum block_IFC_REG_MSH_LIST {
 #define IFC_TET_PRNT_ZMAX               (LIST_DATA_SIZE + 10)
 #define IFC_TET_PRNT_STAT_IDX           (LIST_DATA_SIZE + 11)
 
-#define TET_BLOCK_SIZE                    9
+#define TET_BLOCK_SIZE                   25
 
 #define TET_PTR_PARENT                    0
 #define TET_POINTS                        1
 #define TET_NEIGHBOURS                    5
 
+/* Packed face planes (unit normal and constant for each face) */
+
+#define TET_FACE_U                        9
+#define TET_FACE_V                       13
+#define TET_FACE_W                       17
+#define TET_FACE_D                       21
+
 /* Minimal surface-type for UMSH-cells */
 
 enum block_UMSH_SURF {
@@ -3592,6 +3815,24 @@ enum block_DET {
   DET_PTR_SENS_STAT_ARRAY,
   DET_SKIP_FRAC,
   DET_PTR_TRANS,
+  DET_FLAG_MASK_SET,
+  DET_FLAG_MASK_UNSET,
+  DET_FLAG_MASK_AND_SET,
+  DET_FLAG_MASK_AND_UNSET,
+  DET_STRIDE_E,
+  DET_STRIDE_U,
+  DET_STRIDE_C,
+  DET_STRIDE_M,
+  DET_STRIDE_L,
+  DET_STRIDE_I,
+  DET_STRIDE_T,
+  DET_PTR_CBIN_TAB,
+  DET_CBIN_TAB_IDX0,
+  DET_CBIN_TAB_SZ,
+  DET_PTR_MBIN_TAB,
+  DET_MBIN_TAB_IDX0,
+  DET_MBIN_TAB_SZ,
+  DET_IDX,
   DET_BLOCK_SIZE
 };
 
@@ -4077,6 +4318,13 @@ enum block_SCORE {
   SCORE_PTR_BUF,
   SCORE_STAT_SIZE,
   SCORE_PTR_HIS,
+  SCORE_SPARSE,
+  SCORE_N_PAGES,
+  SCORE_MAX_PAGES,
+  SCORE_PTR_PAGE_TAB,
+  SCORE_PTR_RES_PAGE_TAB,
+  SCORE_RES_PAGES,
+  SCORE_SPARSE_N,
   SCORE_BLOCK_SIZE
 };
 
@@ -4213,6 +4461,16 @@ enum block_FISS_PROG {
 
 #endif
 
+/* Particle stacks (LIFO free lists of pool records, linked through */
+/* LIST_PTR_NEXT) */
+
+enum block_PART_STACK {
+  PART_STACK_PTR_TOP,
+  PART_STACK_N,
+  PART_STACK_TYPE,
+  PART_STACK_BLOCK_SIZE
+};
+
 /*****************************************************************************/
 
 /***** Event array ***********************************************************/
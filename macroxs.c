@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : macroxs.c                                      */
 /*                                                                           */
 /* Created:       2011/01/02 (JLe)                                           */
-/* Last modified: 2019/11/10 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Interpolates macroscopic cross section                       */
@@ -22,8 +22,9 @@
 
 double MacroXS(long rea0, double E, long id)
 {
-  long i, ptr, rea, erg, ne, mat, nuc, ncol, mt;
-  double xs0, xs1, xs, adens, f, mult, Emin, Emax, Er, T;
+  long i, ptr, rea, erg, ne, mat, nuc, ncol, mt, batch;
+  double xs0, xs1, xs, adens, f, mult, Emin, Emax, Er, T, nxs[NUC_XS_N];
+  const float *sp;
 
   /* Check Pointer */
 
@@ -34,6 +35,16 @@ double MacroXS(long rea0, double E, long id)
   mt = (long)RDB[rea0 + REACTION_MT];
   CheckValue(FUNCTION_NAME, "mt", "", mt, -57, -1);
 
+  /* Check if reaction cross sections of nuclides are interpolated */
+  /* together (needed for scoring at the same energy) */
+
+  if ((mt == MT_MACRO_ABSXS) || (mt == MT_MACRO_ELAXS) ||
+      (mt == MT_MACRO_FISSXS) || (mt == MT_MACRO_NSF) ||
+      (mt == MT_MACRO_FISSE))
+    batch = YES;
+  else
+    batch = NO;
+
   /* Get pointer to material */
 
   mat = (long)RDB[rea0 + REACTION_PTR_MAT];
@@ -104,8 +115,24 @@ double MacroXS(long rea0, double E, long id)
             {
               /* Get tabulated cross sections */
 
-              xs0 = RDB[ptr + i];
-              xs1 = RDB[ptr + i + 1];
+              if ((long)RDB[rea0 + REACTION_XS_SP] == YES)
+                {
+                  /* Single-precision data (see packxs.c) */
+
+                  sp = (const float *)&RDB[ptr];
+
+                  xs0 = (double)sp[i];
+
+                  if (i < ne - 1)
+                    xs1 = (double)sp[i + 1];
+                  else
+                    xs1 = 0.0;
+                }
+              else
+                {
+                  xs0 = RDB[ptr + i];
+                  xs1 = RDB[ptr + i + 1];
+                }
 
               if (mt != MT_MACRO_TMP_MAJORANTXS)
                 {
@@ -300,7 +327,29 @@ double MacroXS(long rea0, double E, long id)
 
           /* Add to cross section */
 
-          if (mt != MT_MACRO_TMP_MAJORANTXS)
+          if (batch == YES)
+            {
+              /* Pointer to nuclide */
+
+              nuc = (long)RDB[rea + REACTION_PTR_NUCLIDE];
+              CheckPointer(FUNCTION_NAME, "(nuc)", DATA_ARRAY, nuc);
+
+              /* Interpolate cross sections of nuclide in a single pass */
+
+              NuclideMicroXS(nuc, E, nxs, id);
+
+              /* Get value */
+
+              if (rea == (long)RDB[nuc + NUCLIDE_PTR_SUM_ABSXS])
+                xs = xs + mult*adens*nxs[NUC_XS_ABS];
+              else if (rea == (long)RDB[nuc + NUCLIDE_PTR_ELAXS])
+                xs = xs + mult*adens*nxs[NUC_XS_ELA];
+              else if (rea == (long)RDB[nuc + NUCLIDE_PTR_FISSXS])
+                xs = xs + mult*adens*nxs[NUC_XS_FISS];
+              else
+                xs = xs + mult*adens*MicroXS(rea, E, id);
+            }
+          else if (mt != MT_MACRO_TMP_MAJORANTXS)
             xs = xs + mult*adens*MicroXS(rea, E, id);
 
           /* In case of majorantxs, use MicroMajorantXS */
@@ -361,7 +410,29 @@ double MacroXS(long rea0, double E, long id)
 
       /* Add to cross section */
 
-      if (mt != MT_MACRO_TMP_MAJORANTXS)
+      if (batch == YES)
+        {
+          /* Pointer to nuclide */
+
+          nuc = (long)RDB[rea + REACTION_PTR_NUCLIDE];
+          CheckPointer(FUNCTION_NAME, "(nuc)", DATA_ARRAY, nuc);
+
+          /* Interpolate cross sections of nuclide in a single pass */
+
+          NuclideMicroXS(nuc, E, nxs, id);
+
+          /* Get value */
+
+          if (rea == (long)RDB[nuc + NUCLIDE_PTR_SUM_ABSXS])
+            xs = xs + mult*adens*nxs[NUC_XS_ABS];
+          else if (rea == (long)RDB[nuc + NUCLIDE_PTR_ELAXS])
+            xs = xs + mult*adens*nxs[NUC_XS_ELA];
+          else if (rea == (long)RDB[nuc + NUCLIDE_PTR_FISSXS])
+            xs = xs + mult*adens*nxs[NUC_XS_FISS];
+          else
+            xs = xs + mult*adens*MicroXS(rea, E, id);
+        }
+      else if (mt != MT_MACRO_TMP_MAJORANTXS)
         xs = xs + mult*adens*MicroXS(rea, E, id);
 
       /* In case of majorantxs, use MicroMajorantXS */
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : main.c                                         */
 /*                                                                           */
 /* Created:       2010/11/22 (JLe)                                           */
-/* Last modified: 2020/06/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Main program file                                            */
@@ -384,6 +384,11 @@ int main(int argc, char** argv)
 
           ProcessBC();
 
+          /* Compile cell definitions (must be called after all cells are */
+          /* created and surfaces are linked) */
+
+          CompileCells();
+
           /* Update memory size */
 
           WDB[DATA_TOT_MISC_BYTES] = RDB[DATA_TOT_MISC_BYTES] +
@@ -521,6 +526,10 @@ int main(int argc, char** argv)
 
           PrepareCellSearchMesh();
 
+          /* Prepare regions for delta-tracking majorants */
+
+          PrepareDTRegions();
+
           /* Pre-sort cell lists */
 
           PreSort();
@@ -709,6 +718,10 @@ int main(int argc, char** argv)
 
       WDB[DATA_TOT_RES_BYTES] = RDB[DATA_TOT_RES_BYTES] + (double)MemCount();
 
+      /* Allocate memory for hybrid scoring buffer */
+
+      InitHybridBuf();
+
       /* Init particle structures */
 
       InitHistories();
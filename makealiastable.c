@@ -0,0 +1,86 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : makealiastable.c                               */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Creates Walker's alias table for sampling the bin of a       */
+/*              tabulated cumulative distribution                            */
+/*                                                                           */
+/* Comments: - Input is pointer to CDF array of np values in DATA array.     */
+/*             The returned data block contains alias1, alias2 and cutoff    */
+/*             arrays of np - 1 values (see walkeralias.c).                  */
+/*                                                                           */
+/*           - Negative bin probabilities (non-monotonous CDF) are set to    */
+/*             zero. Null pointer is returned if all probabilities are zero. */
+/*                                                                           */
+/*           - Used in ProcessEDistributions() and ProcessMuDistributions()  */
+/*             if "set aliastab" option is in use.                           */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "MakeAliasTable:"
+
+/*****************************************************************************/
+
+long MakeAliasTable(long cdf, long np)
+{
+  long ptr, n;
+  double *p, sum;
+
+  /* Check pointer and number of points */
+
+  CheckPointer(FUNCTION_NAME, "(cdf)", DATA_ARRAY, cdf);
+  CheckValue(FUNCTION_NAME, "np", "", np, 2, 1000000);
+
+  /* Allocate memory for bin probabilities */
+
+  p = (double *)Mem(MEM_ALLOC, np - 1, sizeof(double));
+
+  /* Calculate probabilities */
+
+  sum = 0.0;
+
+  for (n = 0; n < np - 1; n++)
+    {
+      if ((p[n] = RDB[cdf + n + 1] - RDB[cdf + n]) < 0.0)
+        p[n] = 0.0;
+
+      sum = sum + p[n];
+    }
+
+  /* Check sum */
+
+  if (sum == 0.0)
+    {
+      /* Free memory and return null pointer */
+
+      Mem(MEM_FREE, p);
+
+      return NULLPTR;
+    }
+
+  /* Allocate memory for table */
+
+  ptr = ReallocMem(DATA_ARRAY, 3*(np - 1));
+
+  /* Create alias and cutoff arrays */
+
+  WalkerAliasInit(p, np - 1, &WDB[ptr], &WDB[ptr + np - 1],
+                  &WDB[ptr + 2*(np - 1)]);
+
+  /* Free memory */
+
+  Mem(MEM_FREE, p);
+
+  /* Return pointer */
+
+  return ptr;
+}
+
+/*****************************************************************************/
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : makeenergygrid.c                               */
 /*                                                                           */
 /* Created:       2010/12/09 (JLe)                                           */
-/* Last modified: 2014/05/21 (JLe)                                           */
-/* Version:       2.1.21                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Allocates memory and stores energy array in a search grid    */
 /*              based on a binary tree                                       */
@@ -106,6 +106,7 @@ long MakeEnergyGrid(long ne, long i0, long lvl, long ptr,
   WDB[erg + ENERGY_GRID_PTR_LOW] = NULLPTR;
   WDB[erg + ENERGY_GRID_PTR_HIGH] = NULLPTR;
   WDB[erg + ENERGY_GRID_PTR_BINS] = NULLPTR;
+  WDB[erg + ENERGY_GRID_PTR_LIDX] = NULLPTR;
 
   /* Reset mid-point energy and number of bins */
 
@@ -136,6 +137,13 @@ long MakeEnergyGrid(long ne, long i0, long lvl, long ptr,
 
   WDB[erg + ENERGY_GRID_TYPE] = (double)type;
 
+  /* Set up lethargy-bucket index for top level (search tree is not */
+  /* needed if index is used) */
+
+  if (lvl == 0)
+    if (MakeLethargyIndex(erg) == YES)
+      return erg;
+
   /* TÄÄ !!!!!!!!!!!!!!!!!!!!!! */
   /*
   return erg;
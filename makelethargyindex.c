@@ -0,0 +1,115 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : makelethargyindex.c                            */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Sets up lethargy-bucket index for energy grid search         */
+/*                                                                           */
+/* Comments: - The lethargy range of the grid is divided into equal-width    */
+/*             buckets, and the index of the grid interval containing the    */
+/*             lower boundary of each bucket is stored. GridSearch() then    */
+/*             finds the interval by direct indexing followed by a short     */
+/*             search limited to a single bucket.                            */
+/*                                                                           */
+/*           - Index is used with "set egrididx" for grids larger than       */
+/*             EGRID_LIDX_MIN_NE points. Returns YES if the index was set    */
+/*             up, in which case the search tree is not needed.              */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "MakeLethargyIndex:"
+
+/*****************************************************************************/
+
+long MakeLethargyIndex(long erg)
+{
+  long ne, nb, ptr, loc0, n, i;
+  double u0, u1, Eb;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(erg)", DATA_ARRAY, erg);
+
+  /* Reset pointer */
+
+  WDB[erg + ENERGY_GRID_PTR_LIDX] = NULLPTR;
+
+  /* Check option */
+
+  if ((long)RDB[DATA_ERG_LIDX] == NO)
+    return NO;
+
+  /* Get number of points */
+
+  ne = (long)RDB[erg + ENERGY_GRID_NE];
+
+  /* Check size, first index and minimum energy (log grid needed) */
+
+  if ((ne < EGRID_LIDX_MIN_NE) || ((long)RDB[erg + ENERGY_GRID_I0] != 0) ||
+      (RDB[erg + ENERGY_GRID_EMIN] <= 0.0))
+    return NO;
+
+  /* Get lethargy boundaries */
+
+  u0 = RDB[erg + ENERGY_GRID_LOG_EMIN];
+  u1 = RDB[erg + ENERGY_GRID_LOG_EMAX];
+
+  if (u1 <= u0)
+    return NO;
+
+  /* Number of buckets */
+
+  if ((nb = (long)((double)ne/RDB[DATA_ERG_LIDX_PTS])) < 1)
+    nb = 1;
+
+  /* Allocate memory for index (upper boundary included) */
+
+  loc0 = ReallocMem(DATA_ARRAY, nb + 1);
+
+  /* Pointer to grid data */
+
+  ptr = (long)RDB[erg + ENERGY_GRID_PTR_DATA];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  /* Loop over bucket boundaries */
+
+  i = 0;
+
+  for (n = 0; n < nb + 1; n++)
+    {
+      /* Energy at lower boundary */
+
+      Eb = exp(u0 + ((double)n/((double)nb))*(u1 - u0));
+
+      /* Find last interval starting below boundary */
+
+      while ((i < ne - 2) && (RDB[ptr + i + 1] <= Eb))
+        i++;
+
+      /* Put index */
+
+      WDB[loc0 + n] = (double)i;
+    }
+
+  /* Last boundary is the end of grid (avoid round-off) */
+
+  WDB[loc0 + nb] = (double)(ne - 2);
+
+  /* Put data */
+
+  WDB[erg + ENERGY_GRID_LIDX_NB] = (double)nb;
+  WDB[erg + ENERGY_GRID_LIDX_INV] = (double)nb/(u1 - u0);
+  WDB[erg + ENERGY_GRID_PTR_LIDX] = (double)loc0;
+
+  /* Exit */
+
+  return YES;
+}
+
+/*****************************************************************************/
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : materialtotals.c                               */
 /*                                                                           */
 /* Created:       2011/01/02 (JLe)                                           */
-/* Last modified: 2018/11/13 (RTu)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Calculates material-wise total cross sections                */
 /*                                                                           */
@@ -16,6 +16,9 @@
 /*           - Tosta poistettiin #ifdef-lauseella kommentoitu vaihtoehtoinen */
 /*             tapa 14.3.2017 / 1.1.31.                                      */
 /*                                                                           */
+/*           - Single-precision storage added 17.10.2026 / 2.1.32 / JLe.     */
+/*             The error is checked in PackXS().                             */
+/*                                                                           */
 /*****************************************************************************/
 
 #include "header.h"
@@ -114,7 +117,7 @@ void MaterialTotals0(long mat)
 {
   long n, mode, rea, loc0, loc1, loc2, loc3, ptr, pte, sz, i0, m, ne, erg, id;
   long nemax, nuc, nr, idx, fortms, arr;
-  double Emin, Emax, adens, *xs, *tot, *nubar, mult, *fisse;
+  double Emin, Emax, adens, *xs, *tot, *nubar, mult, *fisse, err;
 
   /* Check div type */
 
@@ -444,12 +447,18 @@ void MaterialTotals0(long mat)
 
       ne = (long)RDB[erg + ENERGY_GRID_NE];
 
-      /* Pointer to cross section data */
+      /* Pointer to cross section data (single-precision data is summed */
+      /* in temporary array and stored after the loop) */
 
-      ptr = (long)RDB[loc0 + REACTION_PTR_XS];
-      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+      if ((long)RDB[loc0 + REACTION_XS_SP] == YES)
+        tot = WorkArray(DATA_PTR_WORK_PRIVA_GRID4, PRIVA_ARRAY, ne, id);
+      else
+        {
+          ptr = (long)RDB[loc0 + REACTION_PTR_XS];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
 
-      tot = &WDB[ptr];
+          tot = &WDB[ptr];
+        }
 
       /* Reset total array */
 
@@ -723,6 +732,13 @@ void MaterialTotals0(long mat)
               }
             }
         }
+
+      /* Store single-precision data and check error */
+
+      if ((long)RDB[loc0 + REACTION_XS_SP] == YES)
+        if ((err = PackXS(loc0, tot, ne)) > RDB[DATA_OPTI_XS_SP_TOL])
+          Error(0, "Single-precision error %1.1E exceeds tolerance in %s",
+                err, GetText(mat + MATERIAL_PTR_NAME));
     }
 
   /* Free allocated memory */
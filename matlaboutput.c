@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : matlaboutput.c                                 */
 /*                                                                           */
 /* Created:       2011/03/13 (JLe)                                           */
-/* Last modified: 2019/10/11 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Prints standard output in Matlab format file                 */
@@ -351,6 +351,9 @@ void MatlabOutput()
       fprintf(fp, "DOUBLE_INDEXING           (idx, 1)        = %ld ;\n",
               (long)RDB[DATA_OPTI_DIX]);
 
+      fprintf(fp, "LETHARGY_INDEXING         (idx, 1)        = %ld ;\n",
+              (long)RDB[DATA_ERG_LIDX]);
+
       fprintf(fp, "MG_MAJORANT_MODE          (idx, 1)        = %ld ;\n",
               (long)RDB[DATA_OPTI_MG_MODE]);
 
@@ -404,6 +407,9 @@ void MatlabOutput()
       fprintf(fp, "SHARE_BUF_ARRAY           (idx, 1)        = %ld ;\n",
               (long)RDB[DATA_OPTI_SHARED_BUF]);
 
+      fprintf(fp, "HYBRID_BUF_ARRAY          (idx, 1)        = %ld ;\n",
+              (long)RDB[DATA_OPTI_HYBRID_BUF]);
+
       fprintf(fp, "SHARE_RES2_ARRAY          (idx, 1)        = %ld ;\n",
               (long)RDB[DATA_OPTI_SHARED_RES2]);
 
@@ -412,6 +418,18 @@ void MatlabOutput()
       fprintf(fp, "OMP_SHARED_QUEUE_LIM      (idx, 1)        = %ld ;\n",
               (long)RDB[DATA_COMMON_QUE_LIM]);
 
+      fprintf(fp, "OMP_QUEUE_STEAL           (idx, 1)        = %ld ;\n",
+              (long)RDB[DATA_QUE_STEAL]);
+
+      /* Event-based transport */
+
+      fprintf(fp, "EVENT_TRANSPORT           (idx, 1)        = %ld ;\n",
+              (long)RDB[DATA_EVENT_TRANSPORT]);
+
+      if ((long)RDB[DATA_EVENT_TRANSPORT] == YES)
+        fprintf(fp, "EVENT_BANK_SIZE           (idx, 1)        = %ld ;\n",
+                (long)RDB[DATA_EVENT_BANK_SIZE]);
+
       /***********************************************************************/
 
       /***** File paths ******************************************************/
@@ -521,6 +539,7 @@ void MatlabOutput()
       PrintValues(fp, "ST_FRAC", RES_ST_TRACK_FRAC, 2, -1, -1, 0, 0);
       PrintValues(fp, "DT_FRAC", RES_DT_TRACK_FRAC, 2, -1, -1, 0, 0);
       PrintValues(fp, "DT_EFF", RES_DT_TRACK_EFF, 2, -1, -1, 0, 0);
+      PrintValues(fp, "ST_NBR_EFF", RES_ST_NBR_EFF, 1, -1, -1, 0, 0);
 
       if ((long)RDB[DATA_PTR_IFC0] > VALID_PTR)
         PrintValues(fp, "IFC_COL_EFF", RES_IFC_COL_EFF, 2, -1, -1, 0, 0);
@@ -539,6 +558,19 @@ void MatlabOutput()
       if ((long)RDB[DATA_TMS_MODE] != TMS_MODE_NONE)
         PrintValues(fp, "TMS_FAIL_STAT", RES_TMS_FAIL_STAT,3,-1,-1,1,0);
 
+      /* Regional delta-tracking majorants (virtual-to-real collision */
+      /* ratio, fraction of collisions and majorant failure fraction) */
+
+      if ((ptr = (long)RDB[DATA_DT_REG_PTR_MESH]) > VALID_PTR)
+        {
+          n = (long)(RDB[ptr + MESH_N0]*RDB[ptr + MESH_N1]*RDB[ptr + MESH_N2]);
+
+          PrintValues(fp, "DT_REG_VIRT_RATIO", RES_DT_REG_STAT, n, 1, -1, 0,
+                      0);
+          PrintValues(fp, "DT_REG_COL_FRAC", RES_DT_REG_STAT, n, 1, -1, 0, 1);
+          PrintValues(fp, "DT_REG_MAJ_FAIL", RES_DT_REG_STAT, n, 1, -1, 0, 2);
+        }
+
       if ((long)RDB[DATA_USE_DBRC] == YES)
         {
           /* DBRC majorant exceed fraction */
@@ -654,11 +686,18 @@ void MatlabOutput()
 
           fprintf(fp, "BATEMAN_SOLUTION_TIME     (idx, [1:  2])  = [ %12.5E %12.5E ];\n",
                   TimerVal(TIMER_BATEMAN_TOTAL)/60.0, TimerVal(TIMER_BATEMAN)/60.0);
+
+          fprintf(fp, "DEPLETION_SOLUTION_TIME   (idx, [1:  2])  = [ %12.5E %12.5E ];\n",
+                  TimerVal(TIMER_DEPLETION_TOTAL)/60.0, TimerVal(TIMER_DEPLETION)/60.0);
         }
 
       fprintf(fp, "MPI_OVERHEAD_TIME         (idx, [1:  2])  = [ %12.5E %12.5E ];\n",
               TimerVal(TIMER_MPI_OVERHEAD_TOTAL)/60.0, TimerVal(TIMER_MPI_OVERHEAD)/60.0);
 
+      if (mpitasks > 1)
+        fprintf(fp, "MPI_REDUCED_SEGMENTS      (idx, [1:  2])  = [ %ld %ld ];\n",
+                (long)RDB[DATA_MPI_SEG_REDUCED], (long)RDB[DATA_MPI_SEG_TOT]);
+
 
       if ((long)RDB[DATA_DD_DECOMPOSE] == YES)
         fprintf(fp, "DD_OVERHEAD_TIME          (idx, 1)        = %12.5E ;\n",
@@ -682,6 +721,8 @@ void MatlabOutput()
                 0.0);
 
       PrintValues(fp, "TRANSPORT_CPU_USAGE", RES_CPU_USAGE, 1, -1, -1, 0, 0);
+      PrintValues(fp, "OMP_LOAD_IMBALANCE", RES_OMP_LOAD_IMBALANCE, 2, -1, -1,
+                  0, 0);
 
       P = TimerVal(TIMER_OMP_PARA)/TimerVal(TIMER_RUNTIME);
       fprintf(fp, "OMP_PARALLEL_FRAC         (idx, 1)        = %12.5E ;\n", P);
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : matrixexponential.c                            */
 /*                                                                           */
 /* Created:       2011/05/03 (MPu)                                           */
-/* Last modified: 2015/04/08 (JLe)                                           */
-/* Version:       2.1.24                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description:                                                              */
 /*                                                                           */
@@ -23,7 +23,8 @@
 /* A = palamamatriisi, N0 = nukliditiehydet alussa, t = aika-askel,   */
 /* cram_k = CRAM-kertaluku, funktio palauttaa ratkaisun N = exp(At)N0 */
 
-double *MatrixExponential(struct ccsMatrix *A, double *N0, double t)
+double *MatrixExponential(struct ccsMatrix *A, double *N0, double t,
+                          struct ccsMatrix **LU0)
 {
   long i, j, k, n, m, cram_k;
  
@@ -306,9 +307,20 @@ double *MatrixExponential(struct ccsMatrix *A, double *N0, double t)
   /* Lasketaan ensin symbolinen LU-hajotelma (tm tarvitsee tehd */
   /* vain kerran) */
 
-  LU = SymbolicLU(A);
-  /* Hae rivi-informaatio numeerista eliminaatiota varten */
-  FindRowIndexes(LU);
+  /* Re-use symbolic decomposition from previous material if given */
+  /* (JLe 17.10.2026 / 2.1.32) */
+
+  if (LU0 != NULL)
+    {
+      LU = ReuseSymbolicLU(A, *LU0);
+      *LU0 = LU;
+    }
+  else
+    {
+      LU = SymbolicLU(A);
+      /* Hae rivi-informaatio numeerista eliminaatiota varten */
+      FindRowIndexes(LU);
+    }
 
   /* Tarkastetaan matriisin LU alkiot */
   
@@ -399,7 +411,9 @@ double *MatrixExponential(struct ccsMatrix *A, double *N0, double t)
   Mem(MEM_FREE, b);
   Mem(MEM_FREE, N0c);
   Mem(MEM_FREE, x, 0);
-  ccsMatrixFree(LU);
+
+  if (LU0 == NULL)
+    ccsMatrixFree(LU);
   
   Mem(MEM_FREE, val);
 
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : mcdf.c                                         */
 /*                                                                           */
 /* Created:       2013/03/08 (JLe)                                           */
-/* Last modified: 2013/03/08 (JLe)                                           */
-/* Version:       2.1.13                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Laskee epäjatkuvuustekijöiden laskentaan tarvittavan         */
 /*              homogeenisen vuon moniryhmäisellä Monte Carlolla             */
@@ -260,7 +260,7 @@ void MCDF()
   ptr = (long)RDB[DATA_PART_PTR_SOURCE];
   printf("source = %ld\n", ListSize(ptr) - 1);
   ptr = (long)RDB[OMPPtr(DATA_PART_PTR_NSTACK, id)];
-  printf("stack = %ld\n", ListSize(ptr) - 1);
+  printf("stack = %ld\n", (long)RDB[ptr + PART_STACK_N]);
   ptr = (long)RDB[OMPPtr(DATA_PART_PTR_BANK, id)];
   printf("bank = %ld\n", ListSize(ptr) - 1);
   ptr = (long)RDB[OMPPtr(DATA_PART_PTR_QUE, id)];
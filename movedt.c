@@ -3,12 +3,20 @@
 /* serpent 2 (beta-version) : movedt.c                                       */
 /*                                                                           */
 /* Created:       2012/10/05 (JLe)                                           */
-/* Last modified: 2019/03/30 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Moves particle forward using delta-tracking                  */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - With regional majorants (set dtreg) the path length is        */
+/*             sampled region by region: the optical distance is reduced by  */
+/*             the majorant times distance to region boundary until the      */
+/*             collision point falls inside the region. This is equivalent   */
+/*             to stopping at the boundary and re-sampling, so the           */
+/*             collision density remains unbiased as long as the regional    */
+/*             majorant is not below the total cross section (see            */
+/*             preparedtregions.c). Majorant failures are not accepted in    */
+/*             active cycles.                                                */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -17,6 +25,8 @@
 
 #define FUNCTION_NAME "MoveDT:"
 
+static void ScoreDTRegion(long, long, long);
+
 /*****************************************************************************/
 
 long MoveDT(long part, double majorant, double minxs, long *cell, double *xs0,
@@ -24,8 +34,8 @@ long MoveDT(long part, double majorant, double minxs, long *cell, double *xs0,
             double *zt, double *l0, double *u, double *v, double *w, double E,
             long id)
 {
-  long ptr, type, mat, mat0, bc;
-  double totxs, l, wgt;
+  long ptr, type, mat, mat0, bc, msh, reg, fail;
+  double totxs, l, wgt, tau, maj, d, x0, y0, z0;
 
   /* Check particle pointer */
 
@@ -50,17 +60,101 @@ long MoveDT(long part, double majorant, double minxs, long *cell, double *xs0,
   CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
   AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
 
-  /* Double the majorant cross section in order to increase number of */
-  /* collisions for sensitivity calculations. TODO: Add this to the   */
-  /* extra majorants instead? */
+  /* Reset region index */
 
-  if ((long)RDB[DATA_SENS_MODE] != SENS_MODE_NONE)
-    majorant *= 2;
+  reg = -1;
+
+  /* Check regional majorants */
+
+  if (((msh = (long)RDB[DATA_DT_REG_PTR_MESH]) > VALID_PTR) &&
+      (type == PARTICLE_TYPE_NEUTRON))
+    {
+      /***********************************************************************/
+
+      /***** Regional majorants **********************************************/
+
+      /* Sample optical distance */
+
+      tau = -log(RandF(id));
+
+      /* Reset path length */
+
+      l = 0.0;
+
+      /* Loop over regions */
+
+      while (1 == 1)
+        {
+          /* Point slightly ahead, to get the next region at boundary */
+
+          x0 = *x + *u*(l + EXTRAP_L);
+          y0 = *y + *v*(l + EXTRAP_L);
+          z0 = *z + *w*(l + EXTRAP_L);
+
+          /* Get region index and majorant */
+
+          reg = MeshIndex(msh, x0, y0, z0, -1.0);
+          maj = DTRegionMajorant(type, majorant, E, x0, y0, z0, id);
+
+          /* Compare to minimum */
+
+          if (maj < minxs)
+            maj = minxs;
+
+          /* Double for sensitivity calculations (see below) */
+
+          if ((long)RDB[DATA_SENS_MODE] != SENS_MODE_NONE)
+            maj *= 2;
+
+          /* Check value */
+
+          CheckValue(FUNCTION_NAME, "maj", "", maj, ZERO, INFTY);
+
+          /* Distance to region boundary (infinite if moving away from */
+          /* mesh) */
+
+          d = NearestMeshBoundary(msh, x0, y0, z0, *u, *v, *w, &fail)
+            + EXTRAP_L;
+
+          /* Check if collision point is within region */
+
+          if (tau < maj*d)
+            {
+              /* Add to path length */
+
+              l = l + tau/maj;
+
+              /* Break loop */
+
+              break;
+            }
+
+          /* Move to boundary */
+
+          tau = tau - maj*d;
+          l = l + d;
+        }
+
+      /* Use regional majorant for collision sampling */
+
+      majorant = maj;
 
-  /* Check cross section and sample path length */
+      /***********************************************************************/
+    }
+  else
+    {
+      /* Double the majorant cross section in order to increase number of */
+      /* collisions for sensitivity calculations. TODO: Add this to the   */
+      /* extra majorants instead? */
+
+      if ((long)RDB[DATA_SENS_MODE] != SENS_MODE_NONE)
+        majorant *= 2;
+
+      /* Check cross section and sample path length */
 
-  CheckValue(FUNCTION_NAME, "majorant", "", majorant, ZERO, INFTY);
-  l = -log(RandF(id))/majorant;
+      CheckValue(FUNCTION_NAME, "majorant", "", majorant, ZERO, INFTY);
+      l = -log(RandF(id))/majorant;
+    }
 
   /* Particles that came from another domain are identified from */
   /* a mismatch in MPI id. Path length is set to zero to enforce */
@@ -195,6 +289,25 @@ long MoveDT(long part, double majorant, double minxs, long *cell, double *xs0,
   if ((long)RDB[DATA_SENS_MODE] != SENS_MODE_NONE)
     totxs *= 2;
 
+  /* Check regional majorant (material was missed in sampling) */
+
+  if ((reg > -1) && (totxs > majorant))
+    {
+      /* Results are biased if this happens in active cycles */
+
+      if (RDB[DATA_CYCLE_IDX] >= RDB[DATA_CRIT_SKIP])
+        Error(0,
+              "Regional majorant exceeded in material %s in active cycle (increase number of points in \"set dtreg\" or number of inactive cycles)",
+              GetText(mat + MATERIAL_PTR_NAME));
+
+      /* Score failure (region is switched to global majorant between */
+      /* cycles in CollectResults(), to keep the results reproducible) */
+
+      ptr = (long)RDB[RES_DT_REG_STAT];
+      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+      AddBuf(1.0, 1.0, ptr, id, -1, reg, 2);
+    }
+
   /*****************************/
 
   /* Compare to minimum value */
@@ -215,6 +328,10 @@ long MoveDT(long part, double majorant, double minxs, long *cell, double *xs0,
           CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY,ptr);
           AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
 
+          /* Score regional statistics */
+
+          ScoreDTRegion(reg, YES, id);
+
           /* Check distance */
 
           CheckValue(FUNCTION_NAME, "l0", "", *l0, 0.0, INFTY);
@@ -235,6 +352,10 @@ long MoveDT(long part, double majorant, double minxs, long *cell, double *xs0,
           CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY,ptr);
           AddBuf1D(1.0, 1.0, ptr, id, 4 - type);
 
+          /* Score regional statistics */
+
+          ScoreDTRegion(reg, NO, id);
+
           /* Check distance */
 
           CheckValue(FUNCTION_NAME, "l0", "", *l0, 0.0, INFTY);
@@ -264,6 +385,10 @@ long MoveDT(long part, double majorant, double minxs, long *cell, double *xs0,
               CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY,ptr);
               AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
 
+              /* Score regional statistics */
+
+              ScoreDTRegion(reg, YES, id);
+
               /* Check distance */
 
               CheckValue(FUNCTION_NAME, "l0", "", *l0, 0.0, INFTY);
@@ -280,6 +405,10 @@ long MoveDT(long part, double majorant, double minxs, long *cell, double *xs0,
               CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY,ptr);
               AddBuf1D(1.0, 1.0, ptr, id, 4 - type);
 
+              /* Score regional statistics */
+
+              ScoreDTRegion(reg, NO, id);
+
               /* Check distance */
 
               CheckValue(FUNCTION_NAME, "l0", "", *l0, 0.0, INFTY);
@@ -301,6 +430,10 @@ long MoveDT(long part, double majorant, double minxs, long *cell, double *xs0,
           CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY,ptr);
           AddBuf1D(1.0, 1.0, ptr, id, 4 - type);
 
+          /* Score regional statistics */
+
+          ScoreDTRegion(reg, NO, id);
+
           /* Check distance */
 
           CheckValue(FUNCTION_NAME, "l0", "", *l0, 0.0, INFTY);
@@ -313,3 +446,29 @@ long MoveDT(long part, double majorant, double minxs, long *cell, double *xs0,
 }
 
 /*****************************************************************************/
+
+/***** Score virtual and real collisions in region ***************************/
+
+static void ScoreDTRegion(long reg, long col, long id)
+{
+  long ptr;
+
+  /* Check region index */
+
+  if (reg < 0)
+    return;
+
+  /* Get pointer */
+
+  ptr = (long)RDB[RES_DT_REG_STAT];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  /* Score (0 = virtual, 1 = real) */
+
+  if (col == YES)
+    AddBuf(1.0, 1.0, ptr, id, -1, reg, 1);
+  else
+    AddBuf(1.0, 1.0, ptr, id, -1, reg, 0);
+}
+
+/*****************************************************************************/
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : movest.c                                       */
 /*                                                                           */
 /* Created:       2012/10/05 (JLe)                                           */
-/* Last modified: 2020/04/09 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Moves particle forward using surface-tracking                */
@@ -333,22 +333,22 @@ long MoveST(long part, double totxs, double minxs, long *cell, double *xs0,
           *z = *z + w*(d + EXTRAP_L);
 
           /* Set cell search list option */
-          /*
+
           ptr = (long)RDB[DATA_CELL_SEARCH_LIST];
           CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
           PutPrivateData(ptr, (double)CELL_SEARCH_LIST_SURF, id);
-          */
+
           /* Find location */
 
           *cell = WhereAmI(*x, *y, *z, u, v, w, id);
           CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, *cell);
 
           /* Set cell search list option */
-          /*
+
           ptr = (long)RDB[DATA_CELL_SEARCH_LIST];
           CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
           PutPrivateData(ptr, (double)CELL_SEARCH_LIST_CELL, id);
-          */
+
           /* Set cross section and path length */
 
           *xs0 = -1.0;
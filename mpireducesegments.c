@@ -0,0 +1,197 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : mpireducesegments.c                            */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Sums data block over MPI tasks in place, skipping segments   */
+/*              that are zero in all tasks                                   */
+/*                                                                           */
+/* Comments: - Replaces MPITransfer() reduction + broadcast in               */
+/*             CollectParallelData(). The block is divided into segments of  */
+/*             DATA_OPTI_MPI_BATCH_SIZE values. Segments that contain        */
+/*             non-zero values in any task are reduced, the rest are zero    */
+/*             in all tasks and left as they are.                            */
+/*                                                                           */
+/*           - Reductions are done in place, so no buffer of the size of     */
+/*             the block is needed. With MPI-3 the segments are reduced      */
+/*             with non-blocking collectives, keeping MPI_SEG_WINDOW         */
+/*             transfers in flight at a time.                                */
+/*                                                                           */
+/*           - With MPI_METH_RED the sums are in root task only, with        */
+/*             MPI_METH_ALL_RED in all tasks.                                */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "MPIReduceSegments:"
+
+/* Number of segments transferred simultaneously */
+
+#define MPI_SEG_WINDOW 16
+
+/*****************************************************************************/
+
+void MPIReduceSegments(double *dat, long sz, long meth)
+{
+
+#ifdef MPI
+
+  long sz0, nseg, n, i, m, k, rc;
+  int *flg;
+
+#if MPI_VERSION >= 3
+
+  MPI_Request req[MPI_SEG_WINDOW];
+
+#endif
+
+  /* Check method */
+
+  if ((meth != MPI_METH_RED) && (meth != MPI_METH_ALL_RED))
+    Die(FUNCTION_NAME, "Invalid function type %ld", meth);
+
+  /* Check size */
+
+  if (sz < 1)
+    return;
+
+  /* Get segment size */
+
+  if ((sz0 = (long)RDB[DATA_OPTI_MPI_BATCH_SIZE]) < 1)
+    Die(FUNCTION_NAME, "Batch size not defined (task %d)", mpiid);
+
+  /* Number of segments */
+
+  nseg = (sz - 1)/sz0 + 1;
+
+  /* Allocate memory for flags */
+
+  flg = (int *)Mem(MEM_ALLOC, nseg, sizeof(int));
+
+  /***************************************************************************/
+
+  /***** Find segments with data *********************************************/
+
+  for (n = 0; n < nseg; n++)
+    {
+      /* Segment size */
+
+      if ((m = sz - n*sz0) > sz0)
+        m = sz0;
+
+      /* Check for non-zero values */
+
+      for (i = n*sz0; i < n*sz0 + m; i++)
+        if (dat[i] != 0.0)
+          {
+            flg[n] = 1;
+            break;
+          }
+    }
+
+  /* Combine flags */
+
+  rc = MPI_Allreduce(MPI_IN_PLACE, flg, nseg, MPI_INT, MPI_MAX, my_comm);
+
+  if (rc != MPI_SUCCESS)
+    Die(FUNCTION_NAME, "Data transfer failed with error condition %ld", rc);
+
+  /***************************************************************************/
+
+  /***** Reduce segments *****************************************************/
+
+  /* Reset number of transfers */
+
+  k = 0;
+
+  /* Loop over segments */
+
+  for (n = 0; n < nseg; n++)
+    {
+      /* Skip segments without data */
+
+      if (flg[n] == 0)
+        continue;
+
+      /* Segment size */
+
+      if ((m = sz - n*sz0) > sz0)
+        m = sz0;
+
+#if MPI_VERSION >= 3
+
+      /* Wait for oldest transfer if window is full */
+
+      if (k >= MPI_SEG_WINDOW)
+        MPI_Wait(&req[k % MPI_SEG_WINDOW], MPI_STATUS_IGNORE);
+
+      /* Start transfer */
+
+      if (meth == MPI_METH_ALL_RED)
+        rc = MPI_Iallreduce(MPI_IN_PLACE, &dat[n*sz0], m, MPI_DOUBLE,
+                            MPI_SUM, my_comm, &req[k % MPI_SEG_WINDOW]);
+      else if (mpiid == 0)
+        rc = MPI_Ireduce(MPI_IN_PLACE, &dat[n*sz0], m, MPI_DOUBLE,
+                         MPI_SUM, 0, my_comm, &req[k % MPI_SEG_WINDOW]);
+      else
+        rc = MPI_Ireduce(&dat[n*sz0], NULL, m, MPI_DOUBLE, MPI_SUM, 0,
+                         my_comm, &req[k % MPI_SEG_WINDOW]);
+
+#else
+
+      /* Blocking transfer */
+
+      if (meth == MPI_METH_ALL_RED)
+        rc = MPI_Allreduce(MPI_IN_PLACE, &dat[n*sz0], m, MPI_DOUBLE,
+                           MPI_SUM, my_comm);
+      else if (mpiid == 0)
+        rc = MPI_Reduce(MPI_IN_PLACE, &dat[n*sz0], m, MPI_DOUBLE,
+                        MPI_SUM, 0, my_comm);
+      else
+        rc = MPI_Reduce(&dat[n*sz0], NULL, m, MPI_DOUBLE, MPI_SUM, 0,
+                        my_comm);
+
+#endif
+
+      /* Check error */
+
+      if (rc != MPI_SUCCESS)
+        Die(FUNCTION_NAME, "Data transfer failed with error condition %ld",
+            rc);
+
+      /* Update number of transfers */
+
+      k++;
+    }
+
+#if MPI_VERSION >= 3
+
+  /* Wait for remaining transfers */
+
+  if (k > MPI_SEG_WINDOW)
+    MPI_Waitall(MPI_SEG_WINDOW, req, MPI_STATUSES_IGNORE);
+  else if (k > 0)
+    MPI_Waitall(k, req, MPI_STATUSES_IGNORE);
+
+#endif
+
+  /***************************************************************************/
+
+  /* Add to statistics of transferred and skipped segments */
+
+  WDB[DATA_MPI_SEG_TOT] = RDB[DATA_MPI_SEG_TOT] + (double)nseg;
+  WDB[DATA_MPI_SEG_REDUCED] = RDB[DATA_MPI_SEG_REDUCED] + (double)k;
+
+  /* Free flags */
+
+  Mem(MEM_FREE, flg);
+
+#endif
+}
+
+/*****************************************************************************/
@@ -0,0 +1,197 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : multipolemajorant.c                            */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Replaces TMS majorant with temperature-range majorant from   */
+/*              windowed multipole data within the resolved resonance range  */
+/*                                                                           */
+/* Comments: - Called from ReadMultipoleData() after TmpMajorants().         */
+/*                                                                           */
+/*           - The majorant is histogram-type (see tmpmajorants.c), so the   */
+/*             value of each energy interval within the multipole range is   */
+/*             the maximum of the exact total cross section over the         */
+/*             interval and the nuclide temperature range. The maximum is    */
+/*             searched from WMP_MAJ_NE x WMP_MAJ_NT points and increased by */
+/*             a small margin. Other partial reactions (see                  */
+/*             multipolemicroxs.c) are bounded by their values at the        */
+/*             interval boundaries.                                          */
+/*                                                                           */
+/*           - The TMS majorant is the maximum of the base cross section     */
+/*             within the thermal motion range, which is much higher than    */
+/*             the broadened cross section near resonances, so this reduces  */
+/*             the number of rejections.                                     */
+/*                                                                           */
+/*           - Majorant is not changed if the other reactions are given in   */
+/*             a different energy grid.                                      */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "MultipoleMajorant:"
+
+#define WMP_MAJ_NE      4
+#define WMP_MAJ_NT      4
+#define WMP_MAJ_MARGIN  1.01
+
+/*****************************************************************************/
+
+void MultipoleMajorant(long nuc)
+{
+  long loc0, rea, rea1, erg, ptr, lst, i0, i1, ne, ne1, n, m, k, j;
+  const double *E0, *xs0;
+  double *xs1, Emin, Emax, T0, T1, T, E, xs[3], max, oth, val;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(nuc)", DATA_ARRAY, nuc);
+
+  /* Pointer to multipole data */
+
+  loc0 = (long)RDB[nuc + NUCLIDE_PTR_WMP];
+  CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+  /* Pointer to total cross section */
+
+  rea = (long)RDB[nuc + NUCLIDE_PTR_TOTXS];
+  CheckPointer(FUNCTION_NAME, "(rea)", DATA_ARRAY, rea);
+
+  /* Energy grid */
+
+  erg = (long)RDB[rea + REACTION_PTR_EGRID];
+  CheckPointer(FUNCTION_NAME, "(erg)", DATA_ARRAY, erg);
+
+  /* Check other reactions */
+
+  if ((lst = (long)RDB[loc0 + WMP_PTR_OTHER_REA]) > VALID_PTR)
+    {
+      ptr = lst;
+      while ((rea1 = (long)RDB[ptr++]) > VALID_PTR)
+        if ((long)RDB[rea1 + REACTION_PTR_EGRID] != erg)
+          return;
+    }
+
+  /* Get first energy point and number of points */
+
+  i0 = (long)RDB[rea + REACTION_XS_I0];
+  ne = (long)RDB[rea + REACTION_XS_NE];
+
+  /* Get energy array */
+
+  ptr = (long)RDB[erg + ENERGY_GRID_PTR_DATA];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+  E0 = &RDB[ptr + i0];
+
+  /* Get majorant reaction */
+
+  ptr = (long)RDB[rea + REACTION_PTR_TMP_MAJORANT];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  /* Check number of points */
+
+  if ((long)RDB[ptr + REACTION_XS_NE] != ne)
+    Die(FUNCTION_NAME, "Mismatch in number of points");
+
+  /* Pointer to cross section array */
+
+  ptr = (long)RDB[ptr + REACTION_PTR_XS];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+  xs1 = &WDB[ptr];
+
+  /* Energy and temperature range */
+
+  Emin = RDB[loc0 + WMP_EMIN];
+  Emax = RDB[loc0 + WMP_EMAX];
+
+  T0 = RDB[nuc + NUCLIDE_TMS_MIN_TEMP];
+  T1 = RDB[nuc + NUCLIDE_TMS_MAX_TEMP];
+
+  /* Loop over intervals */
+
+#ifdef OPEN_MP
+#pragma omp parallel for private(m, k, j, T, E, xs, max, oth, val, ptr, rea1, i1, ne1, xs0)
+#endif
+  for (n = 0; n < ne - 1; n++)
+    {
+      /* Check that interval is within multipole range */
+
+      if ((E0[n] < Emin) || (E0[n + 1] > Emax))
+        continue;
+
+      /* Find maximum of elastic and absorption */
+
+      max = 0.0;
+
+      for (k = 0; k < WMP_MAJ_NT + 1; k++)
+        {
+          /* Temperature */
+
+          T = T0 + (T1 - T0)*((double)k)/((double)WMP_MAJ_NT);
+
+          for (m = 0; m < WMP_MAJ_NE + 1; m++)
+            {
+              /* Energy */
+
+              E = E0[n] + (E0[n + 1] - E0[n])*((double)m)/
+                ((double)WMP_MAJ_NE);
+
+              /* Evaluate */
+
+              MultipoleXS(loc0, E, T, xs);
+
+              /* Remove negative values as in MultipoleMicroXS() */
+
+              if (xs[0] < 0.0)
+                xs[0] = 0.0;
+
+              if (xs[2] < 0.0)
+                xs[2] = 0.0;
+
+              if (xs[1] < xs[2])
+                xs[1] = xs[2];
+
+              /* Compare */
+
+              if (xs[0] + xs[1] > max)
+                max = xs[0] + xs[1];
+            }
+        }
+
+      /* Add other reactions (maximum of interval boundaries) */
+
+      oth = 0.0;
+
+      if ((ptr = (long)RDB[loc0 + WMP_PTR_OTHER_REA]) > VALID_PTR)
+        while ((rea1 = (long)RDB[ptr++]) > VALID_PTR)
+          {
+            /* Get first point, number of points and data */
+
+            i1 = (long)RDB[rea1 + REACTION_XS_I0];
+            ne1 = (long)RDB[rea1 + REACTION_XS_NE];
+            xs0 = &RDB[(long)RDB[rea1 + REACTION_PTR_XS]];
+
+            /* Get maximum */
+
+            val = 0.0;
+
+            for (j = n + i0 - i1; j < n + i0 - i1 + 2; j++)
+              if ((j > -1) && (j < ne1) && (xs0[j] > val))
+                val = xs0[j];
+
+            /* Add to sum */
+
+            oth = oth + val;
+          }
+
+      /* Put majorant */
+
+      xs1[n] = WMP_MAJ_MARGIN*max + oth;
+    }
+}
+
+/*****************************************************************************/
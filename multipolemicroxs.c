@@ -0,0 +1,156 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : multipolemicroxs.c                             */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Returns exact Doppler-broadened microscopic cross section    */
+/*              from windowed multipole data, or -1 if not available         */
+/*                                                                           */
+/* Comments: - Called from DopMicroXS() and SampleReaction() in TMS mode.    */
+/*             Returns -1.0 if the nuclide has no multipole data, if the     */
+/*             energy is outside the range of the data or below the S(a,b)   */
+/*             limit, or if the reaction is a sum or special reaction not    */
+/*             covered by the data (caller uses rejection sampling then).    */
+/*                                                                           */
+/*           - Elastic = scattering, capture = absorption - fission. Other   */
+/*             partial reactions active in the range (n,p), (n,alpha), etc.  */
+/*             are not included in the multipole data and use the pointwise  */
+/*             data at the base temperature. These are mostly 1/v, which is  */
+/*             unchanged by Doppler broadening. They are added to total and  */
+/*             absorption cross sections.                                    */
+/*                                                                           */
+/*           - Previous elastic, absorption and fission values are stored    */
+/*             for each thread, since all reactions are usually needed at    */
+/*             the same energy and temperature.                              */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "MultipoleMicroXS:"
+
+/*****************************************************************************/
+
+double MultipoleMicroXS(long rea, double E, double T, long id)
+{
+  long nuc, loc0, ptr, mt, ty, rea1;
+  double xs[3], val;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(rea)", DATA_ARRAY, rea);
+
+  /* Pointer to nuclide */
+
+  nuc = (long)RDB[rea + REACTION_PTR_NUCLIDE];
+  CheckPointer(FUNCTION_NAME, "(nuc)", DATA_ARRAY, nuc);
+
+  /* Pointer to multipole data */
+
+  if ((loc0 = (long)RDB[nuc + NUCLIDE_PTR_WMP]) < VALID_PTR)
+    return -1.0;
+
+  /* Check energy */
+
+  if ((E < RDB[loc0 + WMP_EMIN]) || (E > RDB[loc0 + WMP_EMAX]) ||
+      (E < RDB[nuc + NUCLIDE_SAB_EMAX]))
+    return -1.0;
+
+  /* Get reaction type */
+
+  mt = (long)RDB[rea + REACTION_MT];
+  ty = (long)RDB[rea + REACTION_TYPE];
+
+  /* Check reaction and set mode (1 = total, 2 = elastic, 18 = fission, */
+  /* 101 = total absorption, 102 = capture) */
+
+  if (rea == (long)RDB[nuc + NUCLIDE_PTR_TOTXS])
+    mt = 1;
+  else if (rea == (long)RDB[nuc + NUCLIDE_PTR_SUM_ABSXS])
+    mt = 101;
+  else if ((rea == (long)RDB[nuc + NUCLIDE_PTR_ELAXS]) ||
+           ((ty == REACTION_TYPE_PARTIAL) && (mt == 2)))
+    mt = 2;
+  else if ((rea == (long)RDB[nuc + NUCLIDE_PTR_FISSXS]) ||
+           ((ty == REACTION_TYPE_PARTIAL) && ((mt == 18) || (mt == 19))))
+    mt = 18;
+  else if ((rea == (long)RDB[nuc + NUCLIDE_PTR_NGAMMAXS]) ||
+           ((ty == REACTION_TYPE_PARTIAL) && (mt == 102)))
+    mt = 102;
+  else if (ty == REACTION_TYPE_PARTIAL)
+    return MicroXS(rea, E, id);
+  else
+    return -1.0;
+
+  /* Get cross sections */
+
+  ptr = (long)RDB[loc0 + WMP_PTR_PREV_XS];
+  CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
+
+  if ((GetPrivateData(ptr, id) == E) && (GetPrivateData(ptr + 1, id) == T))
+    {
+      /* Use previous values */
+
+      xs[0] = GetPrivateData(ptr + 2, id);
+      xs[1] = GetPrivateData(ptr + 3, id);
+      xs[2] = GetPrivateData(ptr + 4, id);
+    }
+  else
+    {
+      /* Evaluate */
+
+      MultipoleXS(loc0, E, T, xs);
+
+      /* Remove negative values (elastic, capture, fission) */
+
+      if (xs[0] < 0.0)
+        xs[0] = 0.0;
+
+      if (xs[2] < 0.0)
+        xs[2] = 0.0;
+
+      if (xs[1] < xs[2])
+        xs[1] = xs[2];
+
+      /* Store values */
+
+      PutPrivateData(ptr, E, id);
+      PutPrivateData(ptr + 1, T, id);
+      PutPrivateData(ptr + 2, xs[0], id);
+      PutPrivateData(ptr + 3, xs[1], id);
+      PutPrivateData(ptr + 4, xs[2], id);
+    }
+
+  /* Check mode */
+
+  if (mt == 2)
+    return xs[0];
+  else if (mt == 18)
+    return xs[2];
+  else if (mt == 102)
+    return xs[1] - xs[2];
+
+  /* Total or absorption */
+
+  if (mt == 1)
+    val = xs[0] + xs[1];
+  else
+    val = xs[1];
+
+  /* Add other reactions */
+
+  if ((ptr = (long)RDB[loc0 + WMP_PTR_OTHER_REA]) > VALID_PTR)
+    while ((rea1 = (long)RDB[ptr++]) > VALID_PTR)
+      if ((mt == 1) || ((long)RDB[rea1 + REACTION_TY] == 0))
+        val = val + MicroXS(rea1, E, id);
+
+  /* Return value */
+
+  return val;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,228 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : multipolexs.c                                  */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Evaluates Doppler-broadened elastic, absorption and fission  */
+/*              cross sections from windowed multipole data                  */
+/*                                                                           */
+/* Comments: - Temperature in kelvin, energy in MeV and cross sections in    */
+/*             barns. Values are put in xs[0] (elastic), xs[1] (absorption)  */
+/*             and xs[2] (fission).                                          */
+/*                                                                           */
+/*           - Poles within the window are broadened with the Faddeeva       */
+/*             function and the background polynomial analytically, so the   */
+/*             result is exact at any temperature. At 0K the poles are       */
+/*             evaluated directly.                                           */
+/*                                                                           */
+/*           - Data structure is described in readmultipoledata.c.           */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "MultipoleXS:"
+
+/*****************************************************************************/
+
+void MultipoleXS(long loc0, double E, double T, double *xs)
+{
+  long nw, nc, fiss, i, n, m, ptr, i0, i1, brd;
+  double sqrtE, invE, kT, dopp, beta, h2, h4, erfb, expb, f[MAX_WMP_COEF];
+  double s, a, fs, rs, ra, rf, x;
+  complex z, w;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+  /* Convert energy to eV */
+
+  E = 1E+6*E;
+
+  sqrtE = sqrt(E);
+  invE = 1.0/E;
+
+  /* Get window index */
+
+  nw = (long)RDB[loc0 + WMP_N_WINDOWS];
+  i = (long)((sqrtE - RDB[loc0 + WMP_SQRT_EMIN])/RDB[loc0 + WMP_SPACING]);
+
+  if (i < 0)
+    i = 0;
+  else if (i > nw - 1)
+    i = nw - 1;
+
+  /* Get pole range and polynomial broadening flag */
+
+  ptr = (long)RDB[loc0 + WMP_PTR_WINDOWS];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  i0 = (long)RDB[ptr + 3*i];
+  i1 = (long)RDB[ptr + 3*i + 1];
+  brd = (long)RDB[ptr + 3*i + 2];
+
+  /* Number of coefficients and fissile flag */
+
+  nc = (long)RDB[loc0 + WMP_N_COEF];
+  fiss = (long)RDB[loc0 + WMP_FISSILE];
+
+  /* Convert temperature to eV and calculate Doppler parameter */
+
+  if (T > 0.0)
+    {
+      kT = 1E+6*KELVIN*T;
+      dopp = RDB[loc0 + WMP_SQRT_AWR]/sqrt(kT);
+    }
+  else
+    dopp = 0.0;
+
+  /***************************************************************************/
+
+  /***** Background polynomial ***********************************************/
+
+  if ((dopp > 0.0) && (brd == YES))
+    {
+      /* Broadened polynomial terms (first three analytically, the rest */
+      /* by recursion) */
+
+      beta = sqrtE*dopp;
+      h2 = 0.5/(dopp*dopp);
+      h4 = h2*h2;
+
+      /* erf(6) is 1 and exp(-36) zero to machine precision */
+
+      if (beta > 6.0)
+        {
+          erfb = 1.0;
+          expb = 0.0;
+        }
+      else
+        {
+          erfb = erf(beta);
+          expb = exp(-beta*beta);
+        }
+
+      f[0] = erfb*invE;
+      f[1] = 1.0/sqrtE;
+      f[2] = f[0]*(h2 + E) + expb/(beta*SQRTPI);
+
+      for (n = 1; n < nc - 2; n++)
+        {
+          if (n == 1)
+            f[n + 2] = f[n]*(E + (1.0 + 2.0*n)*h2);
+          else
+            f[n + 2] = -f[n - 2]*(n - 1.0)*n*h4
+              + f[n]*(E + (1.0 + 2.0*n)*h2);
+        }
+    }
+  else
+    {
+      /* Polynomial in sqrt(E) divided by E */
+
+      x = invE;
+
+      for (n = 0; n < nc; n++)
+        {
+          f[n] = x;
+          x = x*sqrtE;
+        }
+    }
+
+  /* Pointer to coefficients */
+
+  ptr = (long)RDB[loc0 + WMP_PTR_CURVEFIT];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  ptr = ptr + 3*nc*i;
+
+  /* Sum terms */
+
+  s = 0.0;
+  a = 0.0;
+  fs = 0.0;
+
+  for (n = 0; n < nc; n++)
+    {
+      s = s + RDB[ptr + 3*n]*f[n];
+      a = a + RDB[ptr + 3*n + 1]*f[n];
+
+      if (fiss == YES)
+        fs = fs + RDB[ptr + 3*n + 2]*f[n];
+    }
+
+  /***************************************************************************/
+
+  /***** Resonance contribution **********************************************/
+
+  /* Pointer to poles */
+
+  ptr = (long)RDB[loc0 + WMP_PTR_POLES];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  /* Loop over poles in window */
+
+  for (m = i0; m < i1 + 1; m++)
+    {
+      /* Pointer to pole data */
+
+      n = ptr + 8*m;
+
+      /* Check temperature */
+
+      if (dopp == 0.0)
+        {
+          /* Asymptotic form -i/(p - sqrt(E))/E */
+
+          z.re = RDB[n] - sqrtE;
+          z.im = RDB[n + 1];
+
+          x = z.re*z.re + z.im*z.im;
+
+          w.re = -z.im/x*invE;
+          w.im = -z.re/x*invE;
+        }
+      else
+        {
+          /* Faddeeva function of (sqrt(E) - p)*dopp */
+
+          z.re = (sqrtE - RDB[n])*dopp;
+          z.im = -RDB[n + 1]*dopp;
+
+          w = Faddeeva(z);
+
+          x = dopp*invE*SQRTPI;
+
+          w.re = w.re*x;
+          w.im = w.im*x;
+        }
+
+      /* Real part of residue times broadened pole */
+
+      rs = RDB[n + 2]*w.re - RDB[n + 3]*w.im;
+      ra = RDB[n + 4]*w.re - RDB[n + 5]*w.im;
+
+      s = s + rs;
+      a = a + ra;
+
+      if (fiss == YES)
+        {
+          rf = RDB[n + 6]*w.re - RDB[n + 7]*w.im;
+          fs = fs + rf;
+        }
+    }
+
+  /***************************************************************************/
+
+  /* Put values */
+
+  xs[0] = s;
+  xs[1] = a;
+  xs[2] = fs;
+}
+
+/*****************************************************************************/
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : nearestboundary.c                              */
 /*                                                                           */
 /* Created:       2010/10/10 (JLe)                                           */
-/* Last modified: 2020/01/15 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Finds distance to the nearest boundary surface               */
@@ -30,14 +30,9 @@
 double NearestBoundary(long id)
 {
   long lvl0, lvl, reg, cell, pbd, pbl, surf, type, n, np, ptr, loc0, ltype;
-  long nbhr, uni, ncol, ang, i, j, loc1, tet, pt0, pt1, pt2, uni0, surf0;
+  long nbhr, uni, ncol, ang, i, loc1, tet, uni0, surf0;
   double min, d, x, y, z, u, v, w, y2, z2, params[MAX_SURFACE_PARAMS];
   double t, phi, phi2, min0;
-  const long *face[4];
-  static const long face1[3] = {0,2,1};
-  static const long face2[3] = {1,2,3};
-  static const long face3[3] = {0,3,2};
-  static const long face4[3] = {0,1,3};
 
   /* Reset variables */
 
@@ -507,6 +502,25 @@ double NearestBoundary(long id)
             cell = (long)GetPrivateData(lvl + LVL_PRIV_PTR_CELL, id);
             CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
 
+            /* Check packed surfaces */
+
+            if ((ptr = (long)RDB[cell + CELL_PTR_SURF_PACK]) > VALID_PTR)
+              {
+                /* Get distance (nearest surface is not resolved) */
+
+                d = PackedSurfDistance(ptr, x, y, z, u, v, w, id);
+                CheckValue(FUNCTION_NAME, "d", "13", d, 0.0, INFTY);
+
+                /* Compare to minimum */
+
+                if (d < min)
+                  min = d;
+
+                /* Break case */
+
+                break;
+              }
+
             /* Pointer to surface list */
 
             loc0 = (long)RDB[cell + CELL_PTR_SURF_LIST];
@@ -585,50 +599,20 @@ double NearestBoundary(long id)
 
                 nbhr = -1;
 
-                /* Store point list for easy access (faceX are constant lists) */
+                /* Get distance to faces (packed in PackTetFaces()) */
 
-                face[0] = face1;
-                face[1] = face2;
-                face[2] = face3;
-                face[3] = face4;
+                d = TetFaceDistance(tet, x, y, z, u, v, w, &i);
+                CheckValue(FUNCTION_NAME, "d", "15", d, 0.0, INFTY);
 
-                /* Loop over tet faces */
+                /* Compare to minimum */
 
-                for (i = 0; i < 4; i++)
+                if (d < min)
                   {
-                    /* Get pointers to points */
-
-                    pt0 = (long)RDB[tet + TET_POINTS + face[i][0]];
-                    pt1 = (long)RDB[tet + TET_POINTS + face[i][1]];
-                    pt2 = (long)RDB[tet + TET_POINTS + face[i][2]];
+                    min = d;
 
-                    /* Copy points to params */
+                    /* Get neighbour */
 
-                    for (j = 0; j < 3; j++)
-                      {
-                        /* Store coordinates to params */
-
-                        params[0 + j] = RDB[pt0 + j];
-                        params[3 + j] = RDB[pt1 + j];
-                        params[6 + j] = RDB[pt2 + j];
-                      }
-
-                    /* Get distance */
-
-                    d = SurfaceDistance(-1, params, SURF_PLANE, 9,
-                                        x, y, z, u, v, w, id);
-                    CheckValue(FUNCTION_NAME, "d", "15", d, 0.0, INFTY);
-
-                    /* Compare to minimum */
-
-                    if (d < min)
-                      {
-                        min = d;
-
-                        /* Get neighbour */
-
-                        nbhr = (long)RDB[tet + TET_NEIGHBOURS + i];
-                      }
+                    nbhr = (long)RDB[tet + TET_NEIGHBOURS + i];
                   }
 
                 /* Get collision count */
@@ -3,12 +3,12 @@
 /* serpent 2 (beta-version) : nearestpbsurf.c                                */
 /*                                                                           */
 /* Created:       2010/10/25 (JLe)                                           */
-/* Last modified: 2017/09/23 (JLe)                                           */
-/* Version:       2.1.30                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Calculates distance to nearest pebble / particle             */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - Pebbles are read from the packed grid (see packpbgrid.c).     */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -22,9 +22,10 @@
 double NearestPBSurf(long pbd, double x, double y, double z, 
                      double u, double v, double w, long id)
 {
-  long nx, ny, nz, i, j, k, pbl, msh, lst;
-  double xmin, xmax, ymin, ymax, zmin, zmax, dx, dy, dz, param[4], l, min;
-  double px, py, pz;
+  long nx, ny, nz, i, j, k, msh, grd, ptr, n, n0, n1;
+  double xmin, xmax, ymin, ymax, zmin, zmax, dx, dy, dz, l, min, b, c, d;
+  double px, py, pz, x0, y0, z0;
+  const double *X, *Y, *Z, *R2;
 
   /* Pointer to search mesh */
 
@@ -162,40 +163,61 @@ double NearestPBSurf(long pbd, double x, double y, double z,
   else
     Warn(FUNCTION_NAME, "l = %E, w = %E", l, w);
   
-   /* Get pointer to search mesh */
+  /* Pointer to packed search grid */
 
-  lst = MeshPtr(msh, x, y, z);
-  CheckPointer(FUNCTION_NAME, "(lst)", DATA_ARRAY, lst);
-  lst = (long)RDB[lst];
+  grd = (long)RDB[pbd + PBED_PTR_GRID];
+  CheckPointer(FUNCTION_NAME, "(grd)", DATA_ARRAY, grd);
 
-  /* Loop over content */
+  /* Get index range */
 
-  while (lst > VALID_PTR)
+  ptr = (long)RDB[grd + PBGRID_PTR_IDX] + i + nx*(j + ny*k);
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  n0 = (long)RDB[ptr];
+  n1 = (long)RDB[ptr + 1];
+
+  /* Pointers to data */
+
+  X = &RDB[(long)RDB[grd + PBGRID_PTR_X]];
+  Y = &RDB[(long)RDB[grd + PBGRID_PTR_Y]];
+  Z = &RDB[(long)RDB[grd + PBGRID_PTR_Z]];
+  R2 = &RDB[(long)RDB[grd + PBGRID_PTR_R2]];
+
+  /* Loop over content (same equations as for spheres in */
+  /* SurfaceDistance(), written as a minimum reduction) */
+
+  for (n = n0; n < n1; n++)
     {
-      /* Pointer to pebble */
-      
-      pbl = (long)RDB[lst + SEARCH_MESH_CELL_CONTENT];
-      CheckPointer(FUNCTION_NAME, "(pbl)", DATA_ARRAY, pbl);
+      /* Shift origin */
 
-      /* Set surface parameters */
+      x0 = x - X[n];
+      y0 = y - Y[n];
+      z0 = z - Z[n];
 
-      param[0] = RDB[pbl + PEBBLE_X0];
-      param[1] = RDB[pbl + PEBBLE_Y0];
-      param[2] = RDB[pbl + PEBBLE_Z0];
-      param[3] = RDB[pbl + PEBBLE_RAD];
+      /* Calculate constants */
 
-      /* Get distance */
+      b = u*x0 + v*y0 + w*z0;
+      c = x0*x0 + y0*y0 + z0*z0 - R2[n];
 
-      l = SurfaceDistance(-1, param, SURF_SPH, 4, x, y, z, u, v, w, id);
+      d = b*b - c;
+
+      /* Only one root is possible inside, negative outside root is in */
+      /* the opposite direction */
+
+      if (c < 0.0)
+        l = -(b - sqrt(fabs(d)));
+      else
+        l = -(b + sqrt(fabs(d)));
+
+      /* Check line-of-sight */
+
+      if ((d < 0.0) || ((c >= 0.0) && (l < 0.0)))
+        l = INFTY;
 
       /* Compare to minimum */
         
       if (l < min)
         min = l;
-        
-      /* Next */
-
-      lst = NextItem(lst);
     }
 
   /* Do zero cut-off */
@@ -3,12 +3,14 @@
 /* serpent 2 (beta-version) : neareststlsurf.c                               */
 /*                                                                           */
 /* Created:       2014/03/05 (JLe)                                           */
-/* Last modified: 2016/06/15 (JLe)                                           */
-/* Version:       2.1.27                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description:  Calculates minimum distance to STL surface                  */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - Facets are searched from the bounding volume hierarchy if    */
+/*             the search mesh cell contains facets. Search mesh cell        */
+/*             boundaries do not limit the distance in that case.            */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -22,9 +24,9 @@
 double NearestSTLSurf(long stl, double x, double y, double z, double u, 
                       double v, double w, long id)
 {
-  long msh, loc0, loc1, ptr;
-  double xmin, xmax, ymin, ymax, zmin, zmax, l, min;
-  double params[9];
+  long msh, loc0, nod, ptr, fct, n, sp, stk[2*STL_BVH_MAX_DEPTH + 4];
+  double xmin, xmax, ymin, ymax, zmin, zmax, l, min, iu, iv, iw, t0, t1;
+  double tmin, tmax;
 
   /* Check pointer */
 
@@ -106,90 +108,181 @@ double NearestSTLSurf(long stl, double x, double y, double z, double u,
 
   /***** Point is in search mesh *********************************************/
 
-  /* Distance to search mesh boundaries */
-
-  min = NearestMeshBoundary(msh, x, y, z, u, v, w, NULL);
-  CheckValue(FUNCTION_NAME, "min", "", min, ZERO, INFTY);
-
   /* Get pointer to search mesh cell */
 
   loc0 = MeshPtr(msh, x, y, z);
   CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
 
-  /* Loop over content */
+  /* Check if cell contains facets (empty cells and cells with */
+  /* pre-assigned solid are limited by search mesh boundaries) */
+
+  if (((loc0 = (long)RDB[loc0]) < VALID_PTR) ||
+      ((long)RDB[loc0 + SEARCH_MESH_CELL_CONTENT] < VALID_PTR))
+    {
+      /* Distance to search mesh boundaries */
+
+      min = NearestMeshBoundary(msh, x, y, z, u, v, w, NULL);
+      CheckValue(FUNCTION_NAME, "min", "", min, ZERO, INFTY);
+
+      /* Return distance */
+
+      return min;
+    }
+
+  /* Check if DT was enforced */
+
+  if ((long)RDB[DATA_PLOTTER_MODE] == NO)
+    if ((long)RDB[DATA_STL_ENFORCE_DT] == YES)
+      Die(FUNCTION_NAME, "Shouldn't be here");
+
+  /* Distance to outer boundaries */
+
+  min = INFTY;
+
+  if (u > 0.0)
+    min = (xmax - x)/u;
+  else if (u < 0.0)
+    min = (xmin - x)/u;
+
+  if (v > 0.0)
+    {
+      if ((l = (ymax - y)/v) < min)
+        min = l;
+    }
+  else if (v < 0.0)
+    {
+      if ((l = (ymin - y)/v) < min)
+        min = l;
+    }
+
+  if (w > 0.0)
+    {
+      if ((l = (zmax - z)/w) < min)
+        min = l;
+    }
+  else if (w < 0.0)
+    {
+      if ((l = (zmin - z)/w) < min)
+        min = l;
+    }
+
+  CheckValue(FUNCTION_NAME, "min", "", min, 0.0, INFTY);
+
+  /* Inverse direction for slab tests */
+
+  if (u != 0.0)
+    iu = 1.0/u;
+  else
+    iu = INFTY;
+
+  if (v != 0.0)
+    iv = 1.0/v;
+  else
+    iv = INFTY;
+
+  if (w != 0.0)
+    iw = 1.0/w;
+  else
+    iw = INFTY;
+
+  /* Pointers to nodes and solids */
+
+  nod = (long)RDB[stl + STL_PTR_BVH];
+  CheckPointer(FUNCTION_NAME, "(nod)", DATA_ARRAY, nod);
+
+  loc0 = (long)RDB[stl + STL_PTR_BVH_SOLIDS];
+  CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+  /* Put root node to stack */
+
+  stk[0] = 0;
+  sp = 1;
 
-  loc0 = (long)RDB[loc0];
-  while (loc0 > VALID_PTR)
+  /* Loop until stack is empty */
+
+  while (sp > 0)
     {
-      /* Pointer to content */
-      
-      if ((loc1 = (long)RDB[loc0 + SEARCH_MESH_CELL_CONTENT]) < VALID_PTR)
-        break;
+      /* Pointer to node */
 
-      /* Check if DT was enforced */
+      ptr = nod + stk[--sp]*STL_BVH_BLOCK_SIZE;
 
-      if ((long)RDB[DATA_PLOTTER_MODE] == NO)
-        if ((long)RDB[DATA_STL_ENFORCE_DT] == YES)
-          Die(FUNCTION_NAME, "Shouldn't be here");
+      /* Slab test */
 
-      /* Mode */
+      t0 = (RDB[ptr + STL_BVH_XMIN] - x)*iu;
+      t1 = (RDB[ptr + STL_BVH_XMAX] - x)*iu;
 
-      if (1 != 2)
+      if (t0 < t1)
         {
-          /* Get distance */
-
-          l = STLFacetDistance(loc1, x, y, z, u, v, w, NO, id);
-          CheckValue(FUNCTION_NAME, "l", "", l, 0.0, INFTY);
-
-          /* Tää ei varmaan pelaa */
-          /*
-          if ((l > 0.0) && (l < INFTY))
-            {
-              if (l < min)
-                min = l;
-              break;
-            }
-          */
+          tmin = t0;
+          tmax = t1;
         }
       else
         {
-          /* Read points to array */
-      
-          ptr = (long)RDB[loc1 + STL_FACET_PTR_PT1];
-          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-          
-          params[0] = RDB[ptr + STL_POINT_X];
-          params[1] = RDB[ptr + STL_POINT_Y];
-          params[2] = RDB[ptr + STL_POINT_Z];
-          
-          ptr = (long)RDB[loc1 + STL_FACET_PTR_PT2];
-          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-          
-          params[3] = RDB[ptr + STL_POINT_X];
-          params[4] = RDB[ptr + STL_POINT_Y];
-          params[5] = RDB[ptr + STL_POINT_Z];
-          
-          ptr = (long)RDB[loc1 + STL_FACET_PTR_PT3];
-          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-          
-          params[6] = RDB[ptr + STL_POINT_X];
-          params[7] = RDB[ptr + STL_POINT_Y];
-          params[8] = RDB[ptr + STL_POINT_Z];
-          
-          /* Calculate distance */
-          
-          l = SurfaceDistance(-1, params, SURF_PLANE, 9, x, y, z, u, v, w, id);
-          CheckValue(FUNCTION_NAME, "l", "", l, 0.0, INFTY);
+          tmin = t1;
+          tmax = t0;
         }
 
-      /* Compare to minimum */
-      
-      if (l < min)
-        min = l;
-      
-      /* Next */
+      t0 = (RDB[ptr + STL_BVH_YMIN] - y)*iv;
+      t1 = (RDB[ptr + STL_BVH_YMAX] - y)*iv;
+
+      if (t0 > t1)
+        {
+          l = t0;
+          t0 = t1;
+          t1 = l;
+        }
+
+      if (t0 > tmin)
+        tmin = t0;
+      if (t1 < tmax)
+        tmax = t1;
+
+      t0 = (RDB[ptr + STL_BVH_ZMIN] - z)*iw;
+      t1 = (RDB[ptr + STL_BVH_ZMAX] - z)*iw;
+
+      if (t0 > t1)
+        {
+          l = t0;
+          t0 = t1;
+          t1 = l;
+        }
+
+      if (t0 > tmin)
+        tmin = t0;
+      if (t1 < tmax)
+        tmax = t1;
+
+      /* Check miss or node beyond current minimum */
+
+      if ((tmin > tmax) || (tmax < 0.0) || (tmin > min))
+        continue;
+
+      /* Check inner node */
+
+      if ((n = (long)RDB[ptr + STL_BVH_CHILD]) > 0)
+        {
+          /* Check stack size */
+
+          if (sp > 2*STL_BVH_MAX_DEPTH + 1)
+            Die(FUNCTION_NAME, "Stack overflow");
+
+          /* Put children to stack */
+
+          stk[sp++] = n + 1;
+          stk[sp++] = n;
+
+          /* Cycle loop */
+
+          continue;
+        }
+
+      /* Loop over solids in leaf and update minimum */
 
-      loc0 = NextItem(loc0);
+      for (n = (long)RDB[ptr + STL_BVH_FIRST];
+           n < (long)RDB[ptr + STL_BVH_FIRST] + (long)RDB[ptr + STL_BVH_N];
+           n++)
+        STLBVHRayCast((long)RDB[loc0 + n], x, y, z, u, v, w,
+                      STL_BVH_MODE_NEAREST, &min, &fct);
     }
 
   /* Check value */
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : nearestumshsurf.c                              */
 /*                                                                           */
 /* Created:       2013/11/23 (JLe)                                           */
-/* Last modified: 2019/04/03 (VVa)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Calculates distance to nearest boundary when not inside      */
 /*              mesh cell.                                                   */
@@ -24,9 +24,9 @@ double NearestUMSHSurf(long ifc, double x, double y, double z,
                        double u, double v, double w, long id)
 {
   long tet, msh, lst, out;
-  long k, pt0, pt1, pt2;
+  long k;
   double xmin, xmax, ymin, ymax, zmin, zmax, dx, dy, dz, l, min, d;
-  double x1, y1, z1, params[9], bb[6];
+  double x1, y1, z1, bb[6];
 
   /* Check pointer */
 
@@ -277,128 +277,14 @@ double NearestUMSHSurf(long ifc, double x, double y, double z,
 
       if (out == NO)
         {
-          /* Allocate memory for surface parameters */
-
-          /***********************************************************/
-          /* Numbering of tet faces:                                 */
-          /* First face  (0,2,1) is out of cell (out of face).       */
-          /* Second face (1,2,3) is forward on old face perimeter    */
-          /* Third face  (0,3,2) is backward on old face perimeter   */
-          /* Fourth face (0,1,3) is inside cell but not on this face */
-          /***********************************************************/
-
-          /* Get pointer to beginning of point coordinates */
-
-          pt0 = (long)RDB[tet + TET_POINTS + 0];
-          pt1 = (long)RDB[tet + TET_POINTS + 2];
-          pt2 = (long)RDB[tet + TET_POINTS + 1];
-
-          /* Store coordinates to params */
-          k = 0;
-          params[k++] = RDB[pt0 + 0];
-          params[k++] = RDB[pt0 + 1];
-          params[k++] = RDB[pt0 + 2];
-          params[k++] = RDB[pt1 + 0];
-          params[k++] = RDB[pt1 + 1];
-          params[k++] = RDB[pt1 + 2];
-          params[k++] = RDB[pt2 + 0];
-          params[k++] = RDB[pt2 + 1];
-          params[k++] = RDB[pt2 + 2];
-
-          /* Get distance */
-
-          d = SurfaceDistance(-1, params, SURF_PLANE, 9,
-                              x, y, z, u, v, w, id);
+          /* Get distance to cell faces (packed in PackTetFaces()) */
 
-          /* Compare to minimum */
-
-          if (d < min)
-            min = d;
-
-          /* Get pointer to beginning of point coordinates */
-
-          pt0 = (long)RDB[tet + TET_POINTS + 1];
-          pt1 = (long)RDB[tet + TET_POINTS + 2];
-          pt2 = (long)RDB[tet + TET_POINTS + 3];
-
-          /* Store coordinates to params */
-          k = 0;
-          params[k++] = RDB[pt0 + 0];
-          params[k++] = RDB[pt0 + 1];
-          params[k++] = RDB[pt0 + 2];
-          params[k++] = RDB[pt1 + 0];
-          params[k++] = RDB[pt1 + 1];
-          params[k++] = RDB[pt1 + 2];
-          params[k++] = RDB[pt2 + 0];
-          params[k++] = RDB[pt2 + 1];
-          params[k++] = RDB[pt2 + 2];
-
-          /* Get distance */
-
-          d = SurfaceDistance(-1, params, SURF_PLANE, 9,
-                              x, y, z, u, v, w, id);
-
-          /* Compare to minimum */
-
-          if (d < min)
-            min = d;
-
-          /* Get pointer to beginning of point coordinates */
-
-          pt0 = (long)RDB[tet + TET_POINTS + 0];
-          pt1 = (long)RDB[tet + TET_POINTS + 3];
-          pt2 = (long)RDB[tet + TET_POINTS + 2];
-
-          /* Store coordinates to params */
-          k = 0;
-          params[k++] = RDB[pt0 + 0];
-          params[k++] = RDB[pt0 + 1];
-          params[k++] = RDB[pt0 + 2];
-          params[k++] = RDB[pt1 + 0];
-          params[k++] = RDB[pt1 + 1];
-          params[k++] = RDB[pt1 + 2];
-          params[k++] = RDB[pt2 + 0];
-          params[k++] = RDB[pt2 + 1];
-          params[k++] = RDB[pt2 + 2];
-
-          /* Get distance */
-
-          d = SurfaceDistance(-1, params, SURF_PLANE, 9,
-                              x, y, z, u, v, w, id);
+          d = TetFaceDistance(tet, x, y, z, u, v, w, &k);
 
           /* Compare to minimum */
 
           if (d < min)
             min = d;
-
-          /* Get pointer to beginning of point coordinates */
-
-          pt0 = (long)RDB[tet + TET_POINTS + 0];
-          pt1 = (long)RDB[tet + TET_POINTS + 1];
-          pt2 = (long)RDB[tet + TET_POINTS + 3];
-
-          /* Store coordinates to params */
-          k = 0;
-          params[k++] = RDB[pt0 + 0];
-          params[k++] = RDB[pt0 + 1];
-          params[k++] = RDB[pt0 + 2];
-          params[k++] = RDB[pt1 + 0];
-          params[k++] = RDB[pt1 + 1];
-          params[k++] = RDB[pt1 + 2];
-          params[k++] = RDB[pt2 + 0];
-          params[k++] = RDB[pt2 + 1];
-          params[k++] = RDB[pt2 + 2];
-
-          /* Get distance */
-
-          d = SurfaceDistance(-1, params, SURF_PLANE, 9,
-                              x, y, z, u, v, w, id);
-
-          /* Compare to minimum */
-
-          if (d < min)
-            min = d;
-
         }
 
       /* Next */
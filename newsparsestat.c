@@ -0,0 +1,110 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : newsparsestat.c                                */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Creates data structures for scores with sparse paged storage */
+/*                                                                           */
+/* Comments: - Used for large detectors instead of NewStat(). The variable   */
+/*             is two-dimensional (bins and responses) and the bin counts    */
+/*             are passed as long.                                           */
+/*                                                                           */
+/*           - Bins are divided in pages of SPARSE_STAT_PAGE_SZ values, and  */
+/*             memory is allocated for a fixed number of pages in BUF and    */
+/*             RES1. Pages are assigned in SparseStatPtr() when first scored */
+/*             (in BUF for each batch, in RES1 for the whole run).           */
+/*                                                                           */
+/*           - BUF page table contains the slot + 1 of each page (zero if    */
+/*             not scored), the number of used slots and the page of each    */
+/*             slot. The table is cleared with the rest of the buffer.       */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "NewSparseStat:"
+
+/*****************************************************************************/
+
+long NewSparseStat(char *name, long nb, long nr)
+{
+  long loc0, ptr, ntot, np, maxp, n;
+
+  /* Check bin counts */
+
+  if ((nb < 1) || (nr < 1))
+    Die(FUNCTION_NAME, "Invalid number of bins");
+
+  /* New item */
+
+  loc0 = NewItem(DATA_PTR_SCORE0, SCORE_BLOCK_SIZE);
+
+  /* Put name */
+
+  WDB[loc0 + SCORE_PTR_NAME] = (double)PutText(name);
+
+  /* Allocate memory for bin sizes and put values */
+
+  ptr = ReallocMem(DATA_ARRAY, 2);
+  WDB[loc0 + SCORE_PTR_NMAX] = (double)ptr;
+
+  WDB[ptr] = (double)nb;
+  WDB[ptr + 1] = (double)nr;
+
+  /* Put dimension and stat size */
+
+  WDB[loc0 + SCORE_DIM] = 2.0;
+
+  ntot = nb*nr;
+  WDB[loc0 + SCORE_STAT_SIZE] = (double)ntot;
+
+  /* Number of pages and maximum number of allocated pages */
+
+  np = (ntot - 1)/SPARSE_STAT_PAGE_SZ + 1;
+
+  if ((maxp = (long)RDB[DATA_SPARSE_BUF_MAX_PAGES]) > np)
+    maxp = np;
+
+  CheckValue(FUNCTION_NAME, "maxp", "", maxp, 1, np);
+
+  /* Put values */
+
+  WDB[loc0 + SCORE_SPARSE] = (double)YES;
+  WDB[loc0 + SCORE_N_PAGES] = (double)np;
+  WDB[loc0 + SCORE_MAX_PAGES] = (double)maxp;
+  WDB[loc0 + SCORE_RES_PAGES] = 0.0;
+  WDB[loc0 + SCORE_SPARSE_N] = 0.0;
+
+  /* Allocate memory for statistics pages */
+
+  ptr = ReallocMem(RES1_ARRAY, maxp*SPARSE_STAT_PAGE_SZ);
+  WDB[loc0 + SCORE_PTR_DATA] = (double)ptr;
+
+  /* Allocate memory for page table of statistics and reset */
+
+  ptr = ReallocMem(DATA_ARRAY, np);
+  WDB[loc0 + SCORE_PTR_RES_PAGE_TAB] = (double)ptr;
+
+  for (n = 0; n < np; n++)
+    WDB[ptr + n] = -1.0;
+
+  /* Allocate memory for buffer pages */
+
+  ptr = AllocPrivateData(maxp*SPARSE_STAT_PAGE_SZ*BUF_BLOCK_SIZE, BUF_ARRAY);
+  WDB[loc0 + SCORE_PTR_BUF] = (double)ptr;
+
+  /* Allocate memory for buffer page table */
+
+  ptr = AllocPrivateData(np + maxp + 1, BUF_ARRAY);
+  WDB[loc0 + SCORE_PTR_PAGE_TAB] = (double)ptr;
+
+  /* Return pointer */
+
+  return loc0;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,61 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : nextdetcandidate.c                             */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Returns next detector from candidate lists                   */
+/*                                                                           */
+/* Comments: - Lists are collected in DetCandidates(). They are sorted by    */
+/*             detector index, and the smallest index is returned first, so  */
+/*             detectors are looped in the order of the detector list.       */
+/*                                                                           */
+/*           - Detector appearing in several lists is returned once. Returns */
+/*             NULLPTR when all lists are exhausted.                         */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "NextDetCandidate:"
+
+/*****************************************************************************/
+
+long NextDetCandidate(long *lst, long n)
+{
+  long i, j, min, det;
+
+  /* Find minimum index */
+
+  min = -1;
+
+  for (i = 0; i < n; i++)
+    if ((j = (long)RDB[lst[i]]) > -1)
+      if ((min < 0) || (j < min))
+        min = j;
+
+  /* Check if lists are exhausted */
+
+  if (min < 0)
+    return NULLPTR;
+
+  /* Move lists past minimum */
+
+  for (i = 0; i < n; i++)
+    if ((long)RDB[lst[i]] == min)
+      lst[i]++;
+
+  /* Get pointer to detector */
+
+  det = (long)RDB[(long)RDB[DATA_PTR_DET_TAB] + min];
+  CheckPointer(FUNCTION_NAME, "(det)", DATA_ARRAY, det);
+
+  /* Return pointer */
+
+  return det;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,253 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : nuclidemicroxs.c                               */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Interpolates total, absorption, elastic and fission cross    */
+/*              sections of a nuclide in a single pass                       */
+/*                                                                           */
+/* Comments: - Values are indexed by NUC_XS_TOT ... NUC_XS_FISS.             */
+/*                                                                           */
+/*           - The grid factor is calculated only once per grid. Each        */
+/*             reaction is interpolated from the same data as in microxs.c:  */
+/*             from the reaction-interleaved cache-optimized block           */
+/*             (cachexs.c) if the reaction has an index in it and the        */
+/*             energy is below the limit, otherwise from the energy grid of  */
+/*             the reaction. The results are therefore identical.            */
+/*                                                                           */
+/*           - The values are stored with StoreValuePair(), so subsequent    */
+/*             calls to MicroXS() for the same reactions and energy return   */
+/*             directly. Reactions with ures data are handled by MicroXS().  */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "NuclideMicroXS:"
+
+/*****************************************************************************/
+
+void NuclideMicroXS(long nuc, double E, double *xs, long id)
+{
+  long rea[NUC_XS_N], lst[NUC_XS_N], idx[NUC_XS_N], i0[NUC_XS_N];
+  long ne[NUC_XS_N], dat[NUC_XS_N], n, m, mu, k, i, j, erg, ptr, nr;
+  double f, xs0, xs1;
+  const double *row0, *row1;
+
+  /* Check nuclide pointer */
+
+  CheckPointer(FUNCTION_NAME, "(nuc)", DATA_ARRAY, nuc);
+
+  /* Get reaction pointers */
+
+  rea[NUC_XS_TOT] = (long)RDB[nuc + NUCLIDE_PTR_TOTXS];
+  rea[NUC_XS_ABS] = (long)RDB[nuc + NUCLIDE_PTR_SUM_ABSXS];
+  rea[NUC_XS_ELA] = (long)RDB[nuc + NUCLIDE_PTR_ELAXS];
+  rea[NUC_XS_FISS] = (long)RDB[nuc + NUCLIDE_PTR_FISSXS];
+
+  /* Reset values and collect reactions that need to be interpolated. */
+  /* Reactions in the cache-optimized block are put in the beginning  */
+  /* of the list and the rest in the end. */
+
+  mu = 0;
+  m = NUC_XS_N;
+  erg = -1;
+
+  for (n = 0; n < NUC_XS_N; n++)
+    {
+      /* Reset value */
+
+      xs[n] = 0.0;
+
+      /* Check pointer */
+
+      if (rea[n] < VALID_PTR)
+        continue;
+
+      /* Reactions with ures data and missing data are handled by */
+      /* MicroXS(). */
+
+      if (((long)RDB[rea[n] + REACTION_PTR_URES] > VALID_PTR) ||
+          ((long)RDB[rea[n] + REACTION_PTR_XS] < VALID_PTR))
+        {
+          xs[n] = MicroXS(rea[n], E, id);
+          continue;
+        }
+
+      /* Test existing data */
+
+      if ((xs[n] = TestValuePair(rea[n] + REACTION_PTR_PREV_XS, E, id))
+          > -INFTY)
+        continue;
+
+      /* Check cache-optimized index (same condition as in MicroXS()) */
+
+      if (((k = (long)RDB[rea[n] + REACTION_CACHE_OPTI_IDX]) > -1) &&
+          (E < RDB[DATA_CACHE_OPTI_EMAX]))
+        {
+          /* Add to beginning of list */
+
+          idx[mu] = k;
+          lst[mu++] = n;
+
+          /* Cycle loop */
+
+          continue;
+        }
+
+      /* Check common energy grid */
+
+      if (erg < VALID_PTR)
+        erg = (long)RDB[rea[n] + REACTION_PTR_EGRID];
+      else if (erg != (long)RDB[rea[n] + REACTION_PTR_EGRID])
+        erg = 0;
+
+      /* Add to end of list */
+
+      m--;
+
+      /* Pointer to data, first point and number of points */
+
+      dat[m] = (long)RDB[rea[n] + REACTION_PTR_XS];
+      i0[m] = (long)RDB[rea[n] + REACTION_XS_I0];
+      ne[m] = (long)RDB[rea[n] + REACTION_XS_NE];
+
+      lst[m] = n;
+    }
+
+  /***************************************************************************/
+
+  /***** Indexing by reaction ************************************************/
+
+  if (mu > 0)
+    {
+      /* Get pointer to unionized energy grid */
+
+      ptr = (long)RDB[DATA_ERG_PTR_UNIONIZED_NGRID];
+      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+      /* Get interpolation factor */
+
+      if ((f = GridFactor(ptr, E, id)) < 0.0)
+        for (k = 0; k < mu; k++)
+          xs[lst[k]] = 0.0;
+      else
+        {
+          /* Separate integer and decimal parts */
+
+          i = (long)f;
+          f = f - (double)i;
+
+          /* Check values */
+
+          CheckValue(FUNCTION_NAME, "i", "", i, 0, MAX_EGRID_NE);
+          CheckValue(FUNCTION_NAME, "f", "", f, 0.0, 1.0);
+
+          /* Get pointer to data */
+
+          ptr = (long)RDB[DATA_PTR_CACHE_OPTI_XS];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+          /* Number of reactions */
+
+          nr = (long)RDB[DATA_CACHE_OPTI_NREA];
+
+          /* Pointers to neighbouring rows */
+
+          row0 = &RDB[ptr + i*nr];
+          row1 = &RDB[ptr + (i + 1)*nr];
+
+          /* Interpolate all reactions from the same rows */
+
+          for (k = 0; k < mu; k++)
+            {
+              CheckValue(FUNCTION_NAME, "idx", "", idx[k], 0, nr - 1);
+              xs[lst[k]] = f*(row1[idx[k]] - row0[idx[k]]) + row0[idx[k]];
+            }
+        }
+
+      /* Remember values */
+
+      for (k = 0; k < mu; k++)
+        StoreValuePair(rea[lst[k]] + REACTION_PTR_PREV_XS, E, xs[lst[k]],
+                       id);
+    }
+
+  /***************************************************************************/
+
+  /***** Indexing by energy **************************************************/
+
+  if (m == NUC_XS_N)
+    {
+      /* Nothing left to interpolate */
+    }
+  else if (erg > VALID_PTR)
+    {
+      /* Common grid, get interpolation factor */
+
+      if ((f = GridFactor(erg, E, id)) < 0.0)
+        for (k = m; k < NUC_XS_N; k++)
+          xs[lst[k]] = 0.0;
+      else
+        {
+          /* Separate integer and decimal parts */
+
+          i = (long)f;
+          f = f - (double)i;
+
+          /* Check values */
+
+          CheckValue(FUNCTION_NAME, "i", "", i, 0, MAX_EGRID_NE);
+          CheckValue(FUNCTION_NAME, "f", "", f, 0.0, 1.0);
+
+          /* Loop over reactions */
+
+          for (k = m; k < NUC_XS_N; k++)
+            {
+              /* Get relative index */
+
+              j = i - i0[k];
+
+              /* Check boundaries and interpolate */
+
+              if ((j < 0) || (j > ne[k] - 1))
+                xs[lst[k]] = 0.0;
+              else
+                {
+                  /* Get tabulated cross sections */
+
+                  xs0 = RDB[dat[k] + j];
+                  xs1 = RDB[dat[k] + j + 1];
+
+                  /* Interpolate */
+
+                  if (j == ne[k] - 1)
+                    xs[lst[k]] = (1.0 - f)*xs0;
+                  else
+                    xs[lst[k]] = f*(xs1 - xs0) + xs0;
+                }
+            }
+        }
+
+      /* Remember values */
+
+      for (k = m; k < NUC_XS_N; k++)
+        StoreValuePair(rea[lst[k]] + REACTION_PTR_PREV_XS, E, xs[lst[k]],
+                       id);
+    }
+  else
+    {
+      /* Different grids, use reaction-wise routine (values are stored) */
+
+      for (k = m; k < NUC_XS_N; k++)
+        xs[lst[k]] = MicroXS(rea[lst[k]], E, id);
+    }
+
+  /***************************************************************************/
+}
+
+/*****************************************************************************/
@@ -0,0 +1,131 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : ompbalance.c                                   */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Measures load imbalance between OpenMP threads in transport  */
+/*              cycle                                                        */
+/*                                                                           */
+/* Comments: - Called with OMP_BALANCE_START before and OMP_BALANCE_STOP     */
+/*             after each parallel region, and with OMP_BALANCE_THREAD by    */
+/*             each thread when it runs out of work. OMP_BALANCE_END is      */
+/*             called once per cycle, after all parallel regions (dynamic    */
+/*             modes have one region per generation and time interval).      */
+/*                                                                           */
+/*           - Imbalance is defined as 1 - mean/max of the times at which    */
+/*             the threads finish, summed over the regions of the cycle.     */
+/*             The second value in the statistics is the number of           */
+/*             particles stolen from other ques.                             */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "OMPBalance:"
+
+/*****************************************************************************/
+
+void OMPBalance(long mode, long id)
+{
+  long nt, ptr, loc0, n;
+  double max, mean, imb, ns;
+
+  /* Get pointers */
+
+  ptr = (long)RDB[DATA_PTR_OMP_FINISH_TIME];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  loc0 = (long)RDB[DATA_PTR_OMP_STEAL_COUNT];
+  CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+  /* Get number of threads */
+
+  nt = (long)RDB[DATA_OMP_MAX_THREADS];
+
+  /* Check mode */
+
+  if (mode == OMP_BALANCE_START)
+    {
+      /* Store starting time */
+
+      WDB[DATA_OMP_PARA_T0] = TimerVal(TIMER_OMP_PARA);
+
+      /* Reset finish times */
+
+      for (n = 0; n < nt; n++)
+        WDB[ptr + n] = 0.0;
+    }
+  else if (mode == OMP_BALANCE_THREAD)
+    {
+      /* Check id */
+
+      if ((id < 0) || (id > nt - 1))
+        Die(FUNCTION_NAME, "Error in thread id");
+
+      /* Store finish time */
+
+      WDB[ptr + id] = TimerVal(TIMER_OMP_PARA) - RDB[DATA_OMP_PARA_T0];
+    }
+  else if (mode == OMP_BALANCE_STOP)
+    {
+      /* Calculate maximum and mean finish time */
+
+      max = 0.0;
+      mean = 0.0;
+
+      for (n = 0; n < nt; n++)
+        {
+          if (RDB[ptr + n] > max)
+            max = RDB[ptr + n];
+
+          mean = mean + RDB[ptr + n]/((double)nt);
+        }
+
+      /* Add to sums */
+
+      WDB[DATA_OMP_PARA_SUM_MAX] = RDB[DATA_OMP_PARA_SUM_MAX] + max;
+      WDB[DATA_OMP_PARA_SUM_MEAN] = RDB[DATA_OMP_PARA_SUM_MEAN] + mean;
+    }
+  else if (mode == OMP_BALANCE_END)
+    {
+      /* Calculate total steals and reset counts */
+
+      ns = 0.0;
+
+      for (n = 0; n < nt; n++)
+        {
+          ns = ns + RDB[loc0 + n];
+          WDB[loc0 + n] = 0.0;
+        }
+
+      /* Calculate imbalance */
+
+      if (RDB[DATA_OMP_PARA_SUM_MAX] > 0.0)
+        imb = 1.0 - RDB[DATA_OMP_PARA_SUM_MEAN]/RDB[DATA_OMP_PARA_SUM_MAX];
+      else
+        imb = 0.0;
+
+      /* Reset sums */
+
+      WDB[DATA_OMP_PARA_SUM_MAX] = 0.0;
+      WDB[DATA_OMP_PARA_SUM_MEAN] = 0.0;
+
+      /* Store value and add to statistics */
+
+      WDB[DATA_OMP_CYCLE_IMBALANCE] = imb;
+
+      ptr = (long)RDB[RES_OMP_LOAD_IMBALANCE];
+      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+      AddStat(imb, ptr, 0);
+      AddStat(ns, ptr, 1);
+    }
+  else
+    Die(FUNCTION_NAME, "Invalid mode %ld", mode);
+}
+
+/*****************************************************************************/
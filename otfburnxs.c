@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : otfburnxs.c                                    */
 /*                                                                           */
 /* Created:       2018/03/25 (JLe)                                           */
-/* Last modified: 2018/03/25 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Returns macroscopic total cross sections for nuclides        */
 /*              involved in on-the-fly burnup solver.                        */
@@ -23,7 +23,7 @@
 double OTFBurnXS(long mat, double E, long mt, long id)
 {
   long loc0, iso, nuc, rea;
-  double sum, xs, adens, mult;
+  double sum, xs, adens, mult, nxs[NUC_XS_N];
 
   /* Check material pointer */
 
@@ -147,9 +147,27 @@ double OTFBurnXS(long mat, double E, long mt, long id)
 
           if (rea > VALID_PTR)
             {
-              /* Get microscopic cross section */
+              /* Get microscopic cross section (absorption, elastic and */
+              /* fission interpolated in a single pass) */
 
-              xs = MicroXS(rea, E, id);
+              if (mt == MT_MACRO_ABSXS)
+                {
+                  NuclideMicroXS(nuc, E, nxs, id);
+                  xs = nxs[NUC_XS_ABS];
+                }
+              else if (mt == MT_MACRO_ELAXS)
+                {
+                  NuclideMicroXS(nuc, E, nxs, id);
+                  xs = nxs[NUC_XS_ELA];
+                }
+              else if ((mt == MT_MACRO_FISSXS) || (mt == MT_MACRO_FISSE) ||
+                       (mt == MT_MACRO_NSF))
+                {
+                  NuclideMicroXS(nuc, E, nxs, id);
+                  xs = nxs[NUC_XS_FISS];
+                }
+              else
+                xs = MicroXS(rea, E, id);
               
               /* Get multiplier */
               
@@ -8,7 +8,8 @@
 /*                                                                           */
 /* Description: Handles OTF S(a,b) scattering                                */
 /*                                                                           */
-/* Comments: - Toi reaktioiden etsintä voi olla aika paha pullonkaula.       */
+/* Comments: - Reaction pointers are linked in ProcessOTFSab() (the list     */
+/*             search was a bottleneck).                                     */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -27,7 +28,7 @@ void OTFSabScattering(long rea, double *E, double *u, double *v, double *w,
   double mu, mut[2], E0, r, d1, d2, a, f, rnd[2], d1e[2], d2e[2], r_old;
   long law, ptr, l0, l1, l2, erg, ctype;
   long nc2, ne, ne2, i, j, k, l, nuc, n;
-  long sab, iso, ncol, mt, rea0;
+  long sab, ncol, mt, rea0;
 
   /* Check reaction pointer */
 
@@ -109,21 +110,12 @@ void OTFSabScattering(long rea, double *E, double *u, double *v, double *w,
 
       if (mt > 2000)
         {
-          iso = (long)RDB[sab + SAB_PTR_ISO];
-          CheckPointer(FUNCTION_NAME, "(iso)", DATA_ARRAY, iso);
-
-          /* Find reactions (pullonkaula) */
-
-          rea0 = (long)RDB[iso + NUCLIDE_PTR_REA];
-          while (rea0 > VALID_PTR)
-            {
-              /* Check mt */
+          /* Get reaction (linked in ProcessOTFSab()) */
 
-              if((long)RDB[rea0 + REACTION_MT] == mt - 1000)
-                break;
-
-              rea0 = NextItem(rea0);
-            }
+          if (mt == 2002)
+            rea0 = (long)RDB[sab + SAB_PTR_REA_ELA];
+          else
+            rea0 = (long)RDB[sab + SAB_PTR_REA_INL];
 
           /* Check that valid reactions were found */
 
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : otfsabxs.c                                     */
 /*                                                                           */
 /* Created:       2015/03/20 (TVi)                                           */
-/* Last modified: 2016/10/03 (JLe)                                           */
-/* Version:       2.1.28                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Returns interpolated cross sections for on-the-fly S(a,b)    */
 /*              treatment.                                                   */
@@ -12,6 +12,9 @@
 /* Comments: - JLe 1.11.2015 / 2.1.25 Poistin tuolta tallennuksen            */
 /*             REACTION_PTR_PREV_XS:iin (liittyy ures-sämpläykseen)          */
 /*                                                                           */
+/*           - JLe 17.10.2026 / 2.1.32: Temperature interval and reactions   */
+/*             are found by direct indexing (see processotfsab.c).           */
+/*                                                                           */
 /*****************************************************************************/
 
 #include "header.h"
@@ -23,7 +26,7 @@
 
 double OTFSabXS(long rea, double E, double T, long id){
 
-  long nuc, sab1, sab2, nuc1, nuc2, mt, rea2, sab0, ptr, ncol; 
+  long nuc, sab1, sab2, nuc1, nuc2, mt, rea2, sab0, ptr, ncol, n; 
   double f, xs1, xs2, T1, T2, xs;
  
   /* Check reaction pointer */
@@ -46,31 +49,45 @@ double OTFSabXS(long rea, double E, double T, long id){
 
   /* Check that data exists */
 
-  if ((sab2 = (long)RDB[nuc + NUCLIDE_PTR_SAB]) < VALID_PTR )
+  if ((sab0 = (long)RDB[nuc + NUCLIDE_PTR_SAB]) < VALID_PTR )
     Die(FUNCTION_NAME, "S(a,b) data not available for nuclide %s", 
         GetText(nuc + NUCLIDE_PTR_NAME));
-  
-  /* Find correct temperature */
-  
-  while(sab2 > VALID_PTR)
-    {      
 
-      if (RDB[sab2 + SAB_T] > T ||
-          (RDB[sab2 + SAB_T] == T && 
-           NextItem(sab2) < VALID_PTR ) )
-        break;
+  /* Check temperature limits */
+
+  if (T < RDB[sab0 + SAB_T])
+    Die(FUNCTION_NAME, "S(a,b) OTF nuclide not found for %s", 
+        GetText(nuc + NUCLIDE_PTR_NAME));
+
+  /* Get index to temperature bin (see processotfsab.c) */
+
+  n = (long)((T - RDB[sab0 + SAB_T])/RDB[sab0 + SAB_TIDX_DT]);
+
+  if (n > (long)RDB[sab0 + SAB_TIDX_N] - 1)
+    n = (long)RDB[sab0 + SAB_TIDX_N] - 1;
+
+  /* Pointer to interval */
+
+  ptr = (long)RDB[sab0 + SAB_PTR_TIDX];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
 
+  sab1 = (long)RDB[ptr + n];
+  sab2 = NextItem(sab1);
+
+  /* Find correct temperature */
+
+  while ((T >= RDB[sab2 + SAB_T]) && (NextItem(sab2) > VALID_PTR))
+    {
+      sab1 = sab2;
       sab2 = NextItem(sab2);
     }
 
-  /* Check that sab was found */
+  /* Check that temperature is not above the last point */
 
-  if (sab2 < VALID_PTR)
+  if (T > RDB[sab2 + SAB_T])
     Die(FUNCTION_NAME, "S(a,b) OTF nuclide not found for %s", 
         GetText(nuc + NUCLIDE_PTR_NAME));
 
-  sab1 = PrevItem(sab2);
-
   /* Check Pointers */
 
   CheckPointer(FUNCTION_NAME, "(sab1)", DATA_ARRAY, sab1);
@@ -98,24 +115,14 @@ double OTFSabXS(long rea, double E, double T, long id){
   if ((mt == 1) || (mt == 2))
     rea2 = (long)RDB[nuc1 + NUCLIDE_PTR_TOTXS];
   
-  /* Find reaction at first temperature */
+  /* Get reaction at first temperature (linked in ProcessOTFSab()) */
 
   else
     {
-      /* Pointer to reaction */
-
-      rea2 = (long)RDB[nuc1 + NUCLIDE_PTR_REA];
-      CheckPointer(FUNCTION_NAME, "(rea2)", DATA_ARRAY, rea2);
-
-      /* JLe: Tässä voisi käyttää SeekList():iä */
-
-      while (rea2 > VALID_PTR)
-        {     
-          if ((long)RDB[rea2 + REACTION_MT] == mt - 1000)
-            break;
-      
-          rea2 = NextItem(rea2);
-        }
+      if (mt - 1000 == 1002)
+        rea2 = (long)RDB[sab1 + SAB_PTR_REA_ELA];
+      else
+        rea2 = (long)RDB[sab1 + SAB_PTR_REA_INL];
     
       if (rea2 < VALID_PTR)
         Die(FUNCTION_NAME, "mt %ld not found for S(a,b) nuclide %s", mt, 
@@ -130,26 +137,18 @@ double OTFSabXS(long rea, double E, double T, long id){
   if ((mt == 1) || (mt == 2))
     rea2 = (long)RDB[nuc2 + NUCLIDE_PTR_TOTXS];
 
-    /* Find reaction at second temperature */
+    /* Get reaction at second temperature */
 
   else
     {
-      rea2 = (long)RDB[nuc2 + NUCLIDE_PTR_REA];
-      CheckPointer(FUNCTION_NAME, "(rea2)", DATA_ARRAY, rea2);
-
-      /* JLe: Tässä voisi käyttää SeekList():iä */
-
-      while (rea2 > VALID_PTR)
-        {
-          if ((long)RDB[rea2 + REACTION_MT] == mt - 1000)
-            break;
-      
-          rea2 = NextItem(rea2);
-        }
+      if (mt - 1000 == 1002)
+        rea2 = (long)RDB[sab2 + SAB_PTR_REA_ELA];
+      else
+        rea2 = (long)RDB[sab2 + SAB_PTR_REA_INL];
     
       if (rea2 < VALID_PTR)
         Die(FUNCTION_NAME, "mt %ld not found for S(a,b) nuclide %s", mt, 
-            GetText(nuc1 + NUCLIDE_PTR_NAME));
+            GetText(nuc2 + NUCLIDE_PTR_NAME));
     }
 
   /* Get cross section */
@@ -177,10 +176,6 @@ double OTFSabXS(long rea, double E, double T, long id){
   ptr = (long)RDB[DATA_PTR_COLLISION_COUNT];
   ncol = (long)GetPrivateData(ptr, id);
 
-  /* Pointer to first item in sab list */
-
-  sab0 = (long)RDB[nuc + NUCLIDE_PTR_SAB];
-
   /* Store values */
 
   StoreValuePair(sab0 + SAB_PTR_PREV_FRAC, (double)ncol, f, id);
@@ -0,0 +1,415 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : packcellsurfaces.c                             */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Packs cell boundary surfaces into per-type coefficient       */
+/*              arrays used by PackedSurfDistance()                          */
+/*                                                                           */
+/* Comments: - Surfaces are grouped into planes, cylinders (by axis) and     */
+/*             spheres. Coefficients are stored one group after another,     */
+/*             each coefficient in its own array so that the distance loops  */
+/*             can be vectorized.                                            */
+/*                                                                           */
+/*           - Surfaces composed of planes (cube, cuboid, rect, sqc and hex  */
+/*             types without rounded corners) are split into their facets.   */
+/*             Plane coefficients are (A, B, C, D) with A*x + B*y + C*z = D. */
+/*                                                                           */
+/*           - Surfaces with transformations and other types are stored as   */
+/*             pointers and passed to SurfaceDistance().                     */
+/*                                                                           */
+/*           - If ptr is not a valid pointer, only the size of the block is  */
+/*             returned.                                                     */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "PackCellSurfaces:"
+
+static long SurfGroup(long, double [8][4], long *);
+
+/*****************************************************************************/
+
+long PackCellSurfaces(long cell, long ptr)
+{
+  long loc0, surf, i, j, k, g, n, cnt[SURF_PACK_DATA], idx[SURF_PACK_DATA];
+  long sz;
+  double c[8][4];
+  static const long nc[SURF_PACK_DATA] = {4, 3, 3, 3, 4, 1};
+
+  /* Check cell pointer */
+
+  CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
+
+  /* Pointer to surface list */
+
+  loc0 = (long)RDB[cell + CELL_PTR_SURF_LIST];
+  CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+  /* Reset counts */
+
+  for (g = 0; g < SURF_PACK_DATA; g++)
+    cnt[g] = 0;
+
+  /* Loop over surfaces and count items in groups */
+
+  for (i = 0; (surf = (long)RDB[loc0 + i]) > VALID_PTR; i++)
+    {
+      /* Skip duplicates */
+
+      for (j = 0; j < i; j++)
+        if ((long)RDB[loc0 + j] == surf)
+          break;
+
+      if (j < i)
+        continue;
+
+      /* Get group and add count */
+
+      if ((g = SurfGroup(surf, c, &n)) > -1)
+        cnt[g] = cnt[g] + n;
+    }
+
+  /* Calculate size */
+
+  sz = SURF_PACK_DATA;
+
+  for (g = 0; g < SURF_PACK_DATA; g++)
+    sz = sz + nc[g]*cnt[g];
+
+  /* Check mode */
+
+  if (ptr < VALID_PTR)
+    return sz;
+
+  /* Put counts and calculate pointers to groups */
+
+  k = ptr + SURF_PACK_DATA;
+
+  for (g = 0; g < SURF_PACK_DATA; g++)
+    {
+      WDB[ptr + g] = (double)cnt[g];
+
+      idx[g] = k;
+      k = k + nc[g]*cnt[g];
+    }
+
+  /* Loop over surfaces and put coefficients */
+
+  for (i = 0; (surf = (long)RDB[loc0 + i]) > VALID_PTR; i++)
+    {
+      /* Skip duplicates */
+
+      for (j = 0; j < i; j++)
+        if ((long)RDB[loc0 + j] == surf)
+          break;
+
+      if (j < i)
+        continue;
+
+      /* Get group */
+
+      if ((g = SurfGroup(surf, c, &n)) < 0)
+        continue;
+
+      /* Put coefficients (k:th coefficient in k:th array) */
+
+      for (j = 0; j < n; j++)
+        {
+          if (g == SURF_PACK_N_OTHER)
+            WDB[idx[g]] = (double)surf;
+          else
+            for (k = 0; k < nc[g]; k++)
+              WDB[idx[g] + k*cnt[g]] = c[j][k];
+
+          idx[g]++;
+        }
+    }
+
+  /* Return size */
+
+  return sz;
+}
+
+/*****************************************************************************/
+
+/***** Get group and coefficients ********************************************/
+
+static long SurfGroup(long surf, double c[8][4], long *n)
+{
+  long ptr, type, np, i;
+  double x0, y0, r;
+
+  /* Get type and number of parameters */
+
+  type = (long)RDB[surf + SURFACE_TYPE];
+  np = (long)RDB[surf + SURFACE_N_PARAMS];
+
+  /* Infinite surfaces are skipped */
+
+  if (type == SURF_INF)
+    return -1;
+
+  /* Surfaces with transformations are handled separately */
+
+  *n = 1;
+
+  if ((long)RDB[surf + SURFACE_PTR_TRANS] > VALID_PTR)
+    return SURF_PACK_N_OTHER;
+
+  /* Pointer to parameters */
+
+  ptr = (long)RDB[surf + SURFACE_PTR_PARAMS];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  /* Reset plane coefficients */
+
+  for (i = 0; i < 8; i++)
+    {
+      c[i][0] = 0.0;
+      c[i][1] = 0.0;
+      c[i][2] = 0.0;
+      c[i][3] = 0.0;
+    }
+
+  /* Check type */
+
+  switch (type)
+    {
+    case SURF_PX:
+    case SURF_PY:
+    case SURF_PZ:
+      {
+        /* Put normal and constant */
+
+        if (type == SURF_PX)
+          c[0][0] = 1.0;
+        else if (type == SURF_PY)
+          c[0][1] = 1.0;
+        else
+          c[0][2] = 1.0;
+
+        c[0][3] = RDB[ptr];
+
+        return SURF_PACK_N_PLANE;
+      }
+
+    case SURF_PLANE:
+    case SURF_MPLANE:
+      {
+        /* Plane defined by three points is not packed */
+
+        if ((np < 1) || (np > 4))
+          return SURF_PACK_N_OTHER;
+
+        /* Put coefficients */
+
+        for (i = 0; i < np; i++)
+          c[0][i] = RDB[ptr + i];
+
+        return SURF_PACK_N_PLANE;
+      }
+
+    case SURF_CUBOID:
+    case SURF_RECT:
+      {
+        /* Check number of parameters */
+
+        if ((type == SURF_CUBOID) && (np != 6))
+          return SURF_PACK_N_OTHER;
+        else if ((type == SURF_RECT) && (np != 4))
+          return SURF_PACK_N_OTHER;
+
+        /* Put planes */
+
+        *n = np;
+
+        for (i = 0; i < np; i++)
+          {
+            c[i][i/2] = 1.0;
+            c[i][3] = RDB[ptr + i];
+          }
+
+        return SURF_PACK_N_PLANE;
+      }
+
+    case SURF_CUBE:
+      {
+        /* Check number of parameters */
+
+        if (np != 4)
+          return SURF_PACK_N_OTHER;
+
+        /* Get half-width */
+
+        r = RDB[ptr + 3];
+
+        /* Put planes */
+
+        *n = 6;
+
+        for (i = 0; i < 3; i++)
+          {
+            c[2*i][i] = 1.0;
+            c[2*i][3] = RDB[ptr + i] + r;
+            c[2*i + 1][i] = 1.0;
+            c[2*i + 1][3] = RDB[ptr + i] - r;
+          }
+
+        return SURF_PACK_N_PLANE;
+      }
+
+    case SURF_SQC:
+      {
+        /* Rounded corners are not packed */
+
+        if (np != 3)
+          return SURF_PACK_N_OTHER;
+
+        /* Get center and half-width */
+
+        x0 = RDB[ptr];
+        y0 = RDB[ptr + 1];
+        r = RDB[ptr + 2];
+
+        /* Put planes */
+
+        *n = 4;
+
+        c[0][0] = 1.0;
+        c[0][3] = x0 + r;
+        c[1][0] = 1.0;
+        c[1][3] = x0 - r;
+        c[2][1] = 1.0;
+        c[2][3] = y0 + r;
+        c[3][1] = 1.0;
+        c[3][3] = y0 - r;
+
+        return SURF_PACK_N_PLANE;
+      }
+
+    case SURF_HEXYC:
+    case SURF_HEXXC:
+    case SURF_HEXYPRISM:
+    case SURF_HEXXPRISM:
+      {
+        /* Rounded corners are not packed */
+
+        if ((np != 3) && (np != 5))
+          return SURF_PACK_N_OTHER;
+        else if ((np == 5) &&
+                 ((type == SURF_HEXYC) || (type == SURF_HEXXC)))
+          return SURF_PACK_N_OTHER;
+
+        /* Get center and half-width (swap axes for x-type) */
+
+        if ((type == SURF_HEXYC) || (type == SURF_HEXYPRISM))
+          {
+            x0 = RDB[ptr];
+            y0 = RDB[ptr + 1];
+            i = 0;
+          }
+        else
+          {
+            x0 = RDB[ptr + 1];
+            y0 = RDB[ptr];
+            i = 1;
+          }
+
+        r = RDB[ptr + 2];
+
+        /* Flat sides */
+
+        c[0][1 - i] = 1.0;
+        c[0][3] = y0 + r;
+        c[1][1 - i] = 1.0;
+        c[1][3] = y0 - r;
+
+        /* Sides at 60 degrees */
+
+        c[2][i] = -SQRT3;
+        c[2][1 - i] = 1.0;
+        c[2][3] = y0 - SQRT3*x0 + 2.0*r;
+        c[3][i] = -SQRT3;
+        c[3][1 - i] = 1.0;
+        c[3][3] = y0 - SQRT3*x0 - 2.0*r;
+
+        /* Sides at 120 degrees */
+
+        c[4][i] = SQRT3;
+        c[4][1 - i] = 1.0;
+        c[4][3] = y0 + SQRT3*x0 + 2.0*r;
+        c[5][i] = SQRT3;
+        c[5][1 - i] = 1.0;
+        c[5][3] = y0 + SQRT3*x0 - 2.0*r;
+
+        *n = 6;
+
+        /* Axial planes of prism */
+
+        if (np == 5)
+          {
+            c[6][2] = 1.0;
+            c[6][3] = RDB[ptr + 3];
+            c[7][2] = 1.0;
+            c[7][3] = RDB[ptr + 4];
+
+            *n = 8;
+          }
+
+        return SURF_PACK_N_PLANE;
+      }
+
+    case SURF_CYL:
+    case SURF_CYLZ:
+    case SURF_CYLX:
+    case SURF_CYLY:
+      {
+        /* Truncated cylinders are not packed */
+
+        if (np != 3)
+          return SURF_PACK_N_OTHER;
+
+        /* Put center and squared radius */
+
+        c[0][0] = RDB[ptr];
+        c[0][1] = RDB[ptr + 1];
+        c[0][2] = RDB[ptr + 2]*RDB[ptr + 2];
+
+        if (type == SURF_CYLX)
+          return SURF_PACK_N_CYLX;
+        else if (type == SURF_CYLY)
+          return SURF_PACK_N_CYLY;
+        else
+          return SURF_PACK_N_CYLZ;
+      }
+
+    case SURF_SPH:
+      {
+        if (np != 4)
+          return SURF_PACK_N_OTHER;
+
+        /* Put center and squared radius */
+
+        r = RDB[ptr + 3];
+
+        c[0][0] = RDB[ptr];
+        c[0][1] = RDB[ptr + 1];
+        c[0][2] = RDB[ptr + 2];
+        c[0][3] = r*r;
+
+        return SURF_PACK_N_SPH;
+      }
+    }
+
+  /* Other types */
+
+  return SURF_PACK_N_OTHER;
+}
+
+/*****************************************************************************/
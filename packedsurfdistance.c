@@ -0,0 +1,278 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : packedsurfdistance.c                           */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Calculates minimum distance to the surfaces of a cell using  */
+/*              the packed coefficient arrays                                */
+/*                                                                           */
+/* Comments: - Data is created in PackCellSurfaces().                        */
+/*                                                                           */
+/*           - Each group is evaluated in a single loop over contiguous      */
+/*             coefficient arrays. Rejected roots are replaced by infinity   */
+/*             instead of skipping the comparison, so that the loops reduce  */
+/*             to a minimum and the compiler can vectorize them.             */
+/*                                                                           */
+/*           - The equations and sign conventions are the same as in         */
+/*             SurfaceDistance().                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "PackedSurfDistance:"
+
+static double CylDistance(const double *, long, double, double, double,
+                          double, double, double);
+
+/*****************************************************************************/
+
+double PackedSurfDistance(long ptr, double x, double y, double z, double u,
+                          double v, double w, long id)
+{
+  long n, i, surf, loc0;
+  double min, d, L, M, b, c, d0, x0, y0, z0;
+  const double *A, *B, *C, *D;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  /* Reset minimum */
+
+  min = INFTY;
+
+  /* Pointer to data */
+
+  loc0 = ptr + SURF_PACK_DATA;
+
+  /***************************************************************************/
+
+  /***** Planes **************************************************************/
+
+  if ((n = (long)RDB[ptr + SURF_PACK_N_PLANE]) > 0)
+    {
+      /* Pointers to coefficients */
+
+      A = &RDB[loc0];
+      B = &RDB[loc0 + n];
+      C = &RDB[loc0 + 2*n];
+      D = &RDB[loc0 + 3*n];
+
+      /* Loop over planes */
+
+      for (i = 0; i < n; i++)
+        {
+          /* Calculate constants */
+
+          M = A[i]*u + B[i]*v + C[i]*w;
+          L = A[i]*x + B[i]*y + C[i]*z - D[i];
+
+          /* Calculate distance */
+
+          d = -L/M;
+
+          /* Check direction parallel to plane and negative distance */
+
+          if ((M == 0.0) || (d < 0.0))
+            d = INFTY;
+
+          /* Compare to minimum */
+
+          if (d < min)
+            min = d;
+        }
+
+      /* Update pointer */
+
+      loc0 = loc0 + 4*n;
+    }
+
+  /***************************************************************************/
+
+  /***** Cylinders ***********************************************************/
+
+  /* Cylinders parallel to x-axis */
+
+  if ((n = (long)RDB[ptr + SURF_PACK_N_CYLX]) > 0)
+    {
+      if ((d = CylDistance(&RDB[loc0], n, y, z, v, w, 1.0 - u*u, min)) < min)
+        min = d;
+
+      loc0 = loc0 + 3*n;
+    }
+
+  /* Cylinders parallel to y-axis */
+
+  if ((n = (long)RDB[ptr + SURF_PACK_N_CYLY]) > 0)
+    {
+      if ((d = CylDistance(&RDB[loc0], n, x, z, u, w, 1.0 - v*v, min)) < min)
+        min = d;
+
+      loc0 = loc0 + 3*n;
+    }
+
+  /* Cylinders parallel to z-axis */
+
+  if ((n = (long)RDB[ptr + SURF_PACK_N_CYLZ]) > 0)
+    {
+      if ((d = CylDistance(&RDB[loc0], n, x, y, u, v, 1.0 - w*w, min)) < min)
+        min = d;
+
+      loc0 = loc0 + 3*n;
+    }
+
+  /***************************************************************************/
+
+  /***** Spheres *************************************************************/
+
+  if ((n = (long)RDB[ptr + SURF_PACK_N_SPH]) > 0)
+    {
+      /* Pointers to coefficients */
+
+      A = &RDB[loc0];
+      B = &RDB[loc0 + n];
+      C = &RDB[loc0 + 2*n];
+      D = &RDB[loc0 + 3*n];
+
+      /* Loop over spheres */
+
+      for (i = 0; i < n; i++)
+        {
+          /* Shift origin */
+
+          x0 = x - A[i];
+          y0 = y - B[i];
+          z0 = z - C[i];
+
+          /* Calculate constants */
+
+          b = u*x0 + v*y0 + w*z0;
+          c = x0*x0 + y0*y0 + z0*z0 - D[i];
+
+          d0 = b*b - c;
+
+          /* Only one root is possible inside, negative outside root */
+          /* is in the opposite direction */
+
+          if (c < 0.0)
+            d = -(b - sqrt(fabs(d0)));
+          else
+            d = -(b + sqrt(fabs(d0)));
+
+          /* Check line-of-sight */
+
+          if ((d0 < 0.0) || ((c >= 0.0) && (d < 0.0)))
+            d = INFTY;
+
+          /* Compare to minimum */
+
+          if (d < min)
+            min = d;
+        }
+
+      /* Update pointer */
+
+      loc0 = loc0 + 4*n;
+    }
+
+  /***************************************************************************/
+
+  /***** Other surfaces ******************************************************/
+
+  n = (long)RDB[ptr + SURF_PACK_N_OTHER];
+
+  for (i = 0; i < n; i++)
+    {
+      /* Pointer to surface */
+
+      surf = (long)RDB[loc0 + i];
+      CheckPointer(FUNCTION_NAME, "(surf)", DATA_ARRAY, surf);
+
+      /* Get distance */
+
+      d = SurfaceDistance(surf, &RDB[(long)RDB[surf + SURFACE_PTR_PARAMS]],
+                          (long)RDB[surf + SURFACE_TYPE],
+                          (long)RDB[surf + SURFACE_N_PARAMS],
+                          x, y, z, u, v, w, id);
+
+      /* Compare to minimum */
+
+      if (d < min)
+        min = d;
+    }
+
+  /***************************************************************************/
+
+  /* Return minimum */
+
+  return min;
+}
+
+/*****************************************************************************/
+
+/***** Distance to a group of cylinders **************************************/
+
+static double CylDistance(const double *prm, long n, double x, double y,
+                          double u, double v, double a, double min)
+{
+  long i;
+  double x0, y0, b, c, d0, d;
+  const double *X, *Y, *R2;
+
+  /* Check direction parallel to axis */
+
+  if (a == 0.0)
+    return INFTY;
+
+  /* Pointers to coefficients */
+
+  X = prm;
+  Y = &prm[n];
+  R2 = &prm[2*n];
+
+  /* Loop over cylinders */
+
+  for (i = 0; i < n; i++)
+    {
+      /* Shift origin */
+
+      x0 = x - X[i];
+      y0 = y - Y[i];
+
+      /* Calculate constants */
+
+      b = u*x0 + v*y0;
+      c = x0*x0 + y0*y0 - R2[i];
+
+      d0 = b*b - a*c;
+
+      /* Only one root is possible inside, negative outside root is in */
+      /* the opposite direction */
+
+      if (c < 0.0)
+        d = -(b - sqrt(fabs(d0)))/a;
+      else
+        d = -(b + sqrt(fabs(d0)))/a;
+
+      /* Check line-of-sight */
+
+      if ((d0 < 0.0) || ((c >= 0.0) && (d < 0.0)))
+        d = INFTY;
+
+      /* Compare to minimum */
+
+      if (d < min)
+        min = d;
+    }
+
+  /* Return minimum */
+
+  return min;
+}
+
+/*****************************************************************************/
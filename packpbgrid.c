@@ -0,0 +1,207 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : packpbgrid.c                                   */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Packs pebble bed search mesh into contiguous arrays used by  */
+/*              FindPBRegion() and NearestPBSurf()                           */
+/*                                                                           */
+/* Comments: - The content of each search mesh cell is stored in index range */
+/*             IDX[n] ... IDX[n + 1] - 1 of arrays X, Y, Z, R2 (squared      */
+/*             radius), PBL (pebble pointer) and COUNT (pointer to search    */
+/*             counter), where n = i + nx*(j + ny*k). The sphere tests loop  */
+/*             over the arrays without pointer chasing and can be            */
+/*             vectorized.                                                   */
+/*                                                                           */
+/*           - Data is in the shared main data array, so it is not copied    */
+/*             for OpenMP threads.                                           */
+/*                                                                           */
+/*           - The grid is re-packed in place after the search mesh lists    */
+/*             are sorted in SortAll(), so that the order of entries follows */
+/*             the lists.                                                    */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "PackPBGrid:"
+
+/*****************************************************************************/
+
+void PackPBGrid(long pbd)
+{
+  long msh, grd, nx, ny, nz, nt, i, j, k, n, m, lst, pbl, idx, ptr;
+  double r;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(pbd)", DATA_ARRAY, pbd);
+
+  /* Pointer to search mesh */
+
+  msh = (long)RDB[pbd + PBED_PTR_SEARCH_MESH];
+  CheckPointer(FUNCTION_NAME, "(msh)", DATA_ARRAY, msh);
+
+  /* Get size */
+
+  nx = (long)RDB[msh + MESH_N0];
+  ny = (long)RDB[msh + MESH_N1];
+  nz = (long)RDB[msh + MESH_N2];
+
+  /* Check size */
+
+  CheckValue(FUNCTION_NAME, "size", "", nx*ny*nz, 1, 1000000000);
+
+  /* Check if grid exists */
+
+  if ((grd = (long)RDB[pbd + PBED_PTR_GRID]) < VALID_PTR)
+    {
+      /***********************************************************************/
+
+      /***** Allocate memory *************************************************/
+
+      /* Count entries */
+
+      nt = 0;
+
+      for (k = 0; k < nz; k++)
+        for (j = 0; j < ny; j++)
+          for (i = 0; i < nx; i++)
+            {
+              /* Get pointer to list */
+
+              lst = ReadMeshPtr(msh, i, j, k);
+              CheckPointer(FUNCTION_NAME, "(lst)", DATA_ARRAY, lst);
+
+              /* Loop over content */
+
+              lst = (long)RDB[lst];
+              while (lst > VALID_PTR)
+                {
+                  nt++;
+                  lst = NextItem(lst);
+                }
+            }
+
+      /* Allocate memory for block */
+
+      grd = ReallocMem(DATA_ARRAY, PBGRID_BLOCK_SIZE);
+      WDB[pbd + PBED_PTR_GRID] = (double)grd;
+
+      /* Put dimensions */
+
+      WDB[grd + PBGRID_N0] = (double)nx;
+      WDB[grd + PBGRID_N1] = (double)ny;
+      WDB[grd + PBGRID_N2] = (double)nz;
+
+      WDB[grd + PBGRID_MIN0] = RDB[msh + MESH_MIN0];
+      WDB[grd + PBGRID_MIN1] = RDB[msh + MESH_MIN1];
+      WDB[grd + PBGRID_MIN2] = RDB[msh + MESH_MIN2];
+
+      WDB[grd + PBGRID_PITCH0] = (RDB[msh + MESH_MAX0] - RDB[msh + MESH_MIN0])
+        /((double)nx);
+      WDB[grd + PBGRID_PITCH1] = (RDB[msh + MESH_MAX1] - RDB[msh + MESH_MIN1])
+        /((double)ny);
+      WDB[grd + PBGRID_PITCH2] = (RDB[msh + MESH_MAX2] - RDB[msh + MESH_MIN2])
+        /((double)nz);
+
+      WDB[grd + PBGRID_N_ENTRIES] = (double)nt;
+
+      /* Allocate memory for index and data arrays (one extra value to */
+      /* avoid zero size) */
+
+      ptr = ReallocMem(DATA_ARRAY, nx*ny*nz + 1);
+      WDB[grd + PBGRID_PTR_IDX] = (double)ptr;
+
+      ptr = ReallocMem(DATA_ARRAY, 6*nt + 1);
+
+      WDB[grd + PBGRID_PTR_X] = (double)ptr;
+      WDB[grd + PBGRID_PTR_Y] = (double)(ptr + nt);
+      WDB[grd + PBGRID_PTR_Z] = (double)(ptr + 2*nt);
+      WDB[grd + PBGRID_PTR_R2] = (double)(ptr + 3*nt);
+      WDB[grd + PBGRID_PTR_PBL] = (double)(ptr + 4*nt);
+      WDB[grd + PBGRID_PTR_COUNT] = (double)(ptr + 5*nt);
+
+      /***********************************************************************/
+    }
+
+  /***************************************************************************/
+
+  /***** Put data ************************************************************/
+
+  /* Pointer to index array */
+
+  idx = (long)RDB[grd + PBGRID_PTR_IDX];
+  CheckPointer(FUNCTION_NAME, "(idx)", DATA_ARRAY, idx);
+
+  /* Reset counters */
+
+  n = 0;
+  m = 0;
+
+  /* Loop over mesh */
+
+  for (k = 0; k < nz; k++)
+    for (j = 0; j < ny; j++)
+      for (i = 0; i < nx; i++)
+        {
+          /* Put index of first entry */
+
+          WDB[idx + n++] = (double)m;
+
+          /* Get pointer to list */
+
+          lst = ReadMeshPtr(msh, i, j, k);
+          CheckPointer(FUNCTION_NAME, "(lst)", DATA_ARRAY, lst);
+
+          /* Loop over content */
+
+          lst = (long)RDB[lst];
+          while (lst > VALID_PTR)
+            {
+              /* Check count */
+
+              if (m == (long)RDB[grd + PBGRID_N_ENTRIES])
+                Die(FUNCTION_NAME, "Error in grid size");
+
+              /* Pointer to pebble */
+
+              pbl = (long)RDB[lst + SEARCH_MESH_CELL_CONTENT];
+              CheckPointer(FUNCTION_NAME, "(pbl)", DATA_ARRAY, pbl);
+
+              /* Put data */
+
+              r = RDB[pbl + PEBBLE_RAD];
+
+              WDB[(long)RDB[grd + PBGRID_PTR_X] + m] = RDB[pbl + PEBBLE_X0];
+              WDB[(long)RDB[grd + PBGRID_PTR_Y] + m] = RDB[pbl + PEBBLE_Y0];
+              WDB[(long)RDB[grd + PBGRID_PTR_Z] + m] = RDB[pbl + PEBBLE_Z0];
+              WDB[(long)RDB[grd + PBGRID_PTR_R2] + m] = r*r;
+              WDB[(long)RDB[grd + PBGRID_PTR_PBL] + m] = (double)pbl;
+              WDB[(long)RDB[grd + PBGRID_PTR_COUNT] + m] =
+                RDB[lst + SEARCH_MESH_PTR_CELL_COUNT];
+
+              /* Next */
+
+              m++;
+              lst = NextItem(lst);
+            }
+        }
+
+  /* Put end of last range */
+
+  WDB[idx + n] = (double)m;
+
+  /* Check count */
+
+  if (m != (long)RDB[grd + PBGRID_N_ENTRIES])
+    Die(FUNCTION_NAME, "Error in grid size");
+
+  /***************************************************************************/
+}
+
+/*****************************************************************************/
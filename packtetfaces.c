@@ -0,0 +1,89 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : packtetfaces.c                                 */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Calculates face planes of a tetrahedron and stores them in   */
+/*              the tet block                                                */
+/*                                                                           */
+/* Comments: - Planes are stored as unit normals (U, V, W) and constants D,  */
+/*             each component in its own array of four values, so that the   */
+/*             four faces are tested in a single loop. Value                 */
+/*             U*x + V*y + W*z - D is the signed distance from the face and  */
+/*             positive outside the tet.                                     */
+/*                                                                           */
+/*           - Face numbering and orientation are the same as in InTetCell() */
+/*             before the faces were packed.                                 */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "PackTetFaces:"
+
+/*****************************************************************************/
+
+void PackTetFaces(long tet)
+{
+  long pt0, pt1, pt2, i;
+  long face[4][3] = {{0, 2, 1}, {1, 2, 3}, {0, 3, 2}, {0, 1, 3}};
+  double x1, y1, z1, x2, y2, z2, A, B, C, l;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(tet)", DATA_ARRAY, tet);
+
+  /* Loop over faces */
+
+  for (i = 0; i < 4; i++)
+    {
+      /* Get pointers to points */
+
+      pt0 = (long)RDB[tet + TET_POINTS + face[i][0]];
+      pt1 = (long)RDB[tet + TET_POINTS + face[i][1]];
+      pt2 = (long)RDB[tet + TET_POINTS + face[i][2]];
+
+      CheckPointer(FUNCTION_NAME, "(pt0)", DATA_ARRAY, pt0);
+      CheckPointer(FUNCTION_NAME, "(pt1)", DATA_ARRAY, pt1);
+      CheckPointer(FUNCTION_NAME, "(pt2)", DATA_ARRAY, pt2);
+
+      /* Perimeter vectors */
+
+      x1 = -RDB[pt0 + 0] + RDB[pt1 + 0];
+      y1 = -RDB[pt0 + 1] + RDB[pt1 + 1];
+      z1 = -RDB[pt0 + 2] + RDB[pt1 + 2];
+
+      x2 = -RDB[pt1 + 0] + RDB[pt2 + 0];
+      y2 = -RDB[pt1 + 1] + RDB[pt2 + 1];
+      z2 = -RDB[pt1 + 2] + RDB[pt2 + 2];
+
+      /* Normal vector (cross product) */
+
+      A = y1*z2 - y2*z1;
+      B = x2*z1 - x1*z2;
+      C = x1*y2 - x2*y1;
+
+      /* Normalize (degenerate faces are left as zero) */
+
+      if ((l = sqrt(A*A + B*B + C*C)) > 0.0)
+        {
+          A = A/l;
+          B = B/l;
+          C = C/l;
+        }
+
+      /* Put coefficients */
+
+      WDB[tet + TET_FACE_U + i] = A;
+      WDB[tet + TET_FACE_V + i] = B;
+      WDB[tet + TET_FACE_W + i] = C;
+      WDB[tet + TET_FACE_D + i] =
+        A*RDB[pt1 + 0] + B*RDB[pt1 + 1] + C*RDB[pt1 + 2];
+    }
+}
+
+/*****************************************************************************/
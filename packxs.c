@@ -0,0 +1,115 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : packxs.c                                       */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Stores reconstructed cross section array and returns the     */
+/*              maximum relative error caused by single-precision storage    */
+/*                                                                           */
+/* Comments: - Data is copied as such if single-precision storage is not in  */
+/*             use for the reaction (REACTION_XS_SP).                        */
+/*                                                                           */
+/*           - Single-precision values are packed two per DATA array word.   */
+/*                                                                           */
+/*           - The error of linear interpolation between stored points is    */
+/*             bounded by the larger of the two endpoint errors, which is    */
+/*             compared to the larger of the two absolute values (this       */
+/*             avoids division by zero for data that changes sign).          */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "PackXS:"
+
+/*****************************************************************************/
+
+double PackXS(long rea, const double *xs, long ne)
+{
+  long ptr, n;
+  double e0, e1, max, err, f;
+  float *sp;
+
+  /* Check pointers */
+
+  CheckPointer(FUNCTION_NAME, "(rea)", DATA_ARRAY, rea);
+
+  ptr = (long)RDB[rea + REACTION_PTR_XS];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  /* Check number of points */
+
+  if (ne != (long)RDB[rea + REACTION_XS_NE])
+    Die(FUNCTION_NAME, "Mismatch in array size");
+
+  /* Check mode */
+
+  if ((long)RDB[rea + REACTION_XS_SP] == NO)
+    {
+      /* Copy data */
+
+      memcpy(&WDB[ptr], xs, ne*sizeof(double));
+
+      /* Exit subroutine */
+
+      return 0.0;
+    }
+
+  /* Pointer to packed data */
+
+  sp = (float *)&WDB[ptr];
+
+  /* Store values */
+
+  for (n = 0; n < ne; n++)
+    sp[n] = (float)xs[n];
+
+  /* Reset maximum error */
+
+  err = 0.0;
+
+  /* Error at first point */
+
+  e0 = fabs((double)sp[0] - xs[0]);
+
+  /* Loop over intervals */
+
+  for (n = 0; n < ne - 1; n++)
+    {
+      /* Error at upper boundary */
+
+      e1 = fabs((double)sp[n + 1] - xs[n + 1]);
+
+      /* Maximum absolute value */
+
+      if ((max = fabs(xs[n])) < fabs(xs[n + 1]))
+        max = fabs(xs[n + 1]);
+
+      /* Compare relative error to maximum */
+
+      if (max > 0.0)
+        {
+          if (e0 > e1)
+            f = e0/max;
+          else
+            f = e1/max;
+
+          if (f > err)
+            err = f;
+        }
+
+      /* Update lower boundary */
+
+      e0 = e1;
+    }
+
+  /* Return maximum error */
+
+  return err;
+}
+
+/*****************************************************************************/
@@ -3,12 +3,21 @@
 /* serpent 2 (beta-version) : preparecellsearchmesh.c                        */
 /*                                                                           */
 /* Created:       2018/06/20 (JLe)                                           */
-/* Last modified: 2018/06/26 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Prepares an adaptive cell search mesh for cell universes     */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - Enabled with "set adacsm". The mesh is refined level by       */
+/*             level: points are sampled in all search items of the current  */
+/*             level in parallel, and items with the maximum number of cells */
+/*             are split (serial, since it allocates memory).                */
+/*                                                                           */
+/*           - Meshes are read from and written to cache files, if cache     */
+/*             directory is given (see csmcacheheader.c).                    */
+/*                                                                           */
+/*           - Search items store pointers to cell list items, which provide */
+/*             the region index needed for zone indexing.                    */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -17,19 +26,21 @@
 
 #define FUNCTION_NAME "PrepareCellSearchMesh:"
 
-void SplitCell(long, long, long);
+static void SampleCell(long, long, long, long);
 
 /*****************************************************************************/
 
 void PrepareCellSearchMesh()
 {
-  long uni, loc0, loc1, loc2, ptr, n, i, j, k, l, idx, msh, szp, sz, last;
-  long it, np, nc, cell, id, depth, split, sz0;
-  unsigned long seed;
-  double xmin, xmax, ymin, ymax, zmin, zmax, lims[6], x, y, z;
+  long uni, loc0, loc1, ptr, n, i, j, k, idx, msh, szp, last, it, nf, n0;
+  long id, *items;
+  double lims[6];
+
+  /* Check mode */
+
+  if ((long)RDB[DATA_ADA_CSM_MODE] == NO)
+    return;
 
-  /* Get number of points */
-  return;
   fprintf(outp, "Preparing adaptive cell search lists:\n\n");
 
   /* Expand PRIVA, BUF and RES2 arrays for OpenMP parallel calculation */
@@ -37,22 +48,15 @@ void PrepareCellSearchMesh()
 
   ExpandPrivateArrays();
 
-  /* Put mesh depth, size, split criterion and number of sampled points */
-
-  depth = 20;
-  sz0 = 5;
-  sz = 2;
-  split = MAX_CELL_SEARCH_MESH_SZ;
-  np = 1000;
-
   /* Loop over universes */
 
   uni = (long)RDB[DATA_PTR_U0];
   while (uni > VALID_PTR)
     {
-      /* Check type */
+      /* Check type and existing mesh */
 
-      if ((long)RDB[uni + UNIVERSE_TYPE] != UNIVERSE_TYPE_CELL)
+      if (((long)RDB[uni + UNIVERSE_TYPE] != UNIVERSE_TYPE_CELL) ||
+          ((long)RDB[uni + UNIVERSE_PTR_SEARCH_MESH] > VALID_PTR))
         {
           /* Next universe */
 
@@ -67,8 +71,8 @@ void PrepareCellSearchMesh()
 
       ptr = (long)RDB[uni + UNIVERSE_PTR_CELL_LIST];
       CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-      
-      if (ListSize(ptr) <= split)
+
+      if (ListSize(ptr) <= MAX_CELL_SEARCH_MESH_SZ)
         {
           /* Next universe */
 
@@ -79,56 +83,35 @@ void PrepareCellSearchMesh()
           continue;
         }
 
+      /* Start timer */
+
+      ResetTimer(TIMER_MISC);
+      StartTimer(TIMER_MISC);
+
       /***********************************************************************/
 
       /***** Prepare adaptive search mesh ************************************/
 
-      /* Get boundaries */
-      
-      xmin = RDB[uni + UNIVERSE_MINX];
-      xmax = RDB[uni + UNIVERSE_MAXX];
-      ymin = RDB[uni + UNIVERSE_MINY];
-      ymax = RDB[uni + UNIVERSE_MAXY];
-      zmin = RDB[uni + UNIVERSE_MINZ];
-      zmax = RDB[uni + UNIVERSE_MAXZ];
-
-      /* Compare to geometry boundaries */
-      /*
-      if (xmin < RDB[DATA_GEOM_MINX])
-        xmin = RDB[DATA_GEOM_MINX];
-      if (xmax < RDB[DATA_GEOM_MAXX])
-        xmax = RDB[DATA_GEOM_MAXX];
-
-      if (ymin < RDB[DATA_GEOM_MINY])
-        ymin = RDB[DATA_GEOM_MINY];
-      if (ymax < RDB[DATA_GEOM_MAXY])
-        ymax = RDB[DATA_GEOM_MAXY];
-
-      if (zmin < RDB[DATA_GEOM_MINZ])
-        zmin = RDB[DATA_GEOM_MINZ];
-      if (zmax < RDB[DATA_GEOM_MAXZ])
-        zmax = RDB[DATA_GEOM_MAXZ];
-      */
       /* Allocate memory for size vector */
 
-      szp = ReallocMem(DATA_ARRAY, depth + 1);
-      
+      szp = ReallocMem(DATA_ARRAY, ADA_CSM_DEPTH + 1);
+
       /* Put values */
 
-      WDB[szp] = (double)sz0;
-      for (n = 1; n < depth; n++)
-        WDB[szp + n] = (double)sz;
-      
-      WDB[szp + n] = -1.0;      
+      WDB[szp] = (double)ADA_CSM_SZ0;
+      for (n = 1; n < ADA_CSM_DEPTH; n++)
+        WDB[szp + n] = (double)ADA_CSM_SZ;
+
+      WDB[szp + n] = -1.0;
 
       /* Put boundaries */
 
-      lims[0] = xmin;
-      lims[1] = xmax;
-      lims[2] = ymin;
-      lims[3] = ymax;
-      lims[4] = zmin;
-      lims[5] = zmax;
+      lims[0] = RDB[uni + UNIVERSE_MINX];
+      lims[1] = RDB[uni + UNIVERSE_MAXX];
+      lims[2] = RDB[uni + UNIVERSE_MINY];
+      lims[3] = RDB[uni + UNIVERSE_MAXY];
+      lims[4] = RDB[uni + UNIVERSE_MINZ];
+      lims[5] = RDB[uni + UNIVERSE_MAXZ];
 
       /* Create search mesh */
 
@@ -138,226 +121,149 @@ void PrepareCellSearchMesh()
 
       /* Init data */
 
-      for (k = 0; k < sz0; k++)
-        for (j = 0; j < sz0; j++)
-          for (i = 0; i < sz0; i++)
+      for (k = 0; k < ADA_CSM_SZ0; k++)
+        for (j = 0; j < ADA_CSM_SZ0; j++)
+          for (i = 0; i < ADA_CSM_SZ0; i++)
             {
               /* Create search item */
 
-              loc1 = NewItem(uni + UNIVERSE_PTR_SEARCH_MESH_DATA, 
+              loc1 = NewItem(uni + UNIVERSE_PTR_SEARCH_MESH_DATA,
                              CELL_SEARCH_MESH_SIZE);
 
               /* Get mesh pointer */
-              
+
               loc0 = ReadMeshPtr(msh, i, j, k);
               CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
-              
+
               /* Put pointer */
 
               WDB[loc0] = (double)loc1;
 
               /* Calculate index */
 
-              idx = i + j*sz0 + k*sz0*sz0;              
-              
+              idx = i + j*ADA_CSM_SZ0 + k*ADA_CSM_SZ0*ADA_CSM_SZ0;
+
               /* Put mesh pointer and cell index */
 
               WDB[loc1 + CELL_SEARCH_MESH_PTR_MSH] = (double)msh;
               WDB[loc1 + CELL_SEARCH_MESH_IDX] = (double)idx;
             }
-        
-      /***********************************************************************/
 
-      /***** Adapt mesh by sampling random points ****************************/
+      /***********************************************************************/
 
-      /* Loop over iterations */
+      /***** Read mesh from cache file ***************************************/
 
-      for (it = 0; it < depth - 1; it++)
+      if (ReadCSMCache(uni) == YES)
         {
-          /******************************************************************/
-      
-          /***** Sample random points in mesh *******************************/
+          /* Stop timer */
 
-          /* Pointer to mesh */
+          StopTimer(TIMER_MISC);
 
-          msh = (long)RDB[uni + UNIVERSE_PTR_SEARCH_MESH];
-          CheckPointer(FUNCTION_NAME, "(msh)", DATA_ARRAY, msh);
+          fprintf(outp, " - Universe %s -- OK (%ld cells, read from cache, ",
+                  GetText(uni + UNIVERSE_PTR_NAME), ListSize(ptr));
+          fprintf(outp, "%1.1f seconds)\n", TimerVal(TIMER_MISC));
 
-          /* Number of points */
+          /* Next universe */
 
+          uni = NextItem(uni);
 
-          id = 0;
+          /* Cycle loop */
 
-          /* Loop over mesh */
+          continue;
+        }
 
-#ifdef OPEN_MP
-#pragma omp parallel for private(id, idx, xmin, xmax, ymin, ymax, zmin, zmax, l, seed, x, y, z, loc0, loc1, ptr, nc, n, cell)
-#endif
+      /***********************************************************************/
 
-          for (idx = 0; idx < sz0*sz0*sz0; idx++)
-            {
-              /* Get boundaries */
-              
-              MeshCellBounds(msh, idx, &xmin, &xmax, &ymin, &ymax, 
-                             &zmin, &zmax);
-              
-              /* Get Open MP thread id */
+      /***** Adapt mesh by sampling random points ****************************/
 
-              id = OMP_THREAD_NUM;
+      /* Reset number of processed search items (used for random number */
+      /* sequences) */
 
-              /* Loop over random points */
-              
-              for (l = 0; l < np; l++)
-                {
-                  /* Init random number sequence */
-                  
-                  seed = ReInitRNG(it*sz0*sz0*sz0*np + idx*np + l); 
-                  SEED[id*RNG_SZ] = seed;
-                  
-                  /* Sample point */
-                  
-                  x = RandF(id)*(xmax - xmin) + xmin;
-                  y = RandF(id)*(ymax - ymin) + ymin;
-                  
-                  if ((long)RDB[uni + UNIVERSE_DIM] == 3)
-                    z = RandF(id)*(zmax - zmin) + zmin;
-                  else
-                    z = 0.0;
-                  
-                  /* Get mesh pointer */
-                  
-                  loc0 = MeshPtr(msh, x, y, z);
-                  CheckPointer(FUNCTION_NAME, "(loc02)", DATA_ARRAY, loc0);
-                  
-                  loc0 = (long)RDB[loc0];
-                  CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
-                  
-                  /* Get number of previously found cells */
-                  
-                  nc = (long)RDB[loc0 + CELL_SEARCH_MESH_N];
-
-                  /* Loop over previous points */
-                  
-                  for (n = 0; n < nc; n++)
-                    {
-                      /* Get pointer to cell */
-                      
-                      cell = (long)RDB[loc0 + CELL_SEARCH_MESH_PTR_C1 + n];
-                      CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
-                      
-                      /* Test cell */
-                      
-                      if (InCell(cell, x, y, z, NO, id) == YES)
-                        break;
-                    }
-                  
-                  /* Check if found */
-                  
-                  if (n < nc)
-                    continue;
-                  
-                  /* Loop over all cells in universe */
-                  
-                  ptr = (long)RDB[uni + UNIVERSE_PTR_CELL_LIST];
-                  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-                  
-                  n = 0;
-                  while ((loc1 = ListPtr(ptr, n++)) > VALID_PTR)
-                    {
-                      /* Pointer to cell */
-                      
-                      cell = (long)RDB[loc1 + CELL_LIST_PTR_CELL];
-                      CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
-          
-                      /* Test cell */
-                          
-                      if (InCell(cell, x, y, z, NO, id) == YES)
-                        {
-                          /* Check count */
-                          
-                          if (nc < split)
-                            {
-                              /* Add pointer in list */
-                              
-                              WDB[loc0 + CELL_SEARCH_MESH_PTR_C1 + nc] = 
-                                (double)cell;
-                              
-                              /* Add count */
-                              
-                              WDB[loc0 + CELL_SEARCH_MESH_N] = 
-                                (double)(++nc);
-                            }
-                          
-                          /* Break loop */
-                          
-                          break;
-                        }
-                    }
-                }
-            }
-          
-          /******************************************************************/
+      n0 = 0;
 
-          /***** Check splits ***********************************************/
+      /* Loop over levels */
 
-          /* Get pointer to mesh data */
+      for (it = 0; it < ADA_CSM_DEPTH - 1; it++)
+        {
+          /* Pointer to first search item on this level */
 
-          loc1 = (long)RDB[uni + UNIVERSE_PTR_SEARCH_MESH_DATA];
-          CheckPointer(FUNCTION_NAME, "(loc1)", DATA_ARRAY, loc1);
+          if ((loc1 = (long)RDB[uni + UNIVERSE_PTR_SEARCH_MESH_DATA]) <
+              VALID_PTR)
+            break;
 
-          /* Pointer to last */
+          /* Count items and get pointer to last */
 
-          if ((last = LastItem(loc1)) < VALID_PTR)
-            break;
+          nf = 0;
+          last = loc1;
 
-          /* Loop over data */ 
-          
           while (loc1 > VALID_PTR)
             {
-              /* Check splitting */
-              
-              if ((long)RDB[loc1 + CELL_SEARCH_MESH_N] == split)
-                {
-                  /* Get mesh pointer and index */
+              last = loc1;
+              nf++;
+              loc1 = NextItem(loc1);
+            }
 
-                  msh = (long)RDB[loc1 + CELL_SEARCH_MESH_PTR_MSH];
-                  idx = (long)RDB[loc1 + CELL_SEARCH_MESH_IDX];
-                  
-                  /* Get pointer to pointer */
-                  
-                  loc2 = (long)RDB[msh + MESH_PTR_PTR] + idx;
-                  CheckPointer(FUNCTION_NAME, "(loc2)", DATA_ARRAY, loc2);
-                  
-                  /* Split cell */
+          /* Make table of items for parallel loop */
 
-                  SplitCell(uni, msh, idx);
-                }
-              
-              /* Check if last */
+          items = (long *)Mem(MEM_ALLOC, nf, sizeof(long));
 
-              if (loc1 == last)
-                break;
-                
-              /* Next cell */
-                  
+          loc1 = (long)RDB[uni + UNIVERSE_PTR_SEARCH_MESH_DATA];
+          for (n = 0; n < nf; n++)
+            {
+              items[n] = loc1;
               loc1 = NextItem(loc1);
             }
 
+          /* Sample points in each item (items are independent, so the */
+          /* result doesn't depend on the number of threads) */
+
+#ifdef OPEN_MP
+#pragma omp parallel private(id, n)
+#endif
+          {
+            /* Get Open MP thread id */
+
+            id = OMP_THREAD_NUM;
+
+#ifdef OPEN_MP
+#pragma omp for schedule(dynamic)
+#endif
+            for (n = 0; n < nf; n++)
+              SampleCell(uni, items[n], n0 + n, id);
+          }
+
+          /* Split full items (creates items for the next level) */
+
+          for (n = 0; n < nf; n++)
+            if ((long)RDB[items[n] + CELL_SEARCH_MESH_N] ==
+                MAX_CELL_SEARCH_MESH_SZ)
+              SplitCell(uni, (long)RDB[items[n] + CELL_SEARCH_MESH_PTR_MSH],
+                        (long)RDB[items[n] + CELL_SEARCH_MESH_IDX]);
+
+          /* Free table and update counter */
+
+          Mem(MEM_FREE, items);
+          n0 = n0 + nf;
+
           /* Put new list pointer */
-          
+
           WDB[uni + UNIVERSE_PTR_SEARCH_MESH_DATA] = (double)NextItem(last);
- 
-          /******************************************************************/
         }
 
-      ptr = (long)RDB[uni + UNIVERSE_PTR_CELL_LIST];
-      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+      /* Write cache file */
+
+      WriteCSMCache(uni);
+
+      /* Stop timer */
 
-      fprintf(outp, " - Universe %s -- OK (%ld cells, %ld levels)\n", 
+      StopTimer(TIMER_MISC);
+
+      fprintf(outp, " - Universe %s -- OK (%ld cells, %ld levels, ",
               GetText(uni + UNIVERSE_PTR_NAME), ListSize(ptr), it + 1);
+      fprintf(outp, "%1.1f seconds)\n", TimerVal(TIMER_MISC));
 
       /***********************************************************************/
-    
+
       /* Next universe */
 
       uni = NextItem(uni);
@@ -372,6 +278,106 @@ void PrepareCellSearchMesh()
 
 /*****************************************************************************/
 
+/***** Sample random points in search item ***********************************/
+
+static void SampleCell(long uni, long loc0, long n0, long id)
+{
+  long msh, idx, ptr, loc1, cell, nc, n, l;
+  double xmin, xmax, ymin, ymax, zmin, zmax, x, y, z;
+
+  /* Get mesh pointer and index */
+
+  msh = (long)RDB[loc0 + CELL_SEARCH_MESH_PTR_MSH];
+  idx = (long)RDB[loc0 + CELL_SEARCH_MESH_IDX];
+
+  /* Get boundaries */
+
+  MeshCellBounds(msh, idx, &xmin, &xmax, &ymin, &ymax, &zmin, &zmax);
+
+  /* Pointer to cell list */
+
+  ptr = (long)RDB[uni + UNIVERSE_PTR_CELL_LIST];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  /* Loop over random points */
+
+  for (l = 0; l < ADA_CSM_NP; l++)
+    {
+      /* Get number of previously found cells */
+
+      if ((nc = (long)RDB[loc0 + CELL_SEARCH_MESH_N]) ==
+          MAX_CELL_SEARCH_MESH_SZ)
+        break;
+
+      /* Init random number sequence */
+
+      SEED[id*RNG_SZ] = ReInitRNG(n0*ADA_CSM_NP + l);
+
+      /* Sample point */
+
+      x = RandF(id)*(xmax - xmin) + xmin;
+      y = RandF(id)*(ymax - ymin) + ymin;
+
+      if ((long)RDB[uni + UNIVERSE_DIM] == 3)
+        z = RandF(id)*(zmax - zmin) + zmin;
+      else
+        z = 0.0;
+
+      /* Loop over previous points */
+
+      for (n = 0; n < nc; n++)
+        {
+          /* Get pointer to cell (via cell list item) */
+
+          loc1 = (long)RDB[loc0 + CELL_SEARCH_MESH_PTR_C1 + n];
+          CheckPointer(FUNCTION_NAME, "(loc1)", DATA_ARRAY, loc1);
+
+          cell = (long)RDB[loc1 + CELL_LIST_PTR_CELL];
+          CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
+
+          /* Test cell */
+
+          if (InCell(cell, x, y, z, NO, id) == YES)
+            break;
+        }
+
+      /* Check if found */
+
+      if (n < nc)
+        continue;
+
+      /* Loop over all cells in universe */
+
+      n = 0;
+      while ((loc1 = ListPtr(ptr, n++)) > VALID_PTR)
+        {
+          /* Pointer to cell */
+
+          cell = (long)RDB[loc1 + CELL_LIST_PTR_CELL];
+          CheckPointer(FUNCTION_NAME, "(cell)", DATA_ARRAY, cell);
+
+          /* Test cell */
+
+          if (InCell(cell, x, y, z, NO, id) == YES)
+            {
+              /* Add pointer to cell list item (needed for region index) */
+
+              WDB[loc0 + CELL_SEARCH_MESH_PTR_C1 + nc] = (double)loc1;
+
+              /* Add count */
+
+              WDB[loc0 + CELL_SEARCH_MESH_N] = (double)(nc + 1);
+
+              /* Break loop */
+
+              break;
+            }
+        }
+    }
+}
+
+/*****************************************************************************/
+
 /***** Split cell ************************************************************/
 
 void SplitCell(long uni, long msh, long idx)
@@ -0,0 +1,384 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : preparedtregions.c                             */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Prepares spatial regions for regional delta-tracking         */
+/*              majorants                                                    */
+/*                                                                           */
+/* Comments: - Enabled with "set dtreg". The regions are the cells of a      */
+/*             Cartesian mesh covering the geometry. Materials in each       */
+/*             region are found by sampling points, and the regions are      */
+/*             stored in material-wise lists used for calculating the        */
+/*             majorants in CalculateDTMajorants().                          */
+/*                                                                           */
+/*           - Divided materials are included in the list of the parent,     */
+/*             since zones are not created at this point.                    */
+/*                                                                           */
+/*           - The material set of each region is the union of the sampled   */
+/*             sets of the region and all its neighbours (including edge and */
+/*             corner neighbours). This covers materials that are missed in  */
+/*             sampling but found in an adjacent region.                     */
+/*                                                                           */
+/*           - Sampling may still miss small volumes. If total cross         */
+/*             section is found to exceed the regional majorant in MoveDT()  */
+/*             during inactive cycles, the failure is scored and the region  */
+/*             is switched to global majorant between cycles in              */
+/*             CollectResults(). Failures in active cycles, where the        */
+/*             results would be biased, are treated as errors.               */
+/*                                                                           */
+/*           - Not used with domain decomposition or multi-group majorants.  */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "PrepareDTRegions:"
+
+static long RegionUnion(long, const long *, const long *, long, long, long,
+                        long, long *);
+
+/*****************************************************************************/
+
+void PrepareDTRegions()
+{
+  long n0, n1, n2, nr, np, i, j, k, n, m, idx, msh, mat, cell, ptr, id, nmax;
+  long nu, *set, *ns, *uni;
+  unsigned long seed;
+  double lims[6], x, y, z, u, v, w, dx, dy, dz, sum;
+
+  /* Check mode */
+
+  if (((long)RDB[DATA_OPT_USE_DT] == NO) ||
+      ((long)RDB[DATA_DT_REG_N0] < 1))
+    return;
+
+  /* Check domain decomposition and multi-group mode */
+
+  if ((long)RDB[DATA_DD_DECOMPOSE] == YES)
+    {
+      Note(0, "Regional majorants not used with domain decomposition");
+      return;
+    }
+  else if ((long)RDB[DATA_OPTI_MG_MODE] == YES)
+    {
+      Note(0, "Regional majorants not used with multi-group majorants");
+      return;
+    }
+
+  fprintf(outp, "Preparing regions for delta-tracking majorants:\n\n");
+
+  /* Expand PRIVA, BUF and RES2 arrays for OpenMP parallel calculation */
+  /* (this is needed to enable call to WhereAmI()) */
+
+  ExpandPrivateArrays();
+
+  /* Get mesh size and number of points */
+
+  n0 = (long)RDB[DATA_DT_REG_N0];
+  n1 = (long)RDB[DATA_DT_REG_N1];
+  n2 = (long)RDB[DATA_DT_REG_N2];
+  np = (long)RDB[DATA_DT_REG_NP];
+
+  /* Put boundaries */
+
+  lims[0] = RDB[DATA_GEOM_MINX];
+  lims[1] = RDB[DATA_GEOM_MAXX];
+  lims[2] = RDB[DATA_GEOM_MINY];
+  lims[3] = RDB[DATA_GEOM_MAXY];
+
+  /* Use single axial region in 2D geometries */
+
+  if ((long)RDB[DATA_GEOM_DIM] == 3)
+    {
+      lims[4] = RDB[DATA_GEOM_MINZ];
+      lims[5] = RDB[DATA_GEOM_MAXZ];
+    }
+  else
+    {
+      lims[4] = -INFTY;
+      lims[5] = INFTY;
+      n2 = 1;
+    }
+
+  /* Create mesh */
+
+  msh = CreateMesh(MESH_TYPE_CARTESIAN, MESH_CONTENT_NONE, -1, n0, n1, n2,
+                   lims, -1);
+
+  /* Number of regions and region size */
+
+  nr = n0*n1*n2;
+
+  dx = (lims[1] - lims[0])/((double)n0);
+  dy = (lims[3] - lims[2])/((double)n1);
+  dz = (lims[5] - lims[4])/((double)n2);
+
+  /* Allocate memory for temporary material sets */
+
+  set = (long *)Mem(MEM_ALLOC, nr*np, sizeof(long));
+  ns = (long *)Mem(MEM_ALLOC, nr, sizeof(long));
+
+  /***************************************************************************/
+
+  /***** Sample materials in regions *****************************************/
+
+#ifdef OPEN_MP
+#pragma omp parallel private (idx, i, j, k, n, m, seed, x, y, z, u, v, w, cell, mat, id)
+#endif
+  {
+    /* Loop over regions */
+
+#ifdef OPEN_MP
+#pragma omp for
+#endif
+    for (idx = 0; idx < nr; idx++)
+      {
+        /* Get OpenMP thread num */
+
+        id = OMP_THREAD_NUM;
+
+        /* Init random number sequence */
+
+        seed = ReInitRNG(idx + 1);
+        SEED[id*RNG_SZ] = seed;
+
+        /* Get mesh indexes */
+
+        i = idx % n0;
+        j = (idx/n0) % n1;
+        k = idx/(n0*n1);
+
+        /* Reset count */
+
+        ns[idx] = 0;
+
+        /* Loop over points */
+
+        for (n = 0; n < np; n++)
+          {
+            /* Sample point */
+
+            x = lims[0] + ((double)i + RandF(id))*dx;
+            y = lims[2] + ((double)j + RandF(id))*dy;
+
+            if ((long)RDB[DATA_GEOM_DIM] == 3)
+              z = lims[4] + ((double)k + RandF(id))*dz;
+            else
+              z = 0.0;
+
+            /* Sample direction (this is necessary for STL geometries) */
+
+            IsotropicDirection(&u, &v, &w, id);
+
+            /* Find position */
+
+            if ((cell = WhereAmI(x, y, z, u, v, w, id)) < 0)
+              Error(0, "Geometry error at %E %E %E", x, y, z);
+
+            /* Get material (divided materials point to parent) */
+
+            if ((mat = (long)RDB[cell + CELL_PTR_MAT]) < VALID_PTR)
+              continue;
+
+            /* Check if material is already included */
+
+            for (m = 0; m < ns[idx]; m++)
+              if (set[idx*np + m] == mat)
+                break;
+
+            /* Add to set */
+
+            if (m == ns[idx])
+              set[idx*np + ns[idx]++] = mat;
+          }
+      }
+  }
+
+  /***************************************************************************/
+
+  /***** Create material-wise region lists ***********************************/
+
+  /* Allocate memory for union of neighbour sets */
+
+  uni = (long *)Mem(MEM_ALLOC, 27*np, sizeof(long));
+
+  /* Reset average and maximum number of materials */
+
+  sum = 0.0;
+  nmax = 0;
+
+  /* Count regions */
+
+  for (idx = 0; idx < nr; idx++)
+    {
+      /* Get union of sets */
+
+      nu = RegionUnion(idx, set, ns, np, n0, n1, n2, uni);
+
+      /* Add counts */
+
+      for (m = 0; m < nu; m++)
+        {
+          mat = uni[m];
+          WDB[mat + MATERIAL_DT_REG_N] = RDB[mat + MATERIAL_DT_REG_N] + 1.0;
+        }
+
+      /* Update average and maximum */
+
+      sum = sum + (double)nu;
+
+      if (nu > nmax)
+        nmax = nu;
+    }
+
+  /* Allocate memory for lists */
+
+  mat = (long)RDB[DATA_PTR_M0];
+  while (mat > VALID_PTR)
+    {
+      /* Check count */
+
+      if ((n = (long)RDB[mat + MATERIAL_DT_REG_N]) > 0)
+        {
+          /* Allocate memory */
+
+          ptr = ReallocMem(DATA_ARRAY, n + 1);
+          WDB[mat + MATERIAL_PTR_DT_REG_LIST] = (double)ptr;
+
+          /* Put terminator and reset count */
+
+          WDB[ptr + n] = -1.0;
+          WDB[mat + MATERIAL_DT_REG_N] = 0.0;
+        }
+
+      /* Next material */
+
+      mat = NextItem(mat);
+    }
+
+  /* Put regions */
+
+  for (idx = 0; idx < nr; idx++)
+    {
+      /* Get union of sets */
+
+      nu = RegionUnion(idx, set, ns, np, n0, n1, n2, uni);
+
+      /* Loop over materials */
+
+      for (m = 0; m < nu; m++)
+        {
+          /* Pointer to material and list */
+
+          mat = uni[m];
+
+          ptr = (long)RDB[mat + MATERIAL_PTR_DT_REG_LIST];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+          /* Put index and update count */
+
+          n = (long)RDB[mat + MATERIAL_DT_REG_N];
+          WDB[ptr + n] = (double)idx;
+          WDB[mat + MATERIAL_DT_REG_N] = (double)(n + 1);
+        }
+    }
+
+  /***************************************************************************/
+
+  /* Free temporary arrays */
+
+  Mem(MEM_FREE, set);
+  Mem(MEM_FREE, ns);
+  Mem(MEM_FREE, uni);
+
+  /* Allocate memory for majorants and failure flags */
+
+  ptr = ReallocMem(DATA_ARRAY, nr*(long)RDB[DATA_DT_REG_NG]);
+  WDB[DATA_DT_REG_PTR_MAJ] = (double)ptr;
+
+  ptr = ReallocMem(DATA_ARRAY, nr);
+  WDB[DATA_DT_REG_PTR_FAIL] = (double)ptr;
+
+  for (n = 0; n < nr; n++)
+    WDB[ptr + n] = (double)NO;
+
+  /* Put mesh pointer (enables regional majorants) */
+
+  WDB[DATA_DT_REG_PTR_MESH] = (double)msh;
+
+  /* Print */
+
+  fprintf(outp, " - %ld x %ld x %ld regions, %ld points per region\n",
+          n0, n1, n2, np);
+  fprintf(outp, " - %1.1f materials per region on average, maximum %ld\n\n",
+          sum/((double)nr), nmax);
+
+  /* Material sets are not exact */
+
+  if ((long)RDB[DATA_CRIT_SKIP] == 0)
+    Note(0, "Regional majorant failures are errors without inactive cycles");
+}
+
+/*****************************************************************************/
+
+/***** Union of sampled sets in region and its neighbours ********************/
+
+static long RegionUnion(long idx, const long *set, const long *ns, long np,
+                        long n0, long n1, long n2, long *uni)
+{
+  long i, j, k, i0, j0, k0, nb, m, l, nu;
+
+  /* Get mesh indexes */
+
+  i0 = idx % n0;
+  j0 = (idx/n0) % n1;
+  k0 = idx/(n0*n1);
+
+  /* Reset count */
+
+  nu = 0;
+
+  /* Loop over neighbours */
+
+  for (k = k0 - 1; k < k0 + 2; k++)
+    for (j = j0 - 1; j < j0 + 2; j++)
+      for (i = i0 - 1; i < i0 + 2; i++)
+        {
+          /* Check boundaries */
+
+          if ((i < 0) || (i > n0 - 1) || (j < 0) || (j > n1 - 1) ||
+              (k < 0) || (k > n2 - 1))
+            continue;
+
+          /* Neighbour index */
+
+          nb = i + j*n0 + k*n0*n1;
+
+          /* Loop over materials */
+
+          for (m = 0; m < ns[nb]; m++)
+            {
+              /* Check if already included */
+
+              for (l = 0; l < nu; l++)
+                if (uni[l] == set[nb*np + m])
+                  break;
+
+              /* Add to set */
+
+              if (l == nu)
+                uni[nu++] = set[nb*np + m];
+            }
+        }
+
+  /* Return count */
+
+  return nu;
+}
+
+/*****************************************************************************/
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : printcycleoutput.c                             */
 /*                                                                           */
 /* Created:       2011/04/03 (JLe)                                           */
-/* Last modified: 2019/03/13 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Prints cycle-wise data & info to standard output             */
 /*                                                                           */
@@ -309,6 +309,10 @@ void PrintCycleOutput()
              100.0*TimerCPUVal(TIMER_TRANSPORT_CYCLE)/
              TimerVal(TIMER_TRANSPORT_CYCLE));
 
+      if ((long)RDB[DATA_OMP_MAX_THREADS] > 1)
+        fprintf(outp, "OpenMP load imbalance (last cycle) : %7.1f%%\n",
+                100.0*RDB[DATA_OMP_CYCLE_IMBALANCE]);
+
       /* K-eff estimates */
 
       if ((long)RDB[DATA_SIMULATION_MODE] == SIMULATION_MODE_CRIT)
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : processdetectors.c                             */
 /*                                                                           */
 /* Created:       2011/03/03 (JLe)                                           */
-/* Last modified: 2020/06/27 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Processes detector definitions                               */
@@ -1155,6 +1155,12 @@ void ProcessDetectors()
       if (tot > 10000000000)
         Error(det, "Total number of bins exceeds maximum");
 
+      /* Bin indexes are passed to statistics routines as int arguments */
+
+      if (tot*rbins > INT_MAX)
+        Error(det, "Total number of bins %ld exceeds maximum %d", tot*rbins,
+              INT_MAX);
+
       /* Check zero */
 
       if (tot < 1)
@@ -1178,9 +1184,22 @@ void ProcessDetectors()
       if (RDB[det + DET_VOL] < 0.0)
         WDB[det + DET_VOL] = 1.0;
 
-      /* Allocate memory for results */
-
-      ptr = NewStat(str, 2, tot, rbins);
+      /* Allocate memory for results (sparse storage is used for large */
+      /* detectors if bins are never skipped in CollectDet() and results */
+      /* are not combined between MPI tasks) */
+
+      if (((long)RDB[DATA_SPARSE_BUF_MIN_BINS] > 0) &&
+          (tot*rbins >= (long)RDB[DATA_SPARSE_BUF_MIN_BINS]) &&
+          (mpitasks == 1) &&
+          ((long)RDB[det + DET_FET_PTR_PARAMS] < VALID_PTR) &&
+          ((long)RDB[det + DET_TYPE] != DETECTOR_TYPE_CUMU) &&
+          ((long)RDB[det + DET_TYPE] != DETECTOR_TYPE_DIVI) &&
+          ((long)RDB[det + DET_WRITE_HIS] != 1) &&
+          (((long)RDB[DATA_SIMULATION_MODE] != SIMULATION_MODE_DYN) ||
+           ((long)RDB[det + DET_PTR_TME] < VALID_PTR)))
+        ptr = NewSparseStat(str, tot, rbins);
+      else
+        ptr = NewStat(str, 2, tot, rbins);
 
       /* Put pointer */
 
@@ -1283,6 +1302,13 @@ void ProcessDetectors()
     }
 
   /***************************************************************************/
+
+  /***** Compile bin lookup data and reverse index ***************************/
+
+  CompileDetBins();
+  CompileDetIndex();
+
+  /***************************************************************************/
 }
 
 /*****************************************************************************/
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : processedistributions.c                        */
 /*                                                                           */
 /* Created:       2010/02/05 (JLe)                                           */
-/* Last modified: 2019/11/22 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Processes ENDF energy distributions in ACE data              */
@@ -24,7 +24,7 @@
 
 void ProcessEDistributions(long rea, long prec)
 {
-  long mt, nuc, ace, ptr, n, i, j, k, nr, loc0, l0, l1, l2, erg, sum;
+  long mt, nuc, ace, ptr, n, i, j, k, nr, loc0, l0, l1, l2, l3, l4, erg, sum;
   long NXS[16], JXS[32], LED, LDIS, L0, L1, L2, L3, NR, NE, NP, NP2, LAW;
   long NMU, NPEP, NES, L, TY, JED, KY;
   const double *XSS;
@@ -1213,6 +1213,80 @@ void ProcessEDistributions(long rea, long prec)
                   }
               }
 
+            /* Create alias tables for sampling secondary bins */
+
+            if ((long)RDB[DATA_OPTI_ALIAS_TABLES] == YES)
+              {
+                /* Get pointer to data and number of initial energies */
+
+                l0 = (long)RDB[erg + ERG_PTR_DATA];
+                ptr = (long)RDB[l0++];
+                NE = (long)RDB[ptr + ENERGY_GRID_NE];
+
+                /* Pointer to types */
+
+                l2 = (long)RDB[l0++];
+
+                /* Allocate memory for pointers */
+
+                ptr = ReallocMem(DATA_ARRAY, NE);
+                WDB[erg + ERG_PTR_ALIAS] = (double)ptr;
+
+                if (LAW == 61)
+                  {
+                    l3 = ReallocMem(DATA_ARRAY, NE);
+                    WDB[erg + ERG_PTR_ANG_ALIAS] = (double)l3;
+                  }
+                else
+                  l3 = -1;
+
+                /* Loop over initial energies */
+
+                for (i = 0; i < NE; i++)
+                  {
+                    /* Pointer to data */
+
+                    l1 = (long)RDB[l0 + i];
+
+                    /* Get number of data points */
+
+                    NP = (long)RDB[l1++];
+
+                    /* Distributions with discrete photon lines are */
+                    /* sampled by search */
+
+                    if ((RDB[l2 + i] > 9) || (NP < 2))
+                      WDB[ptr + i] = NULLPTR;
+                    else
+                      WDB[ptr + i] = (double)MakeAliasTable(l1 + 2*NP, NP);
+
+                    /* Check law */
+
+                    if (LAW != 61)
+                      continue;
+
+                    /* Allocate memory for angular pointers */
+
+                    l4 = ReallocMem(DATA_ARRAY, NP);
+                    WDB[l3 + i] = (double)l4;
+
+                    /* Loop over angular distributions */
+
+                    for (j = 0; j < NP; j++)
+                      {
+                        /* Pointer to data (null if isotropic) */
+
+                        if ((k = (long)RDB[l1 + 3*NP + j]) < VALID_PTR)
+                          WDB[l4 + j] = NULLPTR;
+                        else if ((NP2 = (long)RDB[k + 1]) < 2)
+                          WDB[l4 + j] = NULLPTR;
+                        else
+                          WDB[l4 + j] =
+                            (double)MakeAliasTable(k + 2 + 2*NP2, NP2);
+                      }
+                  }
+              }
+
             /* Exit */
 
             break;
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : processifctetmesh.c                            */
 /*                                                                           */
 /* Created:       2015/01/15 (VVa)                                           */
-/* Last modified: 2018/11/07 (VVa)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Processes tetra mesh based multi-physics interfaces          */
 /*                                                                           */
@@ -498,6 +498,10 @@ void ProcessIFCTetMesh(long ifc, long update)
 
           tet = (long)RDB[tetlist + i];
 
+          /* Pack face planes */
+
+          PackTetFaces(tet);
+
           /* Calculate limits based on points */
 
           CalculateTetBoundingBox(tet, bb);
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : processmudistributions.c                       */
 /*                                                                           */
 /* Created:       2010/01/19 (JLe)                                           */
-/* Last modified: 2018/06/11 (VVa)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Processes ENDF angular distributions in ACE data             */
 /*                                                                           */
@@ -285,6 +285,16 @@ void ProcessMuDistributions(long rea)
       INTT = (long)XSS[L0 - 2];
       WDB[ang + ANG_INTT] = (double)INTT;
 
+      /* Allocate memory for alias table pointers */
+
+      if ((long)RDB[DATA_OPTI_ALIAS_TABLES] == YES)
+        {
+          ptr = ReallocMem(DATA_ARRAY, NE);
+          WDB[ang + ANG_PTR_ALIAS] = (double)ptr;
+        }
+      else
+        ptr = -1;
+
       /* Loop over energies */
 
       for (i = 0; i < NE; i++)
@@ -383,6 +393,11 @@ void ProcessMuDistributions(long rea)
 
           CheckPointer(FUNCTION_NAME, "angular mu", DATA_ARRAY, l1 - 1);
 
+          /* Create alias table for sampling secondary bin */
+
+          if ((long)RDB[DATA_OPTI_ALIAS_TABLES] == YES)
+            WDB[ptr + i] = (double)MakeAliasTable(l1 - NP, NP);
+
           /* Update pointer */
 
           L0 = L0 + 3*NP + 2;
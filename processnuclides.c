@@ -1439,6 +1439,13 @@ void ProcessNuclides()
       nuc = NextItem(nuc);
     }
 
+  /* Print binary ACE cache statistics */
+
+  if ((long)RDB[DATA_ACE_CACHE_PTR_DIR] > VALID_PTR)
+    fprintf(outp, "ACE data: %ld tables read from binary cache, %ld written.\n\n",
+            (long)RDB[DATA_ACE_CACHE_N_READ],
+            (long)RDB[DATA_ACE_CACHE_N_WRITE]);
+
   /* Read covariance data for nuclides that are included in the simulation */
 
   if ((ptr = (long)RDB[DATA_PTR_COVERXDATA_FNAME_LIST]) > VALID_PTR)
@@ -0,0 +1,177 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : processotfsab.c                                */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Links reaction pointers and creates temperature index for    */
+/*              on-the-fly S(a,b) interpolation                              */
+/*                                                                           */
+/* Comments: - Replaces the reaction and temperature list searches in        */
+/*             OTFSabXS() and OTFSabScattering() with direct indexing.       */
+/*                                                                           */
+/*           - The temperature index is a uniform grid between the lowest    */
+/*             and highest temperature, stored in the first item of the      */
+/*             S(a,b) list. Bin width is not larger than the minimum spacing */
+/*             of the temperatures, so the interval is found by at most one  */
+/*             step in the list.                                             */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "ProcessOTFSab:"
+
+/* Maximum number of temperature bins */
+
+#define MAX_TIDX_N 10000
+
+/*****************************************************************************/
+
+void ProcessOTFSab()
+{
+  long loc0, sab, sab0, iso, rea, ptr, nb, n;
+  double T0, T1, dT, min;
+
+  /* Loop over thermal scattering data */
+
+  loc0 = (long)RDB[DATA_PTR_T0];
+  while (loc0 > VALID_PTR)
+    {
+      /* Check interpolation mode */
+
+      if ((long)RDB[loc0 + THERM_INTERP_MODE] != THERM_INTERP_OTF)
+        {
+          /* Next */
+
+          loc0 = NextItem(loc0);
+
+          /* Cycle loop */
+
+          continue;
+        }
+
+      /* Pointer to first item in sorted list */
+
+      sab0 = (long)RDB[loc0 + THERM_PTR_SAB];
+      CheckPointer(FUNCTION_NAME, "(sab0)", DATA_ARRAY, sab0);
+
+      /***********************************************************************/
+
+      /***** Link reaction pointers ******************************************/
+
+      /* Reset minimum spacing */
+
+      min = INFTY;
+
+      /* Loop over temperatures */
+
+      sab = sab0;
+      while (sab > VALID_PTR)
+        {
+          /* Pointer to S(a,b) nuclide */
+
+          iso = (long)RDB[sab + SAB_PTR_ISO];
+          CheckPointer(FUNCTION_NAME, "(iso)", DATA_ARRAY, iso);
+
+          /* Reset pointers */
+
+          WDB[sab + SAB_PTR_REA_ELA] = NULLPTR;
+          WDB[sab + SAB_PTR_REA_INL] = NULLPTR;
+
+          /* Loop over reactions */
+
+          rea = (long)RDB[iso + NUCLIDE_PTR_REA];
+          while (rea > VALID_PTR)
+            {
+              /* Check mt */
+
+              if ((long)RDB[rea + REACTION_MT] == 1002)
+                WDB[sab + SAB_PTR_REA_ELA] = (double)rea;
+              else if ((long)RDB[rea + REACTION_MT] == 1004)
+                WDB[sab + SAB_PTR_REA_INL] = (double)rea;
+
+              /* Next reaction */
+
+              rea = NextItem(rea);
+            }
+
+          /* Compare spacing to minimum */
+
+          if ((ptr = NextItem(sab)) > VALID_PTR)
+            {
+              /* Check for duplicate temperatures */
+
+              if ((dT = RDB[ptr + SAB_T] - RDB[sab + SAB_T]) <= 0.0)
+                Error(loc0, "Duplicate temperature %1.2f K in S(a,b) data",
+                      RDB[sab + SAB_T]);
+
+              if (dT < min)
+                min = dT;
+            }
+
+          /* Next */
+
+          sab = NextItem(sab);
+        }
+
+      /* Check number of temperatures (needed for interpolation) */
+
+      if (NextItem(sab0) < VALID_PTR)
+        Error(loc0, "At least two temperatures needed for interpolation");
+
+      /***********************************************************************/
+
+      /***** Create temperature index ****************************************/
+
+      /* Temperature limits */
+
+      T0 = RDB[sab0 + SAB_T];
+      T1 = RDB[LastItem(sab0) + SAB_T];
+
+      /* Number of bins */
+
+      if ((T1 - T0)/min < (double)MAX_TIDX_N)
+        nb = (long)ceil((T1 - T0)/min);
+      else
+        nb = MAX_TIDX_N;
+
+      /* Bin width */
+
+      dT = (T1 - T0)/((double)nb);
+
+      /* Allocate memory */
+
+      ptr = ReallocMem(DATA_ARRAY, nb);
+
+      /* Put pointers to intervals containing the lower bin boundaries */
+
+      sab = sab0;
+
+      for (n = 0; n < nb; n++)
+        {
+          while ((NextItem(NextItem(sab)) > VALID_PTR) &&
+                 (T0 + ((double)n)*dT >= RDB[NextItem(sab) + SAB_T]))
+            sab = NextItem(sab);
+
+          WDB[ptr + n] = (double)sab;
+        }
+
+      /* Put data */
+
+      WDB[sab0 + SAB_PTR_TIDX] = (double)ptr;
+      WDB[sab0 + SAB_TIDX_N] = (double)nb;
+      WDB[sab0 + SAB_TIDX_DT] = dT;
+
+      /***********************************************************************/
+
+      /* Next */
+
+      loc0 = NextItem(loc0);
+    }
+}
+
+/*****************************************************************************/
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : processbgeometry.c                             */
 /*                                                                           */
 /* Created:       2010/11/09 (JLe)                                           */
-/* Last modified: 2012/02/18 (JLe)                                           */
-/* Version:       2.1.3                                                      */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                      */
 /*                                                                           */
 /* Description: Processes explicit stochastic geometry                       */
 /*                                                                           */
@@ -21,13 +21,15 @@
 
 void ProcessPBGeometry()
 {  
-  long loc0, pbl, msh, pid, nb, ptr;
-  double x, y, z, r;
+  long loc0, pbl, msh, pid, nb, ptr, grd, nt;
+  double x, y, z, r, mem;
 
   /* Check pointer */
 
   if ((loc0 = (long)RDB[DATA_PTR_PB0]) < 0)
     return;
+
+  fprintf(outp, "Processing pebble bed type geometry:\n\n");
   
   /* Loop over definitions */
 
@@ -73,6 +75,56 @@ void ProcessPBGeometry()
           
           pbl = NextItem(pbl);
         }
+
+      /***********************************************************************/
+
+      /***** Pack search mesh ************************************************/
+
+      /* Reset and start timer */
+
+      ResetTimer(TIMER_MISC);
+      StartTimer(TIMER_MISC);
+
+      /* Pack */
+
+      PackPBGrid(loc0);
+
+      /* Stop timer */
+
+      StopTimer(TIMER_MISC);
+
+      /* Pointer to grid */
+
+      grd = (long)RDB[loc0 + PBED_PTR_GRID];
+      CheckPointer(FUNCTION_NAME, "(grd)", DATA_ARRAY, grd);
+
+      /* Calculate memory size */
+
+      nb = (long)(RDB[grd + PBGRID_N0]*RDB[grd + PBGRID_N1]*
+                  RDB[grd + PBGRID_N2]);
+      nt = (long)RDB[grd + PBGRID_N_ENTRIES];
+
+      mem = (double)(PBGRID_BLOCK_SIZE + nb + 6*nt + 2)*sizeof(double);
+
+      /* Print */
+
+      fprintf(outp, "Search grid for geometry \"%s\":\n\n",
+              GetText(loc0 + PBED_PTR_NAME));
+      fprintf(outp, " - %ld x %ld x %ld cells, %ld entries for %ld pebbles\n",
+              (long)RDB[grd + PBGRID_N0], (long)RDB[grd + PBGRID_N1],
+              (long)RDB[grd + PBGRID_N2], nt, pid);
+
+      if (mem < MEGA)
+        fprintf(outp, " - %1.2f kb of memory allocated for grid\n", 
+                mem/KILO);
+      else if (mem < GIGA)
+        fprintf(outp, " - %1.2f Mb of memory allocated for grid\n", 
+                mem/MEGA);
+      else
+        fprintf(outp, " - %1.2f Gb of memory allocated for grid\n", 
+                mem/GIGA);
+
+      fprintf(outp, " - Packed in %1.2f seconds\n\n", TimerVal(TIMER_MISC));
       
       /***********************************************************************/
 
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : processstats.c                                 */
 /*                                                                           */
 /* Created:       2011/03/10 (JLe)                                           */
-/* Last modified: 2019/04/01 (JLe)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Allocates memory for statistical variables                   */
 /*                                                                           */
@@ -367,6 +367,12 @@ void ProcessStats()
   AllocStatHistory(ptr);
   WDB[RES_CPU_USAGE] = (double)ptr;
 
+  /* OpenMP load imbalance and stolen particles in transport cycle */
+
+  ptr = NewStat("OMP_LOAD_IMBALANCE", 1, 2);
+  AllocStatHistory(ptr);
+  WDB[RES_OMP_LOAD_IMBALANCE] = (double)ptr;
+
   /* Allocate memory for batch-wise absolute running times */
 
   if ((long)RDB[DATA_SIMULATION_MODE] == SIMULATION_MODE_CRIT)
@@ -449,6 +455,9 @@ void ProcessStats()
   ptr = NewStat("DT_EFF", 1, 4);
   WDB[RES_DT_TRACK_EFF] = (double)ptr;
 
+  ptr = NewStat("ST_NBR_EFF", 1, 2);
+  WDB[RES_ST_NBR_EFF] = (double)ptr;
+
   ptr = NewStat("IFC_COL_EFF", 1, 2);
   WDB[RES_IFC_COL_EFF] = (double)ptr;
 
@@ -498,6 +507,17 @@ void ProcessStats()
   ptr = NewStat("TMS_FAIL_STAT", 1, 4);
   WDB[RES_TMS_FAIL_STAT] = (double)ptr;
 
+  /* Regional delta-tracking statistics (virtual, real and majorant */
+  /* failure counts in buffer, virtual-to-real ratio, fraction of   */
+  /* collisions and failure fraction in statistics) */
+
+  if (((long)RDB[DATA_OPT_USE_DT] == YES) && ((long)RDB[DATA_DT_REG_N0] > 0))
+    {
+      np = (long)(RDB[DATA_DT_REG_N0]*RDB[DATA_DT_REG_N1]*RDB[DATA_DT_REG_N2]);
+      ptr = NewStat("DT_REG_STAT", 2, np, 3);
+      WDB[RES_DT_REG_STAT] = (double)ptr;
+    }
+
   /***************************************************************************/
 
   /***** Equilibrium Xe-135 and Sm-149 calculation ***************************/
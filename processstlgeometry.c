@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : processstlgeometry.c                           */
 /*                                                                           */
 /* Created:       2014/03/03 (JLe)                                           */
-/* Last modified: 2020/06/08 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: General processing of STL geometry data                      */
@@ -26,9 +26,10 @@
 
 void ProcessSTLGeometry()
 {
-  long loc0, loc1, nf, ptr, pts, n, msh, sld, cell, mfile;
+  long loc0, loc1, loc2, nf, ptr, pts, n, msh, sld, cell, mfile, i, m, ns;
+  long nn, nft, bvh, *idx;
   double x1, y1, z1, x2, y2, z2, x3, y3, z3, l, xmin, xmax, ymin, ymax;
-  double zmin, zmax, dx, dy, dz, lims[6], mem;
+  double zmin, zmax, dx, dy, dz, lims[6], mem, *box;
 
   /* Check pointer */
 
@@ -268,6 +269,12 @@ void ProcessSTLGeometry()
       if ((loc1 = (long)RDB[loc0 + STL_PTR_SOLIDS]) < VALID_PTR)
         Error(loc0, "Universe has no components");
 
+      /* Reset hierarchy counters */
+
+      nn = 0;
+      nft = 0;
+      bvh = 0;
+
       /* Loop over solids */
 
       while (loc1 > VALID_PTR)
@@ -279,6 +286,7 @@ void ProcessSTLGeometry()
           /* Get number of facets */
 
           nf = (long)RDB[loc1 + STL_SOLID_N_FACETS];
+          nft = nft + nf;
 
           /* Reset solid bounding box coordinates */
 
@@ -628,11 +636,193 @@ void ProcessSTLGeometry()
 
           /*******************************************************************/
 
+          /***** Build bounding volume hierarchy for facets ******************/
+
+          /* Check number of facets */
+
+          if (nf < 1)
+            Error(loc0, "Solid \"%s\" has no facets",
+                  GetText(loc1 + STL_SOLID_PTR_STL_NAME));
+
+          /* Allocate memory for temporary arrays */
+
+          box = (double *)Mem(MEM_ALLOC, 6*nf, sizeof(double));
+          idx = (long *)Mem(MEM_ALLOC, nf, sizeof(long));
+
+          /* Pointer to facets */
+
+          ptr = (long)RDB[loc1 + STL_SOLID_PTR_FACETS];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+          /* Loop over facets and calculate tight bounding boxes (with */
+          /* small margin to keep slab tests conservative) */
+
+          for (n = 0; n < nf; n++)
+            {
+              /* Reset boundaries */
+
+              for (m = 0; m < 3; m++)
+                {
+                  box[6*n + 2*m] = INFTY;
+                  box[6*n + 2*m + 1] = -INFTY;
+                }
+
+              /* Loop over points */
+
+              for (i = 0; i < 3; i++)
+                {
+                  pts = (long)RDB[ptr + STL_FACET_PTR_PT1 + i];
+                  CheckPointer(FUNCTION_NAME, "(pts)", DATA_ARRAY, pts);
+
+                  for (m = 0; m < 3; m++)
+                    {
+                      if (RDB[pts + STL_POINT_X + m] < box[6*n + 2*m])
+                        box[6*n + 2*m] = RDB[pts + STL_POINT_X + m];
+                      if (RDB[pts + STL_POINT_X + m] > box[6*n + 2*m + 1])
+                        box[6*n + 2*m + 1] = RDB[pts + STL_POINT_X + m];
+                    }
+                }
+
+              /* Add margin */
+
+              for (m = 0; m < 3; m++)
+                {
+                  box[6*n + 2*m] = box[6*n + 2*m] - 1E-6;
+                  box[6*n + 2*m + 1] = box[6*n + 2*m + 1] + 1E-6;
+                }
+
+              /* Put index */
+
+              idx[n] = n;
+
+              /* Pointer to next facet */
+
+              ptr = ptr + STL_FACET_BLOCK_SIZE;
+            }
+
+          /* Build hierarchy */
+
+          ptr = BuildSTLBVH(box, idx, nf, &m);
+          WDB[loc1 + STL_SOLID_PTR_BVH] = (double)ptr;
+          WDB[loc1 + STL_SOLID_BVH_NODES] = (double)m;
+
+          /* Add to counters */
+
+          nn = nn + m;
+          bvh = bvh + m*STL_BVH_BLOCK_SIZE + nf*STL_BVH_TRI_BLOCK_SIZE;
+
+          /* Allocate memory for facets in hierarchy order */
+
+          pts = ReallocMem(DATA_ARRAY, nf*STL_BVH_TRI_BLOCK_SIZE);
+          WDB[loc1 + STL_SOLID_PTR_BVH_TRI] = (double)pts;
+
+          /* Copy vertices */
+
+          for (n = 0; n < nf; n++)
+            {
+              /* Pointer to facet */
+
+              ptr = (long)RDB[loc1 + STL_SOLID_PTR_FACETS] +
+                idx[n]*STL_FACET_BLOCK_SIZE;
+
+              /* Loop over points */
+
+              for (i = 0; i < 3; i++)
+                {
+                  loc2 = (long)RDB[ptr + STL_FACET_PTR_PT1 + i];
+                  CheckPointer(FUNCTION_NAME, "(loc2)", DATA_ARRAY, loc2);
+
+                  WDB[pts + STL_BVH_TRI_X1 + 3*i] = RDB[loc2 + STL_POINT_X];
+                  WDB[pts + STL_BVH_TRI_Y1 + 3*i] = RDB[loc2 + STL_POINT_Y];
+                  WDB[pts + STL_BVH_TRI_Z1 + 3*i] = RDB[loc2 + STL_POINT_Z];
+                }
+
+              /* Put facet pointer */
+
+              WDB[pts + STL_BVH_TRI_PTR_FACET] = (double)ptr;
+
+              /* Next */
+
+              pts = pts + STL_BVH_TRI_BLOCK_SIZE;
+            }
+
+          /* Free temporary arrays */
+
+          Mem(MEM_FREE, box);
+          Mem(MEM_FREE, idx);
+
+          /*******************************************************************/
+
+          /* Next solid */
+
+          loc1 = NextItem(loc1);
+        }
+
+      /***********************************************************************/
+
+      /***** Build bounding volume hierarchy for solids **********************/
+
+      /* Get number of solids */
+
+      ns = ListSize((long)RDB[loc0 + STL_PTR_SOLIDS]);
+
+      /* Allocate memory for temporary arrays */
+
+      box = (double *)Mem(MEM_ALLOC, 6*ns, sizeof(double));
+      idx = (long *)Mem(MEM_ALLOC, ns, sizeof(long));
+
+      /* Allocate memory for solid pointers */
+
+      pts = ReallocMem(DATA_ARRAY, ns);
+      WDB[loc0 + STL_PTR_BVH_SOLIDS] = (double)pts;
+
+      /* Loop over solids and copy bounding boxes */
+
+      n = 0;
+
+      loc1 = (long)RDB[loc0 + STL_PTR_SOLIDS];
+      while (loc1 > VALID_PTR)
+        {
+          /* Put bounding box */
+
+          box[6*n] = RDB[loc1 + STL_SOLID_XMIN];
+          box[6*n + 1] = RDB[loc1 + STL_SOLID_XMAX];
+          box[6*n + 2] = RDB[loc1 + STL_SOLID_YMIN];
+          box[6*n + 3] = RDB[loc1 + STL_SOLID_YMAX];
+          box[6*n + 4] = RDB[loc1 + STL_SOLID_ZMIN];
+          box[6*n + 5] = RDB[loc1 + STL_SOLID_ZMAX];
+
+          /* Put index and pointer */
+
+          idx[n] = n;
+          WDB[pts + n++] = (double)loc1;
+
           /* Next solid */
 
           loc1 = NextItem(loc1);
         }
 
+      /* Build hierarchy */
+
+      ptr = BuildSTLBVH(box, idx, ns, &m);
+      WDB[loc0 + STL_PTR_BVH] = (double)ptr;
+      WDB[loc0 + STL_BVH_NODES] = (double)m;
+
+      /* Sort solid pointers */
+
+      for (n = 0; n < ns; n++)
+        box[n] = RDB[pts + idx[n]];
+
+      for (n = 0; n < ns; n++)
+        WDB[pts + n] = box[n];
+
+      /* Free temporary arrays */
+
+      Mem(MEM_FREE, box);
+      Mem(MEM_FREE, idx);
+
+      /***********************************************************************/
+
       /* Loop over bodies and print */
 
       loc1 = (long)RDB[loc0 + STL_PTR_BODIES];
@@ -746,6 +936,26 @@ void ProcessSTLGeometry()
         fprintf(outp, " - %1.2f Gb of memory allocated for search mesh\n\n",
                     mem/GIGA);
 
+      /* Print bounding volume hierarchy stuff */
+
+      mem = (double)(bvh + (long)RDB[loc0 + STL_BVH_NODES]*STL_BVH_BLOCK_SIZE
+                     + ns)*sizeof(double);
+
+      fprintf(outp, "Bounding volume hierarchy:\n\n");
+      fprintf(outp, " - %ld nodes for %ld solids\n",
+              (long)RDB[loc0 + STL_BVH_NODES], ns);
+      fprintf(outp, " - %ld nodes for %ld facets\n", nn, nft);
+
+      if (mem < MEGA)
+        fprintf(outp, " - %1.2f kb of memory allocated for hierarchy\n\n",
+                mem/KILO);
+      else if (mem < GIGA)
+        fprintf(outp, " - %1.2f Mb of memory allocated for hierarchy\n\n",
+                mem/MEGA);
+      else
+        fprintf(outp, " - %1.2f Gb of memory allocated for hierarchy\n\n",
+                mem/GIGA);
+
       /* Write mesh to file */
 
       if (mfile == NO)
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : processumshgeometry.c                          */
 /*                                                                           */
 /* Created:       2013/11/23 (JLe)                                           */
-/* Last modified: 2019/10/11 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Processes unstructured mesh based geometry                   */
@@ -251,6 +251,10 @@ void ProcessUMSHGeometry()
 
           tet = (long)RDB[tetlist + i];
 
+          /* Pack face planes */
+
+          PackTetFaces(tet);
+
           /* Calculate limits based on points */
 
           CalculateTetBoundingBox(tet, bb);
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : processxsdata.c                                */
 /*                                                                           */
 /* Created:       2010/12/13 (JLe)                                           */
-/* Last modified: 2018/11/02 (RTu)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Processes cross sections and ENDF reaction laws              */
 /*                                                                           */
@@ -1067,6 +1067,14 @@ void ProcessXSData()
 
   ProcessTmpData();
 
+  /* Link OTF S(a,b) data */
+
+  ProcessOTFSab();
+
+  /* Read windowed multipole data */
+
+  ReadMultipoleData();
+
   /* Process coarse multi-group majorants */
 
   CalculateMGXS();
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : pythonplotter.c                                */
 /*                                                                           */
 /* Created:       2019/10/09 (JLe)                                           */
-/* Last modified: 2020/06/15 (SÄk)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Interface routines for interactive python plotter.           */
@@ -616,6 +616,11 @@ int init_interactive(int argc, char** argv)
 
       ProcessBC();
 
+      /* Compile cell definitions (must be called after all cells are */
+      /* created and surfaces are linked) */
+
+      CompileCells();
+
       /* Update memory size */
 
       WDB[DATA_TOT_MISC_BYTES] = RDB[DATA_TOT_MISC_BYTES] +
@@ -0,0 +1,192 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : readacecache.c                                 */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Reads NXS, JXS, IZ and XSS arrays of an ACE table from       */
+/*              binary cache file written by WriteACECache().                */
+/*                                                                           */
+/* Comments: - Cache file is mapped in memory read-only (MAP_SHARED), so     */
+/*             MPI tasks running on the same node share the same pages in    */
+/*             the page cache. The data is copied in the ACE array, since    */
+/*             the XSS array is modified by the processing routines.         */
+/*                                                                           */
+/*           - Returns NO if cache is not used, file does not exist or it    */
+/*             does not match the source ACE file, in which case the data    */
+/*             is read from the ASCII file as before.                        */
+/*                                                                           */
+/*           - File position in the ACE file is moved to the end of the      */
+/*             table, where the PENDF data is read from.                     */
+/*                                                                           */
+/*           - Checksum of the source file is calculated only after the      */
+/*             other identifiers match.                                      */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "ReadACECache:"
+
+/*****************************************************************************/
+
+long ReadACECache(long nuc, FILE *fp, long *NXS, long *JXS, long *IZ)
+{
+  long ace, ptr, n, sz, hdr[ACE_CACHE_HDR_SIZE], bytes;
+  const long *map;
+  const double *dat;
+  char fname[MAX_STR];
+  struct stat st;
+  void *addr;
+  int fd;
+
+  /* Get file name and source identifiers */
+
+  if (ACECacheHeader(nuc, fp, fname, hdr, NO) == NO)
+    return NO;
+
+  /* Open file */
+
+  if ((fd = open(fname, O_RDONLY)) < 0)
+    return NO;
+
+  /* Get size */
+
+  if ((fstat(fd, &st) != 0) ||
+      ((long)st.st_size < (long)((ACE_CACHE_HDR_SIZE + 1)*sizeof(long))))
+    {
+      close(fd);
+      return NO;
+    }
+
+  /* Map file in memory */
+
+  addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+  /* Close descriptor (mapping remains valid) */
+
+  close(fd);
+
+  /* Check */
+
+  if (addr == MAP_FAILED)
+    return NO;
+
+  map = (const long *)addr;
+
+  /* Get data size */
+
+  sz = map[ACE_CACHE_HDR_SZ];
+
+  /* Expected file size */
+
+  bytes = (long)(ACE_CACHE_HDR_SIZE*sizeof(long) + (sz + 1)*sizeof(double));
+
+  /* Compare identifiers (stale or foreign file is ignored) */
+
+  if ((map[ACE_CACHE_HDR_MAGIC] != hdr[ACE_CACHE_HDR_MAGIC]) ||
+      (map[ACE_CACHE_HDR_VERSION] != hdr[ACE_CACHE_HDR_VERSION]) ||
+      (map[ACE_CACHE_HDR_SRC_SIZE] != hdr[ACE_CACHE_HDR_SRC_SIZE]) ||
+      (map[ACE_CACHE_HDR_SRC_TIME] != hdr[ACE_CACHE_HDR_SRC_TIME]) ||
+      (sz < 10) || (bytes != (long)st.st_size))
+    {
+      munmap(addr, (size_t)st.st_size);
+      return NO;
+    }
+
+  /* Compare checksum */
+
+  if ((long)RDB[DATA_ACE_CACHE_CHECK] == YES)
+    if ((ACECacheHeader(nuc, fp, fname, hdr, YES) == NO) ||
+        (map[ACE_CACHE_HDR_SRC_SUM] != hdr[ACE_CACHE_HDR_SRC_SUM]))
+      {
+        munmap(addr, (size_t)st.st_size);
+        return NO;
+      }
+
+  /* Pointer to ACE data */
+
+  ace = (long)RDB[nuc + NUCLIDE_PTR_ACE];
+  CheckPointer(FUNCTION_NAME, "ace", ACE_ARRAY, ace);
+
+  /* Copy NXS and JXS arrays */
+
+  for (n = 0; n < 16; n++)
+    NXS[n] = map[ACE_CACHE_HDR_NXS + n];
+
+  for (n = 0; n < 32; n++)
+    JXS[n] = map[ACE_CACHE_HDR_JXS + n];
+
+  /* Copy IZ array (used with S(a,b) data) */
+
+  for (n = 0; n < 16; n++)
+    IZ[n] = map[ACE_CACHE_HDR_IZ + n];
+
+  /* Pointer to AWR and XSS array */
+
+  dat = (const double *)&map[ACE_CACHE_HDR_SIZE];
+
+  /* Preserve decay awr */
+
+  if ((long)RDB[nuc + NUCLIDE_TYPE] != NUCLIDE_TYPE_DECAY)
+    {
+      /* Put atomic weight ratio */
+
+      WDB[nuc + NUCLIDE_AWR] = dat[0];
+
+      /* Use value read from directory file for atomic weight */
+
+      WDB[nuc + NUCLIDE_AW] = ACE[ace + ACE_AW];
+    }
+
+  /* Allocate memory for NXS array */
+
+  ptr = ReallocMem(ACE_ARRAY, 16);
+  ACE[ace + ACE_PTR_NXS] = (double)ptr;
+
+  /* Copy data */
+
+  for (n = 0; n < 16; n++)
+    ACE[ptr++] = (double)NXS[n];
+
+  /* Allocate memory for JXS array */
+
+  ptr = ReallocMem(ACE_ARRAY, 32);
+  ACE[ace + ACE_PTR_JXS] = (double)ptr;
+
+  /* Copy data */
+
+  for (n = 0; n < 32; n++)
+    ACE[ptr++] = (double)JXS[n];
+
+  /* Allocate memory for XSS array and set pointer */
+
+  ptr = ReallocMem(ACE_ARRAY, sz);
+  ACE[ace + ACE_PTR_XSS] = (double)ptr;
+
+  /* Copy data */
+
+  memcpy(&ACE[ptr], &dat[1], sz*sizeof(double));
+
+  /* Move ACE file to end of table */
+
+  if (fseek(fp, map[ACE_CACHE_HDR_POS], SEEK_SET) != 0)
+    Die(FUNCTION_NAME, "fseek error");
+
+  /* Unmap file */
+
+  munmap(addr, (size_t)st.st_size);
+
+  /* Add counter */
+
+  WDB[DATA_ACE_CACHE_N_READ] = RDB[DATA_ACE_CACHE_N_READ] + 1.0;
+
+  /* Exit */
+
+  return YES;
+}
+
+/*****************************************************************************/
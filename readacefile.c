@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : readacefile.c                                  */
 /*                                                                           */
 /* Created:       2010/09/10 (JLe)                                           */
-/* Last modified: 2020/05/14 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Reads data from ACE format cross section library file        */
@@ -14,6 +14,9 @@
 /*             J. Conlin, et al. "Updating the Format of ACE Data Tables."   */
 /*             Trans. Am. Nucl. Soc. 107 (2012) 631-633.                     */
 /*                                                                           */
+/*           - NXS, JXS and XSS arrays are read from binary cache if "set    */
+/*             acecache" is given (readacecache.c, writeacecache.c).         */
+/*                                                                           */
 /*****************************************************************************/
 
 #include "header.h"
@@ -26,7 +29,7 @@
 void ReadACEFile(long nuc)
 {
   long ace, ptr, rea, n, sz, NXS[16], JXS[32], NES, L0, L, NTR, nr, mt, nc, I0;
-  long pos, fiss, edep, ures, nfix, IZ[16];
+  long pos, fiss, edep, ures, nfix, IZ[16], cached;
   double *XSS, awr, Emin, Emax, T;
   char HZ1[MAX_STR], HZ2[MAX_STR], dummy[MAX_STR], name[MAX_STR];
   char file[MAX_STR], date[MAX_STR];
@@ -70,9 +73,14 @@ void ReadACEFile(long nuc)
   *HZ1 = '\0';
   *HZ2 = '\0';
 
+  /* Try binary cache (moves file position to the end of the table) */
+
+  if ((cached = ReadACECache(nuc, fp, NXS, JXS, IZ)) == YES)
+    strcpy(HZ1, name);
+
   /* Read ZAID and data */
 
-  while (fscanf(fp, "%s", HZ1) != EOF)
+  while ((cached == NO) && (fscanf(fp, "%s", HZ1) != EOF))
     {
       /* Check for new format (assuming here that the character string  */
       /* is '2.0.0' -- this is something that may need to be checked in */
@@ -250,6 +258,11 @@ void ReadACEFile(long nuc)
   if ((strcmp(HZ1, name)) && (strcmp(HZ2, name)))
     Die(FUNCTION_NAME, "Unable to find isotope %s in file %s", name, file);
 
+  /* Write binary cache before the data is modified */
+
+  if (cached == NO)
+    WriteACECache(nuc, fp, NXS, JXS, IZ, awr);
+
   /* Pointer to XSS array */
 
   ptr = (long)ACE[ace + ACE_PTR_XSS];
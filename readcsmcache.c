@@ -0,0 +1,226 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : readcsmcache.c                                 */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Reads adaptive cell search mesh of a universe from cache     */
+/*              file                                                         */
+/*                                                                           */
+/* Comments: - Returns NO if the file does not exist or the geometry hash    */
+/*             doesn't match, in which case the mesh is built by sampling.   */
+/*                                                                           */
+/*           - The first level of the mesh must be created before the call.  */
+/*             Data is checked before anything is allocated, so a corrupted  */
+/*             file leaves the mesh untouched.                               */
+/*                                                                           */
+/*           - File format is described in writecsmcache.c.                  */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "ReadCSMCache:"
+
+static long ReadCacheData(long, long, long, long, const long *, long, long,
+                          long);
+
+/*****************************************************************************/
+
+long ReadCSMCache(long uni)
+{
+  long msh, lst, nc, sz, hdr[CSM_CACHE_HDR_SIZE], map[CSM_CACHE_HDR_SIZE];
+  long *dat;
+  char fname[MAX_STR];
+  FILE *fp;
+
+  /* Get file name and geometry identifiers */
+
+  if (CSMCacheHeader(uni, fname, hdr) == NO)
+    return NO;
+
+  /* Open file */
+
+  if ((fp = fopen(fname, "r")) == NULL)
+    return NO;
+
+  /* Read header and compare identifiers (stale or foreign file is */
+  /* ignored) */
+
+  if ((fread(map, sizeof(long), CSM_CACHE_HDR_SIZE, fp) !=
+       CSM_CACHE_HDR_SIZE) ||
+      (map[CSM_CACHE_HDR_MAGIC] != hdr[CSM_CACHE_HDR_MAGIC]) ||
+      (map[CSM_CACHE_HDR_VERSION] != hdr[CSM_CACHE_HDR_VERSION]) ||
+      (map[CSM_CACHE_HDR_HASH] != hdr[CSM_CACHE_HDR_HASH]) ||
+      (map[CSM_CACHE_HDR_NC] != hdr[CSM_CACHE_HDR_NC]) ||
+      ((sz = map[CSM_CACHE_HDR_SZ]) < 1))
+    {
+      fclose(fp);
+      return NO;
+    }
+
+  /* Allocate memory and read data */
+
+  dat = (long *)Mem(MEM_ALLOC, sz, sizeof(long));
+
+  if (fread(dat, sizeof(long), sz, fp) != (size_t)sz)
+    {
+      fclose(fp);
+      Mem(MEM_FREE, dat);
+      return NO;
+    }
+
+  /* Close file */
+
+  fclose(fp);
+
+  /* Pointer to mesh */
+
+  msh = (long)RDB[uni + UNIVERSE_PTR_SEARCH_MESH];
+  CheckPointer(FUNCTION_NAME, "(msh)", DATA_ARRAY, msh);
+
+  /* Pointer to cell list */
+
+  lst = (long)RDB[uni + UNIVERSE_PTR_CELL_LIST];
+  CheckPointer(FUNCTION_NAME, "(lst)", DATA_ARRAY, lst);
+
+  /* Number of cells */
+
+  nc = hdr[CSM_CACHE_HDR_NC];
+
+  /* Check data without building */
+
+  if (ReadCacheData(uni, msh, 0, NO, dat, 0, sz, nc) != sz)
+    {
+      Mem(MEM_FREE, dat);
+      return NO;
+    }
+
+  /* Build mesh */
+
+  if (ReadCacheData(uni, msh, 0, YES, dat, 0, sz, nc) != sz)
+    Die(FUNCTION_NAME, "Error in cache data");
+
+  /* Free memory */
+
+  Mem(MEM_FREE, dat);
+
+  /* Exit */
+
+  return YES;
+}
+
+/*****************************************************************************/
+
+/***** Read mesh data (returns new position or -1 if data is invalid) ********/
+
+static long ReadCacheData(long uni, long msh, long lvl, long build,
+                          const long *dat, long pos, long sz, long nc)
+{
+  long ptr, loc0, lst, ncell, n, m, i;
+
+  /* Number of mesh cells (first level is already created, sub-meshes */
+  /* are created by SplitCell()) */
+
+  if (lvl == 0)
+    ncell = ADA_CSM_SZ0*ADA_CSM_SZ0*ADA_CSM_SZ0;
+  else
+    ncell = ADA_CSM_SZ*ADA_CSM_SZ*ADA_CSM_SZ;
+
+  /* Loop over mesh cells */
+
+  for (n = 0; n < ncell; n++)
+    {
+      /* Check position */
+
+      if (pos >= sz)
+        return -1;
+
+      /* Check split */
+
+      if (dat[pos] == -1)
+        {
+          /* Check depth */
+
+          if (lvl + 1 >= ADA_CSM_DEPTH)
+            return -1;
+
+          /* Split cell and read sub-mesh */
+
+          if (build == YES)
+            {
+              SplitCell(uni, msh, n);
+
+              ptr = (long)RDB[msh + MESH_PTR_PTR];
+              CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+              loc0 = -(long)RDB[ptr + n];
+            }
+          else
+            loc0 = msh;
+
+          if ((pos = ReadCacheData(uni, loc0, lvl + 1, build, dat, pos + 1,
+                                   sz, nc)) < 0)
+            return -1;
+
+          /* Cycle loop */
+
+          continue;
+        }
+
+      /* Get number of candidates and check */
+
+      m = dat[pos++];
+
+      if ((m < 0) || (m > MAX_CELL_SEARCH_MESH_SZ) || (pos + m > sz))
+        return -1;
+
+      for (i = 0; i < m; i++)
+        if ((dat[pos + i] < 0) || (dat[pos + i] > nc - 1))
+          return -1;
+
+      /* Put candidates */
+
+      if (build == YES)
+        {
+          /* Pointer to search item */
+
+          ptr = (long)RDB[msh + MESH_PTR_PTR];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+          loc0 = (long)RDB[ptr + n];
+          CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+          /* Pointer to cell list */
+
+          lst = (long)RDB[uni + UNIVERSE_PTR_CELL_LIST];
+
+          /* Put cells */
+
+          for (i = 0; i < m; i++)
+            {
+              ptr = ListPtr(lst, dat[pos + i]);
+              CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+              WDB[loc0 + CELL_SEARCH_MESH_PTR_C1 + i] = (double)ptr;
+            }
+
+          /* Put count */
+
+          WDB[loc0 + CELL_SEARCH_MESH_N] = (double)m;
+        }
+
+      /* Update position */
+
+      pos = pos + m;
+    }
+
+  /* Return position */
+
+  return pos;
+}
+
+/*****************************************************************************/
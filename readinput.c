@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : readinput.c                                    */
 /*                                                                           */
 /* Created:       2010/09/21 (JLe)                                           */
-/* Last modified: 2020/05/11 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Reads input file.                                            */
@@ -9109,6 +9109,49 @@ void ReadInput(char *inputfile)
                   TestParam(pname, fname, line, params[k++], PTYPE_INT,
                             -1, 1000000000);
 
+              /***************************************************************/
+            }
+          else if (!strcasecmp(params[j], "qsteal"))
+            {
+              /****** Work stealing between OpenMP particle ques *************/
+
+              /* Copy parameter name */
+
+              strcpy (pname, params[j]);
+
+              k = j + 1;
+
+              /* Mode */
+
+              if (k < np)
+                WDB[DATA_QUE_STEAL] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_LOGICAL);
+
+              /***************************************************************/
+            }
+          else if (!strcasecmp(params[j], "eventmode"))
+            {
+              /****** Event-based transport mode *****************************/
+
+              /* Copy parameter name */
+
+              strcpy (pname, params[j]);
+
+              k = j + 1;
+
+              /* Mode */
+
+              if (k < np)
+                WDB[DATA_EVENT_TRANSPORT] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_LOGICAL);
+
+              /* Number of particles in bank */
+
+              if (k < np)
+                WDB[DATA_EVENT_BANK_SIZE] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_INT,
+                            1, 100000);
+
               /***************************************************************/
             }
           else if (!strcasecmp(params[j], "stlfile"))
@@ -10649,6 +10692,117 @@ void ReadInput(char *inputfile)
 
               WDB[ptr] = NULLPTR;
 
+              /***************************************************************/
+            }
+          else if (!strcasecmp(params[j], "acecache"))
+            {
+              /***** Binary ACE cache ****************************************/
+
+              /* Copy parameter name */
+
+              strcpy (pname, params[j]);
+
+              k = j + 1;
+
+              /* Check number of parameters */
+
+              if (k == np)
+                Error(-1, pname, fname, line, "Missing cache directory");
+
+              /* Remove trailing slash */
+
+              if ((strlen(params[k]) > 1) &&
+                  (params[k][strlen(params[k]) - 1] == '/'))
+                params[k][strlen(params[k]) - 1] = '\0';
+
+              /* Cache directory */
+
+              WDB[DATA_ACE_CACHE_PTR_DIR] = (double)PutText(params[k++]);
+
+              /* Checksum option */
+
+              if (k < np)
+                WDB[DATA_ACE_CACHE_CHECK] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_LOGICAL);
+
+              /***************************************************************/
+            }
+          else if (!strcasecmp(params[j], "adacsm"))
+            {
+              /***** Adaptive cell search mesh *******************************/
+
+              /* Copy parameter name */
+
+              strcpy (pname, params[j]);
+
+              k = j + 1;
+
+              /* Check number of parameters */
+
+              if (k == np)
+                Error(-1, pname, fname, line, "Missing mode");
+
+              /* Mode */
+
+              WDB[DATA_ADA_CSM_MODE] =
+                TestParam(pname, fname, line, params[k++], PTYPE_LOGICAL);
+
+              /* Cache directory */
+
+              if (k < np)
+                {
+                  /* Remove trailing slash */
+
+                  if ((strlen(params[k]) > 1) &&
+                      (params[k][strlen(params[k]) - 1] == '/'))
+                    params[k][strlen(params[k]) - 1] = '\0';
+
+                  /* Put name */
+
+                  WDB[DATA_ADA_CSM_PTR_CACHE_DIR] =
+                    (double)PutText(params[k++]);
+                }
+
+              /***************************************************************/
+            }
+          else if (!strcasecmp(params[j], "dtreg"))
+            {
+              /***** Regional delta-tracking majorants ***********************/
+
+              /* Copy parameter name */
+
+              strcpy (pname, params[j]);
+
+              k = j + 1;
+
+              /* Check number of parameters */
+
+              if (np - k < 3)
+                Error(-1, pname, fname, line, "Missing mesh size");
+
+              /* Mesh size */
+
+              WDB[DATA_DT_REG_N0] =
+                TestParam(pname, fname, line, params[k++], PTYPE_INT, 1, 1000);
+              WDB[DATA_DT_REG_N1] =
+                TestParam(pname, fname, line, params[k++], PTYPE_INT, 1, 1000);
+              WDB[DATA_DT_REG_N2] =
+                TestParam(pname, fname, line, params[k++], PTYPE_INT, 1, 1000);
+
+              /* Number of sampled points per region */
+
+              if (k < np)
+                WDB[DATA_DT_REG_NP] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_INT,
+                            10, 100000000);
+
+              /* Number of energy groups */
+
+              if (k < np)
+                WDB[DATA_DT_REG_NG] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_INT,
+                            1, 100000);
+
               /***************************************************************/
             }
           else if (!strcasecmp(params[j], "coverxlib"))
@@ -11610,6 +11764,27 @@ void ReadInput(char *inputfile)
 
               WDB[DATA_USE_DBRC] = (double)YES;
 
+              /***************************************************************/
+            }
+          else if (!strcasecmp(params[j], "wmp"))
+            {
+              /****** Windowed multipole data for TMS ************************/
+
+              /* Copy parameter name */
+
+              strcpy (pname, params[j]);
+
+              k = j + 1;
+
+              /* Check number of parameters */
+
+              if (k == np)
+                Error(-1, pname, fname, line, "Missing data directory");
+
+              /* Data directory */
+
+              WDB[DATA_PTR_WMP_PATH] = (double)PutText(params[k++]);
+
               /***************************************************************/
             }
           else if (!strcasecmp(params[j], "qparam_dbrc"))
@@ -14774,6 +14949,74 @@ void ReadInput(char *inputfile)
                 WDB[DATA_OPTI_DIX] =
                   TestParam(pname, fname, line, params[k++], PTYPE_LOGICAL);
 
+              /***************************************************************/
+            }
+          else if (!strcasecmp(params[j], "xsprec"))
+            {
+              /****** Single-precision reconstructed cross sections **********/
+
+              /* Copy parameter name */
+
+              strcpy (pname, params[j]);
+
+              k = j + 1;
+
+              /* Get option */
+
+              if (k < np)
+                WDB[DATA_OPTI_XS_SP] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_LOGICAL);
+
+              /* Get relative tolerance */
+
+              if (k < np)
+                WDB[DATA_OPTI_XS_SP_TOL] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_REAL,
+                            0.0, 1.0);
+
+              /***************************************************************/
+            }
+          else if (!strcasecmp(params[j], "aliastab"))
+            {
+              /****** Alias tables for tabular distributions *****************/
+
+              /* Copy parameter name */
+
+              strcpy (pname, params[j]);
+
+              k = j + 1;
+
+              /* Get option */
+
+              if (k < np)
+                WDB[DATA_OPTI_ALIAS_TABLES] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_LOGICAL);
+
+              /***************************************************************/
+            }
+          else if (!strcasecmp(params[j], "egrididx"))
+            {
+              /****** Lethargy-bucket index for energy grid search ***********/
+
+              /* Copy parameter name */
+
+              strcpy (pname, params[j]);
+
+              k = j + 1;
+
+              /* Get option */
+
+              if (k < np)
+                WDB[DATA_ERG_LIDX] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_LOGICAL);
+
+              /* Average number of grid points per bucket */
+
+              if (k < np)
+                WDB[DATA_ERG_LIDX_PTS] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_REAL,
+                            1.0, 1000.0);
+
               /***************************************************************/
             }
           else if (!strcasecmp(params[j], "fum"))
@@ -15064,6 +15307,36 @@ void ReadInput(char *inputfile)
                   TestParam(pname, fname, line, params[k++], PTYPE_INT,
                             1, 1000000000);
 
+              /***************************************************************/
+            }
+          else if (!strcasecmp(params[j], "hybuf"))
+            {
+              /***** Hybrid scoring buffer ***********************************/
+
+              /* Copy parameter name */
+
+              strcpy (pname, params[j]);
+
+              k = j + 1;
+
+              /* Option */
+
+              if (k < np)
+                WDB[DATA_OPTI_HYBRID_BUF] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_LOGICAL);
+
+              /* Number of slots in thread-wise tables */
+
+              if (k < np)
+                WDB[DATA_HYBRID_BUF_SIZE] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_INT,
+                            16, 100000000);
+
+              /* Hybrid mode uses shared buffer */
+
+              if ((long)RDB[DATA_OPTI_HYBRID_BUF] == YES)
+                WDB[DATA_OPTI_SHARED_BUF] = (double)YES;
+
               /***************************************************************/
             }
           else if (!strcasecmp(params[j], "shbuf"))
@@ -15088,6 +15361,36 @@ void ReadInput(char *inputfile)
                 WDB[DATA_OPTI_SHARED_RES2] =
                   TestParam(pname, fname, line, params[k++], PTYPE_LOGICAL);
 
+              /***************************************************************/
+            }
+          else if (!strcasecmp(params[j], "spbuf"))
+            {
+              /***** Sparse detector storage *********************************/
+
+              /* Copy parameter name */
+
+              strcpy (pname, params[j]);
+
+              k = j + 1;
+
+              /* Check number of parameters */
+
+              if (k == np)
+                Error(-1, pname, fname, line, "Missing number of bins");
+
+              /* Minimum number of bins */
+
+              WDB[DATA_SPARSE_BUF_MIN_BINS] =
+                TestParam(pname, fname, line, params[k++], PTYPE_INT, 0,
+                          1000000000);
+
+              /* Maximum number of pages */
+
+              if (k < np)
+                WDB[DATA_SPARSE_BUF_MAX_PAGES] =
+                  TestParam(pname, fname, line, params[k++], PTYPE_INT, 1,
+                            100000000);
+
               /***************************************************************/
             }
           else if (!strcasecmp(params[j], "ppid"))
@@ -0,0 +1,329 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : readmultipoledata.c                            */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Reads windowed multipole data for on-the-fly Doppler-        */
+/*              broadening of resolved resonance cross sections in TMS mode  */
+/*                                                                           */
+/* Comments: - Files are read from the directory given with "set wmp", one   */
+/*             file per nuclide, named <ZAI>.wmp (e.g. 922350.wmp). Nuclides */
+/*             without a file use normal TMS rejection sampling.             */
+/*                                                                           */
+/*           - Binary format (native byte order, long = 8 bytes, energies in */
+/*             eV), same data as in the OpenMC WMP library:                  */
+/*                                                                           */
+/*             long   ZAI, fissile flag, number of poles NP, number of       */
+/*                    windows NW, number of curvefit coefficients NC         */
+/*             double Emin, Emax, window spacing in sqrt(E), sqrt(AWR)       */
+/*             double NP x 8: pole, scattering, absorption and fission       */
+/*                    residues (real and imaginary parts)                    */
+/*             long   NW x 3: first and last pole (indexed from 1) and       */
+/*                    polynomial broadening flag of each window              */
+/*             double NW x NC x 3: curvefit coefficients for scattering,     */
+/*                    absorption and fission                                 */
+/*                                                                           */
+/*           - Absorption is capture + fission, and the data does not        */
+/*             include other reactions (see multipolemicroxs.c).             */
+/*                                                                           */
+/*           - TMS majorants are replaced within the multipole range by      */
+/*             majorants calculated from the exact cross sections over the   */
+/*             nuclide temperature range (see multipolemajorant.c).          */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "ReadMultipoleData:"
+
+/*****************************************************************************/
+
+void ReadMultipoleData()
+{
+  long nuc, nuc0, loc0, loc1, ptr, lst, rls, rea, mt, i, n, hdr[5], np, nw;
+  long nc, *win, nr;
+  double val[4], Emax;
+  char fname[MAX_STR];
+  FILE *fp;
+
+  /* Check path and TMS mode */
+
+  if (((long)RDB[DATA_PTR_WMP_PATH] < VALID_PTR) ||
+      ((long)RDB[DATA_TMS_MODE] == TMS_MODE_NONE))
+    return;
+
+  /* Check sensitivity calculation (needs sampled target energies) */
+
+  if ((long)RDB[DATA_PTR_SENS0] > VALID_PTR)
+    {
+      Note(0, "Windowed multipole data not used in sensitivity calculation");
+      return;
+    }
+
+  fprintf(outp, "Reading windowed multipole data:\n\n");
+
+  /* Loop over nuclides */
+
+  nuc = (long)RDB[DATA_PTR_NUC0];
+  while (nuc > VALID_PTR)
+    {
+      /* Check type and TMS flag */
+
+      if (((long)RDB[nuc + NUCLIDE_TYPE] != NUCLIDE_TYPE_TRANSPORT) ||
+          (!((long)RDB[nuc + NUCLIDE_TYPE_FLAGS] & NUCLIDE_FLAG_TMS)) ||
+          ((long)RDB[nuc + NUCLIDE_TYPE_FLAGS] & NUCLIDE_FLAG_SAB_DATA))
+        {
+          /* Pointer to next */
+
+          nuc = NextItem(nuc);
+
+          /* Cycle loop */
+
+          continue;
+        }
+
+      /* Find previous nuclide with same ZAI (data at other temperature) */
+
+      nuc0 = (long)RDB[DATA_PTR_NUC0];
+      while (nuc0 != nuc)
+        {
+          /* Compare ZAI */
+
+          if ((RDB[nuc0 + NUCLIDE_ZAI] == RDB[nuc + NUCLIDE_ZAI]) &&
+              ((long)RDB[nuc0 + NUCLIDE_PTR_WMP] > VALID_PTR))
+            break;
+
+          /* Next */
+
+          nuc0 = NextItem(nuc0);
+        }
+
+      /* Check */
+
+      if (nuc0 != nuc)
+        {
+          /* Copy data (reaction list and previous values are nuclide- */
+          /* wise) */
+
+          loc1 = (long)RDB[nuc0 + NUCLIDE_PTR_WMP];
+          CheckPointer(FUNCTION_NAME, "(loc1)", DATA_ARRAY, loc1);
+
+          loc0 = ReallocMem(DATA_ARRAY, WMP_BLOCK_SIZE);
+
+          for (n = 0; n < WMP_BLOCK_SIZE; n++)
+            WDB[loc0 + n] = RDB[loc1 + n];
+        }
+      else
+        {
+          /* Open file */
+
+          sprintf(fname, "%s/%ld.wmp", GetText(DATA_PTR_WMP_PATH),
+                  (long)RDB[nuc + NUCLIDE_ZAI]);
+
+          if ((fp = fopen(fname, "r")) == NULL)
+            {
+              /* No data, pointer to next */
+
+              nuc = NextItem(nuc);
+
+              /* Cycle loop */
+
+              continue;
+            }
+
+          /* Allocate memory for data block */
+
+          loc0 = ReallocMem(DATA_ARRAY, WMP_BLOCK_SIZE);
+
+          /* Read header */
+
+          if ((fread(hdr, sizeof(long), 5, fp) != 5) ||
+              (fread(val, sizeof(double), 4, fp) != 4))
+            Error(0, "Error reading multipole data file \"%s\"", fname);
+
+          /* Check ZAI */
+
+          if (hdr[0] != (long)RDB[nuc + NUCLIDE_ZAI])
+            Error(0, "Multipole data file \"%s\" is for ZAI %ld", fname,
+                  hdr[0]);
+
+          /* Get sizes */
+
+          np = hdr[2];
+          nw = hdr[3];
+          nc = hdr[4];
+
+          /* Check values */
+
+          if ((np < 0) || (nw < 1) || (nc < 3) || (nc > MAX_WMP_COEF) ||
+              (val[0] <= 0.0) || (val[1] <= val[0]) || (val[2] <= 0.0) ||
+              (val[3] <= 0.0))
+            Error(0, "Invalid data in multipole data file \"%s\"", fname);
+
+          /* Put data (energies in MeV) */
+
+          WDB[loc0 + WMP_FISSILE] = (double)(hdr[1] != 0 ? YES : NO);
+          WDB[loc0 + WMP_N_POLES] = (double)np;
+          WDB[loc0 + WMP_N_WINDOWS] = (double)nw;
+          WDB[loc0 + WMP_N_COEF] = (double)nc;
+          WDB[loc0 + WMP_EMIN] = 1E-6*val[0];
+          WDB[loc0 + WMP_EMAX] = 1E-6*val[1];
+          WDB[loc0 + WMP_SQRT_EMIN] = sqrt(val[0]);
+          WDB[loc0 + WMP_SPACING] = val[2];
+          WDB[loc0 + WMP_SQRT_AWR] = val[3];
+
+          /* Read poles and residues */
+
+          ptr = ReallocMem(DATA_ARRAY, 8*np + 1);
+          WDB[loc0 + WMP_PTR_POLES] = (double)ptr;
+
+          if ((long)fread(&WDB[ptr], sizeof(double), 8*np, fp) != 8*np)
+            Error(0, "Error reading multipole data file \"%s\"", fname);
+
+          /* Read windows */
+
+          win = (long *)Mem(MEM_ALLOC, 3*nw, sizeof(long));
+
+          if ((long)fread(win, sizeof(long), 3*nw, fp) != 3*nw)
+            Error(0, "Error reading multipole data file \"%s\"", fname);
+
+          ptr = ReallocMem(DATA_ARRAY, 3*nw);
+          WDB[loc0 + WMP_PTR_WINDOWS] = (double)ptr;
+
+          for (n = 0; n < nw; n++)
+            {
+              /* Check pole indexes (last < first if window is empty) */
+
+              if ((win[3*n] < 1) || (win[3*n + 1] > np) ||
+                  (win[3*n + 1] < win[3*n] - 1))
+                Error(0, "Invalid window %ld in multipole data file \"%s\"",
+                      n + 1, fname);
+
+              /* Put indexes from 0 */
+
+              WDB[ptr++] = (double)(win[3*n] - 1);
+              WDB[ptr++] = (double)(win[3*n + 1] - 1);
+              WDB[ptr++] = (double)(win[3*n + 2] != 0 ? YES : NO);
+            }
+
+          Mem(MEM_FREE, win);
+
+          /* Read curvefit coefficients */
+
+          ptr = ReallocMem(DATA_ARRAY, 3*nw*nc);
+          WDB[loc0 + WMP_PTR_CURVEFIT] = (double)ptr;
+
+          if ((long)fread(&WDB[ptr], sizeof(double), 3*nw*nc, fp) != 3*nw*nc)
+            Error(0, "Error reading multipole data file \"%s\"", fname);
+
+          /* Close file */
+
+          fclose(fp);
+        }
+
+      /* Print */
+
+      fprintf(outp, " - %s: %ld poles, %1.5E - %1.5E MeV\n",
+              GetText(nuc + NUCLIDE_PTR_NAME), (long)RDB[loc0 + WMP_N_POLES],
+              RDB[loc0 + WMP_EMIN], RDB[loc0 + WMP_EMAX]);
+
+      /***********************************************************************/
+
+      /***** Other partial reactions within range ****************************/
+
+      /* Upper boundary */
+
+      Emax = RDB[loc0 + WMP_EMAX];
+
+      /* Pointer to partial reaction list */
+
+      lst = (long)RDB[nuc + NUCLIDE_PTR_SAMPLE_REA_LIST];
+      CheckPointer(FUNCTION_NAME, "(lst)", DATA_ARRAY, lst);
+
+      /* Count reactions */
+
+      nr = 0;
+
+      for (i = 0; i < 2; i++)
+        {
+          /* Allocate memory for list on second loop */
+
+          if (i == 1)
+            {
+              /* Check count */
+
+              if (nr == 0)
+                {
+                  WDB[loc0 + WMP_PTR_OTHER_REA] = NULLPTR;
+                  break;
+                }
+
+              /* Allocate memory */
+
+              ptr = ReallocMem(DATA_ARRAY, nr + 1);
+              WDB[loc0 + WMP_PTR_OTHER_REA] = (double)ptr;
+            }
+          else
+            ptr = -1;
+
+          /* Loop over reactions */
+
+          n = 0;
+          while ((rls = ListPtr(lst, n++)) > VALID_PTR)
+            {
+              /* Pointer to reaction */
+
+              rea = (long)RDB[rls + RLS_DATA_PTR_REA];
+              CheckPointer(FUNCTION_NAME, "(rea)", DATA_ARRAY, rea);
+
+              /* Check type, mt and energy */
+
+              mt = (long)RDB[rea + REACTION_MT];
+
+              if (((long)RDB[rea + REACTION_TYPE] != REACTION_TYPE_PARTIAL) ||
+                  (mt == 2) || (mt == 18) || (mt == 19) || (mt == 102) ||
+                  (RDB[rea + REACTION_EMIN] > Emax))
+                continue;
+
+              /* Add to count or list */
+
+              if (i == 0)
+                nr++;
+              else
+                WDB[ptr++] = (double)rea;
+            }
+
+          /* Put null pointer */
+
+          if (i == 1)
+            WDB[ptr] = NULLPTR;
+        }
+
+      /***********************************************************************/
+
+      /* Allocate memory for previous values */
+
+      ptr = AllocPrivateData(5, PRIVA_ARRAY);
+      WDB[loc0 + WMP_PTR_PREV_XS] = (double)ptr;
+
+      /* Put pointer */
+
+      WDB[nuc + NUCLIDE_PTR_WMP] = (double)loc0;
+
+      /* Calculate majorant */
+
+      MultipoleMajorant(nuc);
+
+      /* Next nuclide */
+
+      nuc = NextItem(nuc);
+    }
+
+  fprintf(outp, "\n");
+}
+
+/*****************************************************************************/
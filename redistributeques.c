@@ -3,13 +3,16 @@
 /* serpent 2 (beta-version) : redistributeques.c                             */
 /*                                                                           */
 /* Created:       2015/09/29 (VVa)                                           */
-/* Last modified: 2015/09/29 (VVa)                                           */
-/* Version:       2.1.25                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Redistributes queued particles between OpenMp threads        */
 /*                                                                           */
 /* Comments:   -Used only in dynamic simulation mode                         */
 /*                                                                           */
+/*             -With que stealing only the total number of particles is      */
+/*              calculated                                                   */
+/*                                                                           */
 /*****************************************************************************/
 
 #include "header.h"
@@ -62,6 +65,12 @@ long ReDistributeQues()
   /*
   printf("\n");
   */
+  /* Particles are not moved if que stealing is used (threads take */
+  /* work from other ques during tracking instead) */
+
+  if ((long)RDB[DATA_QUE_STEAL] == YES)
+    return tot;
+
   /* Calculate average */
   /* This is long, so ques should have ave or ave + 1 particles */
 
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : redistributestacks.c                           */
 /*                                                                           */
 /* Created:       2012/10/13 (JLe)                                           */
-/* Last modified: 2018/08/22 (VVa)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Redistributes stacked particles between OpenMP threads       */
 /*                                                                           */
@@ -79,7 +79,7 @@ void ReDistributeStacks()
 
               loc1 = (long)RDB[OMPPtr(loc0, id)];
               CheckPointer(FUNCTION_NAME, "(loc1)", DATA_ARRAY, loc1);
-              sz = ListSize(loc1) - 1;
+              sz = (long)RDB[loc1 + PART_STACK_N];
 
               /* Compare to minimum */
 
@@ -126,7 +126,7 @@ void ReDistributeStacks()
 
           /* Get size */
 
-          sz = ListSize(ptr) - 1;
+          sz = (long)RDB[ptr + PART_STACK_N];
 
           /* Minimum stack sizes are not allocated for particles */
           /* that are not transported */
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : reducebuffer.c                                 */
 /*                                                                           */
 /* Created:       2010/11/12 (JLe)                                           */
-/* Last modified: 2014/02/25 (JLe)                                           */
-/* Version:       2.1.18                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Reduces data from OpenMP distributed buffer to thread 0      */
 /*                                                                           */
@@ -36,6 +36,12 @@ void ReduceBuffer()
   else
     WDB[DATA_BUF_REDUCED] = (double)YES;
 
+  /* Flush thread-wise tables of hybrid buffer */
+
+  if ((long)RDB[DATA_OPTI_HYBRID_BUF] == YES)
+    for (i = 0; i < (long)RDB[DATA_OMP_MAX_THREADS]; i++)
+      FlushHybridBuf(i);
+
   /* Return if shared buffer */
 
   if ((long)RDB[DATA_OPTI_SHARED_BUF] == YES)
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : relerr.c                                       */
 /*                                                                           */
 /* Created:       2010/11/10 (JLe)                                           */
-/* Last modified: 2013/04/17 (JLe)                                           */
-/* Version:       2.1.13                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Returns the relative error of scores in statistics           */
 /*                                                                           */
@@ -95,9 +95,15 @@ double RelErr(long ptr, ...)
 
 #endif
 
-  /* Get pointer to statistics */
+  /* Get pointer to statistics (zero if sparse page is not scored) */
 
-  stp = (long)RDB[ptr + SCORE_PTR_DATA] + idx*STAT_BLOCK_SIZE;
+  if ((long)RDB[ptr + SCORE_SPARSE] == YES)
+    {
+      if ((stp = SparseStatPtr(ptr, idx, RES1_ARRAY, NO)) < 0)
+        return 0.0;
+    }
+  else
+    stp = (long)RDB[ptr + SCORE_PTR_DATA] + idx*STAT_BLOCK_SIZE;
 
   /****************************************************************************/
 
@@ -107,7 +113,10 @@ double RelErr(long ptr, ...)
 
   X = RES1[stp + STAT_X];
   X2 = RES1[stp + STAT_X2];
-  N = RES1[stp + STAT_N];
+  if ((long)RDB[ptr + SCORE_SPARSE] == YES)
+    N = RDB[ptr + SCORE_SPARSE_N];
+  else
+    N = RES1[stp + STAT_N];
 
   /* Check zero result */
 
@@ -0,0 +1,235 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : reusesymboliclu.c                              */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Puts burnup matrix values in a previously calculated         */
+/*              symbolic LU decomposition, or calculates a new one if the    */
+/*              sparsity pattern does not fit                                */
+/*                                                                           */
+/* Comments: - The filled pattern (A u F) returned by SymbolicLU() is closed */
+/*             under elimination, so it can be used for any matrix whose     */
+/*             non-zeros are all in the pattern. Burnup matrices of          */
+/*             different materials differ only by elements that are zero in  */
+/*             some of them, so the same pattern is re-used for all          */
+/*             materials burned by the thread.                               */
+/*                                                                           */
+/*           - If the matrix does not fit, the new pattern is calculated     */
+/*             from the union of the matrix and the old pattern, so that the */
+/*             pattern converges after a few materials.                      */
+/*                                                                           */
+/*           - Rows are sorted within columns in both matrices. Unused       */
+/*             elements at the end of LU columns have row index -1.          */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+
+#define FUNCTION_NAME "ReuseSymbolicLU:"
+
+/*****************************************************************************/
+
+struct ccsMatrix *ReuseSymbolicLU(struct ccsMatrix *A, struct ccsMatrix *LU)
+{
+  long n, i, j, p, nnz, ok;
+  long *map;
+  struct ccsMatrix *U;
+
+  /* Get size */
+
+  n = A->n;
+
+  if (A->m != n)
+    Die(FUNCTION_NAME, "Burnup matrix not square");
+
+  /* Allocate memory for map */
+
+  map = (long *)Mem(MEM_ALLOC, A->nnz + 1, sizeof(long));
+
+  /* Check if previous decomposition exists */
+
+  if ((ok = (LU != NULL)))
+    if (LU->n != n)
+      ok = NO;
+
+  /***************************************************************************/
+
+  /***** Map elements to previous pattern ************************************/
+
+  for (i = 0; (i < n) && (ok); i++)
+    {
+      /* Pointer to beginning of LU column */
+
+      p = LU->colptr[i];
+
+      /* Loop over elements in column */
+
+      for (j = A->colptr[i]; j < A->colptr[i + 1]; j++)
+        {
+          /* Skip smaller rows */
+
+          while ((p < LU->colptr[i + 1]) && (LU->rowind[p] > -1) &&
+                 (LU->rowind[p] < A->rowind[j]))
+            p++;
+
+          /* Check match */
+
+          if ((p < LU->colptr[i + 1]) && (LU->rowind[p] == A->rowind[j]))
+            map[j] = p;
+          else
+            {
+              /* Element not in pattern */
+
+              ok = NO;
+              break;
+            }
+        }
+    }
+
+  /***************************************************************************/
+
+  /***** Calculate new pattern ***********************************************/
+
+  if (!ok)
+    {
+      /* Check if union is needed */
+
+      if ((LU != NULL) && (LU->n == n))
+        {
+          /* Allocate memory for union */
+
+          U = ccsMatrixNew(n, n, A->nnz + LU->nnz);
+
+          /* Loop over columns and merge rows */
+
+          nnz = 0;
+
+          for (i = 0; i < n; i++)
+            {
+              /* Pointers to columns */
+
+              U->colptr[i] = nnz;
+
+              j = A->colptr[i];
+              p = LU->colptr[i];
+
+              /* Loop until both columns are done */
+
+              while (1 == 1)
+                {
+                  /* Skip unused LU elements */
+
+                  if ((p < LU->colptr[i + 1]) && (LU->rowind[p] < 0))
+                    p = LU->colptr[i + 1];
+
+                  /* Check end */
+
+                  if ((j == A->colptr[i + 1]) && (p == LU->colptr[i + 1]))
+                    break;
+
+                  /* Add smaller row (value from A) */
+
+                  if ((p == LU->colptr[i + 1]) ||
+                      ((j < A->colptr[i + 1]) &&
+                       (A->rowind[j] <= LU->rowind[p])))
+                    {
+                      /* Skip duplicate in LU */
+
+                      if ((p < LU->colptr[i + 1]) &&
+                          (A->rowind[j] == LU->rowind[p]))
+                        p++;
+
+                      U->rowind[nnz] = A->rowind[j];
+                      U->values[nnz] = A->values[j];
+                      j++;
+                    }
+                  else
+                    {
+                      U->rowind[nnz] = LU->rowind[p];
+                      U->values[nnz].re = 0.0;
+                      U->values[nnz].im = 0.0;
+                      p++;
+                    }
+
+                  /* Update counter */
+
+                  nnz++;
+                }
+            }
+
+          /* Put size */
+
+          U->colptr[n] = nnz;
+          U->nnz = nnz;
+
+          /* Calculate symbolic decomposition for union */
+
+          ccsMatrixFree(LU);
+          LU = SymbolicLU(U);
+          ccsMatrixFree(U);
+        }
+      else
+        {
+          /* Free previous */
+
+          if (LU != NULL)
+            ccsMatrixFree(LU);
+
+          /* Calculate symbolic decomposition */
+
+          LU = SymbolicLU(A);
+        }
+
+      /* Get row information for numeric elimination */
+
+      FindRowIndexes(LU);
+
+      /* Map elements to new pattern */
+
+      for (i = 0; i < n; i++)
+        {
+          p = LU->colptr[i];
+
+          for (j = A->colptr[i]; j < A->colptr[i + 1]; j++)
+            {
+              while ((p < LU->colptr[i + 1]) && (LU->rowind[p] > -1) &&
+                     (LU->rowind[p] < A->rowind[j]))
+                p++;
+
+              if ((p < LU->colptr[i + 1]) && (LU->rowind[p] == A->rowind[j]))
+                map[j] = p;
+              else
+                Die(FUNCTION_NAME, "Element (%ld, %ld) not in pattern",
+                    A->rowind[j], i);
+            }
+        }
+    }
+
+  /***************************************************************************/
+
+  /***** Put values **********************************************************/
+
+  /* Reset values (also fill-in elements) */
+
+  memset(LU->values, 0, LU->nnz*sizeof(complex));
+
+  /* Put matrix elements */
+
+  for (j = 0; j < A->nnz; j++)
+    LU->values[map[j]] = A->values[j];
+
+  /* Free map */
+
+  Mem(MEM_FREE, map);
+
+  /* Return decomposition */
+
+  return LU;
+
+  /***************************************************************************/
+}
+
+/*****************************************************************************/
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : sampleendflaw.c                                */
 /*                                                                           */
 /* Created:       2011/02/11 (JLe)                                           */
-/* Last modified: 2019/11/22 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Processes ENDF energy distributions in ACE data              */
@@ -18,6 +18,9 @@
 /*           - 2.1.22 (15.10.2014) LAW 4/44/61 listtiin toi energiariippuva */
 /*             tyyppivektori                                                 */
 /*                                                                           */
+/*           - LAW 4/44/61 secondary bins are sampled from alias tables if   */
+/*             option "set aliastab" is in use (17.10.2026 / 2.1.32).        */
+/*                                                                           */
 /*           - Ton reaktiopointterin vlittminen tnne tuntuu turhalta      */
 /*                                                                           */
 /*****************************************************************************/
@@ -33,7 +36,7 @@ void SampleENDFLaw(long rea, long erg, double Ein, double *Eout, double *mu,
                    long id)
 {
   long law, l0, l1, l2, ld1, ld2, ne, nb, nr, type, nd, i, j, k, l, m, n;
-  long l4, nuc, np, mt, K1, K2, ptr, np1, np2;
+  long l4, nuc, np, mt, K1, K2, ptr, np1, np2, idx, la;
   double rnd1, rnd2, rnd3, rnd4, d0, d1, d2, U, kT, a, b, g, d, c;
   double r, El1, Elk, p1, p2, c1, c2, R, R1, R2, A, A1, A2, T, E0, EE1, EEk;
   double p, x, y, awr, Q ,rd;
@@ -603,6 +606,10 @@ void SampleENDFLaw(long rea, long erg, double Ein, double *Eout, double *mu,
 
             CheckValue(FUNCTION_NAME, "El1 (law 4/44/61)", "", El1, 0.0, 500.0);
             CheckValue(FUNCTION_NAME, "Elk (law 4/44/61)", "", Elk, 0.0, 500.0);
+
+            /* Remember index to distribution */
+
+            idx = l;
           }
         else
           {
@@ -619,6 +626,10 @@ void SampleENDFLaw(long rea, long erg, double Ein, double *Eout, double *mu,
 
             r = 0.0;
 
+            /* Remember index to distribution */
+
+            idx = i;
+
             /* Avoid compiler warning (this should also cause NAN's in the */
             /* final interpolation if the values are used for some reason) */
 
@@ -633,6 +644,11 @@ void SampleENDFLaw(long rea, long erg, double Ein, double *Eout, double *mu,
         if ((nd < ne) && (ne < 2))
           Die(FUNCTION_NAME, "ne = %ld (< 2) (law 4/44/61)", ne);
 
+        /* Get pointer to alias table (set in processedistributions.c) */
+
+        if ((la = (long)RDB[erg + ERG_PTR_ALIAS]) > VALID_PTR)
+          la = (long)RDB[la + idx];
+
         /* Re-sampling loop (NOTE: noi taulukoidut arvot on joillain */
         /* nuklideilla (23000 @ JEFF-3.1.1) sellasia ett ne antaa   */
         /* ihan hmri tuloksia (b -1E+6). */
@@ -757,6 +773,16 @@ void SampleENDFLaw(long rea, long erg, double Ein, double *Eout, double *mu,
                 else
                   k = SearchArray(&RDB[l1 + 2*ne], rnd1, ne);
               }
+            else if (la > VALID_PTR)
+              {
+                /* Sample bin from alias table and position within bin */
+
+                k = WalkerAliasSample(&RDB[la], &RDB[la + ne - 1],
+                                      &RDB[la + 2*(ne - 1)], ne - 1, id);
+
+                rnd1 = RDB[l1 + 2*ne + k] + RandF(id)*(RDB[l1 + 2*ne + k + 1]
+                                                       - RDB[l1 + 2*ne + k]);
+              }
             else
               {
                 /* Find bin */
@@ -1011,15 +1037,35 @@ void SampleENDFLaw(long rea, long erg, double Ein, double *Eout, double *mu,
 
                 np = (long)RDB[l0++];
 
+                /* Get pointer to alias table */
+
+                if ((la = (long)RDB[erg + ERG_PTR_ANG_ALIAS]) > VALID_PTR)
+                  la = (long)RDB[(long)RDB[la + idx] + m];
+
                 /* Sample secondary bin */
 
-                rnd1 = RandF(id);
+                if (la > VALID_PTR)
+                  {
+                    /* Sample bin from alias table and position within bin */
 
-                k = 0;
-                while (rnd1 > RDB[l0 + 2*np + k])
-                  k++;
+                    k = WalkerAliasSample(&RDB[la], &RDB[la + np - 1],
+                                          &RDB[la + 2*(np - 1)], np - 1, id);
 
-                k--;
+                    rnd1 = RDB[l0 + 2*np + k] + RandF(id)*
+                      (RDB[l0 + 2*np + k + 1] - RDB[l0 + 2*np + k]);
+                  }
+                else
+                  {
+                    /* Search bin from cumulative distribution */
+
+                    rnd1 = RandF(id);
+
+                    k = 0;
+                    while (rnd1 > RDB[l0 + 2*np + k])
+                      k++;
+
+                    k--;
+                  }
 
                 /* Check values */
 
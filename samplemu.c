@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : samplemu.c                                     */
 /*                                                                           */
 /* Created:       2010/01/19 (JLe)                                           */
-/* Last modified: 2019/04/03 (VVa)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Samples scattering cosine from ENDF distributions            */
 /*                                                                           */
@@ -20,6 +20,9 @@
 /*             to angular distribution is then given directly, or null       */
 /*             if isotropic. Reaction pointer must be null.                  */
 /*                                                                           */
+/*           - Tabular distributions are sampled from alias tables if        */
+/*             option "set aliastab" is in use (17.10.2026 / 2.1.32).        */
+/*                                                                           */
 /*****************************************************************************/
 
 #include "header.h"
@@ -33,7 +36,7 @@ double SampleMu(long rea, long ang, double E, double LMS[7],
                     double *pdf, long id)
 {
   double mu, r, rnd, d1, d2, p1, p2, c1, c2, a, b, Emin, Emax;
-  long sens, type, i, j, k, ne, np, nb, erg, l0;
+  long sens, type, i, j, k, n, ne, np, nb, erg, l0, la;
   long ptrlow, ptrhigh, nplow, nphigh;
   double pdflow, pdfhigh;
 
@@ -245,9 +248,11 @@ double SampleMu(long rea, long ang, double E, double LMS[7],
       /* Sample distribution */
 
       if (RandF(id) > r)
-        l0 = (long)RDB[l0 + i];
+        n = i;
       else
-        l0 = (long)RDB[l0 + i + 1];
+        n = i + 1;
+
+      l0 = (long)RDB[l0 + n];
 
       /* Check pointer */
 
@@ -261,6 +266,11 @@ double SampleMu(long rea, long ang, double E, double LMS[7],
 
       CheckValue(FUNCTION_NAME, "np", "", np, 2, 1000000);
 
+      /* Get pointer to alias table (set in processmudistributions.c) */
+
+      if ((la = (long)RDB[ang + ANG_PTR_ALIAS]) > VALID_PTR)
+        la = (long)RDB[la + n];
+
       /* Re-sampling loop (give a second chance) */
 
       j = 0;
@@ -269,13 +279,28 @@ double SampleMu(long rea, long ang, double E, double LMS[7],
         {
           /* Sample secondary bin */
 
-          rnd = RandF(id);
+          if (la > VALID_PTR)
+            {
+              /* Sample bin from alias table and position within bin */
+
+              k = WalkerAliasSample(&RDB[la], &RDB[la + np - 1],
+                                    &RDB[la + 2*(np - 1)], np - 1, id);
 
-          k = 0;
-          while (rnd > RDB[l0 + 2*np + k])
-            k++;
+              rnd = RDB[l0 + 2*np + k] + RandF(id)*(RDB[l0 + 2*np + k + 1]
+                                                    - RDB[l0 + 2*np + k]);
+            }
+          else
+            {
+              /* Search bin from cumulative distribution */
 
-          k--;
+              rnd = RandF(id);
+
+              k = 0;
+              while (rnd > RDB[l0 + 2*np + k])
+                k++;
+
+              k--;
+            }
 
           /* Check values */
 
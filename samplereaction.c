@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : samplereaction.c                               */
 /*                                                                           */
 /* Created:       2011/01/04 (JLe)                                           */
-/* Last modified: 2019/11/07 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Samples reaction after collision                             */
@@ -25,7 +25,7 @@
 
 long SampleReaction(long mat, long type, double E, double wgt, long id)
 {
-  long lst, rea, rls, ptr, i, nuc, ng, TMS, mt;
+  long lst, rea, rls, ptr, i, nuc, ng, TMS, mt, wmp;
   double totxs, adens, xs, absxs, f, g, Er, Emin, Emax, T, E0;
 
   /* Avoid compiler warning */
@@ -33,6 +33,7 @@ long SampleReaction(long mat, long type, double E, double wgt, long id)
   g = 1.0;
   T = -1.0;
   E0 = INFTY;
+  wmp = NO;
 
   /* Check material pointer */
 
@@ -408,13 +409,30 @@ long SampleReaction(long mat, long type, double E, double wgt, long id)
           rea = (long)RDB[nuc + NUCLIDE_PTR_TOTXS];
           CheckPointer(FUNCTION_NAME, "(rea)", DATA_ARRAY, rea);
 
-          xs = DopMicroXS(mat, rea, E, &Er, T, id);
-          CheckValue(FUNCTION_NAME, "xs", "", xs, 0, INFTY);
+          if ((xs = MultipoleMicroXS(rea, E, T, id)) > -1.0)
+            {
+              /* Exact cross section from windowed multipole data, no */
+              /* target velocity or correction factor */
+
+              Er = E;
+              g = 1.0;
+              wmp = YES;
+            }
+          else
+            {
+              /* Sample target velocity */
+
+              xs = DopMicroXS(mat, rea, E, &Er, T, id);
 
-          /* Low-energy correction factor */
+              /* Low-energy correction factor */
 
-          g = PotCorr(nuc, E, T*KELVIN);
-          CheckValue(FUNCTION_NAME, "g", "", g, ZERO, INFTY);
+              g = PotCorr(nuc, E, T*KELVIN);
+              CheckValue(FUNCTION_NAME, "g", "", g, ZERO, INFTY);
+            }
+
+          /* Check cross section */
+
+          CheckValue(FUNCTION_NAME, "xs", "", xs, 0, INFTY);
 
           /* Score total number of TMS samples for efficiency */
 
@@ -562,6 +580,14 @@ long SampleReaction(long mat, long type, double E, double wgt, long id)
               else
                 xs = MicroXS(rea, E, id) - OTFSabXS(rea, E0, T, id)/g;
             }
+          else if (wmp == YES)
+            {
+              /* Windowed multipole data (-1 is returned only for energy */
+              /* outside range, same for all reactions) */
+
+              xs = MultipoleMicroXS(rea, E, T, id);
+              CheckValue(FUNCTION_NAME, "xs", "", xs, 0.0, INFTY);
+            }
           else
             xs = MicroXS(rea, E, id);
         }
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : setoptimization.c                              */
 /*                                                                           */
 /* Created:       2011/07/17 (JLe)                                           */
-/* Last modified: 2019/09/06 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: - Set various options based on optimization                  */
@@ -379,6 +379,18 @@ void SetOptimization()
       ((long)RDB[DATA_OPTI_OMP_REPRODUCIBILITY] == NO))
     WDB[DATA_OPTI_REPLAY] = (double)NO;
 
+  /* Single-precision storage is used only for reconstructed macroscopic */
+  /* cross sections */
+
+  if (((long)RDB[DATA_OPTI_XS_SP] == YES) &&
+      ((long)RDB[DATA_OPTI_RECONSTRUCT_MACROXS] == NO))
+    {
+      Note(0, "Option 'set xsprec' ignored in optimization mode %ld",
+           (long)RDB[DATA_OPTI_MODE]);
+
+      WDB[DATA_OPTI_XS_SP] = (double)NO;
+    }
+
   /* Disable grid thinning if problems */
 
   if (((long)RDB[DATA_OPTI_RECONSTRUCT_MICROXS] == NO) ||
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : sortall.c                                      */
 /*                                                                           */
 /* Created:       2011/03/01 (JLe)                                           */
-/* Last modified: 2019/04/03 (VVa)                                           */
-/* Version:       2.1.31                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Sorts reaction, surface etc. lists to speed up calculation   */
 /*                                                                           */
@@ -107,7 +107,7 @@ void SortAll()
   /* Loop over list */
 
 #ifdef OPEN_MP
-#pragma omp parallel for private(cell, lst)
+#pragma omp parallel for private(cell, lst, ptr)
 #endif
 
   for (i = 0; i < sz; i++)
@@ -124,6 +124,11 @@ void SortAll()
           /* Sort list */
 
           SortList(lst, CELL_INSC_PTR_OUT_COUNT, SORT_MODE_DESCEND_PRIVA);
+
+          /* Re-compile program in place */
+
+          if ((ptr = (long)RDB[cell + CELL_PTR_PROG]) > VALID_PTR)
+            CompileCellProgram(cell, ptr);
         }
     }
 
@@ -443,6 +448,10 @@ void SortAll()
                          SORT_MODE_DESCEND_PRIVA);
             }
 
+      /* Re-pack search grid */
+
+      PackPBGrid(loc0);
+
       /* Next geometry */
 
       loc0 = NextItem(loc0);
@@ -0,0 +1,161 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : sparsestatptr.c                                */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Returns pointer to buffer or statistics data of a bin in     */
+/*              sparse score, assigning the page if needed                   */
+/*                                                                           */
+/* Comments: - Returns NULLPTR if page is not assigned and alloc is NO.      */
+/*                                                                           */
+/*           - Buffer pages are assigned during transport. The page table is */
+/*             shared by all threads (first segment), so the pointer refers  */
+/*             to the first segment also in private buffer mode.             */
+/*                                                                           */
+/*           - Statistics pages are assigned in serial part (CollectDet()).  */
+/*                                                                           */
+/*           - Structure is described in newsparsestat.c.                    */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "SparseStatPtr:"
+
+/*****************************************************************************/
+
+long SparseStatPtr(long ptr, long idx, long type, long alloc)
+{
+  long pg, np, maxp, tab, slot;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  /* Get page index and number of pages */
+
+  pg = idx/SPARSE_STAT_PAGE_SZ;
+  np = (long)RDB[ptr + SCORE_N_PAGES];
+  CheckValue(FUNCTION_NAME, "pg", "", pg, 0, np - 1);
+
+  /* Maximum number of assigned pages */
+
+  maxp = (long)RDB[ptr + SCORE_MAX_PAGES];
+
+  /* Check type */
+
+  if (type == BUF_ARRAY)
+    {
+      /***********************************************************************/
+
+      /***** Buffer **********************************************************/
+
+      /* Pointer to page table */
+
+      tab = (long)RDB[ptr + SCORE_PTR_PAGE_TAB];
+      CheckPointer(FUNCTION_NAME, "(tab)", BUF_ARRAY, tab);
+
+      /* Get slot */
+
+      if ((slot = (long)BUF[tab + pg]) == 0)
+        {
+          /* Check allocation */
+
+          if (alloc == NO)
+            return NULLPTR;
+
+          /* Assign page */
+
+#ifdef OPEN_MP
+#pragma omp critical (sparsebuf)
+#endif
+          {
+            /* Check again (another thread may have assigned the page) */
+
+            if ((slot = (long)BUF[tab + pg]) == 0)
+              {
+                /* Get next slot */
+
+                if ((slot = (long)BUF[tab + np] + 1) > maxp)
+                  Error(0, "Sparse scoring buffer of %s exhausted (%ld "
+                        "pages), increase page count in \"set spbuf\"",
+                        GetText(ptr + SCORE_PTR_NAME), maxp);
+
+                /* Put page of slot and number of used slots */
+
+                BUF[tab + np + slot] = (double)pg;
+                BUF[tab + np] = (double)slot;
+
+                /* Put slot */
+
+                BUF[tab + pg] = (double)slot;
+              }
+          }
+        }
+
+      /* Return pointer to bin */
+
+      return (long)RDB[ptr + SCORE_PTR_BUF] +
+        ((slot - 1)*SPARSE_STAT_PAGE_SZ + idx%SPARSE_STAT_PAGE_SZ)*
+        BUF_BLOCK_SIZE;
+
+      /***********************************************************************/
+    }
+  else if (type == RES1_ARRAY)
+    {
+      /***********************************************************************/
+
+      /***** Statistics ******************************************************/
+
+      /* Pointer to page table */
+
+      tab = (long)RDB[ptr + SCORE_PTR_RES_PAGE_TAB];
+      CheckPointer(FUNCTION_NAME, "(tab)", DATA_ARRAY, tab);
+
+      /* Get slot */
+
+      if ((slot = (long)RDB[tab + pg]) < 0)
+        {
+          /* Check allocation */
+
+          if (alloc == NO)
+            return NULLPTR;
+
+          /* Check thread */
+
+          if (OMP_THREAD_NUM > 0)
+            Die(FUNCTION_NAME, "Not allowed in threads");
+
+          /* Get next slot */
+
+          if ((slot = (long)RDB[ptr + SCORE_RES_PAGES]) > maxp - 1)
+            Error(0, "Sparse statistics of %s exhausted (%ld pages), "
+                  "increase page count in \"set spbuf\"",
+                  GetText(ptr + SCORE_PTR_NAME), maxp);
+
+          /* Put slot and number of used slots */
+
+          WDB[tab + pg] = (double)slot;
+          WDB[ptr + SCORE_RES_PAGES] = (double)(slot + 1);
+        }
+
+      /* Return pointer to bin */
+
+      return (long)RDB[ptr + SCORE_PTR_DATA] +
+        (slot*SPARSE_STAT_PAGE_SZ + idx%SPARSE_STAT_PAGE_SZ)*STAT_BLOCK_SIZE;
+
+      /***********************************************************************/
+    }
+  else
+    Die(FUNCTION_NAME, "Invalid array type");
+
+  /* Avoid compiler warning */
+
+  return NULLPTR;
+}
+
+/*****************************************************************************/
@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : statsum.c                                      */
 /*                                                                           */
 /* Created:       2016/09/11 (JLe)                                           */
-/* Last modified: 2016/09/11 (JLe)                                           */
-/* Version:       2.1.27                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Returns the sum of scores in statistics                      */
 /*                                                                           */
@@ -95,9 +95,15 @@ double StatSum(long ptr, ...)
 
 #endif
 
-  /* Get pointer to statistics */
+  /* Get pointer to statistics (zero if sparse page is not scored) */
 
-  stp = (long)RDB[ptr + SCORE_PTR_DATA] + idx*STAT_BLOCK_SIZE;
+  if ((long)RDB[ptr + SCORE_SPARSE] == YES)
+    {
+      if ((stp = SparseStatPtr(ptr, idx, RES1_ARRAY, NO)) < 0)
+        return 0.0;
+    }
+  else
+    stp = (long)RDB[ptr + SCORE_PTR_DATA] + idx*STAT_BLOCK_SIZE;
 
   /****************************************************************************/
 
@@ -0,0 +1,203 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : stealfromque.c                                 */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Retrieves next neutron / photon from que in dynamic mode, or */
+/*              steals one from the que of another OpenMP thread if all      */
+/*              particles in own que are tracked                             */
+/*                                                                           */
+/* Comments: - Used in Tracking() in dynamic simulation modes with "set      */
+/*             qsteal". The que is gone through from the end to the          */
+/*             beginning, and the next particle to be tracked is stored in   */
+/*             DATA_PTR_OMP_QUE_NEXT. Secondaries are added at the end of    */
+/*             the que and left for the next call.                           */
+/*                                                                           */
+/*           - Only the first particle in the que of another thread is       */
+/*             stolen, and only if it is not the next one to be tracked, so  */
+/*             the particle is taken before its tracking starts. Particles   */
+/*             of histories in progress are never stolen. Ques are scanned   */
+/*             starting from the next thread to spread the stealing evenly.  */
+/*                                                                           */
+/*           - Each que has its own lock, and only the que of the victim is  */
+/*             locked while stealing.                                        */
+/*                                                                           */
+/*           - Stolen particles continue with the random number sequence of  */
+/*             the thief, so the results depend on thread scheduling.        */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "StealFromQue:"
+
+/* Local function definitions */
+
+static long TakeParticle(long, long);
+
+/*****************************************************************************/
+
+long StealFromQue(long *next, long id)
+{
+  long loc0, ptr, nxt, nt, n, i;
+
+  /* Check id */
+
+  if ((id < 0) || (id > (long)RDB[DATA_OMP_MAX_THREADS] - 1))
+    Die(FUNCTION_NAME, "Error in thread id");
+
+  /* Get number of threads */
+
+  nt = (long)RDB[DATA_OMP_MAX_THREADS];
+
+  /* Pointer to next particles */
+
+  loc0 = (long)RDB[DATA_PTR_OMP_QUE_NEXT];
+  CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+  /***************************************************************************/
+
+  /***** Get particle from own que *******************************************/
+
+  /* Lock que */
+
+#ifdef OPEN_MP
+  omp_set_lock(&QUE_LOCK[id]);
+#endif
+
+  /* Check if the beginning of the que is reached */
+
+  if ((long)RDB[*next + PARTICLE_TYPE] != PARTICLE_TYPE_DUMMY)
+    {
+      /* Move to previous particle if no more copies are left */
+
+      ptr = *next;
+
+      if ((long)RDB[ptr + PARTICLE_MULTIPLICITY] == 0)
+        *next = PrevItem(ptr);
+
+      /* Take particle */
+
+      ptr = TakeParticle(ptr, id);
+    }
+  else
+    ptr = -1;
+
+  /* Store next particle to be tracked */
+
+  if ((long)RDB[*next + PARTICLE_TYPE] != PARTICLE_TYPE_DUMMY)
+    WDB[loc0 + id] = (double)(*next);
+  else
+    WDB[loc0 + id] = NULLPTR;
+
+#ifdef OPEN_MP
+  omp_unset_lock(&QUE_LOCK[id]);
+#endif
+
+  /* Check pointer */
+
+  if (ptr > VALID_PTR)
+    return ptr;
+
+  /***************************************************************************/
+
+  /***** Steal particle from other thread ************************************/
+
+  /* Loop over other threads */
+
+  for (n = 1; n < nt; n++)
+    {
+      /* Get index */
+
+      i = (id + n) % nt;
+
+      /* Lock victim que */
+
+#ifdef OPEN_MP
+      omp_set_lock(&QUE_LOCK[i]);
+#endif
+
+      /* Check that the thread is tracking particles from its que */
+
+      if ((nxt = (long)RDB[loc0 + i]) > VALID_PTR)
+        {
+          /* Get first particle after dummy */
+
+          ptr = (long)RDB[OMPPtr(DATA_PART_PTR_QUE, i)];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+          ptr = NextItem(ptr);
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+          /* Compare to next particle to be tracked by the owner */
+
+          if (ptr != nxt)
+            {
+              /* Take particle */
+
+              ptr = TakeParticle(ptr, id);
+
+#ifdef OPEN_MP
+              omp_unset_lock(&QUE_LOCK[i]);
+#endif
+
+              /* Add to counter */
+
+              WDB[(long)RDB[DATA_PTR_OMP_STEAL_COUNT] + id] =
+                RDB[(long)RDB[DATA_PTR_OMP_STEAL_COUNT] + id] + 1.0;
+
+              /* Return pointer */
+
+              return ptr;
+            }
+        }
+
+#ifdef OPEN_MP
+      omp_unset_lock(&QUE_LOCK[i]);
+#endif
+    }
+
+  /***************************************************************************/
+
+  /* Nothing to steal */
+
+  return -1;
+}
+
+/*****************************************************************************/
+
+/***** Remove particle from que or duplicate it ******************************/
+
+static long TakeParticle(long ptr, long id)
+{
+  /* Check multiplicity */
+
+  if ((long)RDB[ptr + PARTICLE_MULTIPLICITY] > 0)
+    {
+      /* Subtract value */
+
+      WDB[ptr + PARTICLE_MULTIPLICITY] =
+        RDB[ptr + PARTICLE_MULTIPLICITY] - 1.0;
+
+      /* Duplicate */
+
+      ptr = DuplicateParticle(ptr, id);
+      WDB[ptr + PARTICLE_MULTIPLICITY] = 0.0;
+    }
+  else
+    {
+      /* Remove particle from que */
+
+      RemoveItem(ptr);
+    }
+
+  /* Return pointer */
+
+  return ptr;
+}
+
+/*****************************************************************************/
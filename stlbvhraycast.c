@@ -0,0 +1,309 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : stlbvhraycast.c                                */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Intersects ray with the facets of STL solid using the        */
+/*              bounding volume hierarchy                                    */
+/*                                                                           */
+/* Comments: - Ray-triangle test is the watertight algorithm by Woop,        */
+/*             Benthin and Wald (JCGT 2, 2013). Rays passing through shared  */
+/*             edges cannot fall between adjacent facets, and edge hits are  */
+/*             detected exactly (one of the edge functions is zero).         */
+/*                                                                           */
+/*           - Modes:                                                        */
+/*                                                                           */
+/*             STL_BVH_MODE_NEAREST  nearest hit below *d, edge hits are     */
+/*                                   accepted (returns YES / NO)             */
+/*             STL_BVH_MODE_STRICT   nearest hit, edge hits and facets at    */
+/*                                   the same distance are failures          */
+/*             STL_BVH_MODE_COUNT    number of crossings, edge hits are      */
+/*                                   failures                                */
+/*                                                                           */
+/*           - Distance to nearest hit is returned in *d and pointer to      */
+/*             facet in *fct.                                                */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "STLBVHRayCast:"
+
+/*****************************************************************************/
+
+long STLBVHRayCast(long sld, double x, double y, double z, double u,
+                   double v, double w, long mode, double *d, long *fct)
+{
+  long nod, tri, ptr, loc0, loc1, stk[2*STL_BVH_MAX_DEPTH + 4], sp, kx, ky;
+  long kz, n, i;
+  double org[3], dir[3], inv[3], sx, sy, sz, t0, t1, tmin, tmax, min;
+  double ax, ay, az, bx, by, bz, cx, cy, cz, U, V, W, det, t;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(sld)", DATA_ARRAY, sld);
+
+  /* Pointers to nodes and facets */
+
+  nod = (long)RDB[sld + STL_SOLID_PTR_BVH];
+  CheckPointer(FUNCTION_NAME, "(nod)", DATA_ARRAY, nod);
+
+  tri = (long)RDB[sld + STL_SOLID_PTR_BVH_TRI];
+  CheckPointer(FUNCTION_NAME, "(tri)", DATA_ARRAY, tri);
+
+  /* Put coordinates and direction */
+
+  org[0] = x;
+  org[1] = y;
+  org[2] = z;
+
+  dir[0] = u;
+  dir[1] = v;
+  dir[2] = w;
+
+  /* Inverse direction for slab tests */
+
+  for (i = 0; i < 3; i++)
+    {
+      if (dir[i] != 0.0)
+        inv[i] = 1.0/dir[i];
+      else
+        inv[i] = INFTY;
+    }
+
+  /* Dimension where direction is largest */
+
+  kz = 0;
+  if (fabs(dir[1]) > fabs(dir[kz]))
+    kz = 1;
+  if (fabs(dir[2]) > fabs(dir[kz]))
+    kz = 2;
+
+  kx = kz + 1;
+  if (kx == 3)
+    kx = 0;
+
+  ky = kx + 1;
+  if (ky == 3)
+    ky = 0;
+
+  /* Swap to preserve winding */
+
+  if (dir[kz] < 0.0)
+    {
+      i = kx;
+      kx = ky;
+      ky = i;
+    }
+
+  /* Shear constants */
+
+  sx = dir[kx]/dir[kz];
+  sy = dir[ky]/dir[kz];
+  sz = 1.0/dir[kz];
+
+  /* Reset nearest distance and facet */
+
+  if (mode == STL_BVH_MODE_NEAREST)
+    min = *d;
+  else
+    min = INFTY;
+
+  *fct = -1;
+
+  /* Reset number of hits */
+
+  n = 0;
+
+  /* Put root node to stack */
+
+  stk[0] = 0;
+  sp = 1;
+
+  /* Loop until stack is empty */
+
+  while (sp > 0)
+    {
+      /* Pointer to node */
+
+      ptr = nod + stk[--sp]*STL_BVH_BLOCK_SIZE;
+
+      /* Slab test */
+
+      t0 = (RDB[ptr + STL_BVH_XMIN] - x)*inv[0];
+      t1 = (RDB[ptr + STL_BVH_XMAX] - x)*inv[0];
+
+      if (t0 < t1)
+        {
+          tmin = t0;
+          tmax = t1;
+        }
+      else
+        {
+          tmin = t1;
+          tmax = t0;
+        }
+
+      t0 = (RDB[ptr + STL_BVH_YMIN] - y)*inv[1];
+      t1 = (RDB[ptr + STL_BVH_YMAX] - y)*inv[1];
+
+      if (t0 > t1)
+        {
+          t = t0;
+          t0 = t1;
+          t1 = t;
+        }
+
+      if (t0 > tmin)
+        tmin = t0;
+      if (t1 < tmax)
+        tmax = t1;
+
+      t0 = (RDB[ptr + STL_BVH_ZMIN] - z)*inv[2];
+      t1 = (RDB[ptr + STL_BVH_ZMAX] - z)*inv[2];
+
+      if (t0 > t1)
+        {
+          t = t0;
+          t0 = t1;
+          t1 = t;
+        }
+
+      if (t0 > tmin)
+        tmin = t0;
+      if (t1 < tmax)
+        tmax = t1;
+
+      /* Check miss (nodes beyond nearest hit are skipped unless */
+      /* counting crossings) */
+
+      if ((tmin > tmax) || (tmax < 0.0))
+        continue;
+      else if ((mode != STL_BVH_MODE_COUNT) && (tmin > min))
+        continue;
+
+      /* Check inner node */
+
+      if ((i = (long)RDB[ptr + STL_BVH_CHILD]) > 0)
+        {
+          /* Check stack size */
+
+          if (sp > 2*STL_BVH_MAX_DEPTH + 1)
+            Die(FUNCTION_NAME, "Stack overflow");
+
+          /* Put children to stack */
+
+          stk[sp++] = i + 1;
+          stk[sp++] = i;
+
+          /* Cycle loop */
+
+          continue;
+        }
+
+      /* Loop over facets in leaf */
+
+      loc0 = tri + (long)RDB[ptr + STL_BVH_FIRST]*STL_BVH_TRI_BLOCK_SIZE;
+
+      for (i = 0; i < (long)RDB[ptr + STL_BVH_N]; i++)
+        {
+          /* Pointer to facet data */
+
+          loc1 = loc0 + i*STL_BVH_TRI_BLOCK_SIZE;
+
+          /* Vertices relative to ray origin */
+
+          ax = RDB[loc1 + STL_BVH_TRI_X1 + kx] - org[kx];
+          ay = RDB[loc1 + STL_BVH_TRI_X1 + ky] - org[ky];
+          az = RDB[loc1 + STL_BVH_TRI_X1 + kz] - org[kz];
+
+          bx = RDB[loc1 + STL_BVH_TRI_X2 + kx] - org[kx];
+          by = RDB[loc1 + STL_BVH_TRI_X2 + ky] - org[ky];
+          bz = RDB[loc1 + STL_BVH_TRI_X2 + kz] - org[kz];
+
+          cx = RDB[loc1 + STL_BVH_TRI_X3 + kx] - org[kx];
+          cy = RDB[loc1 + STL_BVH_TRI_X3 + ky] - org[ky];
+          cz = RDB[loc1 + STL_BVH_TRI_X3 + kz] - org[kz];
+
+          /* Shear and scale */
+
+          ax = ax - sx*az;
+          ay = ay - sy*az;
+          bx = bx - sx*bz;
+          by = by - sy*bz;
+          cx = cx - sx*cz;
+          cy = cy - sy*cz;
+
+          /* Edge functions */
+
+          U = cx*by - cy*bx;
+          V = ax*cy - ay*cx;
+          W = bx*ay - by*ax;
+
+          /* Check miss */
+
+          if (((U < 0.0) || (V < 0.0) || (W < 0.0)) &&
+              ((U > 0.0) || (V > 0.0) || (W > 0.0)))
+            continue;
+
+          /* Determinant (zero if ray is in the plane of the facet) */
+
+          if ((det = U + V + W) == 0.0)
+            continue;
+
+          /* Distance */
+
+          t = (U*sz*az + V*sz*bz + W*sz*cz)/det;
+
+          /* Skip facets behind or beyond nearest */
+
+          if (t <= 0.0)
+            continue;
+          else if ((mode != STL_BVH_MODE_COUNT) && (t > min))
+            continue;
+
+          /* Check edge hit */
+
+          if ((U == 0.0) || (V == 0.0) || (W == 0.0))
+            if (mode != STL_BVH_MODE_NEAREST)
+              return STL_RAY_TEST_FAIL_EDGE;
+
+          /* Check overlap */
+
+          if ((mode == STL_BVH_MODE_STRICT) && (t == min))
+            return STL_FACET_OVERLAP;
+
+          /* Add to number of crossings */
+
+          if (mode == STL_BVH_MODE_COUNT)
+            n++;
+          else
+            n = YES;
+
+          /* Compare to nearest */
+
+          if (t < min)
+            {
+              min = t;
+              *fct = (long)RDB[loc1 + STL_BVH_TRI_PTR_FACET];
+            }
+        }
+    }
+
+  /* Put distance */
+
+  if (*fct > VALID_PTR)
+    *d = min;
+  else if (mode != STL_BVH_MODE_NEAREST)
+    *d = INFTY;
+
+  /* Return number of hits */
+
+  return n;
+}
+
+/*****************************************************************************/
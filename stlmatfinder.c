@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : stlmatfinder.c                                 */
 /*                                                                           */
 /* Created:       2014/03/07 (JLe)                                           */
-/* Last modified: 2016/12/07 (JLe)                                           */
-/* Version:       2.1.28                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Used for reverse-engineering materials in STL geometries     */
 /*              from corresponding CSG models                                */
@@ -22,7 +22,7 @@
 
 void STLMatFinder()
 {
-  long stl, sld, msh, cell, N, n, i, j, m, id, mat;
+  long stl, sld, cell, N, n, i, j, m, id, mat;
   double xmin, xmax, ymin, ymax, zmin, zmax, x, y, z, u, v, w, d;
   unsigned long seed;
   char bname0[MAX_STR], bname[MAX_STR], fname[MAX_STR];
@@ -65,11 +65,6 @@ void STLMatFinder()
       stl = (long)RDB[DATA_PTR_STL0];
       while (stl > VALID_PTR)
         {
-          /* Get pointer to search mesh */
-  
-          msh = (long)RDB[stl + STL_PTR_FACET_MESH];
-          CheckPointer(FUNCTION_NAME, "(msh)", DATA_ARRAY, msh);
-          
           /* Loop over solids */
 
           sld = (long)RDB[stl + STL_PTR_SOLIDS];
@@ -135,8 +130,8 @@ void STLMatFinder()
 
                   /* Perform ray test */
                   
-                  if (STLRayTest(sld, msh, x, y, z, u, v, w, 
-                                 STL_SEARCH_MODE_FAST, id) == YES)
+                  if (STLRayTest(sld, x, y, z, u, v, w, 
+                                 STL_SEARCH_MODE_FAST) == YES)
                     {
                       /* Print coordinates */
 
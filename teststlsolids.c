@@ -3,8 +3,8 @@
 /* serpent 2 (beta-version) : teststlgeometry.c                              */
 /*                                                                           */
 /* Created:       2014/12/10 (JLe)                                           */
-/* Last modified: 2016/10/03 (JLe)                                           */
-/* Version:       2.1.28                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Tests STL solids separately by random sampling               */
 /*                                                                           */
@@ -21,7 +21,7 @@
 
 void TestSTLSolids(long stl, long np, long nd)
 {
-  long sld, msh, ok0, ok, mode, n, m, nf, id;
+  long sld, ok0, ok, mode, n, m, nf, id;
   unsigned long seed;
   double xmin, xmax, ymin, ymax, zmin, zmax, x, y, z, u, v, w;
 
@@ -43,11 +43,6 @@ void TestSTLSolids(long stl, long np, long nd)
 
   mode = STL_SEARCH_MODE_FAST;
 
-  /* Get pointer to search mesh */
-  
-  msh = (long)RDB[stl + STL_PTR_FACET_MESH];
-  CheckPointer(FUNCTION_NAME, "(msh)", DATA_ARRAY, msh);
-  
   /* Loop over solids */
   
   sld = (long)RDB[stl + STL_PTR_SOLIDS];
@@ -99,7 +94,7 @@ void TestSTLSolids(long stl, long np, long nd)
               
               /* Perform ray test */
               
-              ok = STLRayTest(sld, msh, x, y, z, u, v, w, mode, id);
+              ok = STLRayTest(sld, x, y, z, u, v, w, mode);
 
               /* Check with previous */
         
@@ -0,0 +1,81 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : tetfacedistance.c                              */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Calculates minimum distance to the face planes of a          */
+/*              tetrahedron                                                  */
+/*                                                                           */
+/* Comments: - Uses face planes packed in PackTetFaces(). The equations are  */
+/*             the same as for planes in SurfaceDistance().                  */
+/*                                                                           */
+/*           - Index of the nearest face is put in face (-1 if no face is    */
+/*             in the direction of motion).                                  */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "TetFaceDistance:"
+
+/*****************************************************************************/
+
+double TetFaceDistance(long tet, double x, double y, double z, double u,
+                       double v, double w, long *face)
+{
+  long i;
+  double d[4], M, L, min;
+  const double *U, *V, *W, *D;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(tet)", DATA_ARRAY, tet);
+
+  /* Pointers to coefficients */
+
+  U = &RDB[tet + TET_FACE_U];
+  V = &RDB[tet + TET_FACE_V];
+  W = &RDB[tet + TET_FACE_W];
+  D = &RDB[tet + TET_FACE_D];
+
+  /* Calculate distances */
+
+  for (i = 0; i < 4; i++)
+    {
+      /* Calculate constants */
+
+      M = U[i]*u + V[i]*v + W[i]*w;
+      L = U[i]*x + V[i]*y + W[i]*z - D[i];
+
+      /* Calculate distance */
+
+      d[i] = -L/M;
+
+      /* Check direction parallel to plane and negative distance */
+
+      if ((M == 0.0) || (d[i] < 0.0))
+        d[i] = INFTY;
+    }
+
+  /* Find minimum */
+
+  min = INFTY;
+  *face = -1;
+
+  for (i = 0; i < 4; i++)
+    if (d[i] < min)
+      {
+        min = d[i];
+        *face = i;
+      }
+
+  /* Return minimum */
+
+  return min;
+}
+
+/*****************************************************************************/
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : toque.c                                        */
 /*                                                                           */
 /* Created:       2011/03/09 (JLe)                                           */
-/* Last modified: 2019/09/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Puts neutron / photon in que                                 */
@@ -46,6 +46,38 @@ void ToQue(long ptr, long id)
         return;
       }
 
+  /* Check if particles can be stolen by other threads */
+
+  if ((long)RDB[DATA_QUE_STEAL] == YES)
+    {
+      /* Lock que */
+
+#ifdef OPEN_MP
+      omp_set_lock(&QUE_LOCK[id]);
+#endif
+
+      /* Add item in list */
+
+      AddItem(OMPPtr(DATA_PART_PTR_QUE, id), ptr);
+
+      /* Sort list to transport neutrons before photons */
+
+      if (((long)RDB[DATA_PHOTON_TRANSPORT_MODE] == YES) &&
+          ((long)RDB[DATA_NEUTRON_TRANSPORT_MODE] == YES))
+        {
+          ptr = (long)RDB[OMPPtr(DATA_PART_PTR_QUE, id)];
+          SortList(ptr, PARTICLE_TYPE, SORT_MODE_ASCEND);
+        }
+
+#ifdef OPEN_MP
+      omp_unset_lock(&QUE_LOCK[id]);
+#endif
+
+      /* Exit */
+
+      return;
+    }
+
   /* Add item in list */
 
   AddItem(OMPPtr(DATA_PART_PTR_QUE, id), ptr);
@@ -3,12 +3,12 @@
 /* serpent 2 (beta-version) : tostack.c                                      */
 /*                                                                           */
 /* Created:       2011/03/09 (JLe)                                           */
-/* Last modified: 2016/02/01 (VVa)                                           */
-/* Version:       2.1.25                                                     */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Stores neutron / photon / precursor to stack                 */
 /*                                                                           */
-/* Comments:                                                                 */
+/* Comments: - Stacks are LIFO free lists linked through LIST_PTR_NEXT       */
 /*                                                                           */
 /*****************************************************************************/
 
@@ -36,20 +36,36 @@ void ToStack(long ptr, long id)
 
   type = (long)RDB[ptr + PARTICLE_TYPE];
 
+  /* Separate bank for track plotting */
+
+  if ((long)RDB[DATA_STOP_AFTER_PLOT] == STOP_AFTER_PLOT_TRACKS)
+    {
+      /* Get pointer */
+
+      loc0 = OMPPtr(DATA_PART_PTR_TRK_BANK, id);
+      CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+      /* Put item to bank */
+
+      AddItem(loc0, ptr);
+
+      /* Exit */
+
+      return;
+    }
+
   /* Avoid compiler warning */
 
   loc0 = -1;
 
   /* Get stack pointer */
 
-  if ((long)RDB[DATA_STOP_AFTER_PLOT] == STOP_AFTER_PLOT_TRACKS)
-    loc0 = OMPPtr(DATA_PART_PTR_TRK_BANK, id);
-  else if (type == PARTICLE_TYPE_NEUTRON)
-    loc0 = OMPPtr(DATA_PART_PTR_NSTACK, id);
+  if (type == PARTICLE_TYPE_NEUTRON)
+    loc0 = (long)RDB[OMPPtr(DATA_PART_PTR_NSTACK, id)];
   else if (type == PARTICLE_TYPE_GAMMA)
-    loc0 = OMPPtr(DATA_PART_PTR_GSTACK, id);
+    loc0 = (long)RDB[OMPPtr(DATA_PART_PTR_GSTACK, id)];
   else if (type == PARTICLE_TYPE_PRECURSOR)
-    loc0 = OMPPtr(DATA_PART_PTR_PSTACK, id);
+    loc0 = (long)RDB[OMPPtr(DATA_PART_PTR_PSTACK, id)];
   else
     Die(FUNCTION_NAME, "Invalid particle type");
 
@@ -57,9 +73,12 @@ void ToStack(long ptr, long id)
 
   CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
 
-  /* Put item to stack */
+  /* Push to stack */
 
-  AddItem(loc0, ptr);
+  WDB[ptr + LIST_PTR_NEXT] = RDB[loc0 + PART_STACK_PTR_TOP];
+  WDB[ptr + LIST_PTR_PREV] = NULLPTR;
+  WDB[loc0 + PART_STACK_PTR_TOP] = (double)ptr;
+  WDB[loc0 + PART_STACK_N] = RDB[loc0 + PART_STACK_N] + 1.0;
 }
 
 /*****************************************************************************/
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : tracking.c                                     */
 /*                                                                           */
 /* Created:       2011/03/10 (JLe)                                           */
-/* Last modified: 2019/09/28 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Main tracking loop for single particle and secondaries       */
@@ -51,11 +51,10 @@
 
 void Tracking(long id)
 {
-  long part, cell, mat, type, loop, ptr, loc0, trk, mode, bc, gmax, n, lmax;
+  long part, cell, mat, type, loop, ptr, trk, mode, gmax, n, lmax;
   long next, dd;
-  double x, y, z, u, v, w, E0, E, wgt0, wgt, l, totxs, majorant, minxs, xs;
-  double spd, t, dt, g, x0, y0, z0, t0, xt, yt, zt;
-  double xx, yy, zz, dxc, dyc, dzc;
+  double x, y, z, u, v, w, E, wgt, l, totxs, majorant, minxs, xs;
+  double spd, t, x0, y0, z0, t0, xt, yt, zt, dxc, dyc, dzc;
 
   /* Add to OpenMP history counter (onko tää vähän turha?, tää menee */
   /* pieleen dynamic criticality source moodissa) */
@@ -122,6 +121,14 @@ void Tracking(long id)
           if ((part = FromQue(id)) < VALID_PTR)
             break;
         }
+      else if ((long)RDB[DATA_QUE_STEAL] == YES)
+        {
+          /* Get next particle from que or steal one from another thread, */
+          /* or break the while loop */
+
+          if ((part = StealFromQue(&next, id)) < VALID_PTR)
+            break;
+        }
       else
         {
           /* If we have reached the beginning of the que */
@@ -376,116 +383,26 @@ void Tracking(long id)
           CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
           PutPrivateData(ptr, (double)CELL_SEARCH_LIST_CELL, id);
 
-          /* Check photon energy */
-
-          if (type == PARTICLE_TYPE_GAMMA)
-            if (E < RDB[DATA_PHOTON_EMIN])
-              Die(FUNCTION_NAME, "Photon energy below minimum");
-
-          /* Get particle speed */
-
-          spd = Speed(type, E);
-          CheckValue(FUNCTION_NAME, "spd", "", spd, ZERO, INFTY);
-
-          /* Get minimum cross section */
-
-          minxs = MinXS(type, spd, id);
-
-          /* Add to track counter */
-
-          ptr = (long)RDB[DATA_PTR_COLLISION_COUNT];
-          AddPrivateData(ptr, 1.0, id);
-
-          /* Get total cross section and majorant */
-
-          totxs = TotXS(mat, type, E, id);
-          majorant = DTMajorant(type, E, id);
-
-          /* Compare majorant to minimum */
-
-          if (majorant < minxs)
-            majorant = minxs;
-
-          /* Check cross sections */
-
-          CheckValue(FUNCTION_NAME, "majorant", "", majorant, ZERO, INFTY);
-          CheckValue(FUNCTION_NAME, "minxs", "", minxs, ZERO, INFTY);
-          CheckValue(FUNCTION_NAME, "totxs", "", totxs, 0.0, INFTY);
-
           /* Avoid compiler warning */
 
           trk = -1;
           cell = -1;
 
-          /* Get tracking mode */
-
-          mode = TrackMode(part, mat, E, totxs, majorant, type, id);
+          /* Get cross sections and tracking mode */
 
-          xx = x;
-          yy = y;
-          zz = z;
+          mode = TrackingXS(part, mat, type, E, x, y, z, &spd, &minxs, &totxs,
+                            &majorant, id);
 
           /* Move particle forward */
 
-          if (mode == TRACK_MODE_DT)
-            {
-              /* Use delta-tracking */
-
-              trk = MoveDT(part, majorant, minxs, &cell, &xs, &x, &y, &z,
-                           &xt, &yt, &zt, &l, &u, &v, &w, E, id);
-            }
-          else if (mode == TRACK_MODE_ST)
-            {
-              /* Use surface-tracking */
-
-              trk = MoveST(part, totxs, minxs, &cell, &xs, &x, &y, &z, &l,
-                           u, v, w, id);
-
-              /* This may happen in STL mode (DT is forced for next track). */
-
-              if (l == 0.0)
-                continue;
-            }
-          else
-            Die(FUNCTION_NAME, "Invalid tracking mode");
-
-          /* Sampled length may be zero if particle came to  */
-          /* delta-trackingfrom a different domain (toi dd:n */
-          /* testaus on ehkä tarpeeton). */
-
-          if ((dd == NO) || (l > 0.0))
-            {
-              /* Check distance */
-
-              CheckValue(FUNCTION_NAME, "l", "", l, ZERO, INFTY);
-
-              /* Weight window boundary */
+          trk = TrackingMove(part, mode, type, majorant, totxs, minxs, spd, E,
+                             wgt, &cell, &xs, &x, &y, &z, &xt, &yt, &zt, &l,
+                             &u, &v, &w, &t, id);
 
-              trk = StopAtWWBound(type, trk, &x, &y, &z, xx, yy, zz, u, v, w,
-                                  spd, &dt, &l, &cell, id);
+          /* This may happen in STL mode (DT is forced for next track). */
 
-              /* Stop at surface detector flagging */
-
-              trk = StopSurfDetFlg(trk, &x, &y, &z, xx, yy, zz, u, v, w, spd,
-                                   &dt, &l, &cell, id);
-
-              /* Calculate change in time (suhtis?) */
-
-              dt = l/spd;
-
-              /* Do time cut-off (NOTE: Tän pitäisi olla ennen edellisiä) */
-
-              trk = TimeCutoff(trk, part, &cell, &dt, &x, &y, &z, u, v, w, E,
-                               t, &l, wgt, spd, mode, id);
-
-              /* Update time */
-
-              t = t + dt;
-
-              /* Score TLE for RMX */
-
-              ScoreRMXResp(part, -1, l*wgt, id);
-            }
+          if ((mode == TRACK_MODE_ST) && (l == 0.0))
+            continue;
 
           /* Check if track was stopped at tentative collision site */
           /* for domain decomposition. (tähän tullaan MoveDT():stä) */
@@ -531,57 +448,10 @@ void Tracking(long id)
 
               /***** Virtual collision ***************************************/
 
-              /* Check that particle is in correct domain */
-
-              if (CheckDDDomain(mat) == NO)
-                Die(FUNCTION_NAME, "Mismatch in domain");
-
-              /* Score collision */
-
-              ptr = (long)RDB[RES_AVG_VIRT_COL];
-              CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-              AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
-
-              /* Weight adjustment in alpha-eigenvalue mode */
-
-              Alpha(E, majorant, &wgt);
-
-              /* Score collision (NOTE: Cross section is set to -1 if the */
-              /* collision is not to be scored) */
-
-              if (xs > 0.0)
-                {
-                  /* Get density factor */
-
-                  g = DensityFactor(mat, x, y, z, t, id);
-                  CheckValue(FUNCTION_NAME, "g", "", g, 0.0, 1.0);
-
-                  /* Store point in history array */
-
-                  StoreHistoryPoint(part, mat, -1, x, y, z, u, v, w, E,
-                                    t, wgt, 1.0/xs, trk, id);
-
-                  /* Set collision flags for virtual GCU universes */
-
-                  VirtGCUColFlags(x, y, z, id);
-
-                  /* Score collision */
-
-                  Score(mat, part, 1.0/xs, x, y, z, u, v, w, E, wgt, t,
-                        spd, g, id);
-                }
-
-              /**************************************************************/
-            }
-          else if (trk == TRACK_END_FLAG)
-            {
-              /***************************************************************/
-
-              /***** Flag set in surface detector ****************************/
-
-              /* Score surface tallies */
-
-              ScoreSurf(part, &x0, &y0, &z0, x, y, z, u, v, w, E, wgt, t, id);
+              trk = TrackingCollision(trk, part, mat, type, xs, majorant, spd,
+                                      x, y, z, &u, &v, &w, &E, &wgt, t, &x0,
+                                      &y0, &z0, xt, yt, zt, &dxc, &dyc, &dzc,
+                                      id);
 
               /***************************************************************/
             }
@@ -591,122 +461,10 @@ void Tracking(long id)
 
               /***** Physical collision **************************************/
 
-              /* Check that particle is in correct domain */
-
-              if (CheckDDDomain(mat) == NO)
-                Die(FUNCTION_NAME, "Mismatch in domain");
-
-              /* Score surface tallies */
-
-              ScoreSurf(part, &x0, &y0, &z0, x, y, z, u, v, w, E, wgt, t, id);
-
-              /* Score track and collision */
-
-              ptr = (long)RDB[RES_AVG_TRACKS];
-              CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-              AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
-
-              ptr = (long)RDB[RES_AVG_REAL_COL];
-              CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-              AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
-
-              /* Weight adjustment in alpha-eigenvalue mode */
-
-              Alpha(E, majorant, &wgt);
-
-              /* Check material pointer */
-
-              if (mat < VALID_PTR)
-                TrackingError(TRACK_ERR_NO_MATERIAL, -1, -1, -1, id);
-
-              /* Set collision flags for virtual GCU universes */
-
-              VirtGCUColFlags(x, y, z, id);
-
-              /* Get density factor */
-
-              g = DensityFactor(mat, x, y, z, t, id);
-              CheckValue(FUNCTION_NAME, "g", "", g, 0.0, 1.0);
-
-              /* Score collision */
-
-              Score(mat, part, 1.0/xs, x, y, z, u, v, w, E, wgt, t, spd,
-                    g, id);
-
-              /* Additional rejection by density factor */
-
-              if (RandF(id) < g)
-                {
-                  /* Store point in history array */
-
-                  StoreHistoryPoint(part, mat, -1, x, y, z, u, v, w, E,
-                                    t, wgt, 1.0/xs, trk, id);
-
-                  /* Remember energy and weight */
-
-                  E0 = E;
-                  wgt0 = wgt;
-
-                  /* Sample collision */
-
-                  trk = Collision(mat, part, x, y, z, &u, &v, &w, &E,
-                                  &wgt, t, id);
-
-                  /* Score CMM */
-
-                  if (trk == TRACK_END_SCAT)
-                    n = ScoreCMM(dxc, dyc, dzc, x - xt, y - yt, z - zt, E0,
-                                 E, wgt0, wgt, id);
-                  else if ((trk == TRACK_END_CAPT) || (trk == TRACK_END_FISS))
-                    n = ScoreCMM(dxc, dyc, dzc, x - xt, y - yt, z - zt, E0,
-                                 -1.0, wgt0, wgt, id);
-                  else if (trk == TRACK_END_WCUT)
-                    n = ScoreCMM(dxc, dyc, dzc, x - xt, y - yt, z - zt, E0,
-                                  -2.0, wgt0, wgt, id);
-                  else
-                    n = (long)NO;
-
-                  /* Update previous collision delta coordinates */
-
-                  if (n == (long)YES)
-                    {
-                      /* Set previous group change collision delta */
-                      /* coordinates (used for new CMM) */
-
-                      dxc = x - xt;
-                      dyc = y - yt;
-                      dzc = z - zt;
-                    }
-                }
-              else
-                {
-                  /* Virtual collision, change track type */
-
-                  trk = TRACK_END_VIRT;
-                }
-
-              /* Store point in history array */
-
-              StoreHistoryPoint(part, mat, -1, x, y, z, u, v, w, E,
-                                t, wgt, 1.0/xs, trk, id);
-
-              /* Score efficiency of ifc collision rejection */
-
-              if ((long)RDB[mat + MATERIAL_USE_IFC] == YES)
-                {
-                  ptr = (long)RDB[RES_IFC_COL_EFF];
-                  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-                  AddBuf1D(g, 1.0, ptr, id, 2 - type);
-                }
-
-              /* Score total collision effiency */
-
-              if (trk != TRACK_END_VIRT)
-                {
-                  ptr = (long)RDB[RES_TOT_COL_EFF];
-                  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-                  AddBuf1D(g, 1.0, ptr, id, 2 - type);
-                }
+              trk = TrackingCollision(trk, part, mat, type, xs, majorant, spd,
+                                      x, y, z, &u, &v, &w, &E, &wgt, t, &x0,
+                                      &y0, &z0, xt, yt, zt, &dxc, &dyc, &dzc,
+                                      id);
 
               /* Check termination or reset infinite loop counter */
 
@@ -718,199 +476,24 @@ void Tracking(long id)
 
               /***************************************************************/
             }
-          else if (trk == TRACK_END_SURF)
-            {
-              /***************************************************************/
-
-              /***** Surface crossing ****************************************/
-
-              /* Check if outer boundary was crossed and score */
-              /* surface tallies */
-
-              if ((long)RDB[cell + CELL_TYPE] == CELL_TYPE_OUTSIDE)
-                ScoreSurf(part, &x0, &y0, &z0, x, y, z, u, v, w, E,
-                          wgt, t, id);
-
-              /* Score surface crossing */
-
-              ptr = (long)RDB[RES_AVG_SURF_CROSS];
-              CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-              AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
-
-              /* Store first point in history array */
-
-              StoreHistoryPoint(part, mat, -1, x, y, z, u, v, w, E,
-                                t, wgt, -1.0, trk, id);
-
-              /* Remember weight */
-
-              wgt0 = wgt;
-
-              /* Apply boundary conditions */
-
-              bc = BoundaryConditions(&cell, &x, &y, &z, &u, &v, &w, &xt, &yt,
-                                      &zt, &wgt, id);
-
-              /* Check cell pointer */
-
-              if (cell < VALID_PTR)
-                Die(FUNCTION_NAME, "Particle lost");
-
-              /* Check leakage and repeated */
-
-              if (bc < 0)
-                {
-                  /* Score track */
-
-                  ptr = (long)RDB[RES_AVG_TRACKS];
-                  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-                  AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
-
-                  /* Score leakage */
-
-                  Leak(part, x, y, z, u, v, w, E, wgt, id);
-
-                  /* Score leakage detectors */
-
-                  LeakDet(part, 0, x, y, z, u, v, w, E, t, wgt, id);
-
-                  /* Set track type to leak */
-
-                  trk = TRACK_END_LEAK;
-
-                  /* Break loop */
-
-                  break;
-                }
-              else if (bc == YES)
-                {
-                  /* Tätä kutsutaan koska BC:t voi muuttaa sub-meshiä */
-
-                  if ((long)RDB[DATA_RMX_CONVG_ACC] == YES)
-                    ScoreRMXCurr(part, x, y, z, E, wgt, id);
-
-                  /* Adjust previous position (Tässä ja scoresurf.c:ssä */
-                  /* käytetään kaksinkertaista ekstrapolaatiopituutta.) */
-
-                  x0 = x - 2.0*EXTRAP_L*u;
-                  y0 = y - 2.0*EXTRAP_L*v;
-                  z0 = z - 2.0*EXTRAP_L*w;
-
-                  /* Score surface tallies */
-
-                  ScoreSurf(part, &x0, &y0, &z0, x, y, z, u, v, w, E, wgt, t,
-                            id);
-
-                  /* Get material pointer */
-
-                  mat = (long)RDB[cell + CELL_PTR_MAT];
-                  mat = MatPtr(mat, id);
-
-                  /* Store second point in history array */
-
-                  StoreHistoryPoint(part, mat, -1, x, y, z, u, v, w, E,
-                                    t, wgt, -1.0, TRACK_END_BC, id);
-
-                  /* Check if weight was changed by boundary conditions */
-
-                  if (wgt != wgt0)
-                    {
-                      /* Check type */
-
-                      if (type == PARTICLE_TYPE_NEUTRON)
-                        {
-                          /* Score albedo leak rate */
-
-                          ptr = (long)RDB[RES_ALB_NEUTRON_LEAKRATE];
-                          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-                          AddBuf1D(wgt0 - wgt, 1.0, ptr, id, 0);
-
-                          /* Score particle balance */
-
-                          ptr = (long)RDB[RES_N_BALA_LOSS];
-                          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-                          AddBuf(wgt0 - wgt, 1.0, ptr, id, -1,
-                                 BALA_N_LOSS_LEAK, 1);
-                        }
-                      else if (type == PARTICLE_TYPE_GAMMA)
-                        {
-                          /* Score particle balance */
-
-                          ptr = (long)RDB[RES_G_BALA_LOSS];
-                          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-                          AddBuf(wgt0 - wgt, 1.0, ptr, id, -1,
-                                 BALA_G_LOSS_LEAK, 1);
-                        }
-                    }
-                }
-
-              /* Check geometry importances */
-
-              trk = GeoImportance(trk, part, cell, x, y, z, u, v, w, E, &wgt,
-                                  t, id);
-
-              /* Check weight cut-off */
-
-              if (trk == TRACK_END_WCUT)
-                break;
-
-              /***************************************************************/
-            }
-          else if (trk == TRACK_END_TCUT)
-            {
-              /***************************************************************/
-
-              /***** Time cut-off ********************************************/
-
-              /* Score surface tallies */
-
-              ScoreSurf(part, &x0, &y0, &z0, x, y, z, u, v, w, E, wgt, t, id);
-
-              /* Score track */
-
-              ptr = (long)RDB[RES_AVG_TRACKS];
-              CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-              AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
-
-              /* Break loop */
-
-              break;
-
-              /***************************************************************/
-            }
-          else if (trk == TRACK_END_WWIN)
+          else
             {
               /***************************************************************/
 
-              /***** Weight window boundary **********************************/
-
-              /* Store history point */
+              /***** Surface crossing and other track ends *******************/
 
-              StoreHistoryPoint(part, mat, -1, x, y, z, u, v, w, E, t, wgt,
-                                -1.0, trk, id);
+              trk = TrackingSurf(trk, part, type, &cell, &mat, &x, &y, &z,
+                                 &u, &v, &w, E, &wgt, t, &x0, &y0, &z0, &xt,
+                                 &yt, &zt, id);
 
-              /* Score surface tallies */
+              /* Check termination */
 
-              ScoreSurf(part, &x0, &y0, &z0, x, y, z, u, v, w, E, wgt, t, id);
-
-              /* Score current */
-
-              ScoreRMXCurr(part, x, y, z, E, wgt, id);
-
-              /* Apply weight window */
-
-              trk = WeightWindow(trk, part, type, x, y, z, u, v, w, E, &wgt,
-                                 t, WWMESH_BOUND, id);
-
-              /* Check weight cut-off */
-
-              if (trk == TRACK_END_WCUT)
+              if ((trk == TRACK_END_LEAK) || (trk == TRACK_END_TCUT) ||
+                  (trk == TRACK_END_WCUT))
                 break;
 
               /***************************************************************/
             }
-          else
-            Die(FUNCTION_NAME, "Invalid track type %ld", trk);
 
           /* Particles doomed to limbo after crossing a boundary to  */
           /* a material in another domain are caught here. Tentative */
@@ -985,179 +568,10 @@ void Tracking(long id)
           continue;
         }
 
-      /* Get mean number of collisions */
-
-      n = (long)RDB[part + PARTICLE_COL_IDX];
-
-      /* Score total and collisions to fission */
-
-      ptr = (long)RDB[RES_ANA_MEAN_NCOL];
-      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-
-      AddBuf1D((double)n, 1.0, ptr, id, 0);
-
-      if (trk == TRACK_END_FISS)
-        AddBuf1D((double)n, 1.0, ptr, id, 1);
-
-      /* Score number of loops */
-
-      ptr = (long)RDB[RES_AVG_TRACK_LOOPS];
-      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-      AddBuf1D((double)(loop + 1), 1.0, ptr, id, 2 - type);
-
-      /* Check for infinite loop */
-
-      if (loop == lmax)
-        {
-          /* Check type and fail flag */
-
-          if (((type == PARTICLE_TYPE_NEUTRON) &&
-               ((long)RDB[DATA_NEUTRON_MAX_TRACK_LOOP_ERR] == YES)) ||
-              ((type == PARTICLE_TYPE_GAMMA) &&
-               ((long)RDB[DATA_PHOTON_MAX_TRACK_LOOP_ERR] == YES)))
-            TrackingError(TRACK_ERR_INF_LOOP, E, mat, type, id);
-
-          /* Score error */
-
-          AddBuf1D(1.0, 1.0, ptr, id, 4 - type);
-
-          /* Score particle balance */
-
-          if (type == PARTICLE_TYPE_NEUTRON)
-            {
-              ptr = (long)RDB[RES_N_BALA_LOSS];
-              CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-              AddBuf(1.0, 1.0, ptr, id, -1, BALA_N_LOSS_ERR, 0);
-              AddBuf(wgt, 1.0, ptr, id, -1, BALA_N_LOSS_ERR, 1);
-            }
-          else if (type == PARTICLE_TYPE_GAMMA)
-            {
-              ptr = (long)RDB[RES_G_BALA_LOSS];
-              CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
-              AddBuf(1.0, 1.0, ptr, id, -1, BALA_G_LOSS_ERR, 0);
-              AddBuf(wgt, 1.0, ptr, id, -1, BALA_G_LOSS_ERR, 1);
-            }
-
-          /* Put particle back in stack */
-
-          ToStack(part, id);
-
-          /* Cycle outer loop */
-
-          continue;
-        }
-
-      /* Score time constants (kato toi) */
-
-      ScoreTimeConstants(t, wgt, part, trk, id);
-
-      /* Store point in history array */
-
-      StoreHistoryPoint(part, mat, -1, x, y, z, u, v, w, E, t, wgt, -1.0,
-                        trk, id);
-
-      /* Score sensitivities */
-
-      if ((long)RDB[DATA_SENS_MODE] != SENS_MODE_NONE)
-        if (trk == TRACK_END_FISS)
-          EventsToSensitivity(part, wgt, 0, 0.0, id);
-
-      /***********************************************************************/
-
-      /***** Clear events ****************************************************/
-
-      /* Check if events are recorded (no flags set) */
-
-      if ((long)RDB[DATA_EVENT_RECORD_FLAGS] == 0)
-        continue;
-
-      /* Check if track plotter mode */
-
-      if ((long)RDB[DATA_STOP_AFTER_PLOT] == STOP_AFTER_PLOT_TRACKS)
-        continue;
-
-      /* Put OpenMP critical barrier (vissiin tarvitaan) */
-
-#ifdef OPEN_MP
-#pragma omp critical (event)
-#endif
-      {
-        /* Loop over events and update counters */
+      /* Terminate history */
 
-        ptr = (long)RDB[part + PARTICLE_PTR_EVENTS];
-        while (ptr > VALID_PTR)
-          {
-            /* Update count */
-
-            WDB[ptr + EVENT_HIS_COUNT]--;
-
-            /* Check */
-
-            if ((long)RDB[ptr + EVENT_HIS_COUNT] == 0)
-              {
-                /* Remove item (ei pitäisi olla muita jotka operoi tähän) */
-
-                loc0 = ptr;
-
-                /* Pointer to next */
-
-                ptr = NextItem(loc0);
-
-                /* Back to bank */
-
-                EventToBank(loc0, id);
-              }
-            else if ((long)RDB[ptr + EVENT_HIS_COUNT] > 0)
-              {
-                /* Pointer to next */
-
-                ptr = NextItem(ptr);
-              }
-            else
-              Die(FUNCTION_NAME, "WTF?");
-          }
-      }
-
-#ifdef OPEN_MP
-#pragma omp critical (eventblock)
-#endif
-      {
-        /* Loop over event blocks and decrease counters */
-
-        ptr = (long)RDB[part + PARTICLE_PTR_SENS_EBLOCK];
-        while (ptr > VALID_PTR)
-          {
-            /* Reduce count */
-
-            WDB[ptr + SENS_EBLOCK_HIS_COUNT]--;
-
-            /* Check */
-
-            if ((long)RDB[ptr + SENS_EBLOCK_HIS_COUNT] == 0)
-              {
-                /* Remove item (ei pitäisi olla muita jotka operoi tähän) */
-
-                loc0 = ptr;
-
-                /* Pointer to next */
-
-                ptr = NextItem(loc0);
-
-                /* Back to bank */
-
-                EBlockToBank(loc0, id);
-              }
-            else if ((long)RDB[ptr + SENS_EBLOCK_HIS_COUNT] > 0)
-              {
-                /* Pointer to next */
-
-                ptr = NextItem(ptr);
-              }
-            else
-              Die(FUNCTION_NAME, "WTF %ld?",
-                  (long)RDB[ptr + SENS_EBLOCK_HIS_COUNT]);
-          }
-      }
+      TrackingEnd(part, mat, type, trk, loop, lmax, x, y, z, u, v, w, E, wgt,
+                  t, id);
 
       /***********************************************************************/
     }
@@ -0,0 +1,168 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : trackingbank.c                                 */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Event-based transport of source particles using a bank of   */
+/*              histories (replaces the loop over FromSrc() and Tracking()   */
+/*              in criticality source simulation)                            */
+/*                                                                           */
+/* Comments: - The bank holds DATA_EVENT_BANK_SIZE source histories at a     */
+/*             time. All histories in the bank are first advanced through    */
+/*             the cross section event (EventXS) and then through the move   */
+/*             and interaction event (EventMove), so that the same routines  */
+/*             and data are processed for many particles at a time.          */
+/*                                                                           */
+/*           - Each history carries its own random number seed and          */
+/*             collision counter, and secondaries are kept in a separate     */
+/*             que for each source history, so the histories are identical   */
+/*             to the history-based mode. Only the order in which the        */
+/*             results are added in the buffers is different.                */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "TrackingBank:"
+
+/*****************************************************************************/
+
+void TrackingBank(long id)
+{
+  long nb, n, na, src, ptr, loc0;
+  double ncol, t0;
+  EventSlot *bank, *s;
+
+  /* Get bank size */
+
+  nb = (long)RDB[DATA_EVENT_BANK_SIZE];
+  CheckValue(FUNCTION_NAME, "nb", "", nb, 1, 100000);
+
+  /* Allocate memory for bank */
+
+  bank = (EventSlot *)Mem(MEM_ALLOC, nb, sizeof(EventSlot));
+
+  /* Pointer to ques */
+
+  loc0 = (long)RDB[DATA_PART_PTR_EVENT_QUE];
+  CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+  /* Reset slots */
+
+  for (n = 0; n < nb; n++)
+    {
+      bank[n].stat = EVENT_SLOT_FREE;
+      bank[n].que = loc0 + id*nb + n;
+    }
+
+  /* Pointer to collision counter */
+
+  ptr = (long)RDB[DATA_PTR_COLLISION_COUNT];
+  CheckPointer(FUNCTION_NAME, "(ptr)", PRIVA_ARRAY, ptr);
+
+  /* Reset source flag and number of active histories */
+
+  src = YES;
+  na = 0;
+
+  /* Loop until source and bank are empty */
+
+  do
+    {
+      /***********************************************************************/
+
+      /***** Fill bank with source particles *********************************/
+
+      for (n = 0; (n < nb) && (src == YES); n++)
+        {
+          /* Pointer to slot */
+
+          s = &bank[n];
+
+          /* Check status */
+
+          if (s->stat != EVENT_SLOT_FREE)
+            continue;
+
+          /* Get particle from source (put in thread que) */
+
+          if (FromSrc(id) < VALID_PTR)
+            {
+              /* Source is empty */
+
+              src = NO;
+              break;
+            }
+
+          /* Add to OpenMP history counter */
+
+          loc0 = (long)RDB[DATA_PTR_OMP_HISTORY_COUNT];
+          AddPrivateData(loc0, 1.0, id);
+
+          /* Reset maximum generation and time */
+
+          s->gmax = 0;
+          s->t = -1.0;
+
+          /* Start first particle */
+
+          if (EventStart(s, id) == YES)
+            na++;
+
+          /* Save random number seed and private data set by FromSrc() */
+          /* and EventStart(), and move particles to que of history */
+
+          EventState(s, EVENT_STATE_SAVE, id);
+          EventQue(s->que, EVENT_QUE_PUT, id);
+        }
+
+      /***********************************************************************/
+
+      /***** Cross section events ********************************************/
+
+      for (n = 0; n < nb; n++)
+        if (bank[n].stat == EVENT_SLOT_XS)
+          EventXS(&bank[n], id);
+
+      /* Remember collision counter */
+
+      ncol = GetPrivateData(ptr, id);
+
+      /***********************************************************************/
+
+      /***** Move and interaction events *************************************/
+
+      for (n = 0; n < nb; n++)
+        if (bank[n].stat == EVENT_SLOT_MOVE)
+          if (EventMove(&bank[n], id) == NO)
+            na--;
+
+      /* Restore collision counter (counter values are never reused) */
+
+      PutPrivateData(ptr, ncol, id);
+
+      /***********************************************************************/
+    }
+  while ((na > 0) || (src == YES));
+
+  /* Check */
+
+  if (na != 0)
+    Die(FUNCTION_NAME, "Error in number of active histories %ld", na);
+
+  /* Free memory */
+
+  Mem(MEM_FREE, bank);
+
+  /* Put time to be used in coordtrans */
+
+  t0 = RDB[DATA_TIME_CUT_TMIN];
+  ptr = (long)RDB[DATA_PTR_PARTICLE_INITIAL_TIME];
+  PutPrivateData(ptr, t0, id);
+}
+
+/*****************************************************************************/
@@ -0,0 +1,213 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : trackingcollision.c                            */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Handles virtual and physical collisions at the end of track  */
+/*                                                                           */
+/* Comments: - Used in Tracking() and EventMove()                            */
+/*                                                                           */
+/*           - Returns the track type after collision (TRACK_END_VIRT if     */
+/*             the collision was virtual or rejected by density factor).     */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "TrackingCollision:"
+
+/*****************************************************************************/
+
+long TrackingCollision(long trk, long part, long mat, long type, double xs,
+                       double majorant, double spd, double x, double y,
+                       double z, double *u, double *v, double *w, double *E,
+                       double *wgt, double t, double *x0, double *y0,
+                       double *z0, double xt, double yt, double zt,
+                       double *dxc, double *dyc, double *dzc, long id)
+{
+  long ptr, n;
+  double g, E0, wgt0;
+
+  /* Check that particle is in correct domain */
+
+  if (CheckDDDomain(mat) == NO)
+    Die(FUNCTION_NAME, "Mismatch in domain");
+
+  /* Check track type */
+
+  if (trk == TRACK_END_VIRT)
+    {
+      /***********************************************************************/
+
+      /***** Virtual collision ***********************************************/
+
+      /* Score collision */
+
+      ptr = (long)RDB[RES_AVG_VIRT_COL];
+      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+      AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
+
+      /* Weight adjustment in alpha-eigenvalue mode */
+
+      Alpha(*E, majorant, wgt);
+
+      /* Score collision (NOTE: Cross section is set to -1 if the */
+      /* collision is not to be scored) */
+
+      if (xs > 0.0)
+        {
+          /* Get density factor */
+
+          g = DensityFactor(mat, x, y, z, t, id);
+          CheckValue(FUNCTION_NAME, "g", "", g, 0.0, 1.0);
+
+          /* Store point in history array */
+
+          StoreHistoryPoint(part, mat, -1, x, y, z, *u, *v, *w, *E, t, *wgt,
+                            1.0/xs, trk, id);
+
+          /* Set collision flags for virtual GCU universes */
+
+          VirtGCUColFlags(x, y, z, id);
+
+          /* Score collision */
+
+          Score(mat, part, 1.0/xs, x, y, z, *u, *v, *w, *E, *wgt, t, spd, g,
+                id);
+        }
+
+      /* Return track type */
+
+      return trk;
+
+      /***********************************************************************/
+    }
+  else if (trk != TRACK_END_COLL)
+    Die(FUNCTION_NAME, "Invalid track type %ld", trk);
+
+  /***************************************************************************/
+
+  /***** Physical collision **************************************************/
+
+  /* Score surface tallies */
+
+  ScoreSurf(part, x0, y0, z0, x, y, z, *u, *v, *w, *E, *wgt, t, id);
+
+  /* Score track and collision */
+
+  ptr = (long)RDB[RES_AVG_TRACKS];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+  AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
+
+  ptr = (long)RDB[RES_AVG_REAL_COL];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+  AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
+
+  /* Weight adjustment in alpha-eigenvalue mode */
+
+  Alpha(*E, majorant, wgt);
+
+  /* Check material pointer */
+
+  if (mat < VALID_PTR)
+    TrackingError(TRACK_ERR_NO_MATERIAL, -1, -1, -1, id);
+
+  /* Set collision flags for virtual GCU universes */
+
+  VirtGCUColFlags(x, y, z, id);
+
+  /* Get density factor */
+
+  g = DensityFactor(mat, x, y, z, t, id);
+  CheckValue(FUNCTION_NAME, "g", "", g, 0.0, 1.0);
+
+  /* Score collision */
+
+  Score(mat, part, 1.0/xs, x, y, z, *u, *v, *w, *E, *wgt, t, spd, g, id);
+
+  /* Additional rejection by density factor */
+
+  if (RandF(id) < g)
+    {
+      /* Store point in history array */
+
+      StoreHistoryPoint(part, mat, -1, x, y, z, *u, *v, *w, *E, t, *wgt,
+                        1.0/xs, trk, id);
+
+      /* Remember energy and weight */
+
+      E0 = *E;
+      wgt0 = *wgt;
+
+      /* Sample collision */
+
+      trk = Collision(mat, part, x, y, z, u, v, w, E, wgt, t, id);
+
+      /* Score CMM */
+
+      if (trk == TRACK_END_SCAT)
+        n = ScoreCMM(*dxc, *dyc, *dzc, x - xt, y - yt, z - zt, E0, *E, wgt0,
+                     *wgt, id);
+      else if ((trk == TRACK_END_CAPT) || (trk == TRACK_END_FISS))
+        n = ScoreCMM(*dxc, *dyc, *dzc, x - xt, y - yt, z - zt, E0, -1.0,
+                     wgt0, *wgt, id);
+      else if (trk == TRACK_END_WCUT)
+        n = ScoreCMM(*dxc, *dyc, *dzc, x - xt, y - yt, z - zt, E0, -2.0,
+                     wgt0, *wgt, id);
+      else
+        n = (long)NO;
+
+      /* Update previous collision delta coordinates */
+
+      if (n == (long)YES)
+        {
+          /* Set previous group change collision delta */
+          /* coordinates (used for new CMM) */
+
+          *dxc = x - xt;
+          *dyc = y - yt;
+          *dzc = z - zt;
+        }
+    }
+  else
+    {
+      /* Virtual collision, change track type */
+
+      trk = TRACK_END_VIRT;
+    }
+
+  /* Store point in history array */
+
+  StoreHistoryPoint(part, mat, -1, x, y, z, *u, *v, *w, *E, t, *wgt, 1.0/xs,
+                    trk, id);
+
+  /* Score efficiency of ifc collision rejection */
+
+  if ((long)RDB[mat + MATERIAL_USE_IFC] == YES)
+    {
+      ptr = (long)RDB[RES_IFC_COL_EFF];
+      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+      AddBuf1D(g, 1.0, ptr, id, 2 - type);
+    }
+
+  /* Score total collision effiency */
+
+  if (trk != TRACK_END_VIRT)
+    {
+      ptr = (long)RDB[RES_TOT_COL_EFF];
+      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+      AddBuf1D(g, 1.0, ptr, id, 2 - type);
+    }
+
+  /***************************************************************************/
+
+  /* Return track type */
+
+  return trk;
+}
+
+/*****************************************************************************/
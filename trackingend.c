@@ -0,0 +1,208 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : trackingend.c                                  */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Handles termination of particle history                      */
+/*                                                                           */
+/* Comments: - Used in Tracking() and EventMove()                            */
+/*                                                                           */
+/*           - Particles terminated in infinite loop are put back in stack,  */
+/*             otherwise the events recorded for the history are released.   */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "TrackingEnd:"
+
+/*****************************************************************************/
+
+void TrackingEnd(long part, long mat, long type, long trk, long loop,
+                 long lmax, double x, double y, double z, double u, double v,
+                 double w, double E, double wgt, double t, long id)
+{
+  long ptr, loc0, n;
+
+  /* Get mean number of collisions */
+
+  n = (long)RDB[part + PARTICLE_COL_IDX];
+
+  /* Score total and collisions to fission */
+
+  ptr = (long)RDB[RES_ANA_MEAN_NCOL];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  AddBuf1D((double)n, 1.0, ptr, id, 0);
+
+  if (trk == TRACK_END_FISS)
+    AddBuf1D((double)n, 1.0, ptr, id, 1);
+
+  /* Score number of loops */
+
+  ptr = (long)RDB[RES_AVG_TRACK_LOOPS];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+  AddBuf1D((double)(loop + 1), 1.0, ptr, id, 2 - type);
+
+  /* Check for infinite loop */
+
+  if (loop == lmax)
+    {
+      /* Check type and fail flag */
+
+      if (((type == PARTICLE_TYPE_NEUTRON) &&
+           ((long)RDB[DATA_NEUTRON_MAX_TRACK_LOOP_ERR] == YES)) ||
+          ((type == PARTICLE_TYPE_GAMMA) &&
+           ((long)RDB[DATA_PHOTON_MAX_TRACK_LOOP_ERR] == YES)))
+        TrackingError(TRACK_ERR_INF_LOOP, E, mat, type, id);
+
+      /* Score error */
+
+      AddBuf1D(1.0, 1.0, ptr, id, 4 - type);
+
+      /* Score particle balance */
+
+      if (type == PARTICLE_TYPE_NEUTRON)
+        {
+          ptr = (long)RDB[RES_N_BALA_LOSS];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+          AddBuf(1.0, 1.0, ptr, id, -1, BALA_N_LOSS_ERR, 0);
+          AddBuf(wgt, 1.0, ptr, id, -1, BALA_N_LOSS_ERR, 1);
+        }
+      else if (type == PARTICLE_TYPE_GAMMA)
+        {
+          ptr = (long)RDB[RES_G_BALA_LOSS];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+          AddBuf(1.0, 1.0, ptr, id, -1, BALA_G_LOSS_ERR, 0);
+          AddBuf(wgt, 1.0, ptr, id, -1, BALA_G_LOSS_ERR, 1);
+        }
+
+      /* Put particle back in stack */
+
+      ToStack(part, id);
+
+      /* Exit */
+
+      return;
+    }
+
+  /* Score time constants (kato toi) */
+
+  ScoreTimeConstants(t, wgt, part, trk, id);
+
+  /* Store point in history array */
+
+  StoreHistoryPoint(part, mat, -1, x, y, z, u, v, w, E, t, wgt, -1.0,
+                    trk, id);
+
+  /* Score sensitivities */
+
+  if ((long)RDB[DATA_SENS_MODE] != SENS_MODE_NONE)
+    if (trk == TRACK_END_FISS)
+      EventsToSensitivity(part, wgt, 0, 0.0, id);
+
+  /***************************************************************************/
+
+  /***** Clear events ********************************************************/
+
+  /* Check if events are recorded (no flags set) */
+
+  if ((long)RDB[DATA_EVENT_RECORD_FLAGS] == 0)
+    return;
+
+  /* Check if track plotter mode */
+
+  if ((long)RDB[DATA_STOP_AFTER_PLOT] == STOP_AFTER_PLOT_TRACKS)
+    return;
+
+  /* Put OpenMP critical barrier (vissiin tarvitaan) */
+
+#ifdef OPEN_MP
+#pragma omp critical (event)
+#endif
+  {
+    /* Loop over events and update counters */
+
+    ptr = (long)RDB[part + PARTICLE_PTR_EVENTS];
+    while (ptr > VALID_PTR)
+      {
+        /* Update count */
+
+        WDB[ptr + EVENT_HIS_COUNT]--;
+
+        /* Check */
+
+        if ((long)RDB[ptr + EVENT_HIS_COUNT] == 0)
+          {
+            /* Remove item (ei pitäisi olla muita jotka operoi tähän) */
+
+            loc0 = ptr;
+
+            /* Pointer to next */
+
+            ptr = NextItem(loc0);
+
+            /* Back to bank */
+
+            EventToBank(loc0, id);
+          }
+        else if ((long)RDB[ptr + EVENT_HIS_COUNT] > 0)
+          {
+            /* Pointer to next */
+
+            ptr = NextItem(ptr);
+          }
+        else
+          Die(FUNCTION_NAME, "WTF?");
+      }
+  }
+
+#ifdef OPEN_MP
+#pragma omp critical (eventblock)
+#endif
+  {
+    /* Loop over event blocks and decrease counters */
+
+    ptr = (long)RDB[part + PARTICLE_PTR_SENS_EBLOCK];
+    while (ptr > VALID_PTR)
+      {
+        /* Reduce count */
+
+        WDB[ptr + SENS_EBLOCK_HIS_COUNT]--;
+
+        /* Check */
+
+        if ((long)RDB[ptr + SENS_EBLOCK_HIS_COUNT] == 0)
+          {
+            /* Remove item (ei pitäisi olla muita jotka operoi tähän) */
+
+            loc0 = ptr;
+
+            /* Pointer to next */
+
+            ptr = NextItem(loc0);
+
+            /* Back to bank */
+
+            EBlockToBank(loc0, id);
+          }
+        else if ((long)RDB[ptr + SENS_EBLOCK_HIS_COUNT] > 0)
+          {
+            /* Pointer to next */
+
+            ptr = NextItem(ptr);
+          }
+        else
+          Die(FUNCTION_NAME, "WTF %ld?",
+              (long)RDB[ptr + SENS_EBLOCK_HIS_COUNT]);
+      }
+  }
+
+  /***************************************************************************/
+}
+
+/*****************************************************************************/
@@ -0,0 +1,112 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : trackingmove.c                                 */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Moves particle forward using delta- or surface-tracking and  */
+/*              applies stops at weight window boundaries, surface detector  */
+/*              flagging and time cut-off                                    */
+/*                                                                           */
+/* Comments: - Used in Tracking() and EventMove()                            */
+/*                                                                           */
+/*           - Returns with zero track length if surface-tracking fails in   */
+/*             STL mode (DT is forced for next track).                       */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "TrackingMove:"
+
+/*****************************************************************************/
+
+long TrackingMove(long part, long mode, long type, double majorant,
+                  double totxs, double minxs, double spd, double E,
+                  double wgt, long *cell, double *xs, double *x, double *y,
+                  double *z, double *xt, double *yt, double *zt, double *l,
+                  double *u, double *v, double *w, double *t, long id)
+{
+  long trk;
+  double xx, yy, zz, dt;
+
+  /* Avoid compiler warning */
+
+  trk = -1;
+
+  /* Remember position */
+
+  xx = *x;
+  yy = *y;
+  zz = *z;
+
+  /* Move particle forward */
+
+  if (mode == TRACK_MODE_DT)
+    {
+      /* Use delta-tracking */
+
+      trk = MoveDT(part, majorant, minxs, cell, xs, x, y, z, xt, yt, zt, l,
+                   u, v, w, E, id);
+    }
+  else if (mode == TRACK_MODE_ST)
+    {
+      /* Use surface-tracking */
+
+      trk = MoveST(part, totxs, minxs, cell, xs, x, y, z, l, *u, *v, *w,
+                   id);
+
+      /* This may happen in STL mode (DT is forced for next track). */
+
+      if (*l == 0.0)
+        return trk;
+    }
+  else
+    Die(FUNCTION_NAME, "Invalid tracking mode");
+
+  /* Sampled length may be zero if particle came to delta-tracking */
+  /* from a different domain */
+
+  if (((long)RDB[DATA_DD_DECOMPOSE] == NO) || (*l > 0.0))
+    {
+      /* Check distance */
+
+      CheckValue(FUNCTION_NAME, "l", "", *l, ZERO, INFTY);
+
+      /* Weight window boundary */
+
+      trk = StopAtWWBound(type, trk, x, y, z, xx, yy, zz, *u, *v, *w, spd,
+                          &dt, l, cell, id);
+
+      /* Stop at surface detector flagging */
+
+      trk = StopSurfDetFlg(trk, x, y, z, xx, yy, zz, *u, *v, *w, spd, &dt,
+                           l, cell, id);
+
+      /* Calculate change in time */
+
+      dt = *l/spd;
+
+      /* Do time cut-off */
+
+      trk = TimeCutoff(trk, part, cell, &dt, x, y, z, *u, *v, *w, E, *t, l,
+                       wgt, spd, mode, id);
+
+      /* Update time */
+
+      *t = *t + dt;
+
+      /* Score TLE for RMX */
+
+      ScoreRMXResp(part, -1, (*l)*wgt, id);
+    }
+
+  /* Return track type */
+
+  return trk;
+}
+
+/*****************************************************************************/
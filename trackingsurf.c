@@ -0,0 +1,231 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : trackingsurf.c                                 */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Handles surface crossings and other track ends that are not  */
+/*              collisions                                                   */
+/*                                                                           */
+/* Comments: - Used in Tracking() and EventMove()                            */
+/*                                                                           */
+/*           - Handles surface detector flags, surface crossings (boundary   */
+/*             conditions, leakage and geometry importances), time cut-off   */
+/*             and weight window boundaries.                                 */
+/*                                                                           */
+/*           - Returns the new track type. History is terminated if the      */
+/*             returned type is TRACK_END_LEAK, TRACK_END_TCUT or            */
+/*             TRACK_END_WCUT.                                               */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "TrackingSurf:"
+
+/*****************************************************************************/
+
+long TrackingSurf(long trk, long part, long type, long *cell, long *mat,
+                  double *x, double *y, double *z, double *u, double *v,
+                  double *w, double E, double *wgt, double t, double *x0,
+                  double *y0, double *z0, double *xt, double *yt, double *zt,
+                  long id)
+{
+  long ptr, bc;
+  double wgt0;
+
+  /* Check track type */
+
+  if (trk == TRACK_END_FLAG)
+    {
+      /***********************************************************************/
+
+      /***** Flag set in surface detector ************************************/
+
+      /* Score surface tallies */
+
+      ScoreSurf(part, x0, y0, z0, *x, *y, *z, *u, *v, *w, E, *wgt, t, id);
+
+      /***********************************************************************/
+    }
+  else if (trk == TRACK_END_SURF)
+    {
+      /***********************************************************************/
+
+      /***** Surface crossing ************************************************/
+
+      /* Check if outer boundary was crossed and score */
+      /* surface tallies */
+
+      if ((long)RDB[*cell + CELL_TYPE] == CELL_TYPE_OUTSIDE)
+        ScoreSurf(part, x0, y0, z0, *x, *y, *z, *u, *v, *w, E, *wgt, t, id);
+
+      /* Score surface crossing */
+
+      ptr = (long)RDB[RES_AVG_SURF_CROSS];
+      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+      AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
+
+      /* Store first point in history array */
+
+      StoreHistoryPoint(part, *mat, -1, *x, *y, *z, *u, *v, *w, E,
+                        t, *wgt, -1.0, trk, id);
+
+      /* Remember weight */
+
+      wgt0 = *wgt;
+
+      /* Apply boundary conditions */
+
+      bc = BoundaryConditions(cell, x, y, z, u, v, w, xt, yt, zt, wgt, id);
+
+      /* Check cell pointer */
+
+      if (*cell < VALID_PTR)
+        Die(FUNCTION_NAME, "Particle lost");
+
+      /* Check leakage and repeated */
+
+      if (bc < 0)
+        {
+          /* Score track */
+
+          ptr = (long)RDB[RES_AVG_TRACKS];
+          CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+          AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
+
+          /* Score leakage */
+
+          Leak(part, *x, *y, *z, *u, *v, *w, E, *wgt, id);
+
+          /* Score leakage detectors */
+
+          LeakDet(part, 0, *x, *y, *z, *u, *v, *w, E, t, *wgt, id);
+
+          /* Return leak */
+
+          return TRACK_END_LEAK;
+        }
+      else if (bc == YES)
+        {
+          /* Tätä kutsutaan koska BC:t voi muuttaa sub-meshiä */
+
+          if ((long)RDB[DATA_RMX_CONVG_ACC] == YES)
+            ScoreRMXCurr(part, *x, *y, *z, E, *wgt, id);
+
+          /* Adjust previous position (Tässä ja scoresurf.c:ssä */
+          /* käytetään kaksinkertaista ekstrapolaatiopituutta.) */
+
+          *x0 = *x - 2.0*EXTRAP_L*(*u);
+          *y0 = *y - 2.0*EXTRAP_L*(*v);
+          *z0 = *z - 2.0*EXTRAP_L*(*w);
+
+          /* Score surface tallies */
+
+          ScoreSurf(part, x0, y0, z0, *x, *y, *z, *u, *v, *w, E, *wgt, t,
+                    id);
+
+          /* Get material pointer */
+
+          *mat = (long)RDB[*cell + CELL_PTR_MAT];
+          *mat = MatPtr(*mat, id);
+
+          /* Store second point in history array */
+
+          StoreHistoryPoint(part, *mat, -1, *x, *y, *z, *u, *v, *w, E,
+                            t, *wgt, -1.0, TRACK_END_BC, id);
+
+          /* Check if weight was changed by boundary conditions */
+
+          if (*wgt != wgt0)
+            {
+              /* Check type */
+
+              if (type == PARTICLE_TYPE_NEUTRON)
+                {
+                  /* Score albedo leak rate */
+
+                  ptr = (long)RDB[RES_ALB_NEUTRON_LEAKRATE];
+                  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+                  AddBuf1D(wgt0 - *wgt, 1.0, ptr, id, 0);
+
+                  /* Score particle balance */
+
+                  ptr = (long)RDB[RES_N_BALA_LOSS];
+                  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+                  AddBuf(wgt0 - *wgt, 1.0, ptr, id, -1, BALA_N_LOSS_LEAK, 1);
+                }
+              else if (type == PARTICLE_TYPE_GAMMA)
+                {
+                  /* Score particle balance */
+
+                  ptr = (long)RDB[RES_G_BALA_LOSS];
+                  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+                  AddBuf(wgt0 - *wgt, 1.0, ptr, id, -1, BALA_G_LOSS_LEAK, 1);
+                }
+            }
+        }
+
+      /* Check geometry importances */
+
+      trk = GeoImportance(trk, part, *cell, *x, *y, *z, *u, *v, *w, E, wgt,
+                          t, id);
+
+      /***********************************************************************/
+    }
+  else if (trk == TRACK_END_TCUT)
+    {
+      /***********************************************************************/
+
+      /***** Time cut-off ****************************************************/
+
+      /* Score surface tallies */
+
+      ScoreSurf(part, x0, y0, z0, *x, *y, *z, *u, *v, *w, E, *wgt, t, id);
+
+      /* Score track */
+
+      ptr = (long)RDB[RES_AVG_TRACKS];
+      CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+      AddBuf1D(1.0, 1.0, ptr, id, 2 - type);
+
+      /***********************************************************************/
+    }
+  else if (trk == TRACK_END_WWIN)
+    {
+      /***********************************************************************/
+
+      /***** Weight window boundary ******************************************/
+
+      /* Store history point */
+
+      StoreHistoryPoint(part, *mat, -1, *x, *y, *z, *u, *v, *w, E, t, *wgt,
+                        -1.0, trk, id);
+
+      /* Score surface tallies */
+
+      ScoreSurf(part, x0, y0, z0, *x, *y, *z, *u, *v, *w, E, *wgt, t, id);
+
+      /* Score current */
+
+      ScoreRMXCurr(part, *x, *y, *z, E, *wgt, id);
+
+      /* Apply weight window */
+
+      trk = WeightWindow(trk, part, type, *x, *y, *z, *u, *v, *w, E, wgt,
+                         t, WWMESH_BOUND, id);
+
+      /***********************************************************************/
+    }
+  else
+    Die(FUNCTION_NAME, "Invalid track type %ld", trk);
+
+  /* Return track type */
+
+  return trk;
+}
+
+/*****************************************************************************/
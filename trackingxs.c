@@ -0,0 +1,85 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : trackingxs.c                                   */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Calculates speed, cross sections and majorant and selects    */
+/*              tracking mode at the beginning of tracking loop              */
+/*                                                                           */
+/* Comments: - Used in Tracking() and EventXS()                              */
+/*                                                                           */
+/*           - The regional majorant is used only for selecting the tracking */
+/*             mode. The global value is used if total exceeds it (see       */
+/*             MoveDT()).                                                    */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "TrackingXS:"
+
+/*****************************************************************************/
+
+long TrackingXS(long part, long mat, long type, double E, double x,
+                double y, double z, double *spd, double *minxs,
+                double *totxs, double *majorant, long id)
+{
+  long ptr;
+  double maj;
+
+  /* Check photon energy */
+
+  if (type == PARTICLE_TYPE_GAMMA)
+    if (E < RDB[DATA_PHOTON_EMIN])
+      Die(FUNCTION_NAME, "Photon energy below minimum");
+
+  /* Get particle speed */
+
+  *spd = Speed(type, E);
+  CheckValue(FUNCTION_NAME, "spd", "", *spd, ZERO, INFTY);
+
+  /* Get minimum cross section */
+
+  *minxs = MinXS(type, *spd, id);
+
+  /* Add to track counter */
+
+  ptr = (long)RDB[DATA_PTR_COLLISION_COUNT];
+  AddPrivateData(ptr, 1.0, id);
+
+  /* Get total cross section and majorant */
+
+  *totxs = TotXS(mat, type, E, id);
+  *majorant = DTMajorant(type, E, id);
+
+  /* Compare majorant to minimum */
+
+  if (*majorant < *minxs)
+    *majorant = *minxs;
+
+  /* Check cross sections */
+
+  CheckValue(FUNCTION_NAME, "majorant", "", *majorant, ZERO, INFTY);
+  CheckValue(FUNCTION_NAME, "minxs", "", *minxs, ZERO, INFTY);
+  CheckValue(FUNCTION_NAME, "totxs", "", *totxs, 0.0, INFTY);
+
+  /* Get regional majorant */
+
+  maj = DTRegionMajorant(type, *majorant, E, x, y, z, id);
+
+  if (maj < *minxs)
+    maj = *minxs;
+
+  if (*totxs > maj)
+    maj = *majorant;
+
+  /* Get tracking mode */
+
+  return TrackMode(part, mat, E, *totxs, maj, type, id);
+}
+
+/*****************************************************************************/
@@ -3,7 +3,7 @@
 /* serpent 2 (beta-version) : transportcycle.c                               */
 /*                                                                           */
 /* Created:       2011/05/23 (JLe)                                           */
-/* Last modified: 2020/06/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
 /* Version:       2.1.32                                                     */
 /*                                                                           */
 /* Description: Prepares and runs the main transport cycle                   */
@@ -257,6 +257,10 @@ void TransportCycle()
 
           StartTimer(TIMER_OMP_PARA);
 
+          /* Reset load balance data */
+
+          OMPBalance(OMP_BALANCE_START, -1);
+
           /* Parallel loop over histories */
 
 #ifdef OPEN_MP
@@ -268,7 +272,7 @@ void TransportCycle()
             id = OMP_THREAD_NUM;
 
 #ifdef OPEN_MP
-#pragma omp for schedule(dynamic)
+#pragma omp for schedule(dynamic) nowait
 #endif
             /* Loop over source neutrons */
 
@@ -298,6 +302,10 @@ void TransportCycle()
                       OMPSetComp(id);
                     }
               }
+
+            /* Store finish time */
+
+            OMPBalance(OMP_BALANCE_THREAD, id);
           }
 
           /* Move collected pulse data to statistics */
@@ -309,6 +317,10 @@ void TransportCycle()
 
           StopTimer(TIMER_OMP_PARA);
 
+          /* Add to load balance sums */
+
+          OMPBalance(OMP_BALANCE_STOP, -1);
+
           /* Collect data from interval */
 
           CollectDynData();
@@ -367,6 +379,10 @@ void TransportCycle()
 
                   StartTimer(TIMER_OMP_PARA);
 
+                  /* Reset load balance data */
+
+                  OMPBalance(OMP_BALANCE_START, -1);
+
                   /* Loop until source is empty */
 
 #ifdef OPEN_MP
@@ -381,8 +397,16 @@ void TransportCycle()
 
                     while (FromSrc(id) > VALID_PTR)
                       Tracking(id);
+
+                    /* Store finish time */
+
+                    OMPBalance(OMP_BALANCE_THREAD, id);
                   }
 
+                  /* Add to load balance sums */
+
+                  OMPBalance(OMP_BALANCE_STOP, -1);
+
                   /* Collect data from interval */
 
                   CollectDynData();
@@ -446,6 +470,10 @@ void TransportCycle()
           ptr = (long)RDB[RES_CPU_USAGE];
           AddStat(t0, ptr, 0);
 
+          /* Calculate load imbalance */
+
+          OMPBalance(OMP_BALANCE_END, -1);
+
           /* Print cycle-wise output */
 
           PrintCycleOutput();
@@ -717,6 +745,10 @@ void TransportCycle()
           while (tosimulate > 0)
             {
 
+              /* Reset load balance data */
+
+              OMPBalance(OMP_BALANCE_START, -1);
+
               /* Track current generation */
 
 #ifdef OPEN_MP
@@ -730,8 +762,16 @@ void TransportCycle()
                 /* Track neutrons */
 
                 Tracking(id);
+
+                /* Store finish time */
+
+                OMPBalance(OMP_BALANCE_THREAD, id);
               }
 
+              /* Add to load balance sums */
+
+              OMPBalance(OMP_BALANCE_STOP, -1);
+
               /* Even out ques for next generation */
 
               tosimulate = ReDistributeQues();
@@ -848,6 +888,10 @@ void TransportCycle()
 
                   StartTimer(TIMER_OMP_PARA);
 
+                  /* Reset load balance data */
+
+                  OMPBalance(OMP_BALANCE_START, -1);
+
                   /* Loop until source is empty */
 
 #ifdef OPEN_MP
@@ -863,8 +907,15 @@ void TransportCycle()
                     while(FromSrc(id) > VALID_PTR)
                       Tracking(id);
 
+                    /* Store finish time */
+
+                    OMPBalance(OMP_BALANCE_THREAD, id);
                   }
 
+                  /* Add to load balance sums */
+
+                  OMPBalance(OMP_BALANCE_STOP, -1);
+
                   /* Parallel loop over histories */
                   /* Track neutrons */
 
@@ -875,6 +926,10 @@ void TransportCycle()
                   while (tosimulate > 0)
                     {
 
+                      /* Reset load balance data */
+
+                      OMPBalance(OMP_BALANCE_START, -1);
+
                       /* Track current generation */
 
 #ifdef OPEN_MP
@@ -888,8 +943,16 @@ void TransportCycle()
                         /* Track neutrons */
 
                         Tracking(id);
+
+                        /* Store finish time */
+
+                        OMPBalance(OMP_BALANCE_THREAD, id);
                       }
 
+                      /* Add to load balance sums */
+
+                      OMPBalance(OMP_BALANCE_STOP, -1);
+
                       /* Even out ques for next generation */
 
                       tosimulate = ReDistributeQues();
@@ -958,6 +1021,10 @@ void TransportCycle()
           ptr = (long)RDB[RES_CPU_USAGE];
           AddStat(t0, ptr, 0);
 
+          /* Calculate load imbalance */
+
+          OMPBalance(OMP_BALANCE_END, -1);
+
           /* Print cycle-wise output */
 
           PrintCycleOutput();
@@ -1220,6 +1287,10 @@ void TransportCycle()
               while (tosimulate > 0)
                 {
 
+                  /* Reset load balance data */
+
+                  OMPBalance(OMP_BALANCE_START, -1);
+
                   /* Track current generation */
 
 #ifdef OPEN_MP
@@ -1233,8 +1304,16 @@ void TransportCycle()
                     /* Track neutrons */
 
                     Tracking(id);
+
+                    /* Store finish time */
+
+                    OMPBalance(OMP_BALANCE_THREAD, id);
                   }
 
+                  /* Add to load balance sums */
+
+                  OMPBalance(OMP_BALANCE_STOP, -1);
+
                   /* Even out ques for next generation */
 
                   tosimulate = ReDistributeQues();
@@ -1309,6 +1388,10 @@ void TransportCycle()
               ptr = (long)RDB[RES_CPU_USAGE];
               AddStat(t0, ptr, 0);
 
+              /* Calculate load imbalance */
+
+              OMPBalance(OMP_BALANCE_END, -1);
+
               /* Print cycle output */
 
               PrintCycleOutput();
@@ -1564,6 +1647,10 @@ void TransportCycle()
 
                       StartTimer(TIMER_OMP_PARA);
 
+                      /* Reset load balance data */
+
+                      OMPBalance(OMP_BALANCE_START, -1);
+
                       /* Loop until source is empty */
 
 #ifdef OPEN_MP
@@ -1579,8 +1666,15 @@ void TransportCycle()
                         while(FromSrc(id) > VALID_PTR)
                           Tracking(id);
 
+                        /* Store finish time */
+
+                        OMPBalance(OMP_BALANCE_THREAD, id);
                       }
 
+                      /* Add to load balance sums */
+
+                      OMPBalance(OMP_BALANCE_STOP, -1);
+
                       /* Parallel loop over histories */
                       /* Track neutrons */
 
@@ -1591,6 +1685,10 @@ void TransportCycle()
                       while (tosimulate > 0)
                         {
 
+                          /* Reset load balance data */
+
+                          OMPBalance(OMP_BALANCE_START, -1);
+
                           /* Track current generation */
 
 #ifdef OPEN_MP
@@ -1604,8 +1702,16 @@ void TransportCycle()
                             /* Track neutrons */
 
                             Tracking(id);
+
+                            /* Store finish time */
+
+                            OMPBalance(OMP_BALANCE_THREAD, id);
                           }
 
+                          /* Add to load balance sums */
+
+                          OMPBalance(OMP_BALANCE_STOP, -1);
+
                           /* Even out ques for next generation */
 
                           tosimulate = ReDistributeQues();
@@ -1682,6 +1788,10 @@ void TransportCycle()
                       ptr = (long)RDB[RES_CPU_USAGE];
                       AddStat(t0, ptr, 0);
 
+                      /* Calculate load imbalance */
+
+                      OMPBalance(OMP_BALANCE_END, -1);
+
                       /* Print cycle output */
 
                       PrintCycleOutput();
@@ -1963,6 +2073,10 @@ void TransportCycle()
 
           StartTimer(TIMER_OMP_PARA);
 
+          /* Reset load balance data */
+
+          OMPBalance(OMP_BALANCE_START, -1);
+
           /* Loop until source is empty */
 
 #ifdef OPEN_MP
@@ -1973,16 +2087,27 @@ void TransportCycle()
 
             id = OMP_THREAD_NUM;
 
-            /* Loop over source */
+            /* Loop over source (event-based or history-based mode) */
+
+            if ((long)RDB[DATA_EVENT_TRANSPORT] == YES)
+              TrackingBank(id);
+            else
+              while(FromSrc(id) > VALID_PTR)
+                Tracking(id);
+
+            /* Store finish time */
 
-            while(FromSrc(id) > VALID_PTR)
-              Tracking(id);
+            OMPBalance(OMP_BALANCE_THREAD, id);
           }
 
           /* Stop parallel timer */
 
           StopTimer(TIMER_OMP_PARA);
 
+          /* Add to load balance sums */
+
+          OMPBalance(OMP_BALANCE_STOP, -1);
+
           /* MGa: Reset the flags used to manage termination in DD mode */
 
           no_particles_left = 0;
@@ -2118,6 +2243,10 @@ void TransportCycle()
           ptr = (long)RDB[RES_CPU_USAGE];
           AddStat(t0, ptr, 0);
 
+          /* Calculate load imbalance */
+
+          OMPBalance(OMP_BALANCE_END, -1);
+
           /* Print cycle-wise output */
 
           PrintCycleOutput();
@@ -0,0 +1,62 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : unpackxs.c                                     */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Reads reconstructed cross section array stored by PackXS()   */
+/*              into double-precision array                                  */
+/*                                                                           */
+/* Comments: - Used by routines that process the full array. MacroXS()       */
+/*             reads the single-precision values directly.                   */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "UnpackXS:"
+
+/*****************************************************************************/
+
+void UnpackXS(long rea, double *xs, long ne)
+{
+  long ptr, n;
+  const float *sp;
+
+  /* Check pointers */
+
+  CheckPointer(FUNCTION_NAME, "(rea)", DATA_ARRAY, rea);
+
+  ptr = (long)RDB[rea + REACTION_PTR_XS];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  /* Check number of points */
+
+  if (ne != (long)RDB[rea + REACTION_XS_NE])
+    Die(FUNCTION_NAME, "Mismatch in array size");
+
+  /* Check mode */
+
+  if ((long)RDB[rea + REACTION_XS_SP] == NO)
+    {
+      /* Copy data */
+
+      memcpy(xs, &RDB[ptr], ne*sizeof(double));
+    }
+  else
+    {
+      /* Pointer to packed data */
+
+      sp = (const float *)&RDB[ptr];
+
+      /* Read values */
+
+      for (n = 0; n < ne; n++)
+        xs[n] = (double)sp[n];
+    }
+}
+
+/*****************************************************************************/
@@ -0,0 +1,112 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : walktetmesh.c                                  */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Finds tet cell containing point by walking through the mesh  */
+/*              from a given starting cell                                   */
+/*                                                                           */
+/* Comments: - Remembering walk: at each step the signed distances to the    */
+/*             four faces are calculated from the planes packed in           */
+/*             PackTetFaces(), and the walk proceeds through the face with   */
+/*             the largest positive distance, excluding the face through     */
+/*             which the cell was entered.                                   */
+/*                                                                           */
+/*           - Returns NULLPTR if the walk cannot continue (boundary face or */
+/*             return to previous cell) or the maximum number of steps is    */
+/*             exceeded. The calling routine must then fall back to search   */
+/*             mesh.                                                         */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "WalkTetMesh:"
+
+#define MAX_WALK_STEPS 500
+
+/*****************************************************************************/
+
+long WalkTetMesh(long tet, double x, double y, double z)
+{
+  long prev, next, nbr, n, i;
+  double L[4], max;
+  const double *U, *V, *W, *D;
+
+  /* Reset previous */
+
+  prev = -1;
+
+  /* Walk */
+
+  for (n = 0; n < MAX_WALK_STEPS; n++)
+    {
+      /* Check pointer */
+
+      CheckPointer(FUNCTION_NAME, "(tet)", DATA_ARRAY, tet);
+
+      /* Pointers to face planes */
+
+      U = &RDB[tet + TET_FACE_U];
+      V = &RDB[tet + TET_FACE_V];
+      W = &RDB[tet + TET_FACE_W];
+      D = &RDB[tet + TET_FACE_D];
+
+      /* Calculate signed distances to faces */
+
+      for (i = 0; i < 4; i++)
+        L[i] = U[i]*x + V[i]*y + W[i]*z - D[i];
+
+      /* Find face with largest positive distance (boundary faces and the */
+      /* face leading back to previous cell are skipped) */
+
+      max = 0.0;
+      next = -1;
+
+      for (i = 0; i < 4; i++)
+        if (L[i] > max)
+          {
+            /* Get neighbour */
+
+            nbr = (long)RDB[tet + TET_NEIGHBOURS + i];
+
+            /* Compare */
+
+            if ((nbr > VALID_PTR) && (nbr != prev))
+              {
+                max = L[i];
+                next = nbr;
+              }
+          }
+
+      /* Check if neighbour was found */
+
+      if (next < VALID_PTR)
+        {
+          /* Check if point is outside any face */
+
+          for (i = 0; i < 4; i++)
+            if (L[i] > 0.0)
+              return NULLPTR;
+
+          /* Point is inside all faces, return pointer */
+
+          return tet;
+        }
+
+      /* Move to next cell */
+
+      prev = tet;
+      tet = next;
+    }
+
+  /* Maximum number of steps exceeded */
+
+  return NULLPTR;
+}
+
+/*****************************************************************************/
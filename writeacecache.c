@@ -0,0 +1,131 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : writeacecache.c                                */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Writes NXS, JXS, IZ and XSS arrays of an ACE table into      */
+/*              binary cache file read by ReadACECache().                    */
+/*                                                                           */
+/* Comments: - Must be called right after the table is read, before the      */
+/*             XSS array is modified and while the file position is at the   */
+/*             end of the table.                                             */
+/*                                                                           */
+/*           - Written by MPI task 0 only. The file is first written under   */
+/*             a temporary name and then renamed, so that other tasks never  */
+/*             map an incomplete file.                                       */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "WriteACECache:"
+
+/*****************************************************************************/
+
+void WriteACECache(long nuc, FILE *fp, const long *NXS, const long *JXS,
+                   const long *IZ, double awr)
+{
+  long ace, ptr, n, sz, hdr[ACE_CACHE_HDR_SIZE];
+  char fname[MAX_STR], tmpname[MAX_STR + 32];
+  FILE *fc;
+
+  /* Check MPI task */
+
+  if (mpiid > 0)
+    return;
+
+  /* Get file name and source identifiers */
+
+  if (ACECacheHeader(nuc, fp, fname, hdr, YES) == NO)
+    return;
+
+  /* Pointer to ACE data */
+
+  ace = (long)RDB[nuc + NUCLIDE_PTR_ACE];
+  CheckPointer(FUNCTION_NAME, "ace", ACE_ARRAY, ace);
+
+  /* Pointer to XSS array */
+
+  ptr = (long)ACE[ace + ACE_PTR_XSS];
+  CheckPointer(FUNCTION_NAME, "(ptr)", ACE_ARRAY, ptr);
+
+  /* Data size */
+
+  sz = NXS[0];
+
+  /* Put position and data */
+
+  if ((hdr[ACE_CACHE_HDR_POS] = ftell(fp)) == -1)
+    Die(FUNCTION_NAME, "ftell error");
+
+  hdr[ACE_CACHE_HDR_SZ] = sz;
+
+  for (n = 0; n < 16; n++)
+    hdr[ACE_CACHE_HDR_NXS + n] = NXS[n];
+
+  for (n = 0; n < 32; n++)
+    hdr[ACE_CACHE_HDR_JXS + n] = JXS[n];
+
+  for (n = 0; n < 16; n++)
+    hdr[ACE_CACHE_HDR_IZ + n] = IZ[n];
+
+  /* Open temporary file */
+
+  if (snprintf(tmpname, sizeof(tmpname), "%s.%ld.tmp", fname,
+               (long)getpid()) >= (int)sizeof(tmpname))
+    Error(0, "ACE cache file name \"%s\" too long", fname);
+
+  if ((fc = fopen(tmpname, "w")) == NULL)
+    {
+      /* Print warning */
+
+      Warn(FUNCTION_NAME, "Unable to write ACE cache file \"%s\"", fname);
+
+      /* Exit */
+
+      return;
+    }
+
+  /* Write data */
+
+  if ((fwrite(hdr, sizeof(long), ACE_CACHE_HDR_SIZE, fc) !=
+       ACE_CACHE_HDR_SIZE) ||
+      (fwrite(&awr, sizeof(double), 1, fc) != 1) ||
+      (fwrite(&ACE[ptr], sizeof(double), sz, fc) != (size_t)sz))
+    {
+      /* Close and remove file */
+
+      fclose(fc);
+      remove(tmpname);
+
+      /* Print warning */
+
+      Warn(FUNCTION_NAME, "Error writing ACE cache file \"%s\"", fname);
+
+      /* Exit */
+
+      return;
+    }
+
+  /* Close file */
+
+  fclose(fc);
+
+  /* Rename */
+
+  if (rename(tmpname, fname) != 0)
+    {
+      remove(tmpname);
+      return;
+    }
+
+  /* Add counter */
+
+  WDB[DATA_ACE_CACHE_N_WRITE] = RDB[DATA_ACE_CACHE_N_WRITE] + 1.0;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,245 @@
+/*****************************************************************************/
+/*                                                                           */
+/* serpent 2 (beta-version) : writecsmcache.c                                */
+/*                                                                           */
+/* Created:       2026/10/17 (JLe)                                           */
+/* Last modified: 2026/10/17 (JLe)                                           */
+/* Version:       2.1.32                                                     */
+/*                                                                           */
+/* Description: Writes adaptive cell search mesh of a universe in cache file */
+/*                                                                           */
+/* Comments: - Mesh is written in depth-first order. Each mesh cell is       */
+/*             either -1 (split, followed by the cells of the sub-mesh) or   */
+/*             the number of candidate cells followed by their indexes in    */
+/*             the universe cell list. The data is independent of memory     */
+/*             addresses.                                                    */
+/*                                                                           */
+/*           - File is written to a temporary name and renamed, so that      */
+/*             other runs never see a partial file.                          */
+/*                                                                           */
+/*****************************************************************************/
+
+#include "header.h"
+#include "locations.h"
+
+#define FUNCTION_NAME "WriteCSMCache:"
+
+static long WriteCacheData(long, long *, long, const long *, long);
+static int ComparePtr(const void *, const void *);
+
+/*****************************************************************************/
+
+void WriteCSMCache(long uni)
+{
+  long msh, lst, loc0, nc, n, sz, hdr[CSM_CACHE_HDR_SIZE], *idx, *dat;
+  char fname[MAX_STR], tmpname[MAX_STR + 32];
+  FILE *fc;
+
+  /* Check MPI task */
+
+  if (mpiid > 0)
+    return;
+
+  /* Get file name and geometry identifiers */
+
+  if (CSMCacheHeader(uni, fname, hdr) == NO)
+    return;
+
+  /* Pointer to mesh */
+
+  msh = (long)RDB[uni + UNIVERSE_PTR_SEARCH_MESH];
+  CheckPointer(FUNCTION_NAME, "(msh)", DATA_ARRAY, msh);
+
+  /* Pointer to cell list */
+
+  lst = (long)RDB[uni + UNIVERSE_PTR_CELL_LIST];
+  CheckPointer(FUNCTION_NAME, "(lst)", DATA_ARRAY, lst);
+
+  /* Number of cells */
+
+  nc = hdr[CSM_CACHE_HDR_NC];
+
+  /* Create sorted table of cell list item pointers and list indexes */
+
+  idx = (long *)Mem(MEM_ALLOC, 2*nc, sizeof(long));
+
+  for (n = 0; n < nc; n++)
+    {
+      loc0 = ListPtr(lst, n);
+      CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+      idx[2*n] = loc0;
+      idx[2*n + 1] = n;
+    }
+
+  qsort(idx, nc, 2*sizeof(long), ComparePtr);
+
+  /* Get data size, allocate memory and put data */
+
+  sz = WriteCacheData(msh, NULL, 0, idx, nc);
+  dat = (long *)Mem(MEM_ALLOC, sz, sizeof(long));
+
+  if (WriteCacheData(msh, dat, 0, idx, nc) != sz)
+    Die(FUNCTION_NAME, "Error in data size");
+
+  hdr[CSM_CACHE_HDR_SZ] = sz;
+
+  /* Free index table */
+
+  Mem(MEM_FREE, idx);
+
+  /* Open temporary file */
+
+  if (snprintf(tmpname, sizeof(tmpname), "%s.%ld.tmp", fname,
+               (long)getpid()) >= (int)sizeof(tmpname))
+    Error(0, "Cell search mesh cache file name \"%s\" too long", fname);
+
+  if ((fc = fopen(tmpname, "w")) == NULL)
+    {
+      /* Print warning */
+
+      Warn(FUNCTION_NAME, "Unable to write cell search mesh cache file \"%s\"",
+           fname);
+
+      /* Free memory and exit */
+
+      Mem(MEM_FREE, dat);
+
+      return;
+    }
+
+  /* Write data */
+
+  if ((fwrite(hdr, sizeof(long), CSM_CACHE_HDR_SIZE, fc) !=
+       CSM_CACHE_HDR_SIZE) ||
+      (fwrite(dat, sizeof(long), sz, fc) != (size_t)sz))
+    {
+      /* Close and remove file */
+
+      fclose(fc);
+      remove(tmpname);
+
+      /* Print warning */
+
+      Warn(FUNCTION_NAME, "Error writing cell search mesh cache file \"%s\"",
+           fname);
+
+      /* Free memory and exit */
+
+      Mem(MEM_FREE, dat);
+
+      return;
+    }
+
+  /* Close file and free memory */
+
+  fclose(fc);
+  Mem(MEM_FREE, dat);
+
+  /* Rename */
+
+  if (rename(tmpname, fname) != 0)
+    remove(tmpname);
+}
+
+/*****************************************************************************/
+
+/***** Put mesh data (returns new position) **********************************/
+
+static long WriteCacheData(long msh, long *dat, long pos, const long *idx,
+                           long nc)
+{
+  long ptr, loc0, n, ncell, m, i, key[2];
+  const long *found;
+
+  /* Check pointer */
+
+  CheckPointer(FUNCTION_NAME, "(msh)", DATA_ARRAY, msh);
+
+  /* Number of mesh cells */
+
+  ncell = (long)RDB[msh + MESH_N0]*(long)RDB[msh + MESH_N1]*
+    (long)RDB[msh + MESH_N2];
+
+  /* Pointer to content */
+
+  ptr = (long)RDB[msh + MESH_PTR_PTR];
+  CheckPointer(FUNCTION_NAME, "(ptr)", DATA_ARRAY, ptr);
+
+  /* Loop over mesh cells */
+
+  for (n = 0; n < ncell; n++)
+    {
+      /* Check split */
+
+      if ((loc0 = (long)RDB[ptr + n]) < -VALID_PTR)
+        {
+          /* Put flag and sub-mesh */
+
+          if (dat != NULL)
+            dat[pos] = -1;
+
+          pos = WriteCacheData(-loc0, dat, pos + 1, idx, nc);
+
+          /* Cycle loop */
+
+          continue;
+        }
+
+      /* Check pointer */
+
+      CheckPointer(FUNCTION_NAME, "(loc0)", DATA_ARRAY, loc0);
+
+      /* Number of candidates */
+
+      m = (long)RDB[loc0 + CELL_SEARCH_MESH_N];
+
+      if (dat != NULL)
+        dat[pos] = m;
+
+      pos++;
+
+      /* Put cell indexes */
+
+      for (i = 0; i < m; i++)
+        {
+          if (dat != NULL)
+            {
+              /* Find index */
+
+              key[0] = (long)RDB[loc0 + CELL_SEARCH_MESH_PTR_C1 + i];
+
+              if ((found = (const long *)bsearch(key, idx, nc,
+                                                 2*sizeof(long),
+                                                 ComparePtr)) == NULL)
+                Die(FUNCTION_NAME, "Cell not in universe list");
+
+              /* Put index */
+
+              dat[pos] = found[1];
+            }
+
+          pos++;
+        }
+    }
+
+  /* Return position */
+
+  return pos;
+}
+
+/*****************************************************************************/
+
+/***** Compare pointers ******************************************************/
+
+static int ComparePtr(const void *a, const void *b)
+{
+  if (*(const long *)a < *(const long *)b)
+    return -1;
+  else if (*(const long *)a > *(const long *)b)
+    return 1;
+  else
+    return 0;
+}
+
+/*****************************************************************************/